@@ -0,0 +1,81 @@
+#include "chain/ModulationMatrix.hpp"
+
+#include "nodes/PitchShiftNode.hpp"
+#include "nodes/RingModNode.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace voicechanger {
+
+bool ModulationMatrix::canModulate(const ParameterizedNode& node, uint32_t id) {
+    if (id >= node.getParameterCount()) {
+        return false;
+    }
+    const auto& descriptor = node.getParameterDescriptor(id);
+    if (descriptor.readOnly || descriptor.scale == ParameterScale::kDiscrete) {
+        return false;
+    }
+    return dynamic_cast<const PitchShiftNode*>(&node) || dynamic_cast<const RingModNode*>(&node);
+}
+
+void ModulationMatrix::addRoute(const ModulationSpec& spec, ParameterHandle target, float base) {
+    size_t owner = routes_.size();
+    for (size_t i = 0; i < routes_.size(); ++i) {
+        if (routes_[i].target.getNode() == target.getNode() && routes_[i].target.getId() == target.getId()) {
+            owner = i;
+            break;
+        }
+    }
+    routes_.push_back({dsp::Modulator(), spec, target, owner, base});
+}
+
+void ModulationMatrix::prepare(uint sampleRate) {
+    float controlRate = static_cast<float>(sampleRate) / static_cast<float>(kControlFrames);
+    for (size_t i = 0; i < routes_.size(); ++i) {
+        const auto& spec = routes_[i].spec;
+        // Each route gets its own random sequence
+        routes_[i].source.prepare(spec.source, spec.rateHz, spec.attackMs, spec.releaseMs, controlRate,
+                                  static_cast<uint32_t>(i + 1));
+    }
+    position_ = 0;
+    periodPeak_ = 0.0f;
+}
+
+void ModulationMatrix::process(const float* const* input, uint numChannels, uint numFrames) {
+    if (position_ == 0) {
+        // Envelopes follow the period just finished
+        float peak = periodPeak_;
+        periodPeak_ = 0.0f;
+        for (auto& route : routes_) {
+            route.sum = 0.0f;
+        }
+        for (auto& route : routes_) {
+            routes_[route.owner].sum += route.spec.depth * route.source.step(peak);
+        }
+        for (size_t i = 0; i < routes_.size(); ++i) {
+            if (routes_[i].owner == i) {
+                routes_[i].target.set(routes_[i].base + routes_[i].sum);
+            }
+        }
+    }
+
+    for (uint ch = 0; ch < numChannels; ++ch) {
+        for (uint i = 0; i < numFrames; ++i) {
+            periodPeak_ = std::max(periodPeak_, std::abs(input[ch][i]));
+        }
+    }
+    position_ = (position_ + numFrames) % kControlFrames;
+}
+
+bool ModulationMatrix::setBase(const ParameterHandle& target, float value) {
+    for (auto& route : routes_) {
+        if (route.target.getNode() == target.getNode() && route.target.getId() == target.getId()) {
+            routes_[route.owner].base = value;
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace voicechanger
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "dsp/Modulator.hpp"
+#include "nodes/ParameterizedNode.hpp"
+
+#include <string>
+#include <vector>
+
+namespace voicechanger {
+
+/**
+ * One modulation route of a preset: a source and the stage parameter it
+ * moves. The parameter follows its preset value plus depth times the
+ * source (-1 to 1, or 0 to 1 for the envelope), clamped to its range.
+ */
+struct ModulationSpec {
+    dsp::ModulatorType source = dsp::ModulatorType::kSine;
+    std::string stageId;
+    std::string key;
+    float depth = 0.0f;       // In the parameter's own units
+    float rateHz = 1.0f;      // LFO frequency, or random-walk speed
+    float attackMs = 10.0f;   // Envelope only
+    float releaseMs = 200.0f; // Envelope only
+};
+
+/**
+ * ModulationMatrix - Control-rate modulation of a chain's parameters.
+ *
+ * Every route owns one dsp::Modulator, and routes to the same parameter
+ * add. Once per kControlFrames frames the matrix steps each source and
+ * sets its target through a ParameterHandle; the targets are parameters
+ * that PitchShiftNode and RingModNode ramp to per sample, so the
+ * control-rate values come out as straight lines rather than steps.
+ * Routes are added on the control thread; process() and setBase() only
+ * touch preallocated state.
+ */
+class ModulationMatrix {
+public:
+    static constexpr uint kControlFrames = 32;
+
+    /**
+     * @brief True if a parameter can be a modulation target: a settable,
+     *        continuous parameter of a node that ramps it per sample.
+     */
+    static bool canModulate(const ParameterizedNode& node, uint32_t id);
+
+    /**
+     * @brief Adds a route around base, the parameter's preset value. Control thread.
+     */
+    void addRoute(const ModulationSpec& spec, ParameterHandle target, float base);
+
+    /**
+     * @brief Sets every source's coefficients for a sample rate and restarts them.
+     */
+    void prepare(uint sampleRate);
+
+    bool empty() const { return routes_.empty(); }
+    size_t getRouteCount() const { return routes_.size(); }
+
+    /**
+     * @brief Frames left before the next control step; process() must not
+     *        be given more than this.
+     */
+    uint framesUntilStep() const { return kControlFrames - position_; }
+
+    /**
+     * @brief Steps the sources at the start of a control period and follows
+     *        the input's level for the envelopes. Audio thread.
+     */
+    void process(const float* const* input, uint numChannels, uint numFrames);
+
+    /**
+     * @brief Moves the value a routed parameter is modulated around.
+     * @return False if no route targets the parameter. Audio thread.
+     */
+    bool setBase(const ParameterHandle& target, float value);
+
+private:
+    struct Route {
+        dsp::Modulator source;
+        ModulationSpec spec;
+        ParameterHandle target;
+        size_t owner;  // First route to the same target, which holds base and sum
+        float base;
+        float sum = 0.0f;
+    };
+
+    std::vector<Route> routes_;
+    uint position_ = 0;       // Frames into the current control period
+    float periodPeak_ = 0.0f; // Input peak so far in the current period
+};
+
+} // namespace voicechanger
@@ -0,0 +1,99 @@
+#include "chain/PresetMorph.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace voicechanger {
+
+std::unique_ptr<PresetMorph> PresetMorph::create(const ChainSpec& from, const ChainSpec& to, std::string& error) {
+    if (from.stages.size() != to.stages.size()) {
+        error = "cannot morph " + from.name + " into " + to.name + ": they have different stages";
+        return nullptr;
+    }
+
+    std::unique_ptr<PresetMorph> morph(new PresetMorph());
+    morph->from_ = from;
+    morph->to_ = to;
+    for (size_t i = 0; i < from.stages.size(); ++i) {
+        const StageSpec& a = from.stages[i];
+        const StageSpec& b = to.stages[i];
+        if (a.id != b.id || a.type != b.type) {
+            error = "cannot morph " + from.name + " into " + to.name + ": stage " + std::to_string(i) + " is " +
+                    a.id + " (" + a.type + ") in one and " + b.id + " (" + b.type + ") in the other";
+            return nullptr;
+        }
+
+        // The stage's table supplies defaults for keys set on one side only, and the scales
+        auto probe = VoiceChain::createStage(a.type);
+        if (!probe) {
+            error = a.id + ": unknown type " + a.type;
+            return nullptr;
+        }
+        for (uint32_t id = 0; id < probe->getParameterCount(); ++id) {
+            const auto& descriptor = probe->getParameterDescriptor(id);
+            if (descriptor.readOnly) {
+                continue;
+            }
+            float start = a.getParam(descriptor.key, descriptor.defaultValue);
+            float end = b.getParam(descriptor.key, descriptor.defaultValue);
+            if (start != end) {
+                morph->tracks_.push_back({a.id, descriptor.key, start, end, descriptor.scale, start});
+            }
+        }
+    }
+    morph->changes_.reserve(morph->tracks_.size());
+    return morph;
+}
+
+float PresetMorph::valueAt(const Track& track, float position) {
+    if (position <= 0.0f) {
+        return track.from;
+    }
+    if (position >= 1.0f) {
+        return track.to;
+    }
+
+    ParameterScale scale = track.scale;
+    // Zero means "off" for some frequencies and times; there is no geometric path from it
+    if (scale == ParameterScale::kLog && (track.from <= 0.0f || track.to <= 0.0f)) {
+        scale = ParameterScale::kDiscrete;
+    }
+    switch (scale) {
+        case ParameterScale::kLog:
+            return track.from * std::pow(track.to / track.from, position);
+        case ParameterScale::kDiscrete:
+            return position < 0.5f ? track.from : track.to;
+        case ParameterScale::kLinear:
+        default:
+            return track.from + (track.to - track.from) * position;
+    }
+}
+
+ChainSpec PresetMorph::specAt(float position) const {
+    position = std::clamp(position, 0.0f, 1.0f);
+    ChainSpec spec = position < 0.5f ? from_ : to_;
+    spec.validated = false;  // Interpolation can round a hair past an endpoint
+    for (const auto& track : tracks_) {
+        for (auto& stage : spec.stages) {
+            if (stage.id == track.stageId) {
+                stage.setParam(track.key, valueAt(track, position));
+            }
+        }
+    }
+    return spec;
+}
+
+const std::vector<ParameterChange>& PresetMorph::update(float position) {
+    position_ = std::clamp(position, 0.0f, 1.0f);
+    changes_.clear();
+    for (auto& track : tracks_) {
+        float value = valueAt(track, position_);
+        if (value != track.last) {
+            track.last = value;
+            changes_.push_back({track.stageId, track.key, value});
+        }
+    }
+    return changes_;
+}
+
+} // namespace voicechanger
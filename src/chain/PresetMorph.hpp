@@ -0,0 +1,72 @@
+#pragma once
+
+#include "chain/VoiceChain.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace voicechanger {
+
+/**
+ * PresetMorph - Interpolates every parameter between two presets.
+ *
+ * Both presets must have the same stages (ids and types, in order); a key
+ * set on only one side takes the stage's default on the other. Each
+ * parameter moves along the scale its node's table gives it: linearly for
+ * mixes, gains, tap levels and semitones, geometrically for frequencies and
+ * times, and in one step at the midpoint for switches and indices. Position
+ * 0 is exactly the first preset and 1 exactly the second. Modulation
+ * routes are not interpolated; the running preset's stay in place.
+ *
+ * update() returns only the parameters whose value changed since the last
+ * call, so pushing a morph position into a running chain costs one change
+ * per moving parameter and nothing for the rest.
+ */
+class PresetMorph {
+public:
+    /**
+     * @brief Builds the morph, or returns nullptr with the reason in error
+     *        (different stages, or a stage type that does not exist).
+     */
+    static std::unique_ptr<PresetMorph> create(const ChainSpec& from, const ChainSpec& to, std::string& error);
+
+    const ChainSpec& getFrom() const { return from_; }
+    const ChainSpec& getTo() const { return to_; }
+    float getPosition() const { return position_; }
+    size_t getTrackCount() const { return tracks_.size(); }
+
+    /**
+     * @brief The whole preset at a position (clamped to 0..1), named after
+     *        whichever end it is closer to.
+     */
+    ChainSpec specAt(float position) const;
+
+    /**
+     * @brief Moves to a position (clamped to 0..1) and returns the values
+     *        that changed since the last call. Starts at position 0.
+     */
+    const std::vector<ParameterChange>& update(float position);
+
+private:
+    // One parameter that differs between the presets
+    struct Track {
+        std::string stageId;
+        std::string key;
+        float from;
+        float to;
+        ParameterScale scale;
+        float last;
+    };
+
+    PresetMorph() = default;
+    static float valueAt(const Track& track, float position);
+
+    ChainSpec from_;
+    ChainSpec to_;
+    std::vector<Track> tracks_;
+    std::vector<ParameterChange> changes_;
+    float position_ = 0.0f;
+};
+
+} // namespace voicechanger
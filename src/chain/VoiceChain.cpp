@@ -0,0 +1,267 @@
+#include "chain/VoiceChain.hpp"
+
+#include "nodes/DelayNode.hpp"
+#include "nodes/DriveNode.hpp"
+#include "nodes/GlitchNode.hpp"
+#include "nodes/ModDelayNode.hpp"
+#include "nodes/PitchShiftNode.hpp"
+#include "nodes/RingModNode.hpp"
+#include "nodes/WhisperNode.hpp"
+
+#include <switchboard_core/AudioBuffer.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace voicechanger {
+
+float StageSpec::getParam(const std::string& key, float fallback) const {
+    for (const auto& param : params) {
+        if (param.key == key) {
+            return param.value;
+        }
+    }
+    return fallback;
+}
+
+void StageSpec::setParam(const std::string& key, float value) {
+    for (auto& param : params) {
+        if (param.key == key) {
+            param.value = value;
+            return;
+        }
+    }
+    params.push_back({key, value});
+}
+
+bool ChainSpec::buildsSameChain(const ChainSpec& other) const {
+    const auto sameStage = [](const StageSpec& a, const StageSpec& b) {
+        return a.id == b.id && a.type == b.type &&
+               std::equal(a.params.begin(), a.params.end(), b.params.begin(), b.params.end(),
+                          [](const StageParam& p, const StageParam& q) { return p.key == q.key && p.value == q.value; });
+    };
+    const auto sameRoute = [](const ModulationSpec& a, const ModulationSpec& b) {
+        return a.source == b.source && a.stageId == b.stageId && a.key == b.key && a.depth == b.depth &&
+               a.rateHz == b.rateHz && a.attackMs == b.attackMs && a.releaseMs == b.releaseMs;
+    };
+    return name == other.name &&
+           std::equal(stages.begin(), stages.end(), other.stages.begin(), other.stages.end(), sameStage) &&
+           std::equal(modulations.begin(), modulations.end(), other.modulations.begin(), other.modulations.end(),
+                      sameRoute);
+}
+
+bool VoiceChain::isPassThrough(const StageSpec& stage) {
+    if (stage.type == "VoiceChanger.PitchShift" || stage.type == "VoiceChanger.Drive") {
+        return stage.getParam("mix", 1.0f) <= 0.0f && stage.getParam("outputGain", 1.0f) == 1.0f;
+    }
+    if (stage.type == "VoiceChanger.RingMod" || stage.type == "VoiceChanger.Glitch" ||
+        stage.type == "VoiceChanger.Whisper") {
+        return stage.getParam("mix", 1.0f) <= 0.0f;
+    }
+    if (stage.type == "VoiceChanger.ModDelay") {
+        return stage.getParam("useVibrato", 0.0f) <= 0.0f && stage.getParam("useChorus", 0.0f) <= 0.0f &&
+               stage.getParam("useFlanger", 0.0f) <= 0.0f;
+    }
+    if (stage.type == "VoiceChanger.Delay") {
+        return stage.getParam("wetMix", 0.5f) <= 0.0f && stage.getParam("dryMix", 1.0f) == 1.0f;
+    }
+    return false;
+}
+
+std::unique_ptr<ParameterizedNode> VoiceChain::createStage(const std::string& type) {
+    const switchboard::SBAnyMap defaults;
+    if (type == "VoiceChanger.PitchShift") {
+        return std::make_unique<PitchShiftNode>(defaults);
+    }
+    if (type == "VoiceChanger.Whisper") {
+        return std::make_unique<WhisperNode>(defaults);
+    }
+    if (type == "VoiceChanger.RingMod") {
+        return std::make_unique<RingModNode>(defaults);
+    }
+    if (type == "VoiceChanger.Drive") {
+        return std::make_unique<DriveNode>(defaults);
+    }
+    if (type == "VoiceChanger.Glitch") {
+        return std::make_unique<GlitchNode>(defaults);
+    }
+    if (type == "VoiceChanger.ModDelay") {
+        return std::make_unique<ModDelayNode>(defaults);
+    }
+    if (type == "VoiceChanger.Delay") {
+        return std::make_unique<DelayNode>(defaults);
+    }
+    return nullptr;
+}
+
+const std::vector<std::string>& VoiceChain::getStageTypes() {
+    static const std::vector<std::string> types = {
+        "VoiceChanger.PitchShift", "VoiceChanger.Whisper",  "VoiceChanger.RingMod", "VoiceChanger.Drive",
+        "VoiceChanger.Glitch",     "VoiceChanger.ModDelay", "VoiceChanger.Delay"};
+    return types;
+}
+
+std::unique_ptr<VoiceChain> VoiceChain::compile(const ChainSpec& spec,
+                                                const switchboard::AudioBusFormat& format,
+                                                std::string& error) {
+    std::unique_ptr<VoiceChain> chain(new VoiceChain());
+    chain->name_ = spec.name;
+    chain->numChannels_ = std::min(format.numberOfChannels, kMaxChannels);
+    chain->maxFrames_ = std::max(format.numberOfFrames, 1u);
+    chain->sampleRate_ = format.sampleRate;
+
+    for (const auto& stage : spec.stages) {
+        // A modulated stage may be moved away from its pass-through values
+        bool modulated = std::any_of(spec.modulations.begin(), spec.modulations.end(),
+                                     [&](const ModulationSpec& m) { return m.stageId == stage.id; });
+        if (isPassThrough(stage) && !modulated) {
+            continue;
+        }
+        auto node = createStage(stage.type);
+        if (!node) {
+            error = "Unknown stage type: " + stage.type;
+            return nullptr;
+        }
+        for (const auto& param : stage.params) {
+            if (!std::isfinite(param.value)) {
+                error = stage.id + ": \"" + param.key + "\" must be a finite number";
+                return nullptr;
+            }
+            if (param.id != ParameterizedNode::kUnknownParameter) {
+                if (spec.validated) {
+                    node->setValidatedParameter(static_cast<uint32_t>(param.id), param.value);
+                } else {
+                    node->setParameter(static_cast<uint32_t>(param.id), param.value);
+                }
+                continue;
+            }
+            auto result = node->setValue(param.key, param.value);
+            if (result.isError()) {
+                error = stage.id + ": " + result.error().message;
+                return nullptr;
+            }
+        }
+        switchboard::AudioBusFormat inputFormat = format;
+        switchboard::AudioBusFormat outputFormat;
+        if (!node->setBusFormat(inputFormat, outputFormat)) {
+            error = "Stage rejected the bus format: " + stage.id;
+            return nullptr;
+        }
+        chain->stages_.push_back({stage.id, std::move(node)});
+    }
+
+    for (const auto& modulation : spec.modulations) {
+        ParameterHandle target = chain->findParameter(modulation.stageId, modulation.key);
+        if (!target || !ModulationMatrix::canModulate(*target.getNode(), target.getId())) {
+            error = "Cannot modulate " + modulation.stageId + "." + modulation.key;
+            return nullptr;
+        }
+        chain->modulation_.addRoute(modulation, target, target.get());
+    }
+    chain->modulation_.prepare(chain->sampleRate_);
+
+    chain->scratch_.assign(2 * static_cast<size_t>(chain->numChannels_) * chain->maxFrames_, 0.0f);
+    return chain;
+}
+
+std::vector<std::string> VoiceChain::getStageIds() const {
+    std::vector<std::string> ids;
+    ids.reserve(stages_.size());
+    for (const auto& stage : stages_) {
+        ids.push_back(stage.id);
+    }
+    return ids;
+}
+
+ParameterizedNode* VoiceChain::findStage(const std::string& id) const {
+    for (const auto& stage : stages_) {
+        if (stage.id == id) {
+            return stage.node.get();
+        }
+    }
+    return nullptr;
+}
+
+ParameterHandle VoiceChain::findParameter(const std::string& stageId, const std::string& key) const {
+    ParameterizedNode* node = findStage(stageId);
+    return node ? node->getParameterHandle(key) : ParameterHandle();
+}
+
+void VoiceChain::applyParameter(const ParameterHandle& handle, float value) {
+    if (!std::isfinite(value)) {
+        return;
+    }
+    if (!modulation_.setBase(handle, value)) {
+        handle.set(value);
+    }
+}
+
+bool VoiceChain::process(switchboard::AudioBus& inBus, switchboard::AudioBus& outBus) {
+    auto* inBuffer = inBus.getBuffer();
+    auto* outBuffer = outBus.getBuffer();
+
+    if (!inBuffer || !outBuffer) {
+        return false;
+    }
+
+    uint numFrames = inBuffer->getNumberOfFrames();
+    uint numChannels = std::min(inBuffer->getNumberOfChannels(), numChannels_);
+
+    // Channels beyond the chain's pass through, as do all of them with no stages
+    for (uint ch = stages_.empty() ? 0 : numChannels; ch < inBuffer->getNumberOfChannels(); ++ch) {
+        const float* inData = inBuffer->getReadPointer(ch);
+        std::copy(inData, inData + numFrames, outBuffer->getWritePointer(ch));
+    }
+    if (stages_.empty()) {
+        return true;
+    }
+
+    bool ok = true;
+    for (uint done = 0; done < numFrames;) {
+        uint length = std::min(maxFrames_, numFrames - done);
+        if (!modulation_.empty()) {
+            length = std::min(length, modulation_.framesUntilStep());
+        }
+
+        // Planar views of this span: the chain input, two scratch buffers, the chain output
+        float* inPointers[kMaxChannels];
+        float* outPointers[kMaxChannels];
+        float* scratchPointers[2][kMaxChannels];
+        for (uint ch = 0; ch < numChannels; ++ch) {
+            // Stages only read their input bus
+            inPointers[ch] = const_cast<float*>(inBuffer->getReadPointer(ch)) + done;
+            outPointers[ch] = outBuffer->getWritePointer(ch) + done;
+            for (size_t s = 0; s < 2; ++s) {
+                scratchPointers[s][ch] = scratch_.data() + (s * numChannels_ + ch) * maxFrames_;
+            }
+        }
+
+        switchboard::AudioBusFormat format(sampleRate_, numChannels, length);
+        switchboard::AudioBuffer<float> inView(numChannels, length, false, sampleRate_, inPointers);
+        switchboard::AudioBuffer<float> outView(numChannels, length, false, sampleRate_, outPointers);
+        switchboard::AudioBuffer<float> scratchView0(numChannels, length, false, sampleRate_, scratchPointers[0]);
+        switchboard::AudioBuffer<float> scratchView1(numChannels, length, false, sampleRate_, scratchPointers[1]);
+        switchboard::AudioBus buses[4] = {switchboard::AudioBus(&inView), switchboard::AudioBus(&scratchView0),
+                                          switchboard::AudioBus(&scratchView1), switchboard::AudioBus(&outView)};
+        for (auto& bus : buses) {
+            bus.setFormat(format);
+        }
+
+        if (!modulation_.empty()) {
+            modulation_.process(inPointers, numChannels, length);
+        }
+
+        // Input -> scratch 0 -> scratch 1 -> scratch 0 ... -> output
+        for (size_t i = 0; i < stages_.size(); ++i) {
+            auto& source = i == 0 ? buses[0] : buses[1 + (i - 1) % 2];
+            auto& destination = i + 1 == stages_.size() ? buses[3] : buses[1 + i % 2];
+            ok = stages_[i].node->process(source, destination) && ok;
+        }
+
+        done += length;
+    }
+
+    return ok;
+}
+
+} // namespace voicechanger
@@ -0,0 +1,162 @@
+#pragma once
+
+#include "chain/ModulationMatrix.hpp"
+#include "nodes/ParameterizedNode.hpp"
+
+#include <switchboard_core/AudioBus.hpp>
+#include <switchboard_core/AudioBusFormat.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace voicechanger {
+
+/**
+ * One parameter value of a stage. id is the parameter's index in the
+ * stage's table when already resolved (the preset loader does this), so
+ * compiling skips the key lookup; otherwise the key is looked up.
+ */
+struct StageParam {
+    std::string key;
+    float value;
+    int id = ParameterizedNode::kUnknownParameter;
+};
+
+/**
+ * One node of a preset graph: its id, its type ("VoiceChanger.RingMod")
+ * and the parameters set on it. Parameters not listed keep their defaults.
+ */
+struct StageSpec {
+    std::string id;
+    std::string type;
+    std::vector<StageParam> params;
+
+    float getParam(const std::string& key, float fallback) const;
+    void setParam(const std::string& key, float value);
+};
+
+/**
+ * A preset graph as a linear chain, in processing order, with the
+ * modulation routes that move its stages' parameters.
+ *
+ * validated is set by the preset validator (see PresetValidator.hpp) once
+ * every parameter with an id is known to be settable and in range; compile()
+ * then stores those values without clamping them again. Code that edits a
+ * validated spec's values must clear it.
+ */
+struct ChainSpec {
+    std::string name;
+    std::vector<StageSpec> stages;
+    std::vector<ModulationSpec> modulations;
+    bool validated = false;
+
+    /**
+     * @brief True if both specs compile to the same chain: the same name,
+     *        stages, parameter values and modulation routes, in the same
+     *        order. Resolved ids and the validated flag are not compared.
+     */
+    bool buildsSameChain(const ChainSpec& other) const;
+};
+
+/**
+ * A new value for one parameter of one stage of a running chain.
+ */
+struct ParameterChange {
+    std::string stageId;
+    std::string key;
+    float value;
+};
+
+/**
+ * VoiceChain - A preset compiled into the stages it actually needs.
+ *
+ * compile() constructs a node for every stage of a ChainSpec except those
+ * whose parameters make them an exact pass-through (a zero mix, every
+ * ModDelay effect off, a Delay with no wet signal), sizes them for the bus
+ * format and allocates two scratch buffers to ping-pong between stages.
+ * All allocation happens there, on the control thread; process() runs the
+ * surviving stages in order and allocates nothing. A chain with no stages
+ * copies its input.
+ *
+ * A stage that a modulation route targets is never pruned. With any routes
+ * the chain runs in spans of at most ModulationMatrix::kControlFrames, and
+ * the matrix sets its targets at the start of each span.
+ */
+class VoiceChain {
+public:
+    static constexpr uint kMaxChannels = 8;
+
+    /**
+     * @brief Builds the chain for a spec and bus format.
+     * @param error Receives the reason when nullptr is returned (unknown
+     *              stage type, a parameter the stage rejects, or a stage
+     *              rejecting the format).
+     */
+    static std::unique_ptr<VoiceChain> compile(const ChainSpec& spec,
+                                               const switchboard::AudioBusFormat& format,
+                                               std::string& error);
+
+    /**
+     * @brief True if a stage with these parameters leaves audio untouched.
+     */
+    static bool isPassThrough(const StageSpec& stage);
+
+    /**
+     * @brief Constructs the node for a stage type, at its defaults, or
+     *        nullptr if the type is unknown.
+     */
+    static std::unique_ptr<ParameterizedNode> createStage(const std::string& type);
+
+    /**
+     * @brief Every type createStage() accepts.
+     */
+    static const std::vector<std::string>& getStageTypes();
+
+    bool process(switchboard::AudioBus& inBus, switchboard::AudioBus& outBus);
+
+    const std::string& getName() const { return name_; }
+
+    // Order in which the owning node published the chain; 0 until it is
+    uint64_t getSequence() const { return sequence_; }
+    void setSequence(uint64_t sequence) { sequence_ = sequence; }
+
+    size_t getStageCount() const { return stages_.size(); }
+    std::vector<std::string> getStageIds() const;
+    ParameterizedNode* findStage(const std::string& id) const;
+
+    /**
+     * @brief Handle for a parameter of a compiled stage; empty if the stage
+     *        was pruned or has no such parameter. Valid for the chain's lifetime.
+     */
+    ParameterHandle findParameter(const std::string& stageId, const std::string& key) const;
+
+    /**
+     * @brief Sets a parameter of a compiled stage; for a modulated parameter
+     *        this moves the value it is modulated around. NaN and infinite
+     *        values are ignored. Audio thread.
+     */
+    void applyParameter(const ParameterHandle& handle, float value);
+
+    size_t getModulationCount() const { return modulation_.getRouteCount(); }
+
+private:
+    VoiceChain() = default;
+
+    struct Stage {
+        std::string id;
+        std::unique_ptr<ParameterizedNode> node;
+    };
+
+    std::string name_;
+    uint64_t sequence_ = 0;
+    std::vector<Stage> stages_;
+    ModulationMatrix modulation_;
+    std::vector<float> scratch_;  // Two planar buffers of numChannels_ x maxFrames_
+    uint numChannels_ = 0;
+    uint maxFrames_ = 0;
+    uint sampleRate_ = 0;
+};
+
+} // namespace voicechanger
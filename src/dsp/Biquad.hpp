@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cmath>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace voicechanger::dsp {
+
+/**
+ * Biquad - Transposed direct form II biquad filter (RBJ cookbook designs).
+ *
+ * Coefficients are computed on the control path; process() is branch-free
+ * and safe to call per sample on the audio thread.
+ */
+struct Biquad {
+    float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f, a1 = 0.0f, a2 = 0.0f;
+    float z1 = 0.0f, z2 = 0.0f;
+
+    void setLowpass(float sampleRate, float frequency, float q = 0.7071f) {
+        design(sampleRate, frequency, q, false);
+    }
+
+    void setHighpass(float sampleRate, float frequency, float q = 0.7071f) {
+        design(sampleRate, frequency, q, true);
+    }
+
+    void setBandpass(float sampleRate, float frequency, float q) {
+        float w0 = 2.0f * static_cast<float>(M_PI) * frequency / sampleRate;
+        float alpha = std::sin(w0) / (2.0f * q);
+        float a0 = 1.0f + alpha;
+        b0 = alpha / a0;
+        b1 = 0.0f;
+        b2 = -alpha / a0;
+        a1 = -2.0f * std::cos(w0) / a0;
+        a2 = (1.0f - alpha) / a0;
+    }
+
+    void reset() {
+        z1 = 0.0f;
+        z2 = 0.0f;
+    }
+
+    float process(float x) {
+        float y = b0 * x + z1;
+        z1 = b1 * x - a1 * y + z2;
+        z2 = b2 * x - a2 * y;
+        return y;
+    }
+
+private:
+    void design(float sampleRate, float frequency, float q, bool highpass) {
+        float w0 = 2.0f * static_cast<float>(M_PI) * frequency / sampleRate;
+        float cosW0 = std::cos(w0);
+        float alpha = std::sin(w0) / (2.0f * q);
+        float a0 = 1.0f + alpha;
+        float gain = highpass ? (1.0f + cosW0) * 0.5f : (1.0f - cosW0) * 0.5f;
+        b0 = gain / a0;
+        b1 = (highpass ? -2.0f * gain : 2.0f * gain) / a0;
+        b2 = gain / a0;
+        a1 = -2.0f * cosW0 / a0;
+        a2 = (1.0f - alpha) / a0;
+    }
+};
+
+} // namespace voicechanger::dsp
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace voicechanger::dsp {
+
+/**
+ * Fft - In-place radix-2 complex FFT with precomputed twiddles.
+ *
+ * Small, allocation-free (after setSize) transform used by the analysis
+ * stages. Sizes must be powers of two. The inverse transform is unscaled.
+ */
+class Fft {
+public:
+    using Complex = std::complex<float>;
+
+    /**
+     * @brief Prepares twiddle and bit-reversal tables. Allocates; call off the audio thread.
+     */
+    void setSize(size_t size) {
+        size_ = size;
+        twiddles_.resize(size / 2);
+        for (size_t i = 0; i < size / 2; ++i) {
+            double phase = -2.0 * M_PI * static_cast<double>(i) / static_cast<double>(size);
+            twiddles_[i] = Complex(static_cast<float>(std::cos(phase)), static_cast<float>(std::sin(phase)));
+        }
+
+        bitReverse_.resize(size);
+        size_t bits = 0;
+        while ((size_t{1} << bits) < size) {
+            ++bits;
+        }
+        for (size_t i = 0; i < size; ++i) {
+            size_t reversed = 0;
+            for (size_t b = 0; b < bits; ++b) {
+                reversed |= ((i >> b) & 1) << (bits - 1 - b);
+            }
+            bitReverse_[i] = reversed;
+        }
+    }
+
+    size_t size() const { return size_; }
+
+    void forward(Complex* data) const { transform(data, false); }
+    void inverse(Complex* data) const { transform(data, true); }
+
+    /**
+     * @brief Smallest power of two greater than or equal to n.
+     */
+    static size_t nextPowerOfTwo(size_t n) {
+        size_t size = 1;
+        while (size < n) {
+            size <<= 1;
+        }
+        return size;
+    }
+
+private:
+    void transform(Complex* data, bool inverse) const {
+        for (size_t i = 0; i < size_; ++i) {
+            size_t j = bitReverse_[i];
+            if (j > i) {
+                std::swap(data[i], data[j]);
+            }
+        }
+
+        const float sign = inverse ? -1.0f : 1.0f;
+        for (size_t half = 1, stride = size_ / 2; half < size_; half <<= 1, stride >>= 1) {
+            for (size_t start = 0; start < size_; start += half * 2) {
+                Complex* lower = data + start;
+                Complex* upper = lower + half;
+                for (size_t k = 0; k < half; ++k) {
+                    const float wr = twiddles_[k * stride].real();
+                    const float wi = twiddles_[k * stride].imag() * sign;
+                    // Written out to avoid the NaN-checking complex multiply
+                    const float br = upper[k].real() * wr - upper[k].imag() * wi;
+                    const float bi = upper[k].real() * wi + upper[k].imag() * wr;
+                    const float ar = lower[k].real();
+                    const float ai = lower[k].imag();
+                    lower[k] = Complex(ar + br, ai + bi);
+                    upper[k] = Complex(ar - br, ai - bi);
+                }
+            }
+        }
+    }
+
+    size_t size_ = 0;
+    std::vector<Complex> twiddles_;
+    std::vector<size_t> bitReverse_;
+};
+
+} // namespace voicechanger::dsp
@@ -0,0 +1,166 @@
+#pragma once
+
+#include "dsp/Kaiser.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace voicechanger::dsp {
+
+/**
+ * Half-band FIR 2x resampling stages (polyphase).
+ *
+ * A half-band lowpass of length N = 4K + 3 has a centre tap of 0.5 and
+ * zeros at every other offset from it, so each polyphase branch is either
+ * a pure delay or a short symmetric FIR over the "even" taps. Only that
+ * branch is computed. The inner loops run tap-outer/sample-inner over
+ * contiguous history so they auto-vectorise without reassociation.
+ *
+ * Buffers are sized in prepare(); process() never allocates, and takes at
+ * most the prepared number of input samples per call.
+ */
+
+/**
+ * @brief Designs a Kaiser-windowed half-band lowpass and returns its even-phase taps
+ *        (N + 1) / 2 values, normalised to sum to 0.5. numTaps must be 4K + 3.
+ */
+inline std::vector<float> designHalfBand(size_t numTaps, double kaiserBeta) {
+    double centre = static_cast<double>(numTaps - 1) / 2.0;
+    std::vector<float> taps((numTaps + 1) / 2);
+    double sum = 0.0;
+    for (size_t j = 0; j < taps.size(); ++j) {
+        double offset = static_cast<double>(2 * j) - centre;  // Odd, so sinc is non-zero
+        double x = offset / 2.0;
+        double sinc = std::sin(M_PI * x) / (M_PI * x);
+        double ratio = offset / centre;
+        double window = kaiserWindow(ratio, kaiserBeta);
+        taps[j] = static_cast<float>(0.5 * sinc * window);
+        sum += taps[j];
+    }
+    for (auto& tap : taps) {
+        tap = static_cast<float>(tap * 0.5 / sum);
+    }
+    return taps;
+}
+
+/**
+ * HalfBandUpsampler - 2x interpolation: n input samples in, 2n out.
+ */
+class HalfBandUpsampler {
+public:
+    void prepare(const std::vector<float>& evenTaps, size_t maxInput) {
+        taps_ = evenTaps;
+        delay_ = taps_.size() / 2 - 1;
+        history_ = taps_.size() - 1;
+        buffer_.assign(history_ + maxInput, 0.0f);
+        accumulator_.assign(maxInput, 0.0f);
+    }
+
+    void reset() { std::fill(buffer_.begin(), buffer_.end(), 0.0f); }
+
+    // Group delay in output (2x-rate) samples
+    size_t getLatency() const { return 2 * delay_ + 1; }
+
+    void process(const float* in, float* out, size_t n) {
+        if (n == 0) {
+            return;
+        }
+        float* x = buffer_.data() + history_;
+        float* acc = accumulator_.data();
+        std::copy(in, in + n, x);
+        std::fill(acc, acc + n, 0.0f);
+
+        for (size_t j = 0; j < taps_.size(); ++j) {
+            const float tap = 2.0f * taps_[j];
+            const float* src = x - j;
+            for (size_t m = 0; m < n; ++m) {
+                acc[m] += tap * src[m];
+            }
+        }
+
+        for (size_t m = 0; m < n; ++m) {
+            out[2 * m] = acc[m];
+            out[2 * m + 1] = x[m - delay_];  // Centre tap: pure delay
+        }
+
+        std::copy(buffer_.begin() + static_cast<std::ptrdiff_t>(n),
+                  buffer_.begin() + static_cast<std::ptrdiff_t>(n + history_), buffer_.begin());
+    }
+
+private:
+    std::vector<float> taps_;
+    std::vector<float> buffer_;
+    std::vector<float> accumulator_;
+    size_t delay_ = 0;
+    size_t history_ = 0;
+};
+
+/**
+ * HalfBandDownsampler - 2x decimation: 2n input samples in, n out.
+ */
+class HalfBandDownsampler {
+public:
+    void prepare(const std::vector<float>& evenTaps, size_t maxOutput) {
+        taps_ = evenTaps;
+        delay_ = taps_.size() / 2;
+        evenHistory_ = taps_.size() - 1;
+        evenBuffer_.assign(evenHistory_ + maxOutput, 0.0f);
+        oddBuffer_.assign(delay_ + maxOutput, 0.0f);
+        accumulator_.assign(maxOutput, 0.0f);
+    }
+
+    void reset() {
+        std::fill(evenBuffer_.begin(), evenBuffer_.end(), 0.0f);
+        std::fill(oddBuffer_.begin(), oddBuffer_.end(), 0.0f);
+    }
+
+    // Group delay in input (2x-rate) samples
+    size_t getLatency() const { return 2 * delay_ - 1; }
+
+    void process(const float* in, float* out, size_t n) {
+        if (n == 0) {
+            return;
+        }
+        float* even = evenBuffer_.data() + evenHistory_;
+        float* odd = oddBuffer_.data() + delay_;
+        float* acc = accumulator_.data();
+        for (size_t m = 0; m < n; ++m) {
+            even[m] = in[2 * m];
+            odd[m] = in[2 * m + 1];
+        }
+        std::fill(acc, acc + n, 0.0f);
+
+        for (size_t j = 0; j < taps_.size(); ++j) {
+            const float tap = taps_[j];
+            const float* src = even - j;
+            for (size_t m = 0; m < n; ++m) {
+                acc[m] += tap * src[m];
+            }
+        }
+
+        for (size_t m = 0; m < n; ++m) {
+            out[m] = acc[m] + 0.5f * odd[m - delay_];  // Centre tap
+        }
+
+        std::copy(evenBuffer_.begin() + static_cast<std::ptrdiff_t>(n),
+                  evenBuffer_.begin() + static_cast<std::ptrdiff_t>(n + evenHistory_), evenBuffer_.begin());
+        std::copy(oddBuffer_.begin() + static_cast<std::ptrdiff_t>(n),
+                  oddBuffer_.begin() + static_cast<std::ptrdiff_t>(n + delay_), oddBuffer_.begin());
+    }
+
+private:
+    std::vector<float> taps_;
+    std::vector<float> evenBuffer_;
+    std::vector<float> oddBuffer_;
+    std::vector<float> accumulator_;
+    size_t delay_ = 0;
+    size_t evenHistory_ = 0;
+};
+
+} // namespace voicechanger::dsp
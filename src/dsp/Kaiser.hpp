@@ -0,0 +1,29 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+namespace voicechanger::dsp {
+
+/**
+ * @brief Zeroth-order modified Bessel function of the first kind (power series).
+ */
+inline double besselI0(double x) {
+    double sum = 1.0;
+    double term = 1.0;
+    for (int k = 1; k < 32; ++k) {
+        term *= (x / (2.0 * k)) * (x / (2.0 * k));
+        sum += term;
+    }
+    return sum;
+}
+
+/**
+ * @brief Kaiser window value at a position in [-1, 1] (0 = centre).
+ * @details beta = 8 gives roughly 80 dB of stopband attenuation.
+ */
+inline double kaiserWindow(double position, double beta) {
+    return besselI0(beta * std::sqrt(std::max(0.0, 1.0 - position * position))) / besselI0(beta);
+}
+
+} // namespace voicechanger::dsp
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+
+namespace voicechanger::dsp {
+
+constexpr size_t kMaxLpcOrder = 32;
+
+/**
+ * Levinson-Durbin recursion for linear prediction.
+ *
+ * Solves the autocorrelation normal equations for the prediction-error
+ * filter A(z) = 1 + a1 z^-1 + ... + ap z^-p and returns its reflection
+ * coefficients, which drive a lattice filter directly and keep it stable
+ * while they are interpolated (every |k| < 1).
+ *
+ * @param autocorrelation r[0..order], r[0] > 0 for a non-silent frame.
+ * @param order Prediction order, at most kMaxLpcOrder.
+ * @param reflection Receives k[0..order-1].
+ * @return The prediction-error power (r[0] times the product of 1 - k^2),
+ *         or 0 for a silent or degenerate frame, whose coefficients are 0.
+ */
+inline double levinsonDurbin(const double* autocorrelation, size_t order, float* reflection) {
+    double a[kMaxLpcOrder + 1] = {1.0};
+    double previous[kMaxLpcOrder + 1];
+    double error = autocorrelation[0];
+
+    for (size_t i = 0; i < order; ++i) {
+        reflection[i] = 0.0f;
+    }
+    if (!(error > 1.0e-12)) {
+        return 0.0;
+    }
+
+    for (size_t i = 1; i <= order; ++i) {
+        double acc = autocorrelation[i];
+        for (size_t j = 1; j < i; ++j) {
+            acc += a[j] * autocorrelation[i - j];
+        }
+        double k = -acc / error;
+        if (!(k > -1.0 && k < 1.0)) {
+            // Numerically unstable from here on; keep the stable prefix
+            break;
+        }
+
+        for (size_t j = 0; j < i; ++j) {
+            previous[j] = a[j];
+        }
+        for (size_t j = 1; j < i; ++j) {
+            a[j] = previous[j] + k * previous[i - j];
+        }
+        a[i] = k;
+        reflection[i - 1] = static_cast<float>(k);
+        error *= 1.0 - k * k;
+    }
+    return error;
+}
+
+} // namespace voicechanger::dsp
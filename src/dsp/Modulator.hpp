@@ -0,0 +1,106 @@
+#pragma once
+
+#include "dsp/Random.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace voicechanger::dsp {
+
+enum class ModulatorType : uint8_t {
+    kSine,        // Bipolar sine LFO
+    kTriangle,    // Bipolar triangle LFO
+    kEnvelope,    // Unipolar envelope of the input's peak level
+    kRandomWalk,  // Bipolar mean-reverting random walk
+};
+
+/**
+ * Modulator - One control-rate modulation source.
+ *
+ * step() is called once per control period and returns the next value:
+ * -1 to 1 for the LFOs and the random walk, 0 to 1 for the envelope. All
+ * coefficients are computed in prepare(), so step() is a few multiplies
+ * (one sin for the sine LFO) and never allocates.
+ *
+ * The random walk is an Ornstein-Uhlenbeck process: each step pulls the
+ * value back towards 0 at the given rate and adds uniform noise scaled so
+ * the value wanders with a spread of about 0.5 regardless of rate.
+ */
+class Modulator {
+public:
+    /**
+     * @param rateHz LFO frequency, or how fast the random walk moves
+     * @param attackMs, releaseMs Envelope time constants
+     * @param controlRate Steps per second
+     */
+    void prepare(ModulatorType type, float rateHz, float attackMs, float releaseMs, float controlRate,
+                 uint32_t seed) {
+        type_ = type;
+        phaseStep_ = rateHz / controlRate;
+        attack_ = 1.0f - std::exp(-1000.0f / (std::max(attackMs, 0.1f) * controlRate));
+        release_ = 1.0f - std::exp(-1000.0f / (std::max(releaseMs, 0.1f) * controlRate));
+        pull_ = std::min(2.0f * static_cast<float>(M_PI) * rateHz / controlRate, 1.0f);
+        // Uniform noise has variance 1/3; this gives the walk a stationary spread of 0.5
+        spread_ = 0.5f * std::sqrt(3.0f * pull_ * (2.0f - pull_));
+        random_.setSeed(seed);
+        reset();
+    }
+
+    void reset() {
+        phase_ = 0.0;
+        value_ = 0.0f;
+    }
+
+    /**
+     * @param level Peak input level over the period (read by the envelope only)
+     */
+    float step(float level) {
+        switch (type_) {
+            case ModulatorType::kSine:
+                value_ = static_cast<float>(std::sin(2.0 * M_PI * phase_));
+                advancePhase();
+                break;
+            case ModulatorType::kTriangle:
+                // Starts at 0 rising, like the sine
+                value_ = static_cast<float>(phase_ < 0.25   ? 4.0 * phase_
+                                            : phase_ < 0.75 ? 2.0 - 4.0 * phase_
+                                                            : 4.0 * phase_ - 4.0);
+                advancePhase();
+                break;
+            case ModulatorType::kEnvelope: {
+                float target = std::min(level, 1.0f);
+                value_ += (target - value_) * (target > value_ ? attack_ : release_);
+                break;
+            }
+            case ModulatorType::kRandomWalk:
+                value_ = std::clamp(value_ * (1.0f - pull_) + spread_ * random_.nextBipolar(), -1.0f, 1.0f);
+                break;
+        }
+        return value_;
+    }
+
+    float getValue() const { return value_; }
+
+private:
+    void advancePhase() {
+        phase_ += phaseStep_;
+        phase_ -= std::floor(phase_);
+    }
+
+    ModulatorType type_ = ModulatorType::kSine;
+    double phase_ = 0.0;  // Cycles, 0 to 1
+    double phaseStep_ = 0.0;
+    float attack_ = 1.0f;
+    float release_ = 1.0f;
+    float pull_ = 0.0f;
+    float spread_ = 0.0f;
+    float value_ = 0.0f;
+    XorShift32 random_;
+};
+
+} // namespace voicechanger::dsp
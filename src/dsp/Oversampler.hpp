@@ -0,0 +1,110 @@
+#pragma once
+
+#include "dsp/HalfBand.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace voicechanger::dsp {
+
+/**
+ * Oversampler - Runs a per-sample nonlinearity at 1x, 2x or 4x the input rate.
+ *
+ * 2x uses one half-band stage up and down; 4x cascades a second, shorter
+ * stage (its transition band can be much wider). prepare() allocates for 4x
+ * so the factor can be switched on the audio thread; switching clears the
+ * filter history.
+ */
+class Oversampler {
+public:
+    static constexpr size_t kMaxBlock = 256;
+
+    /**
+     * @brief Designs the filters and allocates buffers. Call off the audio thread.
+     */
+    void prepare() {
+        auto stage1 = designHalfBand(47, 8.0);  // Passband to ~0.39 fs, ~80 dB stopband
+        auto stage2 = designHalfBand(23, 8.0);  // Only has to protect the 2x band
+        up1_.prepare(stage1, kMaxBlock);
+        down1_.prepare(stage1, kMaxBlock);
+        up2_.prepare(stage2, 2 * kMaxBlock);
+        down2_.prepare(stage2, 2 * kMaxBlock);
+        buffer2x_.assign(2 * kMaxBlock, 0.0f);
+        buffer4x_.assign(4 * kMaxBlock, 0.0f);
+    }
+
+    void setFactor(int factor) {
+        factor_ = factor >= 4 ? 4 : (factor >= 2 ? 2 : 1);
+        reset();
+    }
+
+    int getFactor() const { return factor_; }
+
+    void reset() {
+        up1_.reset();
+        down1_.reset();
+        up2_.reset();
+        down2_.reset();
+    }
+
+    /**
+     * @brief Round-trip filter delay in input-rate samples.
+     */
+    float getLatency() const {
+        float latency = 0.0f;
+        if (factor_ >= 2) {
+            latency += 0.5f * static_cast<float>(up1_.getLatency() + down1_.getLatency());
+        }
+        if (factor_ >= 4) {
+            latency += 0.25f * static_cast<float>(up2_.getLatency() + down2_.getLatency());
+        }
+        return latency;
+    }
+
+    /**
+     * @brief Applies shaper(x) to every oversampled sample. in and out may alias.
+     */
+    template <typename Shaper>
+    void process(const float* in, float* out, size_t numSamples, Shaper&& shaper) {
+        for (size_t offset = 0; offset < numSamples; offset += kMaxBlock) {
+            size_t n = std::min(kMaxBlock, numSamples - offset);
+
+            if (factor_ == 1) {
+                for (size_t i = 0; i < n; ++i) {
+                    out[offset + i] = shaper(in[offset + i]);
+                }
+                continue;
+            }
+
+            float* x2 = buffer2x_.data();
+            up1_.process(in + offset, x2, n);
+
+            if (factor_ == 4) {
+                float* x4 = buffer4x_.data();
+                up2_.process(x2, x4, 2 * n);
+                for (size_t i = 0; i < 4 * n; ++i) {
+                    x4[i] = shaper(x4[i]);
+                }
+                down2_.process(x4, x2, 2 * n);
+            } else {
+                for (size_t i = 0; i < 2 * n; ++i) {
+                    x2[i] = shaper(x2[i]);
+                }
+            }
+
+            down1_.process(x2, out + offset, n);
+        }
+    }
+
+private:
+    HalfBandUpsampler up1_;
+    HalfBandDownsampler down1_;
+    HalfBandUpsampler up2_;
+    HalfBandDownsampler down2_;
+    std::vector<float> buffer2x_;
+    std::vector<float> buffer4x_;
+    int factor_ = 1;
+};
+
+} // namespace voicechanger::dsp
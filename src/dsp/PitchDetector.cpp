@@ -0,0 +1,188 @@
+#include "dsp/PitchDetector.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace voicechanger::dsp {
+
+namespace {
+// Mean-square level below which a frame is treated as silence (~-70 dBFS)
+constexpr double kSilenceEnergy = 1.0e-7;
+constexpr float kHopSeconds = 0.01f;
+} // namespace
+
+void PitchDetector::prepare(float sampleRate) {
+    decimation_ = std::max<size_t>(1, static_cast<size_t>(std::lround(sampleRate / kAnalysisRate)));
+    analysisRate_ = sampleRate / static_cast<float>(decimation_);
+
+    // Two cascaded Butterworth sections keep harmonics above the analysis
+    // Nyquist from folding back onto the fundamental's lag.
+    for (auto& filter : antiAlias_) {
+        filter.setLowpass(sampleRate, analysisRate_ * 0.4f);
+    }
+
+    maxLag_ = static_cast<size_t>(std::ceil(analysisRate_ / kLowestFrequency)) + 1;
+    window_ = maxLag_;
+    frameSize_ = window_ + maxLag_;
+    hopSize_ = std::max<size_t>(1, static_cast<size_t>(std::lround(analysisRate_ * kHopSeconds)));
+
+    // Linear cross-correlation for lags [0, maxLag_] needs size >= window_ + maxLag_
+    fft_.setSize(Fft::nextPowerOfTwo(frameSize_));
+
+    ring_.assign(frameSize_, 0.0f);
+    frame_.assign(frameSize_, 0.0f);
+    energyPrefix_.assign(frameSize_ + 1, 0.0);
+    difference_.assign(maxLag_ + 2, 0.0f);
+    packed_.assign(fft_.size(), Fft::Complex());
+    cross_.assign(fft_.size(), Fft::Complex());
+
+    reset();
+}
+
+void PitchDetector::reset() {
+    std::fill(ring_.begin(), ring_.end(), 0.0f);
+    for (auto& filter : antiAlias_) {
+        filter.reset();
+    }
+    ringPos_ = 0;
+    decimationPhase_ = 0;
+    samplesSinceHop_ = 0;
+    estimate_ = PitchEstimate{};
+}
+
+void PitchDetector::setFrequencyRange(float minFrequency, float maxFrequency) {
+    minFrequency_ = std::max(minFrequency, kLowestFrequency);
+    maxFrequency_ = std::max(maxFrequency, minFrequency_ * 2.0f);
+}
+
+void PitchDetector::setThreshold(float threshold) {
+    threshold_ = threshold;
+}
+
+bool PitchDetector::process(const float* const* channels, size_t numChannels, size_t numFrames) {
+    if (ring_.empty() || numChannels == 0) {
+        return false;
+    }
+
+    const float channelScale = 1.0f / static_cast<float>(numChannels);
+    bool produced = false;
+
+    for (size_t i = 0; i < numFrames; ++i) {
+        float mono = 0.0f;
+        for (size_t ch = 0; ch < numChannels; ++ch) {
+            mono += channels[ch][i];
+        }
+        mono = antiAlias_[1].process(antiAlias_[0].process(mono * channelScale));
+
+        if (++decimationPhase_ < decimation_) {
+            continue;
+        }
+        decimationPhase_ = 0;
+
+        ring_[ringPos_] = mono;
+        ringPos_ = (ringPos_ + 1 == frameSize_) ? 0 : ringPos_ + 1;
+
+        if (++samplesSinceHop_ >= hopSize_) {
+            samplesSinceHop_ = 0;
+            analyse();
+            produced = true;
+        }
+    }
+
+    return produced;
+}
+
+void PitchDetector::analyse() {
+    // Linearise the ring, oldest sample first
+    const size_t tail = frameSize_ - ringPos_;
+    std::copy(ring_.begin() + static_cast<std::ptrdiff_t>(ringPos_), ring_.end(), frame_.begin());
+    std::copy(ring_.begin(), ring_.begin() + static_cast<std::ptrdiff_t>(ringPos_),
+              frame_.begin() + static_cast<std::ptrdiff_t>(tail));
+
+    energyPrefix_[0] = 0.0;
+    for (size_t i = 0; i < frameSize_; ++i) {
+        energyPrefix_[i + 1] = energyPrefix_[i] + static_cast<double>(frame_[i]) * frame_[i];
+    }
+
+    const double windowEnergy = energyPrefix_[window_];
+    if (windowEnergy / static_cast<double>(window_) < kSilenceEnergy) {
+        estimate_ = PitchEstimate{};
+        return;
+    }
+
+    // Pack the windowed head (real) and the full frame (imaginary) into one transform
+    const size_t fftSize = fft_.size();
+    for (size_t i = 0; i < fftSize; ++i) {
+        float head = i < window_ ? frame_[i] : 0.0f;
+        float full = i < frameSize_ ? frame_[i] : 0.0f;
+        packed_[i] = Fft::Complex(head, full);
+    }
+    fft_.forward(packed_.data());
+
+    // Unpack A (head) and B (frame) spectra and form conj(A) * B
+    for (size_t k = 0; k < fftSize; ++k) {
+        Fft::Complex zk = packed_[k];
+        Fft::Complex zn = std::conj(packed_[(fftSize - k) & (fftSize - 1)]);
+        Fft::Complex a = (zk + zn) * 0.5f;
+        Fft::Complex diff = (zk - zn) * 0.5f;
+        Fft::Complex b(diff.imag(), -diff.real());  // diff / j
+        cross_[k] = Fft::Complex(a.real() * b.real() + a.imag() * b.imag(),
+                                 a.real() * b.imag() - a.imag() * b.real());
+    }
+    fft_.inverse(cross_.data());
+
+    const float inverseSize = 1.0f / static_cast<float>(fftSize);
+    const size_t minLag = std::max<size_t>(2, static_cast<size_t>(analysisRate_ / maxFrequency_));
+    const size_t maxLag = std::min(maxLag_, static_cast<size_t>(std::ceil(analysisRate_ / minFrequency_)));
+
+    // Cumulative mean normalised difference, d'(0) = 1
+    difference_[0] = 1.0f;
+    double runningSum = 0.0;
+    for (size_t lag = 1; lag <= maxLag; ++lag) {
+        double lagEnergy = energyPrefix_[lag + window_] - energyPrefix_[lag];
+        double correlation = static_cast<double>(cross_[lag].real() * inverseSize);
+        double d = std::max(0.0, windowEnergy + lagEnergy - 2.0 * correlation);
+        runningSum += d;
+        difference_[lag] = runningSum > 0.0 ? static_cast<float>(d * static_cast<double>(lag) / runningSum) : 1.0f;
+    }
+
+    // Absolute threshold: first dip below threshold, then walk down to its minimum
+    size_t bestLag = 0;
+    for (size_t lag = minLag; lag <= maxLag; ++lag) {
+        if (difference_[lag] < threshold_) {
+            while (lag + 1 <= maxLag && difference_[lag + 1] < difference_[lag]) {
+                ++lag;
+            }
+            bestLag = lag;
+            break;
+        }
+    }
+
+    if (bestLag == 0) {
+        float minimum = 1.0f;
+        for (size_t lag = minLag; lag <= maxLag; ++lag) {
+            minimum = std::min(minimum, difference_[lag]);
+        }
+        estimate_ = PitchEstimate{0.0f, std::clamp(1.0f - minimum, 0.0f, 1.0f)};
+        return;
+    }
+
+    // Parabolic refinement around the chosen minimum
+    float refinedLag = static_cast<float>(bestLag);
+    if (bestLag > 1 && bestLag < maxLag) {
+        float left = difference_[bestLag - 1];
+        float centre = difference_[bestLag];
+        float right = difference_[bestLag + 1];
+        float denominator = left - 2.0f * centre + right;
+        if (denominator > 1.0e-9f) {
+            refinedLag += 0.5f * (left - right) / denominator;
+        }
+    }
+
+    estimate_ = PitchEstimate{
+        analysisRate_ / refinedLag,
+        std::clamp(1.0f - difference_[bestLag], 0.0f, 1.0f)
+    };
+}
+
+} // namespace voicechanger::dsp
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "dsp/Biquad.hpp"
+#include "dsp/Fft.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace voicechanger::dsp {
+
+/**
+ * A single fundamental-frequency estimate.
+ * frequency is 0 when the frame was judged unvoiced.
+ */
+struct PitchEstimate {
+    float frequency = 0.0f;   // Hz
+    float confidence = 0.0f;  // 0.0 to 1.0
+};
+
+/**
+ * PitchDetector - YIN fundamental-frequency estimator.
+ *
+ * The input is mixed to mono, low-passed and decimated to roughly 11 kHz
+ * before analysis. Every ~10 ms hop the YIN difference function is computed
+ * from an FFT cross-correlation (both operands packed into one complex
+ * transform), followed by the cumulative mean normalised difference,
+ * absolute-threshold picking and parabolic refinement.
+ *
+ * prepare() allocates; everything else is real-time safe.
+ */
+class PitchDetector {
+public:
+    /// Lowest frequency the analysis buffers are sized for.
+    static constexpr float kLowestFrequency = 50.0f;
+    /// Target rate of the decimated analysis signal.
+    static constexpr float kAnalysisRate = 11025.0f;
+
+    void prepare(float sampleRate);
+    void reset();
+
+    void setFrequencyRange(float minFrequency, float maxFrequency);
+    void setThreshold(float threshold);
+
+    /**
+     * @brief Feeds a block of (planar) input.
+     * @return true if at least one new estimate was produced.
+     */
+    bool process(const float* const* channels, size_t numChannels, size_t numFrames);
+
+    PitchEstimate getEstimate() const { return estimate_; }
+
+    /// Distance between estimates, in input samples.
+    size_t getHopSize() const { return hopSize_ * decimation_; }
+    /// Delay from the newest input sample to the centre of the analysis window, in input samples.
+    size_t getLatency() const { return (frameSize_ / 2) * decimation_; }
+
+private:
+    void analyse();
+
+    Fft fft_;
+    Biquad antiAlias_[2];
+
+    size_t decimation_ = 1;
+    float analysisRate_ = kAnalysisRate;
+    size_t window_ = 0;     // YIN integration window
+    size_t maxLag_ = 0;     // Largest lag the buffers are sized for
+    size_t frameSize_ = 0;  // window_ + maxLag_
+    size_t hopSize_ = 0;    // In analysis samples
+
+    std::vector<float> ring_;
+    std::vector<float> frame_;
+    std::vector<double> energyPrefix_;
+    std::vector<float> difference_;
+    std::vector<Fft::Complex> packed_;
+    std::vector<Fft::Complex> cross_;
+
+    size_t ringPos_ = 0;
+    size_t decimationPhase_ = 0;
+    size_t samplesSinceHop_ = 0;
+
+    float minFrequency_ = 60.0f;
+    float maxFrequency_ = 1000.0f;
+    float threshold_ = 0.15f;
+
+    PitchEstimate estimate_;
+};
+
+} // namespace voicechanger::dsp
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace voicechanger::dsp {
+
+/**
+ * XorShift32 - Small deterministic PRNG for audio-thread randomness.
+ *
+ * Same seed, same sequence on every platform, so offline renders are
+ * reproducible. Not suitable for anything security related.
+ */
+class XorShift32 {
+public:
+    explicit XorShift32(uint32_t seed = 1) { setSeed(seed); }
+
+    // Zero is a fixed point of xorshift, so it is remapped
+    void setSeed(uint32_t seed) { state_ = seed != 0 ? seed : 0x9E3779B9u; }
+
+    uint32_t next() {
+        state_ ^= state_ << 13;
+        state_ ^= state_ >> 17;
+        state_ ^= state_ << 5;
+        return state_;
+    }
+
+    // Uniform in [0, 1)
+    float nextFloat() { return static_cast<float>(next() >> 8) * (1.0f / 16777216.0f); }
+
+    // Uniform in [-1, 1)
+    float nextBipolar() { return 2.0f * nextFloat() - 1.0f; }
+
+    // Uniform integer in [0, n)
+    uint32_t nextBelow(uint32_t n) { return static_cast<uint32_t>((static_cast<uint64_t>(next()) * n) >> 32); }
+
+private:
+    uint32_t state_ = 1;
+};
+
+/**
+ * NoiseGenerator - Block white noise from eight interleaved xorshift32 lanes.
+ *
+ * The lanes are independent and have no carried dependency between them,
+ * so fill() compiles to straight SIMD shifts and xors. Floats are made by
+ * writing 23 random bits into the mantissa of a number in [2, 4), which
+ * avoids an integer-to-float conversion. Output is uniform in [-1, 1),
+ * variance 1/3.
+ */
+class NoiseGenerator {
+public:
+    static constexpr size_t kLanes = 8;
+
+    explicit NoiseGenerator(uint32_t seed = 1) { setSeed(seed); }
+
+    void setSeed(uint32_t seed) {
+        // Hash the seed per lane; consecutive outputs of one xorshift would
+        // just be the same sequence shifted by a step
+        for (size_t lane = 0; lane < kLanes; ++lane) {
+            uint32_t z = seed + 0x9E3779B9u * static_cast<uint32_t>(lane + 1);
+            z = (z ^ (z >> 16)) * 0x85EBCA6Bu;
+            z = (z ^ (z >> 13)) * 0xC2B2AE35u;
+            z ^= z >> 16;
+            state_[lane] = z != 0 ? z : 0x9E3779B9u;
+        }
+    }
+
+    void fill(float* out, size_t numSamples) {
+        size_t i = 0;
+        for (; i + kLanes <= numSamples; i += kLanes) {
+            for (size_t lane = 0; lane < kLanes; ++lane) {
+                out[i + lane] = step(lane);
+            }
+        }
+        for (size_t lane = 0; lane < kLanes && i + lane < numSamples; ++lane) {
+            out[i + lane] = step(lane);
+        }
+    }
+
+private:
+    float step(size_t lane) {
+        uint32_t x = state_[lane];
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        state_[lane] = x;
+        uint32_t bits = (x >> 9) | 0x40000000u;
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value - 3.0f;
+    }
+
+    std::array<uint32_t, kLanes> state_{};
+};
+
+} // namespace voicechanger::dsp
@@ -0,0 +1,147 @@
+#pragma once
+
+#include "dsp/Kaiser.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace voicechanger::dsp {
+
+/**
+ * PolyphaseResampler - Streaming rational (L/M) sample-rate converter.
+ *
+ * The rate ratio is reduced to up/down integers L/M; a Kaiser-windowed sinc
+ * is designed at L times the input rate and split into L branches, so each
+ * output costs one short dot product over the input history. The passband
+ * runs to passbandFraction of the lower Nyquist and the stopband starts at
+ * that Nyquist. Branches are stored time-reversed and zero-padded to a
+ * multiple of kLanes, and the dot product keeps kLanes partial sums, so it
+ * auto-vectorises without reassociation.
+ *
+ * The number of outputs per call varies by at most one around n * L / M;
+ * the fractional position carries across calls. Buffers are sized in
+ * prepare(); process() never allocates and takes at most the prepared
+ * number of input samples per call.
+ */
+class PolyphaseResampler {
+public:
+    // Upper bound on L after reduction, which bounds the coefficient table
+    static constexpr size_t kMaxPhases = 1024;
+    static constexpr size_t kLanes = 8;
+
+    /**
+     * @brief Designs the filter bank and allocates buffers. Call off the audio thread.
+     * @return false if the reduced ratio needs more than kMaxPhases branches.
+     */
+    bool prepare(size_t inputRate, size_t outputRate, size_t maxInput,
+                 double passbandFraction = 0.8, double kaiserBeta = 8.0) {
+        size_t divisor = std::gcd(inputRate, outputRate);
+        if (divisor == 0 || outputRate / divisor > kMaxPhases) {
+            return false;
+        }
+        up_ = outputRate / divisor;
+        down_ = inputRate / divisor;
+
+        // Kaiser length estimate for ~80 dB over the transition band, in input samples
+        double nyquist = 0.5 * static_cast<double>(std::min(inputRate, outputRate));
+        double transition = (1.0 - passbandFraction) * nyquist / static_cast<double>(inputRate);
+        double length = 72.0 / (2.285 * 2.0 * M_PI * transition);
+        size_t filterLength = static_cast<size_t>(std::ceil(length));
+        tapsPerPhase_ = (filterLength + kLanes - 1) / kLanes * kLanes;
+
+        // Prototype lowpass at up_ * inputRate, cutoff mid-transition
+        size_t numTaps = filterLength * up_;
+        double cutoff = 0.5 * (1.0 + passbandFraction) * nyquist / (static_cast<double>(inputRate) * static_cast<double>(up_));
+        double centre = static_cast<double>(numTaps - 1) / 2.0;
+        std::vector<double> prototype(numTaps);
+        double sum = 0.0;
+        for (size_t k = 0; k < numTaps; ++k) {
+            double offset = static_cast<double>(k) - centre;
+            double x = 2.0 * cutoff * offset;
+            double sinc = x == 0.0 ? 1.0 : std::sin(M_PI * x) / (M_PI * x);
+            prototype[k] = sinc * kaiserWindow(offset / (centre + 1.0), kaiserBeta);
+            sum += prototype[k];
+        }
+
+        // Each branch sums to ~1 after scaling by L
+        bank_.assign(tapsPerPhase_ * up_, 0.0f);
+        double scale = static_cast<double>(up_) / sum;
+        for (size_t phase = 0; phase < up_; ++phase) {
+            float* branch = bank_.data() + phase * tapsPerPhase_;
+            for (size_t j = 0; j < filterLength; ++j) {
+                branch[tapsPerPhase_ - 1 - j] = static_cast<float>(prototype[phase + j * up_] * scale);
+            }
+        }
+
+        latency_ = centre / static_cast<double>(up_);
+        history_ = tapsPerPhase_ - 1;
+        buffer_.assign(history_ + maxInput, 0.0f);
+        reset();
+        return true;
+    }
+
+    void reset() {
+        std::fill(buffer_.begin(), buffer_.end(), 0.0f);
+        position_ = 0;
+    }
+
+    // Most outputs a call with numInput samples can produce
+    size_t getMaxOutput(size_t numInput) const {
+        return (numInput * up_ + down_ - 1) / down_ + 1;
+    }
+
+    // Group delay in input samples
+    double getLatency() const { return latency_; }
+
+    /**
+     * @brief Converts n input samples; returns the number of samples written to out.
+     */
+    size_t process(const float* in, size_t n, float* out) {
+        float* x = buffer_.data() + history_;
+        std::copy(in, in + n, x);
+
+        size_t numOutput = 0;
+        size_t end = n * up_;
+        while (position_ < end) {
+            size_t index = position_ / up_;
+            const float* branch = bank_.data() + (position_ % up_) * tapsPerPhase_;
+            const float* src = x + index - history_;
+            float partial[kLanes] = {};
+            for (size_t j = 0; j < tapsPerPhase_; j += kLanes) {
+                for (size_t lane = 0; lane < kLanes; ++lane) {
+                    partial[lane] += branch[j + lane] * src[j + lane];
+                }
+            }
+            float acc = 0.0f;
+            for (float value : partial) {
+                acc += value;
+            }
+            out[numOutput++] = acc;
+            position_ += down_;
+        }
+        position_ -= end;
+
+        std::copy(buffer_.begin() + static_cast<std::ptrdiff_t>(n),
+                  buffer_.begin() + static_cast<std::ptrdiff_t>(n + history_), buffer_.begin());
+        return numOutput;
+    }
+
+private:
+    std::vector<float> bank_;    // up_ branches of tapsPerPhase_, time-reversed
+    std::vector<float> buffer_;  // history_ + maxInput
+    size_t up_ = 1;
+    size_t down_ = 1;
+    size_t tapsPerPhase_ = 1;
+    size_t history_ = 0;
+    size_t position_ = 0;        // Next output, in 1/up_ input samples from the block start
+    double latency_ = 0.0;
+};
+
+} // namespace voicechanger::dsp
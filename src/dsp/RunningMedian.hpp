@@ -0,0 +1,56 @@
+#pragma once
+
+#include <algorithm>
+
+namespace voicechanger::dsp {
+
+/**
+ * RunningMedian - O(1) incremental median estimate.
+ *
+ * Stochastic-approximation median: each update nudges the estimate one
+ * step toward the new value (sign only), so outliers such as octave errors
+ * move it no more than any other sample. The step starts large for a fast
+ * lock and decays toward a floor that sets the long-term tracking speed.
+ */
+class RunningMedian {
+public:
+    RunningMedian(float initialStep = 1.0f, float minimumStep = 0.02f, float stepDecay = 0.97f)
+        : initialStep_(initialStep), minimumStep_(minimumStep), stepDecay_(stepDecay) {}
+
+    void reset() {
+        hasValue_ = false;
+        value_ = 0.0f;
+        step_ = initialStep_;
+    }
+
+    float update(float x) {
+        if (!hasValue_) {
+            value_ = x;
+            step_ = initialStep_;
+            hasValue_ = true;
+            return value_;
+        }
+
+        if (x > value_) {
+            value_ += std::min(step_, x - value_);
+        } else if (x < value_) {
+            value_ -= std::min(step_, value_ - x);
+        }
+        step_ = std::max(minimumStep_, step_ * stepDecay_);
+        return value_;
+    }
+
+    bool hasValue() const { return hasValue_; }
+    float value() const { return value_; }
+
+private:
+    float initialStep_;
+    float minimumStep_;
+    float stepDecay_;
+
+    bool hasValue_ = false;
+    float value_ = 0.0f;
+    float step_ = initialStep_;
+};
+
+} // namespace voicechanger::dsp
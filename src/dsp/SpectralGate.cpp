@@ -0,0 +1,161 @@
+#include "dsp/SpectralGate.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace voicechanger::dsp {
+
+namespace {
+// A frame within this ratio (~6 dB) of the noise floor counts as noise-only
+constexpr float kGateRatio = 4.0f;
+// Averaging weight of a gated frame in the noise estimate
+constexpr float kNoiseUpdate = 0.1f;
+// Upward drift of the noise estimate while no frames are gated
+constexpr float kNoiseRiseDbPerSecond = 3.0f;
+// Subtraction factor and attenuation limit at amount = 1
+constexpr float kOverSubtraction = 3.0f;
+constexpr float kMaxReductionDb = 30.0f;
+// Per-hop release coefficient for falling gains
+constexpr float kGainRelease = 0.4f;
+} // namespace
+
+void SpectralGate::prepare(float sampleRate, size_t maxChannels) {
+    maxChannels_ = maxChannels;
+    fft_.setSize(kFftSize);
+
+    window_.resize(kFftSize);
+    for (size_t i = 0; i < kFftSize; ++i) {
+        double hann = 0.5 - 0.5 * std::cos(2.0 * M_PI * static_cast<double>(i) / kFftSize);
+        window_[i] = static_cast<float>(std::sqrt(hann));
+    }
+
+    input_.assign(maxChannels, std::vector<float>(kFftSize, 0.0f));
+    accumulator_.assign(maxChannels, std::vector<float>(kFftSize, 0.0f));
+    output_.assign(maxChannels, std::vector<float>(kHopSize, 0.0f));
+    packed_.assign((maxChannels + 1) / 2, std::vector<Fft::Complex>(kFftSize));
+    power_.assign(kFftSize / 2 + 1, 0.0f);
+    noise_.assign(kFftSize / 2 + 1, 0.0f);
+    gain_.assign(kFftSize / 2 + 1, 1.0f);
+
+    float hopSeconds = static_cast<float>(kHopSize) / sampleRate;
+    noiseRise_ = std::pow(10.0f, kNoiseRiseDbPerSecond * hopSeconds / 10.0f);
+
+    reset();
+}
+
+void SpectralGate::reset() {
+    for (size_t ch = 0; ch < maxChannels_; ++ch) {
+        std::fill(input_[ch].begin(), input_[ch].end(), 0.0f);
+        std::fill(accumulator_[ch].begin(), accumulator_[ch].end(), 0.0f);
+        std::fill(output_[ch].begin(), output_[ch].end(), 0.0f);
+    }
+    std::fill(noise_.begin(), noise_.end(), 0.0f);
+    std::fill(gain_.begin(), gain_.end(), 1.0f);
+    hopPosition_ = 0;
+    hasNoiseEstimate_ = false;
+}
+
+void SpectralGate::process(float* const* channels, size_t numChannels, size_t numFrames, float amount) {
+    numChannels = std::min(numChannels, maxChannels_);
+
+    size_t done = 0;
+    while (done < numFrames) {
+        size_t n = std::min(kHopSize - hopPosition_, numFrames - done);
+        for (size_t ch = 0; ch < numChannels; ++ch) {
+            float* data = channels[ch] + done;
+            float* history = input_[ch].data() + (kFftSize - kHopSize) + hopPosition_;
+            const float* ready = output_[ch].data() + hopPosition_;
+            std::copy(data, data + n, history);
+            std::copy(ready, ready + n, data);
+        }
+        hopPosition_ += n;
+        done += n;
+
+        if (hopPosition_ == kHopSize) {
+            processFrame(numChannels, amount);
+            hopPosition_ = 0;
+        }
+    }
+}
+
+void SpectralGate::processFrame(size_t numChannels, float amount) {
+    const size_t numBins = kFftSize / 2 + 1;
+    const size_t numPairs = (numChannels + 1) / 2;
+
+    // Analysis: with z = x + iy, |X_k|^2 + |Y_k|^2 = (|Z_k|^2 + |Z_{N-k}|^2) / 2
+    std::fill(power_.begin(), power_.end(), 0.0f);
+    for (size_t pair = 0; pair < numPairs; ++pair) {
+        const float* left = input_[2 * pair].data();
+        const float* right = 2 * pair + 1 < numChannels ? input_[2 * pair + 1].data() : nullptr;
+        Fft::Complex* spectrum = packed_[pair].data();
+        for (size_t i = 0; i < kFftSize; ++i) {
+            spectrum[i] = Fft::Complex(left[i] * window_[i], right ? right[i] * window_[i] : 0.0f);
+        }
+        fft_.forward(spectrum);
+
+        for (size_t k = 0; k < numBins; ++k) {
+            power_[k] += 0.5f * (std::norm(spectrum[k]) + std::norm(spectrum[(kFftSize - k) % kFftSize]));
+        }
+    }
+
+    // Noise floor: seed from the first frame, average in gated frames, drift up otherwise
+    float framePower = 0.0f;
+    float noisePower = 0.0f;
+    for (size_t k = 0; k < numBins; ++k) {
+        framePower += power_[k];
+        noisePower += noise_[k];
+    }
+    if (!hasNoiseEstimate_) {
+        std::copy(power_.begin(), power_.end(), noise_.begin());
+        hasNoiseEstimate_ = true;
+    } else if (framePower <= kGateRatio * noisePower) {
+        for (size_t k = 0; k < numBins; ++k) {
+            noise_[k] += (power_[k] - noise_[k]) * kNoiseUpdate;
+        }
+    } else {
+        for (size_t k = 0; k < numBins; ++k) {
+            noise_[k] *= noiseRise_;
+        }
+    }
+
+    // Gains: subtraction limited by a floor, instant attack, smoothed release
+    const float floor = std::pow(10.0f, -amount * kMaxReductionDb / 20.0f);
+    const float subtraction = kOverSubtraction * amount;
+    for (size_t k = 0; k < numBins; ++k) {
+        float target = std::max(floor, 1.0f - subtraction * noise_[k] / (power_[k] + 1.0e-20f));
+        gain_[k] = target >= gain_[k] ? target : gain_[k] * kGainRelease + target * (1.0f - kGainRelease);
+    }
+
+    // Synthesis: sqrt-Hann squared at 50% overlap sums to 1; the inverse FFT is unscaled
+    const float scale = 1.0f / static_cast<float>(kFftSize);
+    for (size_t pair = 0; pair < numPairs; ++pair) {
+        Fft::Complex* spectrum = packed_[pair].data();
+        for (size_t k = 0; k < kFftSize; ++k) {
+            spectrum[k] *= gain_[std::min(k, kFftSize - k)];
+        }
+        fft_.inverse(spectrum);
+
+        float* left = accumulator_[2 * pair].data();
+        float* right = 2 * pair + 1 < numChannels ? accumulator_[2 * pair + 1].data() : nullptr;
+        for (size_t i = 0; i < kFftSize; ++i) {
+            left[i] += spectrum[i].real() * window_[i] * scale;
+        }
+        if (right) {
+            for (size_t i = 0; i < kFftSize; ++i) {
+                right[i] += spectrum[i].imag() * window_[i] * scale;
+            }
+        }
+    }
+
+    // The first hop of the accumulator is complete; shift everything along
+    for (size_t ch = 0; ch < numChannels; ++ch) {
+        std::vector<float>& accumulator = accumulator_[ch];
+        std::vector<float>& history = input_[ch];
+        std::copy(accumulator.begin(), accumulator.begin() + kHopSize, output_[ch].begin());
+        std::copy(accumulator.begin() + kHopSize, accumulator.end(), accumulator.begin());
+        std::fill(accumulator.end() - kHopSize, accumulator.end(), 0.0f);
+        std::copy(history.begin() + kHopSize, history.end(), history.begin());
+    }
+}
+
+} // namespace voicechanger::dsp
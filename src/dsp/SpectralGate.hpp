@@ -0,0 +1,67 @@
+#pragma once
+
+#include "dsp/Fft.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace voicechanger::dsp {
+
+/**
+ * SpectralGate - Stationary-noise suppression by per-bin spectral gating.
+ *
+ * A 512-point STFT with sqrt-Hann windows at 50% overlap. Channels are
+ * packed in pairs into one complex transform (real/imaginary), and since
+ * the gains are real and symmetric they apply to the packed spectrum
+ * directly, so stereo costs one forward and one inverse FFT per hop. The
+ * gain is linked across channels, computed from their summed power.
+ *
+ * The noise floor is a per-bin power estimate that is averaged in during
+ * gated frames (frame power within a few dB of the floor) and drifts
+ * slowly upward otherwise, so it follows a rising floor. Gains are a
+ * Wiener-style subtraction limited by a floor, with instant attack and a
+ * smoothed release to keep musical noise down.
+ *
+ * prepare() allocates; everything else is real-time safe. Processing is
+ * in place with a fixed latency of kFftSize samples.
+ */
+class SpectralGate {
+public:
+    static constexpr size_t kFftSize = 512;
+    static constexpr size_t kHopSize = kFftSize / 2;
+
+    void prepare(float sampleRate, size_t maxChannels);
+    void reset();
+
+    /**
+     * @brief Gates planar audio in place.
+     * @param amount 0.0 (no reduction) to 1.0 (full reduction depth).
+     */
+    void process(float* const* channels, size_t numChannels, size_t numFrames, float amount);
+
+    size_t getLatency() const { return kFftSize; }
+
+private:
+    void processFrame(size_t numChannels, float amount);
+
+    Fft fft_;
+    std::vector<float> window_;  // sqrt-Hann, used for analysis and synthesis
+
+    // Per channel: the last kFftSize input samples, the overlap-add
+    // accumulator, and the finished hop being played out
+    std::vector<std::vector<float>> input_;
+    std::vector<std::vector<float>> accumulator_;
+    std::vector<std::vector<float>> output_;
+
+    std::vector<std::vector<Fft::Complex>> packed_;  // One per channel pair
+    std::vector<float> power_;
+    std::vector<float> noise_;
+    std::vector<float> gain_;
+
+    size_t maxChannels_ = 0;
+    size_t hopPosition_ = 0;
+    bool hasNoiseEstimate_ = false;
+    float noiseRise_ = 1.0f;  // Per-hop upward drift of the floor
+};
+
+} // namespace voicechanger::dsp
@@ -0,0 +1,154 @@
+#include "dsp/VoiceActivityDetector.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace voicechanger::dsp {
+
+namespace {
+// Flatness band: voice harmonics live here, hiss is flat across it
+constexpr float kFlatnessLowHz = 150.0f;
+constexpr float kFlatnessHighHz = 3500.0f;
+// White noise scores ~0.56, voiced speech well under 0.2
+constexpr float kMaxSpeechFlatness = 0.35f;
+// Margins over the noise floor: peaky frames, any frame, and single-block onsets
+constexpr float kSpeechMarginDb = 6.0f;
+constexpr float kLoudMarginDb = 20.0f;
+constexpr float kOnsetMarginDb = 9.0f;
+// Upward drift of the floor, so it follows a rising background
+constexpr float kFloorRiseDbPerSecond = 2.0f;
+
+float powerToDb(double power) {
+    return 10.0f * static_cast<float>(std::log10(power + 1.0e-12));
+}
+} // namespace
+
+void VoiceActivityDetector::prepare(float sampleRate) {
+    decimation_ = std::max<size_t>(1, static_cast<size_t>(std::lround(sampleRate / kAnalysisRate)));
+    analysisRate_ = sampleRate / static_cast<float>(decimation_);
+
+    fft_.setSize(kFrameSize);
+    window_.resize(kFrameSize);
+    for (size_t i = 0; i < kFrameSize; ++i) {
+        window_[i] = static_cast<float>(0.5 - 0.5 * std::cos(2.0 * M_PI * static_cast<double>(i) / kFrameSize));
+    }
+    ring_.assign(kFrameSize, 0.0f);
+    spectrum_.assign(kFrameSize, Fft::Complex());
+
+    float binHz = analysisRate_ / static_cast<float>(kFrameSize);
+    lowBin_ = std::max<size_t>(1, static_cast<size_t>(std::ceil(kFlatnessLowHz / binHz)));
+    highBin_ = std::clamp<size_t>(static_cast<size_t>(kFlatnessHighHz / binHz), lowBin_ + 1, kFrameSize / 2);
+
+    float hopSeconds = static_cast<float>(kHopSize) / analysisRate_;
+    floorRiseDb_ = kFloorRiseDbPerSecond * hopSeconds;
+    setHangover(hangoverSeconds_);
+
+    reset();
+}
+
+void VoiceActivityDetector::reset() {
+    std::fill(ring_.begin(), ring_.end(), 0.0f);
+    ringPos_ = 0;
+    decimationPhase_ = 0;
+    decimationSum_ = 0.0f;
+    samplesSinceHop_ = 0;
+    hangoverRemaining_ = 0;
+    levelDb_ = -120.0f;
+    noiseFloorDb_ = -120.0f;
+    hasNoiseFloor_ = false;
+    flatness_ = 1.0f;
+    blockAboveFloor_ = false;
+}
+
+void VoiceActivityDetector::setThreshold(float thresholdDb) {
+    thresholdDb_ = thresholdDb;
+}
+
+void VoiceActivityDetector::setHangover(float seconds) {
+    hangoverSeconds_ = seconds;
+    float hopSeconds = static_cast<float>(kHopSize) / analysisRate_;
+    hangoverHops_ = std::max<size_t>(1, static_cast<size_t>(std::lround(seconds / hopSeconds)));
+}
+
+bool VoiceActivityDetector::process(const float* const* channels, size_t numChannels, size_t numFrames) {
+    if (ring_.empty() || numChannels == 0) {
+        return false;
+    }
+
+    const float channelScale = 1.0f / static_cast<float>(numChannels);
+    const float decimationScale = 1.0f / static_cast<float>(decimation_);
+    double blockEnergy = 0.0;
+
+    for (size_t i = 0; i < numFrames; ++i) {
+        float mono = 0.0f;
+        for (size_t ch = 0; ch < numChannels; ++ch) {
+            mono += channels[ch][i];
+        }
+        mono *= channelScale;
+        blockEnergy += static_cast<double>(mono) * mono;
+
+        // Box-average decimation: crude, but only energy and flatness are measured
+        decimationSum_ += mono;
+        if (++decimationPhase_ < decimation_) {
+            continue;
+        }
+        ring_[ringPos_] = decimationSum_ * decimationScale;
+        ringPos_ = (ringPos_ + 1) % kFrameSize;
+        decimationPhase_ = 0;
+        decimationSum_ = 0.0f;
+
+        if (++samplesSinceHop_ >= kHopSize) {
+            samplesSinceHop_ = 0;
+            analyse();
+        }
+    }
+
+    if (numFrames > 0) {
+        float blockDb = powerToDb(blockEnergy / static_cast<double>(numFrames));
+        float floorDb = hasNoiseFloor_ ? noiseFloorDb_ + kOnsetMarginDb : thresholdDb_;
+        blockAboveFloor_ = blockDb > std::max(thresholdDb_, floorDb);
+    }
+
+    return isActive();
+}
+
+void VoiceActivityDetector::analyse() {
+    double energy = 0.0;
+    for (size_t i = 0; i < kFrameSize; ++i) {
+        float sample = ring_[(ringPos_ + i) % kFrameSize];
+        energy += static_cast<double>(sample) * sample;
+        spectrum_[i] = Fft::Complex(sample * window_[i], 0.0f);
+    }
+    levelDb_ = powerToDb(energy / static_cast<double>(kFrameSize));
+
+    fft_.forward(spectrum_.data());
+    double logSum = 0.0;
+    double sum = 0.0;
+    for (size_t bin = lowBin_; bin < highBin_; ++bin) {
+        double power = static_cast<double>(std::norm(spectrum_[bin])) + 1.0e-12;
+        logSum += std::log(power);
+        sum += power;
+    }
+    double numBins = static_cast<double>(highBin_ - lowBin_);
+    flatness_ = static_cast<float>(std::exp(logSum / numBins) / (sum / numBins));
+
+    // Floor follows quiet frames down immediately and rises slowly otherwise
+    if (!hasNoiseFloor_ || levelDb_ < noiseFloorDb_) {
+        noiseFloorDb_ = levelDb_;
+        hasNoiseFloor_ = true;
+    } else {
+        noiseFloorDb_ += floorRiseDb_;
+    }
+
+    bool loud = levelDb_ > noiseFloorDb_ + kLoudMarginDb;
+    bool peaky = levelDb_ > noiseFloorDb_ + kSpeechMarginDb && flatness_ < kMaxSpeechFlatness;
+    bool speech = levelDb_ > thresholdDb_ && (loud || peaky);
+
+    if (speech) {
+        hangoverRemaining_ = hangoverHops_;
+    } else if (hangoverRemaining_ > 0) {
+        --hangoverRemaining_;
+    }
+}
+
+} // namespace voicechanger::dsp
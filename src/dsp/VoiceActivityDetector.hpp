@@ -0,0 +1,85 @@
+#pragma once
+
+#include "dsp/Fft.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace voicechanger::dsp {
+
+/**
+ * VoiceActivityDetector - Cheap speech/no-speech decision for idle skipping.
+ *
+ * The input is mixed to mono and box-averaged down to roughly 8 kHz. Every
+ * 16 ms hop a 256-sample frame is scored on energy and spectral flatness
+ * (geometric over arithmetic mean power, 150 Hz to 3.5 kHz): voice is
+ * loud relative to a tracked noise floor and peaky, while hiss is flat.
+ * Very loud frames count as speech regardless of flatness so unvoiced
+ * onsets are not missed. A hangover keeps the decision active through
+ * short pauses.
+ *
+ * isAboveFloor() is a per-call check on the latest block alone, for
+ * callers that must wake on the very first block of an onset rather than
+ * after the next hop.
+ *
+ * prepare() allocates; everything else is real-time safe.
+ */
+class VoiceActivityDetector {
+public:
+    /// Target rate of the decimated analysis signal.
+    static constexpr float kAnalysisRate = 8000.0f;
+    static constexpr size_t kFrameSize = 256;
+    static constexpr size_t kHopSize = kFrameSize / 2;
+
+    void prepare(float sampleRate);
+    void reset();
+
+    /// Absolute level (dBFS) below which nothing counts as speech.
+    void setThreshold(float thresholdDb);
+    void setHangover(float seconds);
+
+    /**
+     * @brief Feeds a block of (planar) input.
+     * @return Whether speech is active after this block.
+     */
+    bool process(const float* const* channels, size_t numChannels, size_t numFrames);
+
+    bool isActive() const { return hangoverRemaining_ > 0; }
+    bool isAboveFloor() const { return blockAboveFloor_; }
+
+    float getLevelDb() const { return levelDb_; }
+    float getNoiseFloorDb() const { return noiseFloorDb_; }
+    float getFlatness() const { return flatness_; }
+
+private:
+    void analyse();
+
+    Fft fft_;
+    std::vector<float> window_;
+    std::vector<float> ring_;
+    std::vector<Fft::Complex> spectrum_;
+
+    size_t decimation_ = 1;
+    float analysisRate_ = kAnalysisRate;
+    size_t lowBin_ = 1;
+    size_t highBin_ = 1;
+
+    size_t ringPos_ = 0;
+    size_t decimationPhase_ = 0;
+    float decimationSum_ = 0.0f;
+    size_t samplesSinceHop_ = 0;
+
+    float thresholdDb_ = -50.0f;
+    float hangoverSeconds_ = 0.5f;
+    size_t hangoverHops_ = 1;
+    size_t hangoverRemaining_ = 0;
+    float floorRiseDb_ = 0.0f;  // Per-hop upward drift of the floor
+
+    float levelDb_ = -120.0f;
+    float noiseFloorDb_ = -120.0f;
+    bool hasNoiseFloor_ = false;
+    float flatness_ = 1.0f;
+    bool blockAboveFloor_ = false;
+};
+
+} // namespace voicechanger::dsp
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+namespace voicechanger::dsp {
+
+/**
+ * Waveshaping curves for the drive stage.
+ *
+ * Cheap rational/piecewise forms, safe to call per oversampled sample;
+ * none of them call transcendental functions. All map 0 to 0. softClip,
+ * hardClip and fold stay within [-1, 1]; asymmetric is softClip shifted
+ * down by its offset, so it spans about [-1.29, 0.71].
+ */
+namespace waveshaper {
+
+// Pade-style tanh approximation, exact saturation at |x| = 3
+inline float softClip(float x) {
+    x = std::clamp(x, -3.0f, 3.0f);
+    float x2 = x * x;
+    return x * (27.0f + x2) / (27.0f + 9.0f * x2);
+}
+
+inline float hardClip(float x) {
+    return std::clamp(x, -1.0f, 1.0f);
+}
+
+// Biased soft clip: unequal halves add even harmonics (growl); static offset removed
+inline float asymmetric(float x) {
+    constexpr float kBias = 0.3f;
+    return softClip(x + kBias) - softClip(kBias);
+}
+
+// Triangle wavefolder: identity in [-1, 1], reflects beyond
+inline float fold(float x) {
+    float t = 0.25f * (x + 1.0f);
+    return 4.0f * std::abs(t - std::floor(t + 0.5f)) - 1.0f;
+}
+
+} // namespace waveshaper
+
+} // namespace voicechanger::dsp
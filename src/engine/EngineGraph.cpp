@@ -0,0 +1,186 @@
+#include "engine/EngineGraph.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <set>
+
+namespace voicechanger {
+
+namespace {
+constexpr const char* kInputNode = "inputNode";
+constexpr const char* kOutputNode = "outputNode";
+
+void appendString(std::string& out, const std::string& text) {
+    out += '"';
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+            out += escaped;
+        } else {
+            out += c;
+        }
+    }
+    out += '"';
+}
+
+// Shortest text that reads back as the same float ("50", not "50.0000000")
+void appendNumber(std::string& out, float value) {
+    char text[32];
+    for (int precision = 1; precision <= 9; ++precision) {
+        std::snprintf(text, sizeof(text), "%.*g", precision, static_cast<double>(value));
+        if (std::strtof(text, nullptr) == value) {
+            break;
+        }
+    }
+    out += text;
+}
+} // namespace
+
+EngineGraph EngineGraph::forChainNode(float crossfadeMs) {
+    EngineGraph graph;
+    graph.addNode({"chain", "VoiceChanger.Chain", {{"crossfadeMs", crossfadeMs}}});
+    graph.connect(kInputNode, "chain");
+    graph.connect("chain", kOutputNode);
+    return graph;
+}
+
+EngineGraph EngineGraph::forChain(const ChainSpec& chain) {
+    EngineGraph graph;
+    std::string previous = kInputNode;
+    for (const auto& stage : chain.stages) {
+        EngineNode node{stage.id, stage.type, {}};
+        for (const auto& param : stage.params) {
+            node.config.emplace_back(param.key, param.value);
+        }
+        graph.addNode(std::move(node));
+        graph.connect(previous, stage.id);
+        previous = stage.id;
+    }
+    graph.connect(previous, kOutputNode);
+    return graph;
+}
+
+void EngineGraph::setSampleRate(uint sampleRate) {
+    sampleRate_ = sampleRate;
+    invalidate();
+}
+
+void EngineGraph::setBufferSize(uint bufferSize) {
+    bufferSize_ = bufferSize;
+    invalidate();
+}
+
+void EngineGraph::setMicrophoneEnabled(bool enabled) {
+    microphoneEnabled_ = enabled;
+    invalidate();
+}
+
+void EngineGraph::addNode(EngineNode node) {
+    nodes_.push_back(std::move(node));
+    invalidate();
+}
+
+void EngineGraph::connect(const std::string& source, const std::string& destination) {
+    connections_.push_back({source, destination});
+    invalidate();
+}
+
+bool EngineGraph::validate(std::string& error) const {
+    if (sampleRate_ < kMinSampleRate || sampleRate_ > kMaxSampleRate) {
+        error = "sample rate " + std::to_string(sampleRate_) + " is outside " + std::to_string(kMinSampleRate) +
+                " to " + std::to_string(kMaxSampleRate);
+        return false;
+    }
+    if (bufferSize_ < kMinBufferSize || bufferSize_ > kMaxBufferSize) {
+        error = "buffer size " + std::to_string(bufferSize_) + " is outside " + std::to_string(kMinBufferSize) +
+                " to " + std::to_string(kMaxBufferSize);
+        return false;
+    }
+
+    std::set<std::string> ids;
+    for (const auto& node : nodes_) {
+        if (node.id.empty() || node.type.empty()) {
+            error = "every node needs an id and a type";
+            return false;
+        }
+        if (node.id == kInputNode || node.id == kOutputNode) {
+            error = "node id \"" + node.id + "\" is reserved";
+            return false;
+        }
+        if (!ids.insert(node.id).second) {
+            error = "duplicate node id \"" + node.id + "\"";
+            return false;
+        }
+        for (const auto& [key, value] : node.config) {
+            if (!std::isfinite(value)) {
+                error = node.id + ": config \"" + key + "\" must be a finite number";
+                return false;
+            }
+        }
+    }
+
+    std::set<std::pair<std::string, std::string>> edges;
+    for (const auto& connection : connections_) {
+        bool knownSource = connection.source == kInputNode || ids.count(connection.source);
+        bool knownDestination = connection.destination == kOutputNode || ids.count(connection.destination);
+        if (!knownSource || !knownDestination) {
+            error = "connection " + connection.source + " -> " + connection.destination + " names an unknown node";
+            return false;
+        }
+        if (!edges.emplace(connection.source, connection.destination).second) {
+            error = "connection " + connection.source + " -> " + connection.destination + " is listed twice";
+            return false;
+        }
+    }
+    return true;
+}
+
+const std::string& EngineGraph::toJson() const {
+    if (!json_.empty()) {
+        return json_;
+    }
+    ++serializeCount_;
+
+    std::string& out = json_;
+    out = R"({"type":"RealTimeGraphRenderer","config":{"microphoneEnabled":)";
+    out += microphoneEnabled_ ? "true" : "false";
+    out += R"(,"graph":{"config":{"sampleRate":)" + std::to_string(sampleRate_) +
+           R"(,"bufferSize":)" + std::to_string(bufferSize_) + R"(},"nodes":[)";
+    for (size_t i = 0; i < nodes_.size(); ++i) {
+        const EngineNode& node = nodes_[i];
+        out += i == 0 ? "{\"id\":" : ",{\"id\":";
+        appendString(out, node.id);
+        out += ",\"type\":";
+        appendString(out, node.type);
+        if (!node.config.empty()) {
+            out += ",\"config\":{";
+            for (size_t c = 0; c < node.config.size(); ++c) {
+                if (c > 0) {
+                    out += ',';
+                }
+                appendString(out, node.config[c].first);
+                out += ':';
+                appendNumber(out, node.config[c].second);
+            }
+            out += '}';
+        }
+        out += '}';
+    }
+    out += R"(],"connections":[)";
+    for (size_t i = 0; i < connections_.size(); ++i) {
+        out += i == 0 ? "{\"sourceNode\":" : ",{\"sourceNode\":";
+        appendString(out, connections_[i].source);
+        out += ",\"destinationNode\":";
+        appendString(out, connections_[i].destination);
+        out += '}';
+    }
+    out += "]}}}";
+    return out;
+}
+
+} // namespace voicechanger
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "chain/VoiceChain.hpp"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace voicechanger {
+
+/**
+ * One node of an engine graph, with the numeric config it is created with.
+ */
+struct EngineNode {
+    std::string id;
+    std::string type;  // "VoiceChanger.Chain"
+    std::vector<std::pair<std::string, float>> config;
+};
+
+/**
+ * One edge of an engine graph; inputNode and outputNode are the engine's own.
+ */
+struct EngineConnection {
+    std::string source;
+    std::string destination;
+};
+
+/**
+ * EngineGraph - The description Switchboard::createEngine() takes, built
+ * from typed fields instead of spliced JSON text.
+ *
+ * The sample rate, buffer size and microphone switch are plain setters;
+ * nodes and connections are added by id. toJson() writes the
+ * RealTimeGraphRenderer document the first time it is asked for and keeps
+ * it, so an engine recreated with the same graph costs nothing to
+ * describe; any change clears the cached text. validate() catches the
+ * mistakes the SDK would only report as a failed createEngine(): unknown
+ * or duplicate ids, dangling connections and out-of-range audio settings.
+ */
+class EngineGraph {
+public:
+    static constexpr uint kDefaultSampleRate = 44100;
+    static constexpr uint kDefaultBufferSize = 512;
+    static constexpr uint kMinSampleRate = 8000;
+    static constexpr uint kMaxSampleRate = 192000;
+    static constexpr uint kMinBufferSize = 16;
+    static constexpr uint kMaxBufferSize = 8192;
+
+    /**
+     * @brief The demo's graph: one VoiceChanger.Chain node between the
+     *        microphone and the speakers, crossfading over crossfadeMs.
+     */
+    static EngineGraph forChainNode(float crossfadeMs);
+
+    /**
+     * @brief A preset's chain with every stage as its own engine node, in
+     *        processing order, configured with the stage's parameters.
+     */
+    static EngineGraph forChain(const ChainSpec& chain);
+
+    void setSampleRate(uint sampleRate);
+    void setBufferSize(uint bufferSize);
+    void setMicrophoneEnabled(bool enabled);
+    uint getSampleRate() const { return sampleRate_; }
+    uint getBufferSize() const { return bufferSize_; }
+    bool isMicrophoneEnabled() const { return microphoneEnabled_; }
+
+    void addNode(EngineNode node);
+    void connect(const std::string& source, const std::string& destination);
+    const std::vector<EngineNode>& getNodes() const { return nodes_; }
+    const std::vector<EngineConnection>& getConnections() const { return connections_; }
+
+    /**
+     * @brief Checks ids, connections and audio settings.
+     * @param error Receives the first problem when false is returned.
+     */
+    bool validate(std::string& error) const;
+
+    /**
+     * @brief The engine description, serialized on first use after a change.
+     */
+    const std::string& toJson() const;
+
+    /// Times the description has been serialized, for tests and benchmarks.
+    size_t getSerializeCount() const { return serializeCount_; }
+
+private:
+    void invalidate() { json_.clear(); }
+
+    uint sampleRate_ = kDefaultSampleRate;
+    uint bufferSize_ = kDefaultBufferSize;
+    bool microphoneEnabled_ = true;
+    std::vector<EngineNode> nodes_;
+    std::vector<EngineConnection> connections_;
+
+    mutable std::string json_;  // Empty until serialized
+    mutable size_t serializeCount_ = 0;
+};
+
+} // namespace voicechanger
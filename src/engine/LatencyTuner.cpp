@@ -0,0 +1,139 @@
+#include "engine/LatencyTuner.hpp"
+
+#include <switchboard_core/AudioBuffer.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace voicechanger {
+
+namespace {
+constexpr float kWarmUpSeconds = 0.25f;
+constexpr float kVoiceHz = 140.0f;
+constexpr float kSyllableHz = 4.0f;
+constexpr int kHarmonics = 12;
+
+// A voice-like signal: a harmonic tone switched on and off at syllable rate
+// over low-level noise, so trials see speech, onsets and pauses
+class TestVoice {
+public:
+    explicit TestVoice(uint sampleRate) : sampleRate_(static_cast<float>(sampleRate)) {}
+
+    void fill(float* data, uint numFrames) {
+        const float twoPi = 2.0f * static_cast<float>(M_PI);
+        for (uint i = 0; i < numFrames; ++i, ++frame_) {
+            float t = static_cast<float>(frame_) / sampleRate_;
+            float sample = 0.0f;
+            if (std::fmod(t * kSyllableHz, 1.0f) < 0.6f) {
+                for (int h = 1; h <= kHarmonics; ++h) {
+                    sample += std::sin(twoPi * kVoiceHz * static_cast<float>(h) * t) / static_cast<float>(h);
+                }
+                sample *= 0.2f;
+            }
+            // xorshift32 noise at about -50 dB
+            noise_ ^= noise_ << 13;
+            noise_ ^= noise_ >> 17;
+            noise_ ^= noise_ << 5;
+            sample += 0.003f * (static_cast<float>(noise_) / 4294967295.0f - 0.5f);
+            data[i] = sample;
+        }
+    }
+
+private:
+    float sampleRate_;
+    uint64_t frame_ = 0;
+    uint32_t noise_ = 0x9e3779b9u;
+};
+} // namespace
+
+LatencyTuner::LatencyTuner(uint sampleRate, uint numChannels)
+    : sampleRate_(sampleRate)
+    , numChannels_(std::clamp(numChannels, 1u, VoiceChain::kMaxChannels)) {}
+
+void LatencyTuner::setBufferSizeRange(uint smallest, uint largest) {
+    smallest_ = std::max(1u, std::min(smallest, largest));
+    largest_ = std::max(smallest_, largest);
+}
+
+void LatencyTuner::setSafetyMargin(float margin) {
+    safetyMargin_ = std::isfinite(margin) ? std::clamp(margin, 0.0f, 1.0f) : kDefaultSafetyMargin;
+}
+
+void LatencyTuner::setTrialSeconds(float seconds) {
+    trialSeconds_ = std::isfinite(seconds) && seconds > 0.0f ? seconds : kDefaultTrialSeconds;
+}
+
+bool LatencyTuner::measure(const ChainSpec& chain, uint bufferSize, LatencyTrial& trial, std::string& error) const {
+    switchboard::AudioBusFormat format(sampleRate_, numChannels_, bufferSize);
+    auto compiled = VoiceChain::compile(chain, format, error);
+    if (!compiled) {
+        return false;
+    }
+
+    std::vector<float> input(static_cast<size_t>(numChannels_) * bufferSize);
+    std::vector<float> output(input.size());
+    float* inPointers[VoiceChain::kMaxChannels];
+    float* outPointers[VoiceChain::kMaxChannels];
+    for (uint ch = 0; ch < numChannels_; ++ch) {
+        inPointers[ch] = input.data() + static_cast<size_t>(ch) * bufferSize;
+        outPointers[ch] = output.data() + static_cast<size_t>(ch) * bufferSize;
+    }
+    switchboard::AudioBuffer<float> inBuffer(numChannels_, bufferSize, false, sampleRate_, inPointers);
+    switchboard::AudioBuffer<float> outBuffer(numChannels_, bufferSize, false, sampleRate_, outPointers);
+    switchboard::AudioBus inBus(&inBuffer);
+    switchboard::AudioBus outBus(&outBuffer);
+    inBus.setFormat(format);
+    outBus.setFormat(format);
+
+    const auto blocksFor = [&](float seconds) {
+        return std::max(1L, std::lround(seconds * static_cast<float>(sampleRate_) / static_cast<float>(bufferSize)));
+    };
+    const long warmUpBlocks = blocksFor(kWarmUpSeconds);
+    const long trialBlocks = blocksFor(trialSeconds_);
+
+    TestVoice voice(sampleRate_);
+    std::chrono::duration<double, std::micro> worst{0};
+    for (long block = 0; block < warmUpBlocks + trialBlocks; ++block) {
+        voice.fill(inPointers[0], bufferSize);
+        for (uint ch = 1; ch < numChannels_; ++ch) {
+            std::copy(inPointers[0], inPointers[0] + bufferSize, inPointers[ch]);
+        }
+        auto start = std::chrono::steady_clock::now();
+        compiled->process(inBus, outBus);
+        std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+        if (block >= warmUpBlocks) {
+            worst = std::max(worst, elapsed);
+        }
+    }
+
+    trial.bufferSize = bufferSize;
+    trial.deadlineUs = 1.0e6 * bufferSize / sampleRate_;
+    trial.worstUs = worst.count();
+    trial.fits = trial.worstUs <= (1.0 - safetyMargin_) * trial.deadlineUs;
+    return true;
+}
+
+bool LatencyTuner::tune(const ChainSpec& chain, uint& bufferSize, std::vector<LatencyTrial>& trials,
+                        std::string& error) const {
+    trials.clear();
+    bufferSize = largest_;
+    for (uint size = largest_; size >= smallest_; size /= 2) {
+        LatencyTrial trial;
+        if (!measure(chain, size, trial, error)) {
+            return false;
+        }
+        trials.push_back(trial);
+        if (!trial.fits) {
+            break;
+        }
+        bufferSize = size;
+    }
+    return true;
+}
+
+} // namespace voicechanger
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "chain/VoiceChain.hpp"
+
+#include <string>
+#include <vector>
+
+namespace voicechanger {
+
+/**
+ * One buffer size tried by LatencyTuner.
+ */
+struct LatencyTrial {
+    uint bufferSize = 0;
+    double deadlineUs = 0.0;  // Audio one buffer holds
+    double worstUs = 0.0;     // Slowest process() call
+    bool fits = false;        // worstUs within the deadline, less the safety margin
+};
+
+/**
+ * LatencyTuner - Finds the smallest buffer size a chain can keep up with.
+ *
+ * Each trial compiles the chain offline at one buffer size and runs a few
+ * seconds of a voiced, syllable-gated test signal through it, timing every
+ * process() call. What matters is the slowest call rather than the average:
+ * PitchShift and Whisper do their heavy work once per analysis frame, so at
+ * small buffers most calls are cheap and a few carry a whole frame. A size
+ * fits when that slowest call leaves the safety margin of the deadline
+ * free; the default of half also covers the crossfade, during which the
+ * chain node runs two chains per call.
+ *
+ * Sizes are tried from the largest down, halving each time, and the search
+ * stops at the first one that does not fit.
+ */
+class LatencyTuner {
+public:
+    static constexpr uint kDefaultLargestBufferSize = 512;
+    static constexpr uint kDefaultSmallestBufferSize = 32;
+    static constexpr float kDefaultSafetyMargin = 0.5f;
+    static constexpr float kDefaultTrialSeconds = 2.0f;
+
+    explicit LatencyTuner(uint sampleRate, uint numChannels = 2);
+
+    void setBufferSizeRange(uint smallest, uint largest);
+    void setSafetyMargin(float margin);  // Share of the deadline left free, 0 to 1
+    void setTrialSeconds(float seconds);
+
+    /**
+     * @brief Times one buffer size.
+     * @param error Receives the reason when the chain does not compile.
+     */
+    bool measure(const ChainSpec& chain, uint bufferSize, LatencyTrial& trial, std::string& error) const;
+
+    /**
+     * @brief Tries buffer sizes until one does not fit.
+     * @param bufferSize Receives the smallest size that fits, or the largest
+     *                   size tried if none does (trials.front().fits is then false).
+     * @param trials Receives every size tried, largest first.
+     */
+    bool tune(const ChainSpec& chain, uint& bufferSize, std::vector<LatencyTrial>& trials, std::string& error) const;
+
+private:
+    uint sampleRate_;
+    uint numChannels_;
+    uint smallest_ = kDefaultSmallestBufferSize;
+    uint largest_ = kDefaultLargestBufferSize;
+    float safetyMargin_ = kDefaultSafetyMargin;
+    float trialSeconds_ = kDefaultTrialSeconds;
+};
+
+} // namespace voicechanger
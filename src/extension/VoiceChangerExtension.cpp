@@ -1,7 +1,16 @@
 #include "extension/VoiceChangerExtension.hpp"
 #include "extension/VoiceChangerNodeFactory.hpp"
+#include "nodes/ChainNode.hpp"
+#include "nodes/DelayNode.hpp"
+#include "nodes/DriveNode.hpp"
+#include "nodes/GlitchNode.hpp"
+#include "nodes/ModDelayNode.hpp"
+#include "nodes/PitchCorrectNode.hpp"
+#include "nodes/PitchDetectNode.hpp"
 #include "nodes/PitchShiftNode.hpp"
 #include "nodes/RingModNode.hpp"
+#include "nodes/VoiceActivityNode.hpp"
+#include "nodes/WhisperNode.hpp"
 
 #include <switchboard_core/ExtensionManager.hpp>
 
@@ -30,6 +39,78 @@ VoiceChangerNodeFactory::VoiceChangerNodeFactory() {
             return new RingModNode(config);
         }
     );
+
+    // Register PitchDetectNode
+    registerNode(
+        PitchDetectNode::getNodeTypeInfo(),
+        [](const switchboard::SBAnyMap& config) -> switchboard::Node* {
+            return new PitchDetectNode(config);
+        }
+    );
+
+    // Register PitchCorrectNode
+    registerNode(
+        PitchCorrectNode::getNodeTypeInfo(),
+        [](const switchboard::SBAnyMap& config) -> switchboard::Node* {
+            return new PitchCorrectNode(config);
+        }
+    );
+
+    // Register GlitchNode
+    registerNode(
+        GlitchNode::getNodeTypeInfo(),
+        [](const switchboard::SBAnyMap& config) -> switchboard::Node* {
+            return new GlitchNode(config);
+        }
+    );
+
+    // Register DriveNode
+    registerNode(
+        DriveNode::getNodeTypeInfo(),
+        [](const switchboard::SBAnyMap& config) -> switchboard::Node* {
+            return new DriveNode(config);
+        }
+    );
+
+    // Register ModDelayNode
+    registerNode(
+        ModDelayNode::getNodeTypeInfo(),
+        [](const switchboard::SBAnyMap& config) -> switchboard::Node* {
+            return new ModDelayNode(config);
+        }
+    );
+
+    // Register DelayNode
+    registerNode(
+        DelayNode::getNodeTypeInfo(),
+        [](const switchboard::SBAnyMap& config) -> switchboard::Node* {
+            return new DelayNode(config);
+        }
+    );
+
+    // Register VoiceActivityNode
+    registerNode(
+        VoiceActivityNode::getNodeTypeInfo(),
+        [](const switchboard::SBAnyMap& config) -> switchboard::Node* {
+            return new VoiceActivityNode(config);
+        }
+    );
+
+    // Register WhisperNode
+    registerNode(
+        WhisperNode::getNodeTypeInfo(),
+        [](const switchboard::SBAnyMap& config) -> switchboard::Node* {
+            return new WhisperNode(config);
+        }
+    );
+
+    // Register ChainNode
+    registerNode(
+        ChainNode::getNodeTypeInfo(),
+        [](const switchboard::SBAnyMap& config) -> switchboard::Node* {
+            return new ChainNode(config);
+        }
+    );
 }
 
 std::string VoiceChangerNodeFactory::getNodeTypePrefix() {
@@ -39,7 +120,16 @@ std::string VoiceChangerNodeFactory::getNodeTypePrefix() {
 std::vector<switchboard::NodeTypeInfo> VoiceChangerNodeFactory::getNodeTypes() {
     return {
         PitchShiftNode::getNodeTypeInfo(),
-        RingModNode::getNodeTypeInfo()
+        RingModNode::getNodeTypeInfo(),
+        PitchDetectNode::getNodeTypeInfo(),
+        PitchCorrectNode::getNodeTypeInfo(),
+        GlitchNode::getNodeTypeInfo(),
+        DriveNode::getNodeTypeInfo(),
+        ModDelayNode::getNodeTypeInfo(),
+        DelayNode::getNodeTypeInfo(),
+        VoiceActivityNode::getNodeTypeInfo(),
+        WhisperNode::getNodeTypeInfo(),
+        ChainNode::getNodeTypeInfo()
     };
 }
 
@@ -11,6 +11,15 @@ namespace voicechanger {
  * Provides voice changing audio effect nodes:
  * - VoiceChanger.PitchShift: Pitch shifting with formant preservation
  * - VoiceChanger.RingMod: Ring modulation for robotic/alien effects
+ * - VoiceChanger.PitchDetect: Real-time f0 estimation (analysis only)
+ * - VoiceChanger.PitchCorrect: Scale-aware pitch correction
+ * - VoiceChanger.Glitch: Stutter, reverse and bit-crush glitches
+ * - VoiceChanger.Drive: Oversampled waveshaping distortion
+ * - VoiceChanger.ModDelay: Vibrato, chorus and flanger on one modulated delay line
+ * - VoiceChanger.Delay: Multi-tap feedback delay with damping
+ * - VoiceChanger.VoiceActivity: Voice activity detection (analysis only)
+ * - VoiceChanger.Whisper: Noise-excited LPC whisper
+ * - VoiceChanger.Chain: A whole preset, pruned to its active stages
  */
 class VoiceChangerExtension : public switchboard::Extension {
 public:
@@ -1,27 +1,49 @@
 /**
  * Voice Changer Demo
  *
- * Real-time voice changer with 10 preset voices loaded from JSON.
+ * Real-time voice changer with a library of preset voices loaded from JSON.
  * Uses Switchboard SDK V3 API for audio I/O and custom voice effect nodes.
  *
  * Controls:
- * - 1-9, 0: Select preset directly (1=preset 1, 0=preset 10)
+ * - 1-9, 0: Select one of the first ten presets (1=preset 1, 0=preset 10)
  * - Up/Down arrows: Cycle through presets
+ * - Right/Left arrows: Morph towards the next preset and back, in 10% steps
+ * - C: Jump to the first preset of the next category
  * - Q or Esc: Quit
+ *
+ * Preset files edited while the demo runs are reparsed in the background;
+ * changes to the running preset are heard straight away. Given a preset
+ * bank file (see make-preset-bank) instead of a directory, the demo maps
+ * it and parses nothing. With no presets directory at all it falls back to
+ * the presets compiled in from the same JSON files (see VoicePresets.hpp).
+ *
+ * Usage: voice-changer-demo [--sample-rate HZ] [--buffer-size FRAMES]
+ *                           [--auto-latency] [presets-dir | bank-file]
+ * --auto-latency times the first preset offline at halving buffer sizes and
+ * starts the engine at the smallest one it keeps up with (see LatencyTuner).
  */
 
 #include <switchboard/Switchboard.hpp>
 
 #include "extension/VoiceChangerExtension.hpp"
+#include "chain/PresetMorph.hpp"
+#include "engine/EngineGraph.hpp"
+#include "engine/LatencyTuner.hpp"
+#include "presets/PresetLibrary.hpp"
+#include "presets/PresetWatcher.hpp"
 
 #include <AudioEffectsExtension.hpp>
 
+#include <algorithm>
 #include <atomic>
+#include <cerrno>
+#include <cstdlib>
 #include <csignal>
 #include <filesystem>
-#include <fstream>
 #include <iostream>
+#include <memory>
 #include <sstream>
+#include <string>
 #include <termios.h>
 #include <unistd.h>
 #include <vector>
@@ -31,6 +53,9 @@ using namespace switchboard;
 // Global flag for clean shutdown
 static std::atomic<bool> g_running{true};
 
+// How long a preset switch crossfades between the old and new chains
+constexpr float kCrossfadeMs = 50.0f;
+
 void signalHandler(int signum) {
     (void)signum;
     g_running = false;
@@ -65,6 +90,8 @@ public:
                     switch (seq[1]) {
                         case 'A': return 1000;  // Up
                         case 'B': return 1001;  // Down
+                        case 'C': return 1002;  // Right
+                        case 'D': return 1003;  // Left
                     }
                 }
                 return '\x1b';
@@ -78,223 +105,156 @@ private:
     struct termios originalTermios_;
 };
 
+using PresetPtr = std::shared_ptr<const voicechanger::PresetDefinition>;
+
 /**
- * Voice preset loaded from JSON.
+ * Load the first preset from index onwards, stepping by direction, that
+ * parses; presets that do not are reported and skipped. A direction of 0
+ * tries index only.
+ * @return The index loaded, or -1 if none could be.
  */
-struct VoicePreset {
-    std::string name;
-    std::string description;
-    std::string jsonContent;
-};
+int loadPreset(voicechanger::PresetLibrary& library, int index, int direction, PresetPtr& preset) {
+    int numPresets = static_cast<int>(library.size());
+    int attempts = direction == 0 ? 1 : numPresets;
+    for (int i = 0; i < attempts; ++i) {
+        int candidate = ((index + i * direction) % numPresets + numPresets) % numPresets;
+        std::string error;
+        if (auto loaded = library.load(static_cast<size_t>(candidate), error)) {
+            preset = std::move(loaded);
+            return candidate;
+        }
+        std::cerr << std::endl << "Warning: Skipping preset " << error << std::endl;
+    }
+    return -1;
+}
 
 /**
- * Read file contents.
+ * Compile the preset after index while idle, so stepping through them only swaps.
  */
-static std::optional<std::string> readFile(const std::string& path) {
-    if (!std::filesystem::exists(path)) {
-        return std::nullopt;
+void prepareNext(voicechanger::PresetLibrary& library, int index) {
+    PresetPtr next;
+    if (loadPreset(library, index + 1, 1, next) >= 0) {
+        Switchboard::setValue("chain", "prepare", next->chain);
     }
-    std::ifstream file(path);
-    std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
-    return content;
 }
 
 /**
- * Extract a string value from JSON.
+ * Switch the chain node to a preset, compiled down to its active stages.
  */
-static std::string extractJsonString(const std::string& json, const std::string& key) {
-    std::string search = "\"" + key + "\"";
-    size_t pos = json.find(search);
-    if (pos == std::string::npos) return "";
-    size_t start = json.find("\"", pos + search.length()) + 1;
-    size_t end = json.find("\"", start);
-    return json.substr(start, end - start);
+void applyPreset(const voicechanger::ChainSpec& spec) {
+    auto result = Switchboard::setValue("chain", "preset", spec);
+    if (result.isError()) {
+        std::cerr << std::endl << "Failed to apply preset " << spec.name << ": " << result.error().message << std::endl;
+    }
 }
 
 /**
- * Load all JSON presets from the presets directory.
+ * Bring the running preset up to date with an edited version of its file.
+ * When only parameter values changed they are applied as one batch, so
+ * delay tails and oscillators carry on; a change of stages, modulators or
+ * name compiles the new version and crossfades to it like any switch.
  */
-std::vector<VoicePreset> loadPresets(const std::string& presetsDir) {
-    std::vector<VoicePreset> presets;
-
-    std::vector<std::string> presetFiles = {
-        "01_deep_villain.json",
-        "02_chipmunk.json",
-        "03_robot.json",
-        "04_alien.json",
-        "05_monster.json",
-        "06_radio.json",
-        "07_demon.json",
-        "08_ghost.json",
-        "09_giant.json",
-        "10_cyborg.json"
+void reloadPreset(const voicechanger::PresetDefinition& running, const voicechanger::PresetDefinition& edited) {
+    auto sameRoutes = [](const voicechanger::ModulationSpec& a, const voicechanger::ModulationSpec& b) {
+        return a.source == b.source && a.stageId == b.stageId && a.key == b.key && a.depth == b.depth &&
+               a.rateHz == b.rateHz && a.attackMs == b.attackMs && a.releaseMs == b.releaseMs;
     };
-
-    for (const auto& filename : presetFiles) {
-        auto content = readFile(presetsDir + "/" + filename);
-        if (!content.has_value()) {
-            std::cerr << "Warning: Could not open preset file: " << filename << std::endl;
-            continue;
-        }
-
-        VoicePreset preset;
-        preset.jsonContent = content.value();
-        preset.name = extractJsonString(preset.jsonContent, "name");
-        preset.description = extractJsonString(preset.jsonContent, "description");
-        presets.push_back(preset);
+    const auto& from = running.chain;
+    const auto& to = edited.chain;
+    std::string error;
+    auto diff = voicechanger::PresetMorph::create(from, to, error);
+    if (!diff || from.name != to.name ||
+        !std::equal(from.modulations.begin(), from.modulations.end(), to.modulations.begin(), to.modulations.end(),
+                    sameRoutes)) {
+        applyPreset(to);
+        return;
+    }
+    // Every parameter that differs, at the edited values
+    const auto& changes = diff->update(1.0f);
+    if (changes.empty()) {
+        return;
+    }
+    auto result = Switchboard::setValue("chain", "parameters", changes);
+    if (result.isError()) {
+        std::cerr << std::endl << "Failed to update preset " << to.name << ": " << result.error().message << std::endl;
     }
-
-    return presets;
 }
 
 /**
- * Apply preset parameters to nodes via Switchboard API.
+ * Display how far a morph between two presets has got.
  */
-void applyPreset(const VoicePreset& preset) {
-    auto extractFloat = [&](const std::string& nodeId, const std::string& key) -> std::optional<float> {
-        // Find the node's config block
-        std::string nodeSearch = "\"id\": \"" + nodeId + "\"";
-        size_t nodePos = preset.jsonContent.find(nodeSearch);
-        if (nodePos == std::string::npos) {
-            nodeSearch = "\"id\":\"" + nodeId + "\"";
-            nodePos = preset.jsonContent.find(nodeSearch);
-        }
-        if (nodePos == std::string::npos) return std::nullopt;
-
-        // Find the key within this node's config
-        size_t configPos = preset.jsonContent.find("\"config\"", nodePos);
-        if (configPos == std::string::npos) return std::nullopt;
-
-        std::string search = "\"" + key + "\":";
-        size_t pos = preset.jsonContent.find(search, configPos);
-        if (pos == std::string::npos || pos > configPos + 500) return std::nullopt;
-
-        pos += search.length();
-        while (pos < preset.jsonContent.length() && (preset.jsonContent[pos] == ' ' || preset.jsonContent[pos] == '\t')) pos++;
-
-        size_t end = pos;
-        while (end < preset.jsonContent.length() && (isdigit(preset.jsonContent[end]) || preset.jsonContent[end] == '.' || preset.jsonContent[end] == '-')) end++;
-
-        if (end > pos) {
-            return std::stof(preset.jsonContent.substr(pos, end - pos));
-        }
-        return std::nullopt;
-    };
-
-    auto extractBool = [&](const std::string& nodeId, const std::string& key) -> std::optional<bool> {
-        std::string nodeSearch = "\"id\": \"" + nodeId + "\"";
-        size_t nodePos = preset.jsonContent.find(nodeSearch);
-        if (nodePos == std::string::npos) {
-            nodeSearch = "\"id\":\"" + nodeId + "\"";
-            nodePos = preset.jsonContent.find(nodeSearch);
-        }
-        if (nodePos == std::string::npos) return std::nullopt;
-
-        size_t configPos = preset.jsonContent.find("\"config\"", nodePos);
-        if (configPos == std::string::npos) return std::nullopt;
-
-        std::string search = "\"" + key + "\":";
-        size_t pos = preset.jsonContent.find(search, configPos);
-        if (pos == std::string::npos || pos > configPos + 500) return std::nullopt;
-
-        pos += search.length();
-        while (pos < preset.jsonContent.length() && (preset.jsonContent[pos] == ' ' || preset.jsonContent[pos] == '\t')) pos++;
-
-        if (preset.jsonContent.substr(pos, 4) == "true") return true;
-        if (preset.jsonContent.substr(pos, 5) == "false") return false;
-        return std::nullopt;
-    };
-
-    auto extractInt = [&](const std::string& nodeId, const std::string& key) -> std::optional<int> {
-        std::string nodeSearch = "\"id\": \"" + nodeId + "\"";
-        size_t nodePos = preset.jsonContent.find(nodeSearch);
-        if (nodePos == std::string::npos) {
-            nodeSearch = "\"id\":\"" + nodeId + "\"";
-            nodePos = preset.jsonContent.find(nodeSearch);
-        }
-        if (nodePos == std::string::npos) return std::nullopt;
-
-        size_t configPos = preset.jsonContent.find("\"config\"", nodePos);
-        if (configPos == std::string::npos) return std::nullopt;
-
-        std::string search = "\"" + key + "\":";
-        size_t pos = preset.jsonContent.find(search, configPos);
-        if (pos == std::string::npos || pos > configPos + 500) return std::nullopt;
-
-        pos += search.length();
-        while (pos < preset.jsonContent.length() && (preset.jsonContent[pos] == ' ' || preset.jsonContent[pos] == '\t')) pos++;
-
-        size_t end = pos;
-        while (end < preset.jsonContent.length() && (isdigit(preset.jsonContent[end]) || preset.jsonContent[end] == '-')) end++;
-
-        if (end > pos) {
-            return std::stoi(preset.jsonContent.substr(pos, end - pos));
-        }
-        return std::nullopt;
-    };
-
-    // Apply PitchShift parameters
-    if (auto v = extractFloat("pitchShift", "pitchShift"))
-        Switchboard::setValue("pitchShift", "pitchShift", *v);
-    if (auto v = extractFloat("pitchShift", "formantPreserve"))
-        Switchboard::setValue("pitchShift", "formantPreserve", *v);
-    if (auto v = extractFloat("pitchShift", "outputGain"))
-        Switchboard::setValue("pitchShift", "outputGain", *v);
-
-    // Apply RingMod parameters
-    if (auto v = extractFloat("ringMod", "carrierFrequency"))
-        Switchboard::setValue("ringMod", "carrierFrequency", *v);
-    if (auto v = extractFloat("ringMod", "mix"))
-        Switchboard::setValue("ringMod", "mix", *v);
-
-    // Apply Vibrato parameters
-    if (auto v = extractBool("vibrato", "isEnabled"))
-        Switchboard::setValue("vibrato", "isEnabled", *v);
-    if (auto v = extractFloat("vibrato", "sweepWidth"))
-        Switchboard::setValue("vibrato", "sweepWidth", *v);
-    if (auto v = extractFloat("vibrato", "frequency"))
-        Switchboard::setValue("vibrato", "frequency", *v);
-
-    // Apply Chorus parameters
-    if (auto v = extractBool("chorus", "isEnabled"))
-        Switchboard::setValue("chorus", "isEnabled", *v);
-    if (auto v = extractFloat("chorus", "sweepWidth"))
-        Switchboard::setValue("chorus", "sweepWidth", *v);
-    if (auto v = extractFloat("chorus", "frequency"))
-        Switchboard::setValue("chorus", "frequency", *v);
-
-    // Apply Flanger parameters
-    if (auto v = extractBool("flanger", "isEnabled"))
-        Switchboard::setValue("flanger", "isEnabled", *v);
-    if (auto v = extractFloat("flanger", "sweepWidth"))
-        Switchboard::setValue("flanger", "sweepWidth", *v);
-    if (auto v = extractFloat("flanger", "frequency"))
-        Switchboard::setValue("flanger", "frequency", *v);
-
-    // Apply Delay parameters
-    if (auto v = extractBool("delay", "isEnabled"))
-        Switchboard::setValue("delay", "isEnabled", *v);
-    if (auto v = extractInt("delay", "delayMs"))
-        Switchboard::setValue("delay", "delayMs", *v);
-    if (auto v = extractFloat("delay", "feedbackLevel"))
-        Switchboard::setValue("delay", "feedbackLevel", *v);
-    if (auto v = extractFloat("delay", "wetMix"))
-        Switchboard::setValue("delay", "wetMix", *v);
-    if (auto v = extractFloat("delay", "dryMix"))
-        Switchboard::setValue("delay", "dryMix", *v);
+void displayMorph(const voicechanger::PresetDefinition& from, const voicechanger::PresetDefinition& to, int step) {
+    std::cout << "\r\033[K";
+    std::cout << "Morph " << from.name << " -> " << to.name << ": " << (step * 10) << "%";
+    std::cout << std::flush;
 }
 
 /**
  * Display the current preset status.
  */
-void displayStatus(int presetIndex, const VoicePreset& preset) {
+void displayStatus(int presetIndex, size_t numPresets, const voicechanger::PresetDefinition& preset) {
     std::cout << "\r\033[K";
-    std::cout << "Preset " << (presetIndex + 1) << "/10: " << preset.name;
+    std::cout << "Preset " << (presetIndex + 1) << "/" << numPresets << ": " << preset.name;
+    if (!preset.category.empty()) {
+        std::cout << " [" << preset.category << "]";
+    }
     std::cout << " | " << preset.description;
     std::cout << std::flush;
 }
 
+/**
+ * Parse a whole positive number for a command-line option.
+ */
+static bool parsePositive(const char* text, uint& value) {
+    char* end = nullptr;
+    errno = 0;
+    unsigned long parsed = std::strtoul(text, &end, 10);
+    if (errno != 0 || end == text || *end != '\0' || parsed == 0 || parsed > 1000000) {
+        return false;
+    }
+    value = static_cast<uint>(parsed);
+    return true;
+}
+
+static void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options] [presets-dir | bank-file]" << std::endl;
+    std::cout << "  --sample-rate HZ      Engine sample rate (default "
+              << voicechanger::EngineGraph::kDefaultSampleRate << ")" << std::endl;
+    std::cout << "  --buffer-size FRAMES  Engine buffer size (default "
+              << voicechanger::EngineGraph::kDefaultBufferSize << ")" << std::endl;
+    std::cout << "  --auto-latency        Pick the smallest buffer size the first preset keeps up with,"
+              << " up to --buffer-size" << std::endl;
+}
+
 int main(int argc, char* argv[]) {
+    // Command line: audio settings, then an optional presets directory or bank
+    std::string presetsArg;
+    uint sampleRate = voicechanger::EngineGraph::kDefaultSampleRate;
+    uint bufferSize = voicechanger::EngineGraph::kDefaultBufferSize;
+    bool autoLatency = false;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--sample-rate" || arg == "--buffer-size") {
+            uint& value = arg == "--sample-rate" ? sampleRate : bufferSize;
+            if (i + 1 >= argc || !parsePositive(argv[i + 1], value)) {
+                std::cerr << "Error: " << arg << " needs a positive whole number" << std::endl;
+                return 1;
+            }
+            ++i;
+        } else if (arg == "--auto-latency") {
+            autoLatency = true;
+        } else if (arg == "-h" || arg == "--help") {
+            printUsage(argv[0]);
+            return 0;
+        } else if (arg.rfind("--", 0) == 0 || !presetsArg.empty()) {
+            std::cerr << "Error: Unexpected argument " << arg << std::endl;
+            printUsage(argv[0]);
+            return 1;
+        } else {
+            presetsArg = arg;
+        }
+    }
+
     std::cout << "====================================" << std::endl;
     std::cout << "    Voice Changer Demo" << std::endl;
     std::cout << "====================================" << std::endl;
@@ -302,18 +262,22 @@ int main(int argc, char* argv[]) {
     std::cout << "Controls:" << std::endl;
     std::cout << "  1-9, 0  : Select preset (0 = preset 10)" << std::endl;
     std::cout << "  Up/Down : Cycle through presets" << std::endl;
+    std::cout << "  C       : Next category" << std::endl;
+    std::cout << "  Right   : Morph towards the next preset (Left morphs back)" << std::endl;
     std::cout << "  Q/Esc   : Quit" << std::endl;
     std::cout << std::endl;
 
-    // Determine presets directory
+    // Determine presets directory, or bank file
     std::string presetsDir = "src/presets/json";
-    if (argc > 1) {
-        presetsDir = argv[1];
+    if (!presetsArg.empty()) {
+        presetsDir = presetsArg;
     }
     if (!std::filesystem::exists(presetsDir)) {
         presetsDir = "../src/presets/json";
     }
-    if (!std::filesystem::exists(presetsDir)) {
+    // Without one, fall back to the presets compiled into the build
+    const bool builtIn = presetsArg.empty() && !std::filesystem::exists(presetsDir);
+    if (!builtIn && !std::filesystem::exists(presetsDir)) {
         std::cerr << "Error: Could not find presets directory." << std::endl;
         return 1;
     }
@@ -322,13 +286,34 @@ int main(int argc, char* argv[]) {
     signal(SIGINT, signalHandler);
     signal(SIGTERM, signalHandler);
 
-    // Load presets
-    std::vector<VoicePreset> presets = loadPresets(presetsDir);
-    if (presets.empty()) {
+    // Index the presets; each file is parsed when it is first selected
+    voicechanger::PresetLibrary library;
+    const bool fromBank = std::filesystem::is_regular_file(presetsDir);
+    std::string scanError;
+    if (builtIn) {
+        library.openBuiltIn();
+        presetsDir = "built-in";
+        std::cout << "No presets directory found; using the built-in presets" << std::endl;
+    } else if (!(fromBank ? library.openBank(presetsDir, scanError) : library.scan(presetsDir, scanError))) {
+        std::cerr << "Error: " << scanError << std::endl;
+        return 1;
+    }
+    if (library.empty()) {
         std::cerr << "Error: No presets found in " << presetsDir << std::endl;
         return 1;
     }
-    std::cout << "Loaded " << presets.size() << " presets" << std::endl;
+    std::cout << "Found " << library.size() << " presets";
+    if (!library.getCategories().empty()) {
+        std::cout << " in " << library.getCategories().size() << " categories";
+    }
+    std::cout << std::endl;
+
+    PresetPtr current;
+    int currentPresetIndex = loadPreset(library, 0, 1, current);
+    if (currentPresetIndex < 0) {
+        std::cerr << "Error: No valid presets in " << presetsDir << std::endl;
+        return 1;
+    }
 
     // Load extensions
     extensions::audioeffects::AudioEffectsExtension::load();
@@ -350,62 +335,46 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
-    // Build engine JSON from first preset
-    // Wrap the preset's graph in a RealTimeGraphRenderer
-    const std::string& firstPresetJson = presets[0].jsonContent;
-
-    // Extract the graph portion from the preset
-    size_t graphPos = firstPresetJson.find("\"graph\"");
-    size_t graphStart = firstPresetJson.find("{", graphPos);
-    int braceCount = 1;
-    size_t graphEnd = graphStart + 1;
-    while (graphEnd < firstPresetJson.length() && braceCount > 0) {
-        if (firstPresetJson[graphEnd] == '{') braceCount++;
-        else if (firstPresetJson[graphEnd] == '}') braceCount--;
-        graphEnd++;
+    // The engine runs a single chain node; presets swap the stages inside it,
+    // crossfading from the old ones over 50 ms
+    auto engineGraph = voicechanger::EngineGraph::forChainNode(kCrossfadeMs);
+    engineGraph.setSampleRate(sampleRate);
+    engineGraph.setBufferSize(bufferSize);
+    std::string graphError;
+    if (!engineGraph.validate(graphError)) {
+        std::cerr << "Invalid engine graph: " << graphError << std::endl;
+        Switchboard::deinitialize();
+        return 1;
     }
-    std::string graphContent = firstPresetJson.substr(graphStart, graphEnd - graphStart);
-
-    // Build the engine JSON
-    std::string engineJson = R"({
-        "type": "RealTimeGraphRenderer",
-        "config": {
-            "microphoneEnabled": true,
-            "graph": {
-                "config": {
-                    "sampleRate": 44100,
-                    "bufferSize": 512
-                },
-                "nodes": )" + [&]() {
-                    size_t nodesPos = graphContent.find("\"nodes\"");
-                    size_t start = graphContent.find("[", nodesPos);
-                    int bracketCount = 1;
-                    size_t end = start + 1;
-                    while (end < graphContent.length() && bracketCount > 0) {
-                        if (graphContent[end] == '[') bracketCount++;
-                        else if (graphContent[end] == ']') bracketCount--;
-                        end++;
-                    }
-                    return graphContent.substr(start, end - start);
-                }() + R"(,
-                "connections": )" + [&]() {
-                    size_t connPos = graphContent.find("\"connections\"");
-                    size_t start = graphContent.find("[", connPos);
-                    int bracketCount = 1;
-                    size_t end = start + 1;
-                    while (end < graphContent.length() && bracketCount > 0) {
-                        if (graphContent[end] == '[') bracketCount++;
-                        else if (graphContent[end] == ']') bracketCount--;
-                        end++;
-                    }
-                    return graphContent.substr(start, end - start);
-                }() + R"(
-            }
+
+    // Time the first preset offline and take the smallest buffer it keeps up with
+    if (autoLatency) {
+        voicechanger::LatencyTuner tuner(sampleRate);
+        tuner.setBufferSizeRange(
+            std::min(voicechanger::LatencyTuner::kDefaultSmallestBufferSize, bufferSize), bufferSize);
+        std::vector<voicechanger::LatencyTrial> trials;
+        uint tuned = bufferSize;
+        std::string tuneError;
+        if (!tuner.tune(current->chain, tuned, trials, tuneError)) {
+            std::cerr << "Error: Could not time " << current->name << ": " << tuneError << std::endl;
+            Switchboard::deinitialize();
+            return 1;
         }
-    })";
+        for (const auto& trial : trials) {
+            std::cout << "  " << trial.bufferSize << " frames: worst call " << trial.worstUs << " us of "
+                      << trial.deadlineUs << " us" << (trial.fits ? "" : " (too slow)") << std::endl;
+        }
+        if (!trials.front().fits) {
+            std::cerr << "Warning: " << current->name << " does not keep up even at " << tuned
+                      << " frames" << std::endl;
+        }
+        engineGraph.setBufferSize(std::max(tuned, voicechanger::EngineGraph::kMinBufferSize));
+    }
+    std::cout << "Engine: " << sampleRate << " Hz, " << engineGraph.getBufferSize() << " frames ("
+              << 1000.0 * engineGraph.getBufferSize() / sampleRate << " ms per buffer)" << std::endl;
 
-    // Create audio engine from JSON
-    auto createResult = Switchboard::createEngine(engineJson);
+    // Create audio engine from its description
+    auto createResult = Switchboard::createEngine(engineGraph.toJson());
     if (createResult.isError()) {
         std::cerr << "Failed to create engine: " << createResult.error().message << std::endl;
         Switchboard::deinitialize();
@@ -413,9 +382,12 @@ int main(int argc, char* argv[]) {
     }
     const std::string engineID = createResult.value();
 
-    // Apply initial preset parameters
-    int currentPresetIndex = 0;
-    applyPreset(presets[currentPresetIndex]);
+    // Apply initial preset and have the next one ready
+    int morphIndex = -1;  // Preset being morphed towards, -1 if none
+    int morphStep = 0;    // Morph position in tenths
+    PresetPtr morphTarget;
+    applyPreset(current->chain);
+    prepareNext(library, currentPresetIndex);
 
     // Start audio engine
     auto startResult = Switchboard::callAction(engineID, "start", {});
@@ -426,21 +398,55 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
+    // Pick up preset edits without a restart
+    voicechanger::PresetWatcher watcher;
+    std::string watchError;
+    if (!fromBank && !builtIn && !watcher.start(presetsDir, watchError)) {
+        std::cerr << "Warning: Presets will not reload when edited: " << watchError << std::endl;
+    }
+
     std::cout << "Audio engine started. Speak into your microphone!" << std::endl;
     std::cout << std::endl;
 
-    displayStatus(currentPresetIndex, presets[currentPresetIndex]);
+    displayStatus(currentPresetIndex, library.size(), *current);
 
     // Enter raw terminal mode
     TerminalRawMode terminalRaw;
 
     // Main loop
     while (g_running) {
+        for (auto& update : watcher.takeUpdates()) {
+            if (!update.preset) {
+                // The running preset stays as it was
+                std::cerr << std::endl << "Warning: Not reloading preset " << update.error << std::endl;
+                displayStatus(currentPresetIndex, library.size(), *current);
+                continue;
+            }
+            for (const auto& warning : update.preset->warnings) {
+                std::cerr << std::endl << "Warning: " << update.path << ": " << warning << std::endl;
+            }
+            int index = static_cast<int>(library.update(update.path, update.preset));
+            if (index == currentPresetIndex) {
+                if (morphIndex >= 0) {
+                    // Editing either end of a morph restarts from the edited preset
+                    morphIndex = -1;
+                    applyPreset(update.preset->chain);
+                } else {
+                    reloadPreset(*current, *update.preset);
+                }
+                current = update.preset;
+                displayStatus(currentPresetIndex, library.size(), *current);
+            }
+            if (index == currentPresetIndex || index == (currentPresetIndex + 1) % static_cast<int>(library.size())) {
+                prepareNext(library, currentPresetIndex);
+            }
+        }
+
         int key = terminalRaw.readKey();
         if (key == -1) continue;
 
-        bool presetChanged = false;
-        int numPresets = static_cast<int>(presets.size());
+        int selected = -1;  // Preset to switch to, -1 if none
+        int direction = 0;  // Which way to skip presets that fail to load
 
         switch (key) {
             case 'q':
@@ -451,33 +457,98 @@ int main(int argc, char* argv[]) {
 
             case '1': case '2': case '3': case '4': case '5':
             case '6': case '7': case '8': case '9':
-                if (key - '1' < numPresets) {
-                    currentPresetIndex = key - '1';
-                    presetChanged = true;
+                if (static_cast<size_t>(key - '1') < library.size()) {
+                    selected = key - '1';
                 }
                 break;
 
             case '0':
-                if (numPresets >= 10) {
-                    currentPresetIndex = 9;
-                    presetChanged = true;
+                if (library.size() >= 10) {
+                    selected = 9;
                 }
                 break;
 
             case 1000:  // Up
-                currentPresetIndex = (currentPresetIndex - 1 + numPresets) % numPresets;
-                presetChanged = true;
+                selected = currentPresetIndex - 1;
+                direction = -1;
                 break;
 
             case 1001:  // Down
-                currentPresetIndex = (currentPresetIndex + 1) % numPresets;
-                presetChanged = true;
+                selected = currentPresetIndex + 1;
+                direction = 1;
+                break;
+
+            case 'c':
+            case 'C': {
+                const auto& categories = library.getCategories();
+                if (categories.empty()) {
+                    break;
+                }
+                const std::string& category = library.getEntry(currentPresetIndex).category;
+                auto it = std::find(categories.begin(), categories.end(), category);
+                size_t next = it == categories.end() ? 0 : (it - categories.begin() + 1) % categories.size();
+                // Skip a category whose presets have all moved elsewhere
+                for (size_t tried = 0; tried < categories.size(); ++tried) {
+                    auto indices = library.findByCategory(categories[(next + tried) % categories.size()]);
+                    if (!indices.empty()) {
+                        selected = static_cast<int>(indices.front());
+                        direction = 1;
+                        break;
+                    }
+                }
+                break;
+            }
+
+            case 1002:  // Right
+            case 1003:  // Left
+                if (morphIndex < 0) {
+                    if (key == 1003) {
+                        break;
+                    }
+                    morphIndex = loadPreset(library, currentPresetIndex + 1, 1, morphTarget);
+                    if (morphIndex < 0) {
+                        break;
+                    }
+                    morphStep = 0;
+                    auto result = Switchboard::setValue("chain", "morphTarget", morphTarget->chain);
+                    if (result.isError()) {
+                        std::cerr << std::endl << "Cannot morph: " << result.error().message << std::endl;
+                        morphIndex = -1;
+                        break;
+                    }
+                }
+                morphStep = std::clamp(morphStep + (key == 1002 ? 1 : -1), 0, 10);
+                Switchboard::setValue("chain", "morph", static_cast<float>(morphStep) / 10.0f);
+                if (morphStep == 10) {
+                    // Arrived: the target is now the current preset
+                    currentPresetIndex = morphIndex;
+                    current = std::move(morphTarget);
+                    morphIndex = -1;
+                    displayStatus(currentPresetIndex, library.size(), *current);
+                    prepareNext(library, currentPresetIndex);
+                } else if (morphStep == 0) {
+                    morphIndex = -1;
+                    displayStatus(currentPresetIndex, library.size(), *current);
+                } else {
+                    displayMorph(*current, *morphTarget, morphStep);
+                }
                 break;
         }
 
-        if (presetChanged) {
-            applyPreset(presets[currentPresetIndex]);
-            displayStatus(currentPresetIndex, presets[currentPresetIndex]);
+        if (selected >= 0 || direction != 0) {
+            PresetPtr preset;
+            int loaded = loadPreset(library, selected, direction, preset);
+            if (loaded < 0) {
+                // Keep the running preset
+                displayStatus(currentPresetIndex, library.size(), *current);
+                continue;
+            }
+            currentPresetIndex = loaded;
+            current = std::move(preset);
+            morphIndex = -1;
+            applyPreset(current->chain);
+            displayStatus(currentPresetIndex, library.size(), *current);
+            prepareNext(library, currentPresetIndex);
         }
     }
 
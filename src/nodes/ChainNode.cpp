@@ -0,0 +1,484 @@
+#include "nodes/ChainNode.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace voicechanger {
+
+namespace {
+constexpr float kMaxCrossfadeMs = 1000.0f;
+// Weight of each block in the smoothed load
+constexpr float kLoadSmoothing = 0.05f;
+
+bool isStructural(const ParameterHandle& handle) {
+    return handle && handle.getNode()->getParameterDescriptor(handle.getId()).structural;
+}
+} // namespace
+
+ChainNode::ChainNode(const switchboard::SBAnyMap& config) {
+    // Stages come from a ChainSpec; only the transition is configured here
+    if (config.hasKey("crossfadeMs")) {
+        crossfadeMs_.store(std::clamp(switchboard::SBAny::convert<float>(config.at("crossfadeMs")), 0.0f,
+                                      kMaxCrossfadeMs));
+    }
+}
+
+ChainNode::~ChainNode() {
+    reclaim();
+    delete pending_.exchange(nullptr);
+    delete pendingParameters_.exchange(nullptr);
+    delete heldParameters_;
+    delete fading_;
+    delete active_;
+}
+
+bool ChainNode::setBusFormat(switchboard::AudioBusFormat& inputBusFormat,
+                             switchboard::AudioBusFormat& outputBusFormat) {
+    if (!inputBusFormat.isSet()) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(controlMutex_);
+    reclaim();
+    format_ = inputBusFormat;
+    formatSet_ = true;
+
+    // Processing is stopped while the format changes. Every chain built for the old
+    // format goes now, so the rebuilt one comes in without a fade from a mismatched chain
+    delete fading_;
+    fading_ = nullptr;
+    delete active_;
+    active_ = nullptr;
+    delete pending_.exchange(nullptr, std::memory_order_acq_rel);
+    published_ = nullptr;
+    inTransition_ = false;
+    sampleRate_ = format_.sampleRate;
+    fadeChannels_ = std::min(format_.numberOfChannels, VoiceChain::kMaxChannels);
+    fadeFrames_ = std::max(format_.numberOfFrames, 1u);
+    fadeBuffer_.assign(static_cast<size_t>(fadeChannels_) * fadeFrames_, 0.0f);
+
+    // Chains are sized for the format, so rebuild both for the new one
+    std::string error;
+    standby_.reset();
+    if (preparedSpec_) {
+        standby_ = VoiceChain::compile(*preparedSpec_, format_, error);
+    }
+    if (activeSpec_) {
+        auto chain = VoiceChain::compile(*activeSpec_, format_, error);
+        if (!chain) {
+            return false;
+        }
+        publish(std::move(chain));
+    }
+
+    // Match output format to input
+    outputBusFormat = inputBusFormat;
+    return true;
+}
+
+void ChainNode::publish(std::unique_ptr<VoiceChain> chain) {
+    // Stamped here rather than at compile time: a standby compiled earlier can be published later
+    chain->setSequence(++publishCount_);
+    published_ = chain.get();
+    // A chain still pending was never seen by the audio thread
+    delete pending_.exchange(chain.release(), std::memory_order_acq_rel);
+}
+
+void ChainNode::reclaim() {
+    size_t tail = retireTail_.load(std::memory_order_relaxed);
+    const size_t head = retireHead_.load(std::memory_order_acquire);
+    for (; tail != head; ++tail) {
+        delete retired_[tail % kRetireSlots].chain;
+        delete retired_[tail % kRetireSlots].snapshot;
+    }
+    retireTail_.store(tail, std::memory_order_release);
+}
+
+switchboard::Result<void> ChainNode::changeParameters(const std::vector<ParameterChange>& changes) {
+    if (!activeSpec_) {
+        return switchboard::makeError<void>("No preset to change");
+    }
+
+    // The spec keeps every change, so later recompiles carry them
+    ChainSpec spec = *activeSpec_;
+    bool recompile = false;
+    for (const auto& change : changes) {
+        auto stage = std::find_if(spec.stages.begin(), spec.stages.end(),
+                                  [&](const StageSpec& s) { return s.id == change.stageId; });
+        if (stage == spec.stages.end()) {
+            return switchboard::makeError<void>("Unknown stage: " + change.stageId);
+        }
+        if (!std::isfinite(change.value)) {
+            return switchboard::makeError<void>(change.stageId + ": \"" + change.key + "\" must be a finite number");
+        }
+        stage->setParam(change.key, change.value);
+        spec.validated = false;  // The new values have not been range-checked
+        recompile = recompile || !published_ || !published_->findStage(change.stageId) ||
+                    isStructural(published_->findParameter(change.stageId, change.key));
+    }
+
+    if (!formatSet_) {
+        // Nothing is compiled yet; check the keys against the stage types
+        for (const auto& change : changes) {
+            for (const auto& stage : spec.stages) {
+                if (stage.id == change.stageId) {
+                    auto probe = VoiceChain::createStage(stage.type);
+                    auto result = probe ? probe->setValue(change.key, change.value)
+                                        : switchboard::makeError<void>("Unknown stage type: " + stage.type);
+                    if (result.isError()) {
+                        return switchboard::makeError<void>(change.stageId + ": " + result.error().message);
+                    }
+                }
+            }
+        }
+        activeSpec_ = std::move(spec);
+        return switchboard::makeSuccess();
+    }
+
+    if (recompile) {
+        std::string error;
+        auto chain = VoiceChain::compile(spec, format_, error);
+        if (!chain) {
+            return switchboard::makeError<void>(error);
+        }
+        publish(std::move(chain));
+        activeSpec_ = std::move(spec);
+        return switchboard::makeSuccess();
+    }
+
+    auto snapshot = std::make_unique<ParameterSnapshot>();
+    snapshot->chainSequence = published_->getSequence();
+    for (const auto& change : changes) {
+        ParameterHandle handle = published_->findParameter(change.stageId, change.key);
+        if (!handle) {
+            return switchboard::makeError<void>(change.stageId + ": Unknown parameter: " + change.key);
+        }
+        if (handle.getNode()->getParameterDescriptor(handle.getId()).readOnly) {
+            return switchboard::makeError<void>(change.stageId + ": Read-only parameter: " + change.key);
+        }
+        snapshot->values.emplace_back(handle, change.value);
+    }
+
+    // Fold in a batch the audio thread has not taken yet; later values win
+    std::unique_ptr<ParameterSnapshot> previous(pendingParameters_.exchange(nullptr, std::memory_order_acq_rel));
+    if (previous && previous->chainSequence == snapshot->chainSequence) {
+        previous->values.insert(previous->values.end(), snapshot->values.begin(), snapshot->values.end());
+        snapshot = std::move(previous);
+    }
+    pendingParameters_.store(snapshot.release(), std::memory_order_release);
+    activeSpec_ = std::move(spec);
+    return switchboard::makeSuccess();
+}
+
+bool ChainNode::process(switchboard::AudioBus& inBus, switchboard::AudioBus& outBus) {
+    auto* inBuffer = inBus.getBuffer();
+    auto* outBuffer = outBus.getBuffer();
+
+    if (!inBuffer || !outBuffer) {
+        return false;
+    }
+    auto blockStart = std::chrono::steady_clock::now();
+
+    // Swap at the block boundary, only if there is room to hand the old chain back
+    const size_t head = retireHead_.load(std::memory_order_relaxed);
+    if (head - retireTail_.load(std::memory_order_acquire) < kRetireSlots) {
+        Retired retired;
+        if (fading_ && fadePosition_ >= fadeLength_) {
+            retired.chain = fading_;
+            fading_ = nullptr;
+        }
+        // A new chain waits for a fade in progress to finish
+        if (!fading_ && !retired.chain) {
+            if (VoiceChain* next = pending_.exchange(nullptr, std::memory_order_acq_rel)) {
+                float fadeMs = crossfadeMs_.load();
+                fadeLength_ = static_cast<uint>(std::lround(fadeMs * 0.001f * static_cast<float>(sampleRate_)));
+                if (active_ && fadeLength_ > 0 && !fadeBuffer_.empty()) {
+                    fading_ = active_;
+                    fadePosition_ = 0;
+                } else {
+                    retired.chain = active_;
+                }
+                active_ = next;
+                inTransition_ = true;
+                transitionPeak_ = 0.0f;
+                transitionStep_ = 0.0f;
+            }
+        }
+        // Newer batches stay pending while one is held, so the control thread merges them into that
+        if (!heldParameters_) {
+            heldParameters_ = pendingParameters_.exchange(nullptr, std::memory_order_acq_rel);
+        }
+        if (ParameterSnapshot* snapshot = heldParameters_) {
+            // Chains come in in publish order: a snapshot for an earlier chain is dropped, as the
+            // chain that replaced it was compiled with its values, and one for a later chain waits for it
+            if (active_ && active_->getSequence() >= snapshot->chainSequence) {
+                if (active_->getSequence() == snapshot->chainSequence) {
+                    for (const auto& [handle, value] : snapshot->values) {
+                        active_->applyParameter(handle, value);
+                    }
+                }
+                retired.snapshot = snapshot;
+                heldParameters_ = nullptr;
+            }
+        }
+        if (retired.chain || retired.snapshot) {
+            retired_[head % kRetireSlots] = retired;
+            retireHead_.store(head + 1, std::memory_order_release);
+        }
+    }
+
+    bool ok = true;
+    if (fading_ && fadePosition_ < fadeLength_) {
+        ok = processCrossfade(inBus, outBus);
+    } else if (active_) {
+        ok = active_->process(inBus, outBus);
+    } else {
+        // No preset yet
+        uint numFrames = inBuffer->getNumberOfFrames();
+        for (uint ch = 0; ch < inBuffer->getNumberOfChannels(); ++ch) {
+            const float* inData = inBuffer->getReadPointer(ch);
+            std::copy(inData, inData + numFrames, outBuffer->getWritePointer(ch));
+        }
+    }
+
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - blockStart;
+    measureBlock(*outBuffer, elapsed.count());
+    return ok;
+}
+
+bool ChainNode::processCrossfade(switchboard::AudioBus& inBus, switchboard::AudioBus& outBus) {
+    auto* inBuffer = inBus.getBuffer();
+    auto* outBuffer = outBus.getBuffer();
+    uint numFrames = inBuffer->getNumberOfFrames();
+    uint numChannels = std::min(inBuffer->getNumberOfChannels(), fadeChannels_);
+
+    // Channels beyond the fade buffer's pass through, as they do in a chain
+    for (uint ch = numChannels; ch < inBuffer->getNumberOfChannels(); ++ch) {
+        const float* inData = inBuffer->getReadPointer(ch);
+        std::copy(inData, inData + numFrames, outBuffer->getWritePointer(ch));
+    }
+
+    bool ok = true;
+    for (uint done = 0; done < numFrames;) {
+        uint length = std::min(fadeFrames_, numFrames - done);
+
+        // Both chains read this span of the input; the outgoing one writes to the fade buffer
+        float* inPointers[VoiceChain::kMaxChannels];
+        float* outPointers[VoiceChain::kMaxChannels];
+        float* fadePointers[VoiceChain::kMaxChannels];
+        for (uint ch = 0; ch < numChannels; ++ch) {
+            // Chains only read their input bus
+            inPointers[ch] = const_cast<float*>(inBuffer->getReadPointer(ch)) + done;
+            outPointers[ch] = outBuffer->getWritePointer(ch) + done;
+            fadePointers[ch] = fadeBuffer_.data() + static_cast<size_t>(ch) * fadeFrames_;
+        }
+
+        switchboard::AudioBusFormat format(sampleRate_, numChannels, length);
+        switchboard::AudioBuffer<float> inView(numChannels, length, false, sampleRate_, inPointers);
+        switchboard::AudioBuffer<float> outView(numChannels, length, false, sampleRate_, outPointers);
+        switchboard::AudioBuffer<float> fadeView(numChannels, length, false, sampleRate_, fadePointers);
+        switchboard::AudioBus inSpan(&inView);
+        switchboard::AudioBus outSpan(&outView);
+        switchboard::AudioBus fadeSpan(&fadeView);
+        inSpan.setFormat(format);
+        outSpan.setFormat(format);
+        fadeSpan.setFormat(format);
+
+        ok = fading_->process(inSpan, fadeSpan) && ok;
+        ok = active_->process(inSpan, outSpan) && ok;
+
+        // Equal-power gains; past the end of the fade only the new chain is heard
+        const float angleStep = static_cast<float>(M_PI / 2.0) / static_cast<float>(fadeLength_);
+        for (uint i = 0; i < length; ++i) {
+            uint position = std::min(fadePosition_ + i, fadeLength_);
+            float angle = angleStep * static_cast<float>(position);
+            float newGain = std::sin(angle);
+            float oldGain = std::cos(angle);
+            for (uint ch = 0; ch < numChannels; ++ch) {
+                outPointers[ch][i] = newGain * outPointers[ch][i] + oldGain * fadePointers[ch][i];
+            }
+        }
+
+        fadePosition_ = std::min(fadePosition_ + length, fadeLength_);
+        done += length;
+    }
+
+    return ok;
+}
+
+void ChainNode::measureBlock(switchboard::AudioBuffer<float>& output, double nanos) {
+    uint numFrames = output.getNumberOfFrames();
+    uint numChannels = std::min(output.getNumberOfChannels(), VoiceChain::kMaxChannels);
+    if (numFrames == 0) {
+        return;
+    }
+
+    float load = static_cast<float>(nanos * 1.0e-9 * static_cast<double>(sampleRate_) / numFrames);
+    if (inTransition_) {
+        transitionPeak_ = std::max(transitionPeak_, load);
+
+        // Largest step, including the one across the block boundary
+        for (uint ch = 0; ch < numChannels; ++ch) {
+            const float* data = output.getReadPointer(ch);
+            float previous = lastOutput_[ch];
+            for (uint frame = 0; frame < numFrames; ++frame) {
+                transitionStep_ = std::max(transitionStep_, std::abs(data[frame] - previous));
+                previous = data[frame];
+            }
+        }
+
+        if (!fading_ || fadePosition_ >= fadeLength_) {
+            transitionPeakLoad_.store(transitionPeak_);
+            transitionMaxStep_.store(transitionStep_);
+            inTransition_ = false;
+        }
+    } else {
+        smoothedLoad_ += kLoadSmoothing * (load - smoothedLoad_);
+        load_.store(smoothedLoad_);
+    }
+
+    for (uint ch = 0; ch < numChannels; ++ch) {
+        lastOutput_[ch] = output.getReadPointer(ch)[numFrames - 1];
+    }
+}
+
+switchboard::Result<void> ChainNode::setValue(const std::string& key, const switchboard::SBAny& value) {
+    try {
+        if (key == "preset") {
+            auto spec = std::any_cast<ChainSpec>(value);
+            std::lock_guard<std::mutex> lock(controlMutex_);
+            reclaim();
+            if (formatSet_) {
+                std::unique_ptr<VoiceChain> chain;
+                // Names are not unique and a reloaded preset keeps its name, so match the whole spec
+                if (standby_ && preparedSpec_ && preparedSpec_->buildsSameChain(spec)) {
+                    chain = std::move(standby_);
+                    preparedSpec_.reset();
+                } else {
+                    std::string error;
+                    chain = VoiceChain::compile(spec, format_, error);
+                    if (!chain) {
+                        return switchboard::makeError<void>(error);
+                    }
+                }
+                publish(std::move(chain));
+            }
+            activeSpec_ = std::move(spec);
+            morph_.reset();
+            return switchboard::makeSuccess();
+        }
+        if (key == "prepare") {
+            auto spec = std::any_cast<ChainSpec>(value);
+            std::lock_guard<std::mutex> lock(controlMutex_);
+            reclaim();
+            if (formatSet_) {
+                std::string error;
+                auto chain = VoiceChain::compile(spec, format_, error);
+                if (!chain) {
+                    return switchboard::makeError<void>(error);
+                }
+                standby_ = std::move(chain);
+            }
+            preparedSpec_ = std::move(spec);
+            return switchboard::makeSuccess();
+        }
+        if (key == "crossfadeMs") {
+            auto v = std::any_cast<float>(value);
+            crossfadeMs_.store(std::clamp(v, 0.0f, kMaxCrossfadeMs));
+            return switchboard::makeSuccess();
+        }
+        if (key == "parameters") {
+            auto changes = std::any_cast<std::vector<ParameterChange>>(value);
+            std::lock_guard<std::mutex> lock(controlMutex_);
+            reclaim();
+            return changeParameters(changes);
+        }
+        if (key == "morphTarget") {
+            auto target = std::any_cast<ChainSpec>(value);
+            std::lock_guard<std::mutex> lock(controlMutex_);
+            reclaim();
+            if (!activeSpec_) {
+                return switchboard::makeError<void>("No preset to morph from");
+            }
+            std::string error;
+            auto morph = PresetMorph::create(*activeSpec_, target, error);
+            if (!morph) {
+                return switchboard::makeError<void>(error);
+            }
+            morph_ = std::move(morph);
+            return switchboard::makeSuccess();
+        }
+        if (key == "morph") {
+            auto v = std::any_cast<float>(value);
+            std::lock_guard<std::mutex> lock(controlMutex_);
+            reclaim();
+            if (!morph_) {
+                return switchboard::makeError<void>("No morph target");
+            }
+            const auto& changes = morph_->update(v);
+            if (!changes.empty()) {
+                auto result = changeParameters(changes);
+                if (result.isError()) {
+                    return result;
+                }
+            }
+            // At either end the running preset is that preset
+            if (morph_->getPosition() <= 0.0f) {
+                activeSpec_->name = morph_->getFrom().name;
+            } else if (morph_->getPosition() >= 1.0f) {
+                activeSpec_->name = morph_->getTo().name;
+            }
+            return switchboard::makeSuccess();
+        }
+        if (key == "stageCount" || key == "activePreset" || key == "preparedPreset" || key == "load" ||
+            key == "transitionPeakLoad" || key == "transitionMaxStep") {
+            return switchboard::makeError<void>("Read-only parameter: " + key);
+        }
+        return switchboard::makeError<void>("Unknown parameter: " + key);
+    } catch (const std::bad_any_cast&) {
+        return switchboard::makeError<void>("Invalid value type for parameter: " + key);
+    }
+}
+
+switchboard::Result<switchboard::SBAny> ChainNode::getValue(const std::string& key) {
+    if (key == "crossfadeMs") {
+        return switchboard::makeSuccess<switchboard::SBAny>(crossfadeMs_.load());
+    }
+    if (key == "load") {
+        return switchboard::makeSuccess<switchboard::SBAny>(load_.load());
+    }
+    if (key == "transitionPeakLoad") {
+        return switchboard::makeSuccess<switchboard::SBAny>(transitionPeakLoad_.load());
+    }
+    if (key == "transitionMaxStep") {
+        return switchboard::makeSuccess<switchboard::SBAny>(transitionMaxStep_.load());
+    }
+
+    std::lock_guard<std::mutex> lock(controlMutex_);
+    if (key == "morph") {
+        return switchboard::makeSuccess<switchboard::SBAny>(morph_ ? morph_->getPosition() : 0.0f);
+    }
+    if (key == "stageCount") {
+        return switchboard::makeSuccess<switchboard::SBAny>(static_cast<int>(published_ ? published_->getStageCount() : 0));
+    }
+    if (key == "activePreset") {
+        return switchboard::makeSuccess<switchboard::SBAny>(activeSpec_ ? activeSpec_->name : std::string());
+    }
+    if (key == "preparedPreset") {
+        return switchboard::makeSuccess<switchboard::SBAny>(preparedSpec_ ? preparedSpec_->name : std::string());
+    }
+    size_t dot = key.find('.');
+    if (dot != std::string::npos && published_) {
+        if (ParameterHandle handle = published_->findParameter(key.substr(0, dot), key.substr(dot + 1))) {
+            return switchboard::makeSuccess<switchboard::SBAny>(handle.get());
+        }
+    }
+    return switchboard::makeError<switchboard::SBAny>("Unknown parameter: " + key);
+}
+
+} // namespace voicechanger
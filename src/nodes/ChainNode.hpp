@@ -0,0 +1,183 @@
+#pragma once
+
+#include "chain/PresetMorph.hpp"
+#include "chain/VoiceChain.hpp"
+
+#include <switchboard_core/AudioBuffer.hpp>
+#include <switchboard_core/SingleBusAudioProcessorNode.hpp>
+#include <switchboard_core/NodeTypeInfo.hpp>
+
+#include <any>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace voicechanger {
+
+/**
+ * ChainNode - Runs a whole preset as one node, compiled down to its active stages.
+ *
+ * Setting "preset" compiles a ChainSpec into a VoiceChain on the calling
+ * (control) thread, dropping every stage whose config makes it a
+ * pass-through, and publishes it through an atomic pointer. The audio thread
+ * picks the new chain up at the start of its next block and hands the old
+ * one back through a small lock-free ring; the control thread frees it on
+ * its next call. Nothing is allocated or freed on the audio thread, and a
+ * preset with two active effects costs two effects.
+ *
+ * Setting "prepare" compiles a ChainSpec into a standby chain ahead of
+ * time, so a following "preset" with an identical spec only has to
+ * publish it.
+ * Specs set before the bus format is known are compiled once it is.
+ *
+ * Setting "parameters" changes stage parameters of the running preset
+ * without rebuilding it, so delay lines and oscillators keep their state.
+ * The batch is resolved to parameter handles on the control thread and
+ * published as one snapshot through an atomic pointer; the audio thread
+ * applies every value at the start of the same block. Batches that arrive
+ * before the audio thread has taken the previous one are merged into it.
+ * A change to a stage the running chain pruned, or to a structural
+ * parameter that a node only reads when it is configured (PitchShift's
+ * processingRate), recompiles the preset instead, which also swaps in at a
+ * single block boundary. A batch for a
+ * chain still waiting behind a crossfade is held until that chain comes in.
+ *
+ * Setting "morphTarget" starts a morph from the running preset to another
+ * with the same stages, and "morph" moves between them (0 is the running
+ * preset, 1 the target). Each position is turned into the parameter
+ * changes that differ from the last one, interpolated on each parameter's
+ * own scale (see PresetMorph), and applied like "parameters"; a ModDelay
+ * effect that only one side uses fades in by its tap level rather than
+ * switching. Setting "preset" ends the morph.
+ *
+ * With crossfadeMs above zero a new chain fades in instead: for that long
+ * the outgoing and incoming chains both run and are mixed with equal-power
+ * (cos/sin) gains, which keep the loudness steady across the uncorrelated
+ * outputs of two presets. Both chains were compiled on the control thread
+ * and the fade buffer is sized by setBusFormat, so a transition costs one
+ * extra chain for its duration and allocates nothing. A preset set during
+ * a fade waits for it to finish; a format change drops the old chains and
+ * starts the rebuilt one without a fade. Every transition is measured on
+ * the audio thread: the peak processing load and the largest
+ * sample-to-sample step of the output (a click shows up as a step far
+ * above the signal's own).
+ *
+ * Parameters:
+ * - crossfadeMs: Transition length in ms (0 = switch at the block boundary, up to 1000)
+ * - preset: ChainSpec to switch to at the next block boundary
+ * - prepare: ChainSpec to compile into the standby slot
+ * - parameters: std::vector<ParameterChange> to apply at the next block boundary
+ * - morphTarget: ChainSpec to morph the running preset towards
+ * - morph: Morph position (0.0 to 1.0)
+ * - stageCount: Stages in the published chain (read-only)
+ * - activePreset: Name of the published chain (read-only)
+ * - preparedPreset: Name of the standby chain, empty if none (read-only)
+ * - load: Smoothed share of the block period spent processing, outside transitions (read-only)
+ * - transitionPeakLoad: Peak share of the block period spent processing during
+ *   the last transition (read-only)
+ * - transitionMaxStep: Largest sample-to-sample step of the output during the
+ *   last transition (read-only)
+ * - <stageId>.<key>: Value of a parameter in the published chain, as the
+ *   audio thread last applied it (read-only)
+ */
+class ChainNode : public switchboard::SingleBusAudioProcessorNode {
+public:
+    static switchboard::NodeTypeInfo getNodeTypeInfo() {
+        return switchboard::NodeTypeInfo{
+            "VoiceChanger",
+            "Chain",
+            "Chain",
+            "Preset chain pruned to its active stages",
+            {switchboard::NODE_CATEGORY_AUDIO_PROCESSING, switchboard::NODE_CATEGORY_EFFECTS}
+        };
+    }
+
+    explicit ChainNode(const switchboard::SBAnyMap& config);
+    ~ChainNode() override;
+
+    // SingleBusAudioProcessorNode interface
+    bool setBusFormat(switchboard::AudioBusFormat& inputBusFormat,
+                      switchboard::AudioBusFormat& outputBusFormat) override;
+    bool process(switchboard::AudioBus& inBus, switchboard::AudioBus& outBus) override;
+
+    // Parameter access
+    switchboard::Result<void> setValue(const std::string& key, const switchboard::SBAny& value) override;
+    switchboard::Result<switchboard::SBAny> getValue(const std::string& key) override;
+
+private:
+    // Chains the audio thread can retire before the control thread frees them
+    static constexpr size_t kRetireSlots = 8;
+
+    // Values for stages of one published chain, applied together
+    struct ParameterSnapshot {
+        uint64_t chainSequence = 0;
+        std::vector<std::pair<ParameterHandle, float>> values;
+    };
+
+    // What the audio thread replaced in one block
+    struct Retired {
+        VoiceChain* chain = nullptr;
+        ParameterSnapshot* snapshot = nullptr;
+    };
+
+    // Control thread, with controlMutex_ held
+    void publish(std::unique_ptr<VoiceChain> chain);
+    void reclaim();
+    switchboard::Result<void> changeParameters(const std::vector<ParameterChange>& changes);
+
+    // Audio thread
+    bool processCrossfade(switchboard::AudioBus& inBus, switchboard::AudioBus& outBus);
+    void measureBlock(switchboard::AudioBuffer<float>& output, double nanos);
+
+    // Control-thread state
+    std::mutex controlMutex_;
+    switchboard::AudioBusFormat format_;
+    bool formatSet_ = false;
+    std::optional<ChainSpec> activeSpec_;
+    std::optional<ChainSpec> preparedSpec_;
+    std::unique_ptr<VoiceChain> standby_;
+    std::unique_ptr<PresetMorph> morph_;
+    VoiceChain* published_ = nullptr;  // Last chain published; freed only after a newer one is
+    uint64_t publishCount_ = 0;        // Sequence stamped on the last chain published
+
+    // Control -> audio handoffs; the audio thread takes them with an exchange
+    std::atomic<VoiceChain*> pending_{nullptr};
+    std::atomic<ParameterSnapshot*> pendingParameters_{nullptr};
+
+    // Audio -> control handoff of replaced chains and applied snapshots
+    // (single producer, single consumer)
+    std::array<Retired, kRetireSlots> retired_{};
+    std::atomic<size_t> retireHead_{0};  // Written by the audio thread
+    std::atomic<size_t> retireTail_{0};  // Written by the control thread
+
+    // Thread-safe parameters
+    std::atomic<float> crossfadeMs_{0.0f};
+
+    // Published metrics
+    std::atomic<float> load_{0.0f};
+    std::atomic<float> transitionPeakLoad_{0.0f};
+    std::atomic<float> transitionMaxStep_{0.0f};
+
+    // Audio-thread state
+    VoiceChain* active_ = nullptr;
+    VoiceChain* fading_ = nullptr;  // Outgoing chain during a crossfade
+    ParameterSnapshot* heldParameters_ = nullptr;  // Batch for a chain not yet taken
+    uint fadePosition_ = 0;
+    uint fadeLength_ = 0;
+    std::vector<float> fadeBuffer_;  // Outgoing chain's output, fadeChannels_ x fadeFrames_ planar
+    uint fadeChannels_ = 0;
+    uint fadeFrames_ = 0;
+    uint sampleRate_ = 44100;
+    bool inTransition_ = false;
+    float transitionPeak_ = 0.0f;
+    float transitionStep_ = 0.0f;
+    float smoothedLoad_ = 0.0f;
+    std::array<float, VoiceChain::kMaxChannels> lastOutput_{};
+};
+
+} // namespace voicechanger
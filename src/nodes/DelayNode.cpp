@@ -0,0 +1,243 @@
+#include "nodes/DelayNode.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace voicechanger {
+
+namespace {
+// Added to everything fed back, so a decaying tail settles on a tiny
+// constant instead of sinking into denormals
+constexpr float kAntiDenormal = 1.0e-18f;
+
+// Tap of an extra tap's Ms or Feedback parameter (they come in pairs after tap 1's)
+static_assert(DelayNode::kTap4Feedback == DelayNode::kTap2Ms + 2 * (DelayNode::kMaxTaps - 1) - 1,
+              "one Ms/Feedback pair per extra tap");
+size_t tapIndex(uint32_t id) {
+    return 1 + (id - DelayNode::kTap2Ms) / 2;
+}
+} // namespace
+
+DelayNode::DelayNode(const switchboard::SBAnyMap& config) {
+    tapMs_[0].store(250.0f);
+    tapFeedback_[0].store(0.3f);
+    for (size_t t = 1; t < kMaxTaps; ++t) {
+        tapMs_[t].store(0.0f);
+        tapFeedback_[t].store(0.0f);
+    }
+
+    // Initialize from config
+    applyConfig(config);
+}
+
+bool DelayNode::setBusFormat(switchboard::AudioBusFormat& inputBusFormat,
+                              switchboard::AudioBusFormat& outputBusFormat) {
+    if (!inputBusFormat.isSet()) {
+        return false;
+    }
+
+    sampleRate_ = inputBusFormat.sampleRate;
+    numChannels_ = std::min(inputBusFormat.numberOfChannels, kMaxChannels);
+
+    // Power-of-two rings so positions wrap with a mask
+    auto maxDelay = static_cast<size_t>(std::ceil(kMaxDelayMs * 0.001f * static_cast<float>(sampleRate_))) + kMaxSpan;
+    bufferSize_ = 1;
+    while (bufferSize_ < maxDelay) {
+        bufferSize_ <<= 1;
+    }
+    buffer_.assign(bufferSize_ * numChannels_, 0.0f);
+    writePos_ = 0;
+    taps_ = {};
+    damped_ = {};
+
+    // Match output format to input
+    outputBusFormat = inputBusFormat;
+    return true;
+}
+
+void DelayNode::readSpan(const float* line, size_t delay, uint length, float* out) const {
+    size_t readPos = (writePos_ + bufferSize_ - delay) & (bufferSize_ - 1);
+    size_t first = std::min<size_t>(length, bufferSize_ - readPos);
+    std::copy(line + readPos, line + readPos + first, out);
+    std::copy(line, line + (length - first), out + first);
+}
+
+bool DelayNode::process(switchboard::AudioBus& inBus, switchboard::AudioBus& outBus) {
+    auto* inBuffer = inBus.getBuffer();
+    auto* outBuffer = outBus.getBuffer();
+
+    if (!inBuffer || !outBuffer) {
+        return false;
+    }
+
+    uint numFrames = inBuffer->getNumberOfFrames();
+    uint numChannels = std::min(inBuffer->getNumberOfChannels(), numChannels_);
+
+    const float wetMix = wetMix_.load();
+    const float dryMix = dryMix_.load();
+    const float damping = damping_.load();
+    const size_t mask = bufferSize_ - 1;
+
+    // Per-tap targets; the feedback gains are scaled together to stay stable
+    std::array<size_t, kMaxTaps> targetDelay{};
+    std::array<float, kMaxTaps> targetGain{};
+    std::array<float, kMaxTaps> feedback{};
+    float totalFeedback = 0.0f;
+    for (size_t t = 0; t < kMaxTaps; ++t) {
+        float ms = tapMs_[t].load();
+        targetGain[t] = ms > 0.0f ? 1.0f : 0.0f;
+        targetDelay[t] = ms > 0.0f
+            ? std::max<size_t>(1, static_cast<size_t>(std::lround(ms * 0.001f * static_cast<float>(sampleRate_))))
+            : taps_[t].delay;
+        feedback[t] = ms > 0.0f ? tapFeedback_[t].load() : 0.0f;
+        totalFeedback += feedback[t];
+    }
+    if (totalFeedback > kMaxFeedback) {
+        for (float& gain : feedback) {
+            gain *= kMaxFeedback / totalFeedback;
+        }
+    }
+
+    uint done = 0;
+    while (done < numFrames) {
+        // Spans never reach past the shortest delay, so every read is of
+        // samples already written
+        uint length = std::min(kMaxSpan, numFrames - done);
+        bool anyTap = false;
+        for (size_t t = 0; t < kMaxTaps; ++t) {
+            if (taps_[t].gain > 0.0f || targetGain[t] > 0.0f) {
+                if (taps_[t].delay == 0) {
+                    taps_[t].delay = targetDelay[t];
+                }
+                length = static_cast<uint>(std::min<size_t>(length, std::min(taps_[t].delay, targetDelay[t])));
+                anyTap = true;
+            }
+        }
+        const bool readTaps = anyTap && wetMix > 0.0f;
+        const float spanScale = 1.0f / static_cast<float>(length);
+
+        for (uint ch = 0; ch < numChannels; ++ch) {
+            const float* inData = inBuffer->getReadPointer(ch) + done;
+            float* outData = outBuffer->getWritePointer(ch) + done;
+            float* line = buffer_.data() + ch * bufferSize_;
+
+            alignas(16) float feed[kMaxSpan];
+            alignas(16) float wet[kMaxSpan];
+            alignas(16) float fed[kMaxSpan];
+            std::fill(wet, wet + length, 0.0f);
+            std::fill(fed, fed + length, 0.0f);
+
+            if (readTaps) {
+                for (size_t t = 0; t < kMaxTaps; ++t) {
+                    Tap& tap = taps_[t];
+                    if (tap.gain == 0.0f && targetGain[t] == 0.0f) {
+                        continue;
+                    }
+
+                    // The tap as heard: faded in or out, and crossfaded to a new delay
+                    alignas(16) float echo[kMaxSpan];
+                    readSpan(line, targetDelay[t], length, echo);
+                    if (tap.delay != targetDelay[t]) {
+                        alignas(16) float previous[kMaxSpan];
+                        readSpan(line, tap.delay, length, previous);
+                        for (uint i = 0; i < length; ++i) {
+                            float fade = static_cast<float>(i + 1) * spanScale;
+                            echo[i] = previous[i] + fade * (echo[i] - previous[i]);
+                        }
+                    }
+                    if (tap.gain != targetGain[t]) {
+                        float gainStep = (targetGain[t] - tap.gain) * spanScale;
+                        for (uint i = 0; i < length; ++i) {
+                            echo[i] *= tap.gain + gainStep * static_cast<float>(i + 1);
+                        }
+                    }
+                    const float gain = feedback[t];
+                    for (uint i = 0; i < length; ++i) {
+                        wet[i] += echo[i];
+                        fed[i] += gain * echo[i];
+                    }
+                }
+
+                // One damping lowpass on the summed feedback
+                if (damping > 0.0f) {
+                    const float smoothing = 1.0f - damping;
+                    float damped = damped_[ch];
+                    for (uint i = 0; i < length; ++i) {
+                        damped = smoothing * fed[i] + damping * damped;
+                        fed[i] = damped;
+                    }
+                    damped_[ch] = damped;
+                }
+            }
+
+            for (uint i = 0; i < length; ++i) {
+                feed[i] = inData[i] + fed[i] + kAntiDenormal;
+            }
+
+            // Write the span into the ring, split at the wrap point
+            size_t first = std::min<size_t>(length, bufferSize_ - writePos_);
+            std::copy(feed, feed + first, line + writePos_);
+            std::copy(feed + first, feed + length, line);
+
+            for (uint i = 0; i < length; ++i) {
+                outData[i] = dryMix * inData[i] + wetMix * wet[i];
+            }
+        }
+
+        for (size_t t = 0; t < kMaxTaps; ++t) {
+            taps_[t].delay = targetDelay[t];
+            taps_[t].gain = targetGain[t];
+        }
+        writePos_ = (writePos_ + length) & mask;
+        done += length;
+    }
+
+    // Channels beyond the ring count pass through
+    for (uint ch = numChannels; ch < inBuffer->getNumberOfChannels(); ++ch) {
+        const float* inData = inBuffer->getReadPointer(ch);
+        std::copy(inData, inData + numFrames, outBuffer->getWritePointer(ch));
+    }
+
+    return true;
+}
+
+const ParameterDescriptor& DelayNode::getParameterDescriptor(uint32_t id) const {
+    return kParameters[id];
+}
+
+void DelayNode::storeParameter(uint32_t id, float value) {
+    switch (id) {
+        case kDelayMs: tapMs_[0].store(value); break;
+        case kFeedbackLevel: tapFeedback_[0].store(value); break;
+        // Zero turns an extra tap off
+        case kTap2Ms:
+        case kTap3Ms:
+        case kTap4Ms: tapMs_[tapIndex(id)].store(value <= 0.0f ? 0.0f : std::max(value, 1.0f)); break;
+        case kTap2Feedback:
+        case kTap3Feedback:
+        case kTap4Feedback: tapFeedback_[tapIndex(id)].store(value); break;
+        case kDamping: damping_.store(value); break;
+        case kWetMix: wetMix_.store(value); break;
+        case kDryMix: dryMix_.store(value); break;
+        default: break;
+    }
+}
+
+float DelayNode::getParameter(uint32_t id) const {
+    switch (id) {
+        case kDelayMs: return tapMs_[0].load();
+        case kFeedbackLevel: return tapFeedback_[0].load();
+        case kTap2Ms:
+        case kTap3Ms:
+        case kTap4Ms: return tapMs_[tapIndex(id)].load();
+        case kTap2Feedback:
+        case kTap3Feedback:
+        case kTap4Feedback: return tapFeedback_[tapIndex(id)].load();
+        case kDamping: return damping_.load();
+        case kWetMix: return wetMix_.load();
+        case kDryMix: return dryMix_.load();
+        default: return 0.0f;
+    }
+}
+
+} // namespace voicechanger
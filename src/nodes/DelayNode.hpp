@@ -0,0 +1,136 @@
+#pragma once
+
+#include "nodes/ParameterizedNode.hpp"
+
+#include <switchboard_core/NodeTypeInfo.hpp>
+
+#include <any>
+#include <array>
+#include <atomic>
+#include <string>
+#include <vector>
+
+namespace voicechanger {
+
+/**
+ * DelayNode - Multi-tap feedback delay (echo).
+ *
+ * Each channel has one power-of-two ring buffer shared by up to four taps.
+ * Every tap reads the ring at its own delay, adds to the wet output, and
+ * feeds back into the ring through its own gain. The damping lowpass is
+ * linear and shared, so it runs once on the summed feedback rather than
+ * once per tap, and repeats darken as they decay. Audio is handled in spans
+ * no longer than the shortest delay, which makes every read and write a
+ * contiguous copy (split once at the wrap point) rather than per-sample
+ * index arithmetic. A tiny constant offset in the feedback path keeps
+ * decaying tails out of the denormal range.
+ *
+ * Changing a delay time crossfades between the old and new read positions;
+ * switching a tap on or off fades it. With wetMix at 0 the ring still
+ * records the input but nothing is read back.
+ *
+ * Parameters:
+ * - delayMs: First tap delay in milliseconds (1 to 2000)
+ * - feedbackLevel: First tap feedback (0.0 to 0.95)
+ * - tap2Ms, tap3Ms, tap4Ms: Further tap delays in milliseconds (0 = off, else 1 to 2000)
+ * - tap2Feedback, tap3Feedback, tap4Feedback: Their feedback (0.0 to 0.95)
+ * - damping: Feedback lowpass amount (0.0 = none to 0.99 = dark)
+ * - wetMix: Level of the summed taps (0.0 to 1.0)
+ * - dryMix: Level of the input (0.0 to 1.0)
+ *
+ * The feedback gains are scaled down together if they sum past 0.95.
+ */
+class DelayNode : public ParameterizedNode {
+public:
+    // Parameter ids, in table order
+    enum Param : uint32_t {
+        kDelayMs,
+        kFeedbackLevel,
+        kTap2Ms,
+        kTap2Feedback,
+        kTap3Ms,
+        kTap3Feedback,
+        kTap4Ms,
+        kTap4Feedback,
+        kDamping,
+        kWetMix,
+        kDryMix,
+        kNumParams
+    };
+
+    static switchboard::NodeTypeInfo getNodeTypeInfo() {
+        return switchboard::NodeTypeInfo{
+            "VoiceChanger",
+            "Delay",
+            "Delay",
+            "Multi-tap feedback delay with damping",
+            {switchboard::NODE_CATEGORY_AUDIO_PROCESSING, switchboard::NODE_CATEGORY_EFFECTS}
+        };
+    }
+
+    explicit DelayNode(const switchboard::SBAnyMap& config);
+    ~DelayNode() override = default;
+
+    // SingleBusAudioProcessorNode interface
+    bool setBusFormat(switchboard::AudioBusFormat& inputBusFormat,
+                      switchboard::AudioBusFormat& outputBusFormat) override;
+    bool process(switchboard::AudioBus& inBus, switchboard::AudioBus& outBus) override;
+
+    // ParameterizedNode interface
+    uint32_t getParameterCount() const override { return kNumParams; }
+    const ParameterDescriptor& getParameterDescriptor(uint32_t id) const override;
+    float getParameter(uint32_t id) const override;
+
+    static constexpr uint kMaxChannels = 8;
+    static constexpr size_t kMaxTaps = 4;
+
+    static constexpr float kMaxDelayMs = 2000.0f;
+    static constexpr float kMaxFeedback = 0.95f;
+
+    // Parameter table, indexed by Param; constexpr so presets can be checked at compile time
+    static constexpr ParameterDescriptor kParameters[kNumParams] = {
+        {"delayMs", 1.0f, kMaxDelayMs, 250.0f, false, ParameterScale::kLog},
+        {"feedbackLevel", 0.0f, kMaxFeedback, 0.3f},
+        {"tap2Ms", 0.0f, kMaxDelayMs, 0.0f, false, ParameterScale::kLog},
+        {"tap2Feedback", 0.0f, kMaxFeedback, 0.0f},
+        {"tap3Ms", 0.0f, kMaxDelayMs, 0.0f, false, ParameterScale::kLog},
+        {"tap3Feedback", 0.0f, kMaxFeedback, 0.0f},
+        {"tap4Ms", 0.0f, kMaxDelayMs, 0.0f, false, ParameterScale::kLog},
+        {"tap4Feedback", 0.0f, kMaxFeedback, 0.0f},
+        {"damping", 0.0f, 0.99f, 0.0f},
+        {"wetMix", 0.0f, 1.0f, 0.5f},
+        {"dryMix", 0.0f, 1.0f, 1.0f},
+    };
+
+protected:
+    void storeParameter(uint32_t id, float value) override;
+
+private:
+    // Longest span processed at once, also the scratch buffer size
+    static constexpr uint kMaxSpan = 256;
+
+    struct Tap {
+        size_t delay = 0;   // Samples currently read at
+        float gain = 0.0f;  // 1 while on, faded to 0 when off
+    };
+
+    void readSpan(const float* line, size_t delay, uint length, float* out) const;
+
+    // Thread-safe parameters; index 0 is delayMs/feedbackLevel
+    std::array<std::atomic<float>, kMaxTaps> tapMs_;
+    std::array<std::atomic<float>, kMaxTaps> tapFeedback_;
+    std::atomic<float> damping_{0.0f};
+    std::atomic<float> wetMix_{0.5f};
+    std::atomic<float> dryMix_{1.0f};
+
+    // Audio-thread state
+    std::vector<float> buffer_;  // One ring of bufferSize_ per channel, back to back
+    size_t bufferSize_ = 0;      // Power of two
+    size_t writePos_ = 0;
+    std::array<Tap, kMaxTaps> taps_{};
+    std::array<float, kMaxChannels> damped_{};  // Damping lowpass state per channel
+    uint numChannels_ = 0;
+    uint sampleRate_ = 44100;
+};
+
+} // namespace voicechanger
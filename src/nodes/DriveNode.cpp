@@ -0,0 +1,209 @@
+#include "nodes/DriveNode.hpp"
+
+#include "dsp/Waveshaper.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace voicechanger {
+
+namespace {
+constexpr float kDcBlockHz = 20.0f;
+
+float dbToGain(float db) {
+    return std::pow(10.0f, db / 20.0f);
+}
+
+int nearestFactor(float v) {
+    return v >= 3.0f ? 4 : (v >= 1.5f ? 2 : 1);
+}
+} // namespace
+
+DriveNode::DriveNode(const switchboard::SBAnyMap& config) {
+    // Initialize from config
+    applyConfig(config);
+}
+
+bool DriveNode::setBusFormat(switchboard::AudioBusFormat& inputBusFormat,
+                              switchboard::AudioBusFormat& outputBusFormat) {
+    if (!inputBusFormat.isSet()) {
+        return false;
+    }
+
+    sampleRate_ = inputBusFormat.sampleRate;
+    numChannels_ = std::min(inputBusFormat.numberOfChannels, kMaxChannels);
+
+    lastTone_ = std::clamp(tone_.load(), 1000.0f, 0.45f * static_cast<float>(sampleRate_));
+    for (uint ch = 0; ch < numChannels_; ++ch) {
+        Channel& channel = channels_[ch];
+        channel.oversampler.prepare();
+        channel.dcBlocker.setHighpass(static_cast<float>(sampleRate_), kDcBlockHz);
+        channel.dcBlocker.reset();
+        channel.tone.setLowpass(static_cast<float>(sampleRate_), lastTone_);
+        channel.tone.reset();
+        channel.dryDelay.fill(0.0f);
+        channel.dryWrite = 0;
+    }
+
+    applyOversampling(oversampling_.load());
+    lastGain_ = dbToGain(drive_.load());
+
+    // Match output format to input
+    outputBusFormat = inputBusFormat;
+    return true;
+}
+
+void DriveNode::applyOversampling(int factor) {
+    for (uint ch = 0; ch < numChannels_; ++ch) {
+        channels_[ch].oversampler.setFactor(factor);
+    }
+    activeFactor_ = factor;
+
+    float latency = numChannels_ > 0 ? channels_[0].oversampler.getLatency() : 0.0f;
+    dryDelaySamples_ = static_cast<uint>(std::lround(latency));
+    latencyMs_.store(1000.0f * latency / static_cast<float>(sampleRate_));
+}
+
+bool DriveNode::process(switchboard::AudioBus& inBus, switchboard::AudioBus& outBus) {
+    auto* inBuffer = inBus.getBuffer();
+    auto* outBuffer = outBus.getBuffer();
+
+    if (!inBuffer || !outBuffer) {
+        return false;
+    }
+
+    uint numFrames = inBuffer->getNumberOfFrames();
+    uint numChannels = inBuffer->getNumberOfChannels();
+    uint numDriveChannels = std::min(numChannels, numChannels_);
+
+    float mix = mix_.load();
+    float dryMix = 1.0f - mix;
+    float outputGain = outputGain_.load();
+
+    // Bypassed, or channels beyond the configured count: gain only
+    for (uint ch = mix <= 0.0f ? 0 : numDriveChannels; ch < numChannels; ++ch) {
+        const float* inData = inBuffer->getReadPointer(ch);
+        float* outData = outBuffer->getWritePointer(ch);
+        for (uint frame = 0; frame < numFrames; ++frame) {
+            outData[frame] = inData[frame] * outputGain;
+        }
+    }
+    if (mix <= 0.0f) {
+        bypassed_ = true;
+        return true;
+    }
+    if (numFrames == 0) {
+        return true;
+    }
+
+    // The filters and dry delay still hold audio from before the bypass; start them clean
+    if (bypassed_) {
+        for (uint ch = 0; ch < numDriveChannels; ++ch) {
+            Channel& channel = channels_[ch];
+            channel.oversampler.reset();
+            channel.dcBlocker.reset();
+            channel.tone.reset();
+            channel.dryDelay.fill(0.0f);
+            channel.dryWrite = 0;
+        }
+        lastGain_ = dbToGain(drive_.load());
+        bypassed_ = false;
+    }
+
+    int factor = oversampling_.load();
+    if (factor != activeFactor_) {
+        applyOversampling(factor);
+    }
+
+    float tone = std::clamp(tone_.load(), 1000.0f, 0.45f * static_cast<float>(sampleRate_));
+    if (tone != lastTone_) {
+        for (uint ch = 0; ch < numDriveChannels; ++ch) {
+            channels_[ch].tone.setLowpass(static_cast<float>(sampleRate_), tone);
+        }
+        lastTone_ = tone;
+    }
+
+    // Ramp the drive gain across the block to avoid zipper noise
+    float startGain = lastGain_;
+    float targetGain = dbToGain(drive_.load());
+    float gainStep = (targetGain - startGain) / static_cast<float>(numFrames);
+    lastGain_ = targetGain;
+
+    int curve = std::clamp(curve_.load(), 0, kNumCurves - 1);
+    constexpr uint kDelayMask = kDryDelaySize - 1;
+
+    for (uint ch = 0; ch < numDriveChannels; ++ch) {
+        Channel& channel = channels_[ch];
+        const float* inData = inBuffer->getReadPointer(ch);
+        float* outData = outBuffer->getWritePointer(ch);
+
+        float scratch[dsp::Oversampler::kMaxBlock];
+        for (uint offset = 0; offset < numFrames; offset += dsp::Oversampler::kMaxBlock) {
+            uint n = std::min(static_cast<uint>(dsp::Oversampler::kMaxBlock), numFrames - offset);
+
+            for (uint i = 0; i < n; ++i) {
+                scratch[i] = inData[offset + i] * (startGain + gainStep * static_cast<float>(offset + i + 1));
+            }
+
+            // One instantiation per curve keeps the shaper inlined in the oversampled loop
+            switch (curve) {
+                case 1:
+                    channel.oversampler.process(scratch, scratch, n, [](float x) { return dsp::waveshaper::hardClip(x); });
+                    break;
+                case 2:
+                    channel.oversampler.process(scratch, scratch, n, [](float x) { return dsp::waveshaper::asymmetric(x); });
+                    break;
+                case 3:
+                    channel.oversampler.process(scratch, scratch, n, [](float x) { return dsp::waveshaper::fold(x); });
+                    break;
+                default:
+                    channel.oversampler.process(scratch, scratch, n, [](float x) { return dsp::waveshaper::softClip(x); });
+                    break;
+            }
+
+            for (uint i = 0; i < n; ++i) {
+                float wet = channel.tone.process(channel.dcBlocker.process(scratch[i]));
+
+                // Align the dry path with the oversampling latency
+                channel.dryDelay[channel.dryWrite] = inData[offset + i];
+                float dry = channel.dryDelay[(channel.dryWrite - dryDelaySamples_) & kDelayMask];
+                channel.dryWrite = (channel.dryWrite + 1) & kDelayMask;
+
+                outData[offset + i] = (wet * mix + dry * dryMix) * outputGain;
+            }
+        }
+    }
+
+    return true;
+}
+
+const ParameterDescriptor& DriveNode::getParameterDescriptor(uint32_t id) const {
+    return kParameters[id];
+}
+
+void DriveNode::storeParameter(uint32_t id, float value) {
+    switch (id) {
+        case kDrive: drive_.store(value); break;
+        case kCurve: curve_.store(static_cast<int>(std::lround(value))); break;
+        case kOversampling: oversampling_.store(nearestFactor(value)); break;
+        case kTone: tone_.store(value); break;
+        case kMix: mix_.store(value); break;
+        case kOutputGain: outputGain_.store(value); break;
+        default: break;
+    }
+}
+
+float DriveNode::getParameter(uint32_t id) const {
+    switch (id) {
+        case kDrive: return drive_.load();
+        case kCurve: return static_cast<float>(curve_.load());
+        case kOversampling: return static_cast<float>(oversampling_.load());
+        case kTone: return tone_.load();
+        case kMix: return mix_.load();
+        case kOutputGain: return outputGain_.load();
+        case kLatency: return latencyMs_.load();
+        default: return 0.0f;
+    }
+}
+
+} // namespace voicechanger
@@ -0,0 +1,256 @@
+#include "nodes/GlitchNode.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace voicechanger {
+
+namespace {
+// Fade at every grain repeat boundary to avoid clicks
+constexpr float kFadeMs = 2.0f;
+} // namespace
+
+GlitchNode::GlitchNode(const switchboard::SBAnyMap& config) {
+    // Initialize from config
+    applyConfig(config);
+}
+
+bool GlitchNode::setBusFormat(switchboard::AudioBusFormat& inputBusFormat,
+                               switchboard::AudioBusFormat& outputBusFormat) {
+    if (!inputBusFormat.isSet()) {
+        return false;
+    }
+
+    sampleRate_ = inputBusFormat.sampleRate;
+    numChannels_ = std::min(inputBusFormat.numberOfChannels, kMaxChannels);
+
+    // Size by time so any block size works
+    maxGrainFrames_ = static_cast<uint>(std::ceil(kMaxGrainMs * 0.001f * static_cast<float>(sampleRate_)));
+    ring_.assign(static_cast<size_t>(numChannels_) * maxGrainFrames_, 0.0f);
+    grainStorage_.assign(static_cast<size_t>(kMaxGrains) * numChannels_ * maxGrainFrames_, 0.0f);
+    ringWrite_ = 0;
+    ringFilled_ = 0;
+
+    reseed(seed_.load());
+
+    // Match output format to input
+    outputBusFormat = inputBusFormat;
+    return true;
+}
+
+void GlitchNode::reseed(uint32_t seed) {
+    rng_.setSeed(seed);
+    appliedSeed_ = seed;
+    samplesUntilEvent_ = 0;
+    for (auto& grain : grains_) {
+        grain.active = false;
+    }
+}
+
+uint GlitchNode::nextEventInterval(float density) {
+    // Mean interval 1/density, jittered by +-50%
+    float frames = static_cast<float>(sampleRate_) / density * (0.5f + rng_.nextFloat());
+    return std::max(1u, static_cast<uint>(frames));
+}
+
+void GlitchNode::triggerGrain() {
+    // Draw everything up front so the sequence does not depend on pool state
+    auto length = static_cast<uint>(std::lround(grainMs_.load() * 0.001f * static_cast<float>(sampleRate_)));
+    length = std::clamp(length, 1u, maxGrainFrames_);
+    uint repeats = 1 + rng_.nextBelow(static_cast<uint32_t>(std::clamp(repeats_.load(), 1, 8)));
+    bool reverse = rng_.nextFloat() < reverse_.load();
+    bool crush = rng_.nextFloat() < crush_.load();
+
+    if (ringFilled_ < length) {
+        return;
+    }
+
+    Grain* slot = nullptr;
+    uint slotIndex = 0;
+    for (uint i = 0; i < kMaxGrains; ++i) {
+        if (!grains_[i].active) {
+            slot = &grains_[i];
+            slotIndex = i;
+            break;
+        }
+    }
+    if (slot == nullptr) {
+        return;  // Pool exhausted: drop the event rather than allocate
+    }
+
+    // Copy the most recent `length` frames out of the ring in time order
+    uint start = (ringWrite_ + maxGrainFrames_ - length) % maxGrainFrames_;
+    uint firstPart = std::min(length, maxGrainFrames_ - start);
+    for (uint ch = 0; ch < numChannels_; ++ch) {
+        const float* src = ring_.data() + static_cast<size_t>(ch) * maxGrainFrames_;
+        float* dst = grainData(slotIndex, ch);
+        std::copy(src + start, src + start + firstPart, dst);
+        std::copy(src, src + (length - firstPart), dst + firstPart);
+    }
+
+    auto fadeFrames = static_cast<uint>(kFadeMs * 0.001f * static_cast<float>(sampleRate_));
+    slot->active = true;
+    slot->reverse = reverse;
+    slot->crush = crush;
+    slot->length = length;
+    slot->fade = std::clamp(fadeFrames, 1u, std::max(1u, length / 2));
+    slot->position = 0;
+    slot->repeatsLeft = repeats;
+    slot->holdCounter = 0;
+}
+
+bool GlitchNode::process(switchboard::AudioBus& inBus, switchboard::AudioBus& outBus) {
+    auto* inBuffer = inBus.getBuffer();
+    auto* outBuffer = outBus.getBuffer();
+
+    if (!inBuffer || !outBuffer || maxGrainFrames_ == 0) {
+        return false;
+    }
+
+    uint numFrames = inBuffer->getNumberOfFrames();
+    uint numChannels = inBuffer->getNumberOfChannels();
+    uint numGlitchChannels = std::min(numChannels, numChannels_);
+
+    uint32_t seed = seed_.load();
+    if (seed != appliedSeed_) {
+        reseed(seed);
+    }
+
+    // Channels beyond the configured count pass through
+    for (uint ch = numGlitchChannels; ch < numChannels; ++ch) {
+        const float* inData = inBuffer->getReadPointer(ch);
+        float* outData = outBuffer->getWritePointer(ch);
+        std::copy(inData, inData + numFrames, outData);
+    }
+
+    float mix = mix_.load();
+    if (mix <= 0.0f) {
+        // Bypassed: drop stale state so re-enabling starts clean
+        for (uint ch = 0; ch < numGlitchChannels; ++ch) {
+            const float* inData = inBuffer->getReadPointer(ch);
+            float* outData = outBuffer->getWritePointer(ch);
+            std::copy(inData, inData + numFrames, outData);
+        }
+        ringFilled_ = 0;
+        for (auto& grain : grains_) {
+            grain.active = false;
+        }
+        return true;
+    }
+
+    float dryMix = 1.0f - mix;
+    float density = density_.load();
+    auto levels = static_cast<float>(1 << (std::clamp(bitDepth_.load(), 1, 16) - 1));
+    auto holdFrames = static_cast<uint>(std::clamp(downsample_.load(), 1, 32));
+
+    const float* inData[kMaxChannels];
+    float* outData[kMaxChannels];
+    for (uint ch = 0; ch < numGlitchChannels; ++ch) {
+        inData[ch] = inBuffer->getReadPointer(ch);
+        outData[ch] = outBuffer->getWritePointer(ch);
+    }
+
+    for (uint frame = 0; frame < numFrames; ++frame) {
+        // Capture
+        for (uint ch = 0; ch < numGlitchChannels; ++ch) {
+            ring_[static_cast<size_t>(ch) * maxGrainFrames_ + ringWrite_] = inData[ch][frame];
+        }
+        ringWrite_ = ringWrite_ + 1 == maxGrainFrames_ ? 0 : ringWrite_ + 1;
+        ringFilled_ = std::min(ringFilled_ + 1, maxGrainFrames_);
+
+        // Schedule
+        if (density > 0.0f) {
+            if (samplesUntilEvent_ == 0) {
+                triggerGrain();
+                samplesUntilEvent_ = nextEventInterval(density);
+            } else {
+                --samplesUntilEvent_;
+            }
+        }
+
+        // Play grains
+        float wet[kMaxChannels] = {};
+        float coverage = 0.0f;
+        for (uint i = 0; i < kMaxGrains; ++i) {
+            Grain& grain = grains_[i];
+            if (!grain.active) {
+                continue;
+            }
+
+            float envelope = 1.0f;
+            if (grain.position < grain.fade) {
+                envelope = static_cast<float>(grain.position + 1) / static_cast<float>(grain.fade);
+            } else if (grain.length - grain.position <= grain.fade) {
+                envelope = static_cast<float>(grain.length - grain.position) / static_cast<float>(grain.fade);
+            }
+
+            uint index = grain.reverse ? grain.length - 1 - grain.position : grain.position;
+            for (uint ch = 0; ch < numGlitchChannels; ++ch) {
+                float sample = grainData(i, ch)[index];
+                if (grain.crush) {
+                    if (grain.holdCounter == 0) {
+                        grain.held[ch] = std::floor(sample * levels + 0.5f) / levels;
+                    }
+                    sample = grain.held[ch];
+                }
+                wet[ch] += sample * envelope;
+            }
+            if (grain.crush) {
+                grain.holdCounter = grain.holdCounter == 0 ? holdFrames - 1 : grain.holdCounter - 1;
+            }
+            coverage += envelope;
+
+            if (++grain.position == grain.length) {
+                grain.position = 0;
+                grain.active = --grain.repeatsLeft > 0;
+            }
+        }
+        // Overlapping grains are normalised; grains duck the live signal while they play
+        float grainGain = coverage > 1.0f ? 1.0f / coverage : 1.0f;
+        coverage = std::min(coverage, 1.0f);
+
+        for (uint ch = 0; ch < numGlitchChannels; ++ch) {
+            float dry = inData[ch][frame];
+            float glitched = dry * (1.0f - coverage) + wet[ch] * grainGain;
+            outData[ch][frame] = glitched * mix + dry * dryMix;
+        }
+    }
+
+    return true;
+}
+
+const ParameterDescriptor& GlitchNode::getParameterDescriptor(uint32_t id) const {
+    return kParameters[id];
+}
+
+void GlitchNode::storeParameter(uint32_t id, float value) {
+    switch (id) {
+        case kMix: mix_.store(value); break;
+        case kDensity: density_.store(value); break;
+        case kGrainMs: grainMs_.store(value); break;
+        case kRepeats: repeats_.store(static_cast<int>(std::lround(value))); break;
+        case kReverse: reverse_.store(value); break;
+        case kCrush: crush_.store(value); break;
+        case kBitDepth: bitDepth_.store(static_cast<int>(std::lround(value))); break;
+        case kDownsample: downsample_.store(static_cast<int>(std::lround(value))); break;
+        case kSeed: seed_.store(static_cast<uint32_t>(value)); break;
+        default: break;
+    }
+}
+
+float GlitchNode::getParameter(uint32_t id) const {
+    switch (id) {
+        case kMix: return mix_.load();
+        case kDensity: return density_.load();
+        case kGrainMs: return grainMs_.load();
+        case kRepeats: return static_cast<float>(repeats_.load());
+        case kReverse: return reverse_.load();
+        case kCrush: return crush_.load();
+        case kBitDepth: return static_cast<float>(bitDepth_.load());
+        case kDownsample: return static_cast<float>(downsample_.load());
+        case kSeed: return static_cast<float>(seed_.load());
+        default: return 0.0f;
+    }
+}
+
+} // namespace voicechanger
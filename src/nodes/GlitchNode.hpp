@@ -0,0 +1,149 @@
+#pragma once
+
+#include "dsp/Random.hpp"
+
+#include "nodes/ParameterizedNode.hpp"
+
+#include <switchboard_core/NodeTypeInfo.hpp>
+
+#include <any>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace voicechanger {
+
+/**
+ * GlitchNode - Stutter, reverse and bit-crush glitches for malfunctioning-machine voices.
+ *
+ * The input is continuously written to a capture ring. At random intervals
+ * the most recent grain is copied into a free slot of a fixed grain pool and
+ * replayed over the live signal: repeated (stutter), optionally reversed and
+ * optionally bit/sample-rate crushed. All randomness comes from a seeded
+ * PRNG, so the same input and seed always render the same output.
+ *
+ * The ring and pool are allocated in setBusFormat; when every slot is busy
+ * new events are dropped, so process() never allocates.
+ *
+ * Parameters:
+ * - mix: Dry/wet mix (0.0 = dry, 1.0 = wet)
+ * - density: Glitch events per second (0.0 to 20.0)
+ * - grainMs: Grain length in ms (10 to 200)
+ * - repeats: Maximum stutter repeats per event (1 to 8)
+ * - reverse: Probability a grain plays backwards (0.0 to 1.0)
+ * - crush: Probability a grain is bit/sample-rate crushed (0.0 to 1.0)
+ * - bitDepth: Crushed grain resolution in bits (1 to 16)
+ * - downsample: Crushed grain sample-and-hold factor (1 to 32)
+ * - seed: PRNG seed; setting it restarts the random sequence
+ */
+class GlitchNode : public ParameterizedNode {
+public:
+    // Parameter ids, in table order
+    enum Param : uint32_t {
+        kMix,
+        kDensity,
+        kGrainMs,
+        kRepeats,
+        kReverse,
+        kCrush,
+        kBitDepth,
+        kDownsample,
+        kSeed,
+        kNumParams
+    };
+
+    static switchboard::NodeTypeInfo getNodeTypeInfo() {
+        return switchboard::NodeTypeInfo{
+            "VoiceChanger",
+            "Glitch",
+            "Glitch",
+            "Stutter, reverse and bit-crush glitches",
+            {switchboard::NODE_CATEGORY_AUDIO_PROCESSING, switchboard::NODE_CATEGORY_EFFECTS}
+        };
+    }
+
+    explicit GlitchNode(const switchboard::SBAnyMap& config);
+    ~GlitchNode() override = default;
+
+    // SingleBusAudioProcessorNode interface
+    bool setBusFormat(switchboard::AudioBusFormat& inputBusFormat,
+                      switchboard::AudioBusFormat& outputBusFormat) override;
+    bool process(switchboard::AudioBus& inBus, switchboard::AudioBus& outBus) override;
+
+    // ParameterizedNode interface
+    uint32_t getParameterCount() const override { return kNumParams; }
+    const ParameterDescriptor& getParameterDescriptor(uint32_t id) const override;
+    float getParameter(uint32_t id) const override;
+
+    static constexpr uint kMaxChannels = 8;
+    static constexpr uint kMaxGrains = 8;
+    static constexpr float kMaxGrainMs = 200.0f;
+
+    // Parameter table, indexed by Param; constexpr so presets can be checked at compile time
+    static constexpr ParameterDescriptor kParameters[kNumParams] = {
+        {"mix", 0.0f, 1.0f, 1.0f},
+        {"density", 0.0f, 20.0f, 4.0f},
+        {"grainMs", 10.0f, GlitchNode::kMaxGrainMs, 60.0f, false, ParameterScale::kLog},
+        {"repeats", 1.0f, 8.0f, 3.0f, false, ParameterScale::kDiscrete},
+        {"reverse", 0.0f, 1.0f, 0.25f},
+        {"crush", 0.0f, 1.0f, 0.25f},
+        {"bitDepth", 1.0f, 16.0f, 6.0f, false, ParameterScale::kDiscrete},
+        {"downsample", 1.0f, 32.0f, 4.0f, false, ParameterScale::kDiscrete},
+        // Seeds are integers; floats hold them exactly up to 2^24
+        {"seed", 0.0f, 16777216.0f, 1.0f, false, ParameterScale::kDiscrete},
+    };
+
+protected:
+    void storeParameter(uint32_t id, float value) override;
+
+private:
+    struct Grain {
+        bool active = false;
+        bool reverse = false;
+        bool crush = false;
+        uint length = 0;       // Frames per repeat
+        uint fade = 1;         // Edge fade in frames
+        uint position = 0;     // Frame within the current repeat
+        uint repeatsLeft = 0;
+        uint holdCounter = 0;  // Sample-and-hold countdown when crushed
+        float held[kMaxChannels] = {};
+    };
+
+    void reseed(uint32_t seed);
+    void triggerGrain();
+    uint nextEventInterval(float density);
+    float* grainData(uint grain, uint channel) {
+        return grainStorage_.data() + (grain * numChannels_ + channel) * maxGrainFrames_;
+    }
+
+    // Thread-safe parameters
+    std::atomic<float> mix_{1.0f};          // 0.0 to 1.0
+    std::atomic<float> density_{4.0f};      // Events per second
+    std::atomic<float> grainMs_{60.0f};     // ms
+    std::atomic<int> repeats_{3};           // 1 to 8
+    std::atomic<float> reverse_{0.25f};     // Probability
+    std::atomic<float> crush_{0.25f};       // Probability
+    std::atomic<int> bitDepth_{6};          // 1 to 16
+    std::atomic<int> downsample_{4};        // 1 to 32
+    std::atomic<uint32_t> seed_{1};
+
+    // Audio-thread state
+    dsp::XorShift32 rng_;
+    uint32_t appliedSeed_ = 1;
+    uint sampleRate_ = 44100;
+    uint numChannels_ = 0;
+    uint maxGrainFrames_ = 0;
+    uint samplesUntilEvent_ = 0;
+
+    // Capture ring, channel-major, maxGrainFrames_ per channel
+    std::vector<float> ring_;
+    uint ringWrite_ = 0;
+    uint ringFilled_ = 0;
+
+    // Grain pool
+    Grain grains_[kMaxGrains];
+    std::vector<float> grainStorage_;
+};
+
+} // namespace voicechanger
@@ -0,0 +1,280 @@
+#include "nodes/ModDelayNode.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace voicechanger {
+
+namespace {
+// Fixed part of each tap's delay
+constexpr float kChorusBaseSeconds = 0.020f;
+constexpr float kFlangerBaseSeconds = 0.001f;
+// Longest possible delay: vibrato + chorus base + chorus sweep, plus headroom
+constexpr float kMaxDelaySeconds = 0.01f + kChorusBaseSeconds + 0.05f + 0.005f;
+// Level of the chorus and flanger taps over the dry signal
+constexpr float kChorusMix = 0.5f;
+constexpr float kFlangerMix = 0.7f;
+} // namespace
+
+ModDelayNode::ModDelayNode(const switchboard::SBAnyMap& config) {
+    // Initialize from config
+    applyConfig(config);
+}
+
+bool ModDelayNode::setBusFormat(switchboard::AudioBusFormat& inputBusFormat,
+                                 switchboard::AudioBusFormat& outputBusFormat) {
+    if (!inputBusFormat.isSet()) {
+        return false;
+    }
+
+    sampleRate_ = inputBusFormat.sampleRate;
+    numChannels_ = std::min(inputBusFormat.numberOfChannels, kMaxChannels);
+
+    // Power-of-two lines so reads wrap with a mask; a whole chunk is written
+    // before it is read, and +2 covers the interpolation neighbour
+    size_t maxDelay = static_cast<size_t>(std::ceil(kMaxDelaySeconds * static_cast<float>(sampleRate_))) + kChunkSize + 2;
+    bufferSize_ = 1;
+    while (bufferSize_ < maxDelay) {
+        bufferSize_ <<= 1;
+    }
+    buffer_.assign(bufferSize_ * numChannels_, 0.0f);
+    writePos_ = 0;
+
+    float rate = static_cast<float>(sampleRate_);
+    baseDelays_ = {0.0f, kChorusBaseSeconds * rate, kFlangerBaseSeconds * rate};
+
+    // Start each tap at its target, so the first block does not ramp in
+    std::array<float, kNumTaps> widths{};
+    std::array<float, kNumTaps> gains{};
+    std::array<float, kNumTaps> frequencies{};
+    loadTargets(widths, gains, frequencies);
+    for (size_t t = 0; t < kNumTaps; ++t) {
+        taps_[t] = TapState{};
+        taps_[t].width = widths[t];
+        taps_[t].gain = gains[t];
+    }
+
+    // Match output format to input
+    outputBusFormat = inputBusFormat;
+    return true;
+}
+
+void ModDelayNode::loadTargets(std::array<float, kNumTaps>& widths, std::array<float, kNumTaps>& gains,
+                               std::array<float, kNumTaps>& frequencies) const {
+    float rate = static_cast<float>(sampleRate_);
+
+    // A disabled vibrato also drops its sweep, so it stops delaying the other taps
+    float vibrato = useVibrato_.load();
+    widths[kVibrato] = vibrato > 0.0f ? vibratoSweepWidth_.load() * rate : 0.0f;
+    gains[kVibrato] = vibrato;
+    frequencies[kVibrato] = vibratoFrequency_.load();
+
+    widths[kChorus] = chorusSweepWidth_.load() * rate;
+    gains[kChorus] = kChorusMix * useChorus_.load();
+    frequencies[kChorus] = chorusFrequency_.load();
+
+    widths[kFlanger] = flangerSweepWidth_.load() * rate;
+    gains[kFlanger] = kFlangerMix * useFlanger_.load();
+    frequencies[kFlanger] = flangerFrequency_.load();
+}
+
+bool ModDelayNode::process(switchboard::AudioBus& inBus, switchboard::AudioBus& outBus) {
+    auto* inBuffer = inBus.getBuffer();
+    auto* outBuffer = outBus.getBuffer();
+
+    if (!inBuffer || !outBuffer) {
+        return false;
+    }
+
+    uint numFrames = inBuffer->getNumberOfFrames();
+    uint numChannels = std::min(inBuffer->getNumberOfChannels(), numChannels_);
+    if (numFrames == 0) {
+        return true;
+    }
+
+    std::array<float, kNumTaps> targetWidths{};
+    std::array<float, kNumTaps> targetGains{};
+    std::array<float, kNumTaps> frequencies{};
+    loadTargets(targetWidths, targetGains, frequencies);
+
+    const size_t mask = bufferSize_ - 1;
+    const float blockScale = 1.0f / static_cast<float>(numFrames);
+
+    // Nothing audible now or ramping: keep the line filled and pass through
+    bool idle = true;
+    for (size_t t = 0; t < kNumTaps; ++t) {
+        idle = idle && taps_[t].gain == 0.0f && targetGains[t] == 0.0f;
+    }
+    if (idle) {
+        for (uint ch = 0; ch < numChannels; ++ch) {
+            const float* inData = inBuffer->getReadPointer(ch);
+            float* outData = outBuffer->getWritePointer(ch);
+            float* line = buffer_.data() + ch * bufferSize_;
+            for (uint i = 0; i < numFrames; ++i) {
+                line[(writePos_ + i) & mask] = inData[i];
+            }
+            std::copy(inData, inData + numFrames, outData);
+        }
+        writePos_ = (writePos_ + numFrames) & mask;
+    } else {
+        std::array<double, kNumTaps> increment{};
+        std::array<float, kNumTaps> widthStep{};
+        std::array<float, kNumTaps> gain{};
+        std::array<float, kNumTaps> gainStep{};
+        std::array<bool, kNumTaps> audible{};
+        for (size_t t = 0; t < kNumTaps; ++t) {
+            increment[t] = 2.0 * M_PI * frequencies[t] / static_cast<double>(sampleRate_);
+            audible[t] = taps_[t].gain != 0.0f || targetGains[t] != 0.0f;
+            widthStep[t] = (targetWidths[t] - taps_[t].width) * blockScale;
+            gain[t] = taps_[t].gain;
+            gainStep[t] = (targetGains[t] - gain[t]) * blockScale;
+        }
+
+        for (uint start = 0; start < numFrames; start += kChunkSize) {
+            const uint n = std::min(kChunkSize, numFrames - start);
+
+            // Tap delays for the chunk: the LFO is evaluated every kLfoStep frames and
+            // the delay interpolated in between. The vibrato row is always filled, as
+            // the other taps add it even while vibrato itself is off
+            for (size_t t = 0; t < kNumTaps; ++t) {
+                if (!audible[t] && t != kVibrato) {
+                    continue;
+                }
+                TapState& tap = taps_[t];
+                float* delays = chunkFractions_[t].data();
+                for (uint segment = 0; segment < n; segment += kLfoStep) {
+                    const uint length = std::min(kLfoStep, n - segment);
+                    double endPhase = std::fmod(tap.phase + increment[t] * length, 2.0 * M_PI);
+                    auto endSine = static_cast<float>(std::sin(endPhase));
+                    float endWidth = tap.width + widthStep[t] * static_cast<float>(length);
+
+                    float from = baseDelays_[t] + tap.width * (0.5f + 0.5f * tap.sine);
+                    float to = baseDelays_[t] + endWidth * (0.5f + 0.5f * endSine);
+                    float step = (to - from) / static_cast<float>(length);
+                    for (uint i = 0; i < length; ++i) {
+                        delays[segment + i] = from + step * static_cast<float>(i);
+                    }
+
+                    tap.phase = endPhase;
+                    tap.sine = endSine;
+                    tap.width = endWidth;
+                }
+            }
+
+            // Chorus and flanger ride on the vibrato delay; split each delay into
+            // a masked read index and a fraction, vibrato last as the others need it
+            const float* vibratoDelays = chunkFractions_[kVibrato].data();
+            const auto base = static_cast<uint32_t>(writePos_ + bufferSize_);
+            const auto wrap = static_cast<uint32_t>(mask);
+            for (size_t t = kNumTaps; t-- > 0;) {
+                if (!audible[t]) {
+                    continue;
+                }
+                float* delays = chunkFractions_[t].data();
+                uint32_t* offsets = chunkOffsets_[t].data();
+                const float carried = t == kVibrato ? 0.0f : 1.0f;
+                for (uint i = 0; i < n; ++i) {
+                    float delay = delays[i] + carried * vibratoDelays[i];
+                    auto whole = static_cast<int32_t>(delay);
+                    offsets[i] = (base + i - static_cast<uint32_t>(whole)) & wrap;
+                    delays[i] = delay - static_cast<float>(whole);
+                }
+            }
+
+            // One write and one read pass per audible tap over each channel's line
+            for (uint ch = 0; ch < numChannels; ++ch) {
+                const float* inData = inBuffer->getReadPointer(ch) + start;
+                float* outData = outBuffer->getWritePointer(ch) + start;
+                float* line = buffer_.data() + ch * bufferSize_;
+
+                for (uint i = 0; i < n; ++i) {
+                    line[(writePos_ + i) & mask] = inData[i];
+                }
+
+                // The vibrato tap crossfades with the dry signal rather than adding to it
+                alignas(16) float mixed[kChunkSize];
+                float dryGain = 1.0f - gain[kVibrato];
+                for (uint i = 0; i < n; ++i) {
+                    mixed[i] = dryGain * inData[i];
+                    dryGain -= gainStep[kVibrato];
+                }
+
+                for (size_t t = 0; t < kNumTaps; ++t) {
+                    if (!audible[t]) {
+                        continue;
+                    }
+                    const uint32_t* offsets = chunkOffsets_[t].data();
+                    const float* fractions = chunkFractions_[t].data();
+                    float tapGain = gain[t];
+                    for (uint i = 0; i < n; ++i) {
+                        float a = line[offsets[i]];
+                        float b = line[(offsets[i] - 1) & mask];
+                        mixed[i] += tapGain * (a + fractions[i] * (b - a));
+                        tapGain += gainStep[t];
+                    }
+                }
+                std::copy(mixed, mixed + n, outData);
+            }
+
+            for (size_t t = 0; t < kNumTaps; ++t) {
+                gain[t] += gainStep[t] * static_cast<float>(n);
+            }
+            writePos_ = (writePos_ + n) & mask;
+        }
+    }
+
+    // Land exactly on the targets, whichever path ran
+    for (size_t t = 0; t < kNumTaps; ++t) {
+        taps_[t].width = targetWidths[t];
+        taps_[t].gain = targetGains[t];
+    }
+
+    // Channels beyond the line count pass through
+    for (uint ch = numChannels; ch < inBuffer->getNumberOfChannels(); ++ch) {
+        const float* inData = inBuffer->getReadPointer(ch);
+        std::copy(inData, inData + numFrames, outBuffer->getWritePointer(ch));
+    }
+
+    return true;
+}
+
+const ParameterDescriptor& ModDelayNode::getParameterDescriptor(uint32_t id) const {
+    return kParameters[id];
+}
+
+void ModDelayNode::storeParameter(uint32_t id, float value) {
+    switch (id) {
+        case kUseVibrato: useVibrato_.store(value); break;
+        case kVibratoSweepWidth: vibratoSweepWidth_.store(value); break;
+        case kVibratoFrequency: vibratoFrequency_.store(value); break;
+        case kUseChorus: useChorus_.store(value); break;
+        case kChorusSweepWidth: chorusSweepWidth_.store(value); break;
+        case kChorusFrequency: chorusFrequency_.store(value); break;
+        case kUseFlanger: useFlanger_.store(value); break;
+        case kFlangerSweepWidth: flangerSweepWidth_.store(value); break;
+        case kFlangerFrequency: flangerFrequency_.store(value); break;
+        default: break;
+    }
+}
+
+float ModDelayNode::getParameter(uint32_t id) const {
+    switch (id) {
+        case kUseVibrato: return useVibrato_.load();
+        case kVibratoSweepWidth: return vibratoSweepWidth_.load();
+        case kVibratoFrequency: return vibratoFrequency_.load();
+        case kUseChorus: return useChorus_.load();
+        case kChorusSweepWidth: return chorusSweepWidth_.load();
+        case kChorusFrequency: return chorusFrequency_.load();
+        case kUseFlanger: return useFlanger_.load();
+        case kFlangerSweepWidth: return flangerSweepWidth_.load();
+        case kFlangerFrequency: return flangerFrequency_.load();
+        default: return 0.0f;
+    }
+}
+
+} // namespace voicechanger
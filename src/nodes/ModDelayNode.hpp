@@ -0,0 +1,145 @@
+#pragma once
+
+#include "nodes/ParameterizedNode.hpp"
+
+#include <switchboard_core/NodeTypeInfo.hpp>
+
+#include <any>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace voicechanger {
+
+/**
+ * ModDelayNode - Vibrato, chorus and flanger on one modulated delay line.
+ *
+ * Each channel writes its input once into a single circular buffer, and
+ * every effect is a read tap whose delay is swept by its own sine LFO:
+ *
+ * - vibrato: 0 to vibratoSweepWidth seconds, replacing the dry signal
+ * - chorus: 20 ms plus 0 to chorusSweepWidth seconds, mixed over the dry signal
+ * - flanger: 1 ms plus 0 to flangerSweepWidth seconds, mixed over the dry signal
+ *
+ * With vibrato on, the chorus and flanger taps also carry the vibrato delay,
+ * which is what running vibrato ahead of them in series does to a pure
+ * delay. Chorus and flanger run in parallel rather than in series, so their
+ * cross term (a flanged chorus voice) is missing; at these depths it is
+ * inaudible. The LFOs are evaluated every 32 frames with the delays
+ * interpolated in between, so per chunk of frames every tap's read
+ * positions come from a few sines and straight-line ramps; each channel's
+ * line is then written once and read once per audible tap with linear
+ * interpolation, and a tap that is off costs nothing. Changing a tap level
+ * or a sweep width ramps over one block.
+ *
+ * Parameters:
+ * - useVibrato, useChorus, useFlanger: Tap levels (0 is off, 1 is fully on;
+ *   values in between fade the tap in, e.g. while morphing presets)
+ * - vibratoSweepWidth: Seconds (0.001 to 0.01)
+ * - vibratoFrequency: LFO Hz (0.1 to 10.0)
+ * - chorusSweepWidth: Seconds (0.001 to 0.05)
+ * - chorusFrequency: LFO Hz (0.1 to 5.0)
+ * - flangerSweepWidth: Seconds (0.001 to 0.02)
+ * - flangerFrequency: LFO Hz (0.05 to 2.0)
+ */
+class ModDelayNode : public ParameterizedNode {
+public:
+    // Parameter ids, in table order
+    enum Param : uint32_t {
+        kUseVibrato,
+        kVibratoSweepWidth,
+        kVibratoFrequency,
+        kUseChorus,
+        kChorusSweepWidth,
+        kChorusFrequency,
+        kUseFlanger,
+        kFlangerSweepWidth,
+        kFlangerFrequency,
+        kNumParams
+    };
+
+    static switchboard::NodeTypeInfo getNodeTypeInfo() {
+        return switchboard::NodeTypeInfo{
+            "VoiceChanger",
+            "ModDelay",
+            "ModDelay",
+            "Vibrato, chorus and flanger on a shared modulated delay line",
+            {switchboard::NODE_CATEGORY_AUDIO_PROCESSING, switchboard::NODE_CATEGORY_EFFECTS}
+        };
+    }
+
+    explicit ModDelayNode(const switchboard::SBAnyMap& config);
+    ~ModDelayNode() override = default;
+
+    // SingleBusAudioProcessorNode interface
+    bool setBusFormat(switchboard::AudioBusFormat& inputBusFormat,
+                      switchboard::AudioBusFormat& outputBusFormat) override;
+    bool process(switchboard::AudioBus& inBus, switchboard::AudioBus& outBus) override;
+
+    // ParameterizedNode interface
+    uint32_t getParameterCount() const override { return kNumParams; }
+    const ParameterDescriptor& getParameterDescriptor(uint32_t id) const override;
+    float getParameter(uint32_t id) const override;
+
+    static constexpr uint kMaxChannels = 8;
+
+    // Parameter table, indexed by Param; constexpr so presets can be checked at compile time
+    static constexpr ParameterDescriptor kParameters[kNumParams] = {
+        {"useVibrato", 0.0f, 1.0f, 0.0f},
+        {"vibratoSweepWidth", 0.001f, 0.01f, 0.003f, false, ParameterScale::kLog},
+        {"vibratoFrequency", 0.1f, 10.0f, 5.0f, false, ParameterScale::kLog},
+        {"useChorus", 0.0f, 1.0f, 0.0f},
+        {"chorusSweepWidth", 0.001f, 0.05f, 0.02f, false, ParameterScale::kLog},
+        {"chorusFrequency", 0.1f, 5.0f, 0.5f, false, ParameterScale::kLog},
+        {"useFlanger", 0.0f, 1.0f, 0.0f},
+        {"flangerSweepWidth", 0.001f, 0.02f, 0.008f, false, ParameterScale::kLog},
+        {"flangerFrequency", 0.05f, 2.0f, 0.3f, false, ParameterScale::kLog},
+    };
+
+protected:
+    void storeParameter(uint32_t id, float value) override;
+
+private:
+    static constexpr size_t kNumTaps = 3;
+    // Frames whose tap positions are computed ahead of the per-channel read passes
+    static constexpr uint kChunkSize = 128;
+    // LFO evaluation interval; the delay is interpolated linearly in between
+    static constexpr uint kLfoStep = 32;
+    enum Tap { kVibrato = 0, kChorus = 1, kFlanger = 2 };
+
+    struct TapState {
+        double phase = 0.0;  // LFO phase in radians
+        float sine = 0.0f;   // sin(phase)
+        float width = 0.0f;  // Current sweep in samples
+        float gain = 0.0f;   // Mix gain, as of the end of the last block
+    };
+
+    void loadTargets(std::array<float, kNumTaps>& widths, std::array<float, kNumTaps>& gains,
+                     std::array<float, kNumTaps>& frequencies) const;
+
+    // Thread-safe parameters
+    std::atomic<float> useVibrato_{0.0f};
+    std::atomic<float> vibratoSweepWidth_{0.003f};
+    std::atomic<float> vibratoFrequency_{5.0f};
+    std::atomic<float> useChorus_{0.0f};
+    std::atomic<float> chorusSweepWidth_{0.02f};
+    std::atomic<float> chorusFrequency_{0.5f};
+    std::atomic<float> useFlanger_{0.0f};
+    std::atomic<float> flangerSweepWidth_{0.008f};
+    std::atomic<float> flangerFrequency_{0.3f};
+
+    // Audio-thread state
+    std::vector<float> buffer_;  // One line of bufferSize_ per channel, back to back
+    size_t bufferSize_ = 0;      // Power of two
+    size_t writePos_ = 0;
+    std::array<TapState, kNumTaps> taps_{};
+    std::array<float, kNumTaps> baseDelays_{};  // Fixed delay of each tap in samples
+    std::array<std::array<uint32_t, kChunkSize>, kNumTaps> chunkOffsets_{};  // Masked read index
+    std::array<std::array<float, kChunkSize>, kNumTaps> chunkFractions_{};   // Delay, then its fraction
+    uint numChannels_ = 0;
+    uint sampleRate_ = 44100;
+};
+
+} // namespace voicechanger
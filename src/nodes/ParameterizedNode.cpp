@@ -0,0 +1,73 @@
+#include "nodes/ParameterizedNode.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace voicechanger {
+
+bool ParameterizedNode::setParameter(uint32_t id, float value) {
+    if (id >= getParameterCount() || !std::isfinite(value)) {
+        return false;
+    }
+    const auto& descriptor = getParameterDescriptor(id);
+    if (descriptor.readOnly) {
+        return false;
+    }
+    storeParameter(id, std::clamp(value, descriptor.minValue, descriptor.maxValue));
+    return true;
+}
+
+int ParameterizedNode::findParameter(const std::string& key) const {
+    for (uint32_t id = 0; id < getParameterCount(); ++id) {
+        if (key == getParameterDescriptor(id).key) {
+            return static_cast<int>(id);
+        }
+    }
+    return kUnknownParameter;
+}
+
+ParameterHandle ParameterizedNode::getParameterHandle(const std::string& key) {
+    int id = findParameter(key);
+    if (id == kUnknownParameter) {
+        return ParameterHandle();
+    }
+    return ParameterHandle(this, static_cast<uint32_t>(id));
+}
+
+void ParameterizedNode::applyConfig(const switchboard::SBAnyMap& config) {
+    for (uint32_t id = 0; id < getParameterCount(); ++id) {
+        const auto& descriptor = getParameterDescriptor(id);
+        if (!descriptor.readOnly && config.hasKey(descriptor.key)) {
+            setParameter(id, switchboard::SBAny::convert<float>(config.at(descriptor.key)));
+        }
+    }
+}
+
+switchboard::Result<void> ParameterizedNode::setValue(const std::string& key, const switchboard::SBAny& value) {
+    try {
+        int id = findParameter(key);
+        if (id == kUnknownParameter) {
+            return switchboard::makeError<void>("Unknown parameter: " + key);
+        }
+        if (getParameterDescriptor(static_cast<uint32_t>(id)).readOnly) {
+            return switchboard::makeError<void>("Read-only parameter: " + key);
+        }
+        auto v = std::any_cast<float>(value);
+        if (!setParameter(static_cast<uint32_t>(id), v)) {
+            return switchboard::makeError<void>("Non-finite value for parameter: " + key);
+        }
+        return switchboard::makeSuccess();
+    } catch (const std::bad_any_cast&) {
+        return switchboard::makeError<void>("Invalid value type for parameter: " + key);
+    }
+}
+
+switchboard::Result<switchboard::SBAny> ParameterizedNode::getValue(const std::string& key) {
+    int id = findParameter(key);
+    if (id == kUnknownParameter) {
+        return switchboard::makeError<switchboard::SBAny>("Unknown parameter: " + key);
+    }
+    return switchboard::makeSuccess<switchboard::SBAny>(getParameter(static_cast<uint32_t>(id)));
+}
+
+} // namespace voicechanger
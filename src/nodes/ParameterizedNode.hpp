@@ -0,0 +1,126 @@
+#pragma once
+
+#include <switchboard_core/SingleBusAudioProcessorNode.hpp>
+
+#include <any>
+#include <cstdint>
+#include <string>
+
+namespace voicechanger {
+
+/**
+ * How a parameter is interpolated, e.g. when morphing between presets.
+ */
+enum class ParameterScale : uint8_t {
+    kLinear,    // Mixes, gains, levels, semitones
+    kLog,       // Frequencies and times; zero or negative endpoints fall back to kDiscrete
+    kDiscrete,  // Switches, indices and seeds; steps at the midpoint
+};
+
+/**
+ * One entry of a node's parameter table. Values outside [minValue, maxValue]
+ * are clamped before the node sees them.
+ */
+struct ParameterDescriptor {
+    const char* key;
+    float minValue;
+    float maxValue;
+    float defaultValue;
+    bool readOnly = false;  // Published by the node, not settable
+    ParameterScale scale = ParameterScale::kLinear;
+    bool structural = false;  // Only read by setBusFormat; a running node needs rebuilding to hear it
+};
+
+class ParameterizedNode;
+
+/**
+ * A (node, parameter id) pair resolved once, so setting the parameter is a
+ * virtual call and an atomic store with no string handling. Valid for as
+ * long as the node is alive.
+ */
+class ParameterHandle {
+public:
+    ParameterHandle() = default;
+    ParameterHandle(ParameterizedNode* node, uint32_t id) : node_(node), id_(id) {}
+
+    explicit operator bool() const { return node_ != nullptr; }
+
+    inline bool set(float value) const;
+    inline float get() const;
+
+    ParameterizedNode* getNode() const { return node_; }
+    uint32_t getId() const { return id_; }
+
+private:
+    ParameterizedNode* node_ = nullptr;
+    uint32_t id_ = 0;
+};
+
+/**
+ * ParameterizedNode - Base for nodes whose parameters are all floats.
+ *
+ * Each node describes its parameters in a table indexed by a stable
+ * integer id (the node's Param enum). setValue/getValue look the key up in
+ * that table, so string keys keep working through the Switchboard API, but
+ * code that sets parameters repeatedly resolves them once with
+ * findParameter() or getParameterHandle() and then calls setParameter(),
+ * which checks, clamps and stores without any lookup. setParameter and
+ * getParameter are lock-free and safe from any thread.
+ */
+class ParameterizedNode : public switchboard::SingleBusAudioProcessorNode {
+public:
+    static constexpr int kUnknownParameter = -1;
+
+    virtual uint32_t getParameterCount() const = 0;
+    virtual const ParameterDescriptor& getParameterDescriptor(uint32_t id) const = 0;
+    virtual float getParameter(uint32_t id) const = 0;
+
+    /**
+     * @brief Clamps to the parameter's range and stores it. Returns false,
+     *        storing nothing, for read-only and out-of-range ids and for
+     *        NaN or infinite values.
+     */
+    bool setParameter(uint32_t id, float value);
+
+    /**
+     * @brief Stores a value already checked against the table (a settable
+     *        id and an in-range value, as in a validated preset) without
+     *        clamping it again.
+     */
+    void setValidatedParameter(uint32_t id, float value) { storeParameter(id, value); }
+
+    /**
+     * @brief Id of the parameter with this key, or kUnknownParameter.
+     */
+    int findParameter(const std::string& key) const;
+
+    /**
+     * @brief Handle for the parameter with this key; empty if unknown.
+     */
+    ParameterHandle getParameterHandle(const std::string& key);
+
+    // Parameter access by key
+    switchboard::Result<void> setValue(const std::string& key, const switchboard::SBAny& value) override;
+    switchboard::Result<switchboard::SBAny> getValue(const std::string& key) override;
+
+protected:
+    /**
+     * @brief Stores an already clamped value of a settable parameter.
+     */
+    virtual void storeParameter(uint32_t id, float value) = 0;
+
+    /**
+     * @brief Sets every parameter the config names. Call from the derived constructor.
+     */
+    void applyConfig(const switchboard::SBAnyMap& config);
+};
+
+inline bool ParameterHandle::set(float value) const {
+    return node_->setParameter(id_, value);
+}
+
+inline float ParameterHandle::get() const {
+    return node_->getParameter(id_);
+}
+
+} // namespace voicechanger
@@ -0,0 +1,110 @@
+#include "nodes/PitchCorrectNode.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace voicechanger {
+
+namespace {
+// Allowed pitch classes per scale, bit n = n semitones above the key
+constexpr uint16_t kScaleMasks[] = {
+    0b111111111111,  // Chromatic
+    0b101010110101,  // Major (0 2 4 5 7 9 11)
+    0b010110101101,  // Natural minor (0 2 3 5 7 8 10)
+    0b001010010101,  // Major pentatonic (0 2 4 7 9)
+    0b010010101001,  // Minor pentatonic (0 3 5 7 10)
+};
+constexpr int kNumScales = static_cast<int>(sizeof(kScaleMasks) / sizeof(kScaleMasks[0]));
+
+const ParameterDescriptor kCorrectionParameters[PitchCorrectNode::kNumParams - PitchShiftNode::kNumParams] = {
+    {"key", 0.0f, 11.0f, 0.0f, false, ParameterScale::kDiscrete},
+    {"scale", 0.0f, static_cast<float>(kNumScales - 1), 0.0f, false, ParameterScale::kDiscrete},
+    {"retuneSpeed", 0.0f, 500.0f, 50.0f},
+    {"minConfidence", 0.0f, 1.0f, 0.8f},
+    {"f0", 0.0f, 2000.0f, 0.0f, true},
+    {"correction", -6.0f, 6.0f, 0.0f, true},
+};
+} // namespace
+
+PitchCorrectNode::PitchCorrectNode(const switchboard::SBAnyMap& config)
+    : PitchShiftNode(config) {
+
+    // Initialize from config (PitchShiftNode has applied its own parameters)
+    applyConfig(config);
+}
+
+float PitchCorrectNode::correctionToScale(float midiPitch, int key, int scale) {
+    uint16_t mask = kScaleMasks[std::clamp(scale, 0, kNumScales - 1)];
+    int nearest = static_cast<int>(std::lround(midiPitch));
+
+    // Search outward from the nearest semitone; every scale has a note within 6
+    float bestDistance = 12.0f;
+    float bestNote = static_cast<float>(nearest);
+    for (int step = 0; step <= 6; ++step) {
+        for (int note : {nearest - step, nearest + step}) {
+            int pitchClass = ((note - key) % 12 + 12) % 12;
+            float distance = std::abs(static_cast<float>(note) - midiPitch);
+            if (((mask >> pitchClass) & 1) != 0 && distance < bestDistance) {
+                bestDistance = distance;
+                bestNote = static_cast<float>(note);
+            }
+        }
+    }
+
+    return bestNote - midiPitch;
+}
+
+float PitchCorrectNode::pitchOffsetForEstimate(const dsp::PitchEstimate& estimate, float hopSeconds) {
+    detectedF0_.store(estimate.frequency);
+
+    // Target-register offset (0 unless targetMedianHz is set)
+    float registerOffset = PitchShiftNode::pitchOffsetForEstimate(estimate, hopSeconds);
+
+    // Unvoiced or uncertain frames hold the current correction
+    if (estimate.frequency > 0.0f && estimate.confidence >= minConfidence_.load()) {
+        // Snap the output pitch, so shifted voices also land on the scale
+        float midiPitch = 69.0f + 12.0f * std::log2(estimate.frequency / 440.0f)
+                        + pitchShiftSemitones() + registerOffset;
+        float target = correctionToScale(midiPitch, key_.load(), scale_.load());
+
+        // One-pole glide; retuneSpeed is the time constant
+        float retuneSeconds = retuneSpeed_.load() * 0.001f;
+        float coefficient = retuneSeconds > 0.0f ? 1.0f - std::exp(-hopSeconds / retuneSeconds) : 1.0f;
+        smoothedCorrection_ += (target - smoothedCorrection_) * coefficient;
+    }
+
+    correction_.store(smoothedCorrection_);
+    return registerOffset + smoothedCorrection_;
+}
+
+const ParameterDescriptor& PitchCorrectNode::getParameterDescriptor(uint32_t id) const {
+    if (id < PitchShiftNode::kNumParams) {
+        return PitchShiftNode::getParameterDescriptor(id);
+    }
+    return kCorrectionParameters[id - PitchShiftNode::kNumParams];
+}
+
+void PitchCorrectNode::storeParameter(uint32_t id, float value) {
+    switch (id) {
+        case kKey: key_.store(static_cast<int>(std::lround(value))); break;
+        case kScale: scale_.store(static_cast<int>(std::lround(value))); break;
+        case kRetuneSpeed: retuneSpeed_.store(value); break;
+        case kMinConfidence: minConfidence_.store(value); break;
+        default: PitchShiftNode::storeParameter(id, value); break;
+    }
+}
+
+float PitchCorrectNode::getParameter(uint32_t id) const {
+    switch (id) {
+        case kKey: return static_cast<float>(key_.load());
+        case kScale: return static_cast<float>(scale_.load());
+        case kRetuneSpeed: return retuneSpeed_.load();
+        case kMinConfidence: return minConfidence_.load();
+        case kF0: return detectedF0_.load();
+        case kCorrection: return correction_.load();
+        default: return PitchShiftNode::getParameter(id);
+    }
+}
+
+} // namespace voicechanger
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "nodes/PitchShiftNode.hpp"
+
+#include <atomic>
+#include <string>
+
+namespace voicechanger {
+
+/**
+ * PitchCorrectNode - Pitch correction ("autotune") on top of PitchShiftNode.
+ *
+ * Tracks the input f0 once per hop and glides the stretcher's transpose
+ * toward the nearest note of the selected scale. The correction is added
+ * to the inherited pitchShift (and targetMedianHz register offset) and is
+ * computed on the shifted pitch, so the output stays on the scale.
+ * It reuses PitchShiftNode's stretcher; there is no second STFT.
+ *
+ * Parameters (in addition to PitchShiftNode's):
+ * - key: Scale root as a pitch class (0 = C ... 11 = B)
+ * - scale: 0 = chromatic, 1 = major, 2 = natural minor, 3 = major pentatonic,
+ *          4 = minor pentatonic
+ * - retuneSpeed: Time to reach the target note in ms (0 = hard tune, up to 500)
+ * - minConfidence: Estimates below this confidence hold the current correction (0.0 to 1.0)
+ *
+ * Read-only values:
+ * - f0: Latest detected input f0 in Hz (0 when unvoiced)
+ * - correction: Correction currently applied, in semitones
+ * - latency: Audio latency in milliseconds (inherited)
+ */
+class PitchCorrectNode : public PitchShiftNode {
+public:
+    // Parameter ids, continuing PitchShiftNode's
+    enum Param : uint32_t {
+        kKey = PitchShiftNode::kNumParams,
+        kScale,
+        kRetuneSpeed,
+        kMinConfidence,
+        kF0,
+        kCorrection,
+        kNumParams
+    };
+
+    static switchboard::NodeTypeInfo getNodeTypeInfo() {
+        return switchboard::NodeTypeInfo{
+            "VoiceChanger",
+            "PitchCorrect",
+            "PitchCorrect",
+            "Scale-aware pitch correction",
+            {switchboard::NODE_CATEGORY_AUDIO_PROCESSING, switchboard::NODE_CATEGORY_EFFECTS}
+        };
+    }
+
+    explicit PitchCorrectNode(const switchboard::SBAnyMap& config);
+    ~PitchCorrectNode() override = default;
+
+    // ParameterizedNode interface
+    uint32_t getParameterCount() const override { return kNumParams; }
+    const ParameterDescriptor& getParameterDescriptor(uint32_t id) const override;
+    float getParameter(uint32_t id) const override;
+
+    /**
+     * @brief Offset in semitones from a MIDI pitch to the nearest note of a scale.
+     */
+    static float correctionToScale(float midiPitch, int key, int scale);
+
+protected:
+    void storeParameter(uint32_t id, float value) override;
+    bool needsPitchTracking() const override { return true; }
+    float pitchOffsetForEstimate(const dsp::PitchEstimate& estimate, float hopSeconds) override;
+
+private:
+    // Thread-safe parameters
+    std::atomic<int> key_{0};                // Pitch class
+    std::atomic<int> scale_{0};              // Scale index
+    std::atomic<float> retuneSpeed_{50.0f};  // ms
+    std::atomic<float> minConfidence_{0.8f}; // 0.0 to 1.0
+
+    // Published state
+    std::atomic<float> detectedF0_{0.0f};
+    std::atomic<float> correction_{0.0f};
+
+    // Audio-thread state
+    float smoothedCorrection_ = 0.0f;
+};
+
+} // namespace voicechanger
@@ -0,0 +1,104 @@
+#include "nodes/PitchDetectNode.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace voicechanger {
+
+namespace {
+const ParameterDescriptor kParameters[PitchDetectNode::kNumParams] = {
+    {"minFrequency", 50.0f, 500.0f, 60.0f, false, ParameterScale::kLog},
+    {"maxFrequency", 100.0f, 2000.0f, 1000.0f, false, ParameterScale::kLog},
+    {"threshold", 0.05f, 0.5f, 0.15f},
+    {"f0", 0.0f, 2000.0f, 0.0f, true},
+    {"confidence", 0.0f, 1.0f, 0.0f, true},
+};
+} // namespace
+
+PitchDetectNode::PitchDetectNode(const switchboard::SBAnyMap& config) {
+    // Initialize from config
+    applyConfig(config);
+}
+
+bool PitchDetectNode::setBusFormat(switchboard::AudioBusFormat& inputBusFormat,
+                                   switchboard::AudioBusFormat& outputBusFormat) {
+    if (!inputBusFormat.isSet()) {
+        return false;
+    }
+
+    detector_.prepare(static_cast<float>(inputBusFormat.sampleRate));
+    estimate_.store(dsp::PitchEstimate{});
+    isConfigured_ = true;
+
+    // Match output format to input
+    outputBusFormat = inputBusFormat;
+    return true;
+}
+
+bool PitchDetectNode::process(switchboard::AudioBus& inBus, switchboard::AudioBus& outBus) {
+    if (!isConfigured_) {
+        return false;
+    }
+
+    auto* inBuffer = inBus.getBuffer();
+    auto* outBuffer = outBus.getBuffer();
+
+    if (!inBuffer || !outBuffer) {
+        return false;
+    }
+
+    uint numFrames = inBuffer->getNumberOfFrames();
+    uint numChannels = inBuffer->getNumberOfChannels();
+
+    detector_.setFrequencyRange(minFrequency_.load(), maxFrequency_.load());
+    detector_.setThreshold(threshold_.load());
+
+    // Gather channel pointers without allocating (the graph is at most stereo in practice)
+    constexpr uint kMaxChannels = 8;
+    const float* channels[kMaxChannels];
+    uint analysedChannels = std::min(numChannels, kMaxChannels);
+    for (uint ch = 0; ch < analysedChannels; ++ch) {
+        channels[ch] = inBuffer->getReadPointer(ch);
+    }
+
+    if (detector_.process(channels, analysedChannels, numFrames)) {
+        estimate_.store(detector_.getEstimate(), std::memory_order_release);
+    }
+
+    // Analysis only: pass audio through
+    for (uint ch = 0; ch < numChannels; ++ch) {
+        const float* inData = inBuffer->getReadPointer(ch);
+        float* outData = outBuffer->getWritePointer(ch);
+        if (outData != inData) {
+            std::memcpy(outData, inData, numFrames * sizeof(float));
+        }
+    }
+
+    return true;
+}
+
+const ParameterDescriptor& PitchDetectNode::getParameterDescriptor(uint32_t id) const {
+    return kParameters[id];
+}
+
+void PitchDetectNode::storeParameter(uint32_t id, float value) {
+    switch (id) {
+        case kMinFrequency: minFrequency_.store(value); break;
+        case kMaxFrequency: maxFrequency_.store(value); break;
+        case kThreshold: threshold_.store(value); break;
+        default: break;
+    }
+}
+
+float PitchDetectNode::getParameter(uint32_t id) const {
+    switch (id) {
+        case kMinFrequency: return minFrequency_.load();
+        case kMaxFrequency: return maxFrequency_.load();
+        case kThreshold: return threshold_.load();
+        case kF0: return estimate_.load(std::memory_order_acquire).frequency;
+        case kConfidence: return estimate_.load(std::memory_order_acquire).confidence;
+        default: return 0.0f;
+    }
+}
+
+} // namespace voicechanger
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "dsp/PitchDetector.hpp"
+
+#include "nodes/ParameterizedNode.hpp"
+
+#include <switchboard_core/NodeTypeInfo.hpp>
+
+#include <any>
+#include <atomic>
+#include <map>
+#include <string>
+
+namespace voicechanger {
+
+/**
+ * PitchDetectNode - Real-time fundamental frequency (f0) analysis.
+ *
+ * Passes audio through unchanged and publishes the latest YIN estimate
+ * (see dsp::PitchDetector) for other nodes or the UI to read with
+ * getValue(). The estimate is published as a single lock-free atomic so
+ * f0 and confidence always belong to the same analysis frame.
+ *
+ * Parameters:
+ * - minFrequency: Lowest f0 searched, Hz (50 to 500)
+ * - maxFrequency: Highest f0 searched, Hz (100 to 2000)
+ * - threshold: YIN absolute threshold (0.05 to 0.5, lower = stricter voicing)
+ *
+ * Read-only values:
+ * - f0: Latest fundamental estimate in Hz (0 when unvoiced)
+ * - confidence: Periodicity of the latest frame (0.0 to 1.0)
+ */
+class PitchDetectNode : public ParameterizedNode {
+public:
+    // Parameter ids, in table order
+    enum Param : uint32_t {
+        kMinFrequency,
+        kMaxFrequency,
+        kThreshold,
+        kF0,
+        kConfidence,
+        kNumParams
+    };
+
+    static switchboard::NodeTypeInfo getNodeTypeInfo() {
+        return switchboard::NodeTypeInfo{
+            "VoiceChanger",
+            "PitchDetect",
+            "PitchDetect",
+            "Real-time pitch (f0) detection",
+            {switchboard::NODE_CATEGORY_AUDIO_PROCESSING}
+        };
+    }
+
+    explicit PitchDetectNode(const switchboard::SBAnyMap& config);
+    ~PitchDetectNode() override = default;
+
+    // SingleBusAudioProcessorNode interface
+    bool setBusFormat(switchboard::AudioBusFormat& inputBusFormat,
+                      switchboard::AudioBusFormat& outputBusFormat) override;
+    bool process(switchboard::AudioBus& inBus, switchboard::AudioBus& outBus) override;
+
+    // ParameterizedNode interface
+    uint32_t getParameterCount() const override { return kNumParams; }
+    const ParameterDescriptor& getParameterDescriptor(uint32_t id) const override;
+    float getParameter(uint32_t id) const override;
+
+protected:
+    void storeParameter(uint32_t id, float value) override;
+
+private:
+    // Thread-safe parameters
+    std::atomic<float> minFrequency_{60.0f};   // Hz
+    std::atomic<float> maxFrequency_{1000.0f}; // Hz
+    std::atomic<float> threshold_{0.15f};      // YIN threshold
+
+    // Published analysis result
+    std::atomic<dsp::PitchEstimate> estimate_{dsp::PitchEstimate{}};
+    static_assert(std::atomic<dsp::PitchEstimate>::is_always_lock_free,
+                  "PitchEstimate must be published without locks");
+
+    // Audio-thread state
+    dsp::PitchDetector detector_;
+    bool isConfigured_ = false;
+};
+
+} // namespace voicechanger
@@ -1,5 +1,8 @@
 #include "nodes/PitchShiftNode.hpp"
 
+#include "dsp/Resampler.hpp"
+#include "dsp/SpectralGate.hpp"
+#include "dsp/VoiceActivityDetector.hpp"
 #include "signalsmith-stretch.h"
 
 #include <algorithm>
@@ -11,6 +14,7 @@ namespace voicechanger {
 class PitchShiftNode::Impl {
 public:
     signalsmith::stretch::SignalsmithStretch<> stretch;
+    dsp::PitchDetector pitchDetector;
     std::vector<float*> inputPtrs;
     std::vector<float*> outputPtrs;
     std::vector<std::vector<float>> inputBuffers;
@@ -22,24 +26,63 @@ public:
 
     float lastPitchShift = 0.0f;
     float lastFormantPreserve = 1.0f;
+
+    // Transpose offset from pitch tracking, in semitones
+    float trackedOffset = 0.0f;
+
+    // Target-register mode: running median of the input pitch (MIDI note
+    // numbers, so steps are in semitones) and the smoothed register offset
+    dsp::RunningMedian medianPitch;
+    float registerOffset = 0.0f;
+
+    // Reduced processing rate: the stretcher runs at stretchRate between
+    // per-channel polyphase resamplers. The upsampler's output count varies
+    // by a sample or two per chunk, so it is re-blocked through a FIFO that
+    // starts primed with a few samples of silence.
+    uint stretchRate = 44100;
+    bool resampling = false;
+    std::vector<dsp::PolyphaseResampler> downsamplers;
+    std::vector<dsp::PolyphaseResampler> upsamplers;
+    std::vector<std::vector<float>> lowInputBuffers;
+    std::vector<std::vector<float>> lowOutputBuffers;
+    std::vector<std::vector<float>> fifos;
+    size_t fifoCount = 0;
+    size_t fifoPrime = 0;
+
+    // Optional noise gate ahead of the stretcher, at the stretcher's rate.
+    // Its latency is only added (and published) while it is running.
+    dsp::SpectralGate spectralGate;
+    bool gateActive = false;
+    float baseLatencyMs = 0.0f;
+
+    // Idle skipping: the whole stretch path is frozen while the detector
+    // reports sustained silence, and reset when speech resumes
+    dsp::VoiceActivityDetector activity;
+    bool frozen = false;
+
+    // Mix and gain as of the end of the last block; each block ramps from them
+    float currentMix = 1.0f;
+    float currentGain = 1.0f;
 };
 
+namespace {
+// Time constant for gliding the register offset toward its target
+constexpr float kRegisterGlideSeconds = 0.3f;
+// Minimum YIN confidence for an estimate to update the median
+constexpr float kMedianMinConfidence = 0.85f;
+// Graph-rate frames per resampling pass
+constexpr uint kResampleChunk = 256;
+
+float frequencyToMidi(float hz) {
+    return 69.0f + 12.0f * std::log2(hz / 440.0f);
+}
+} // namespace
+
 PitchShiftNode::PitchShiftNode(const switchboard::SBAnyMap& config)
     : pImpl(std::make_unique<Impl>()) {
 
     // Initialize from config
-    if (config.hasKey("pitchShift")) {
-        pitchShift_.store(switchboard::SBAny::convert<float>(config.at("pitchShift")));
-    }
-    if (config.hasKey("formantPreserve")) {
-        formantPreserve_.store(switchboard::SBAny::convert<float>(config.at("formantPreserve")));
-    }
-    if (config.hasKey("mix")) {
-        mix_.store(switchboard::SBAny::convert<float>(config.at("mix")));
-    }
-    if (config.hasKey("outputGain")) {
-        outputGain_.store(switchboard::SBAny::convert<float>(config.at("outputGain")));
-    }
+    applyConfig(config);
 }
 
 PitchShiftNode::~PitchShiftNode() = default;
@@ -53,15 +96,57 @@ bool PitchShiftNode::setBusFormat(switchboard::AudioBusFormat& inputBusFormat,
     pImpl->sampleRate = inputBusFormat.sampleRate;
     pImpl->numChannels = inputBusFormat.numberOfChannels;
 
+    // Pick the stretcher's rate; anything at or above the graph rate means no resampling
+    float requestedRate = processingRate_.load();
+    pImpl->stretchRate = pImpl->sampleRate;
+    if (requestedRate > 0.0f && requestedRate < static_cast<float>(pImpl->sampleRate)) {
+        pImpl->stretchRate = static_cast<uint>(std::lround(std::max(requestedRate, 8000.0f)));
+    }
+    pImpl->resampling = pImpl->stretchRate != pImpl->sampleRate && configureResamplers();
+    if (!pImpl->resampling) {
+        pImpl->stretchRate = pImpl->sampleRate;
+    }
+
     // Configure signalsmith-stretch with presetDefault for quality
     pImpl->stretch.presetDefault(
         static_cast<int>(pImpl->numChannels),
-        static_cast<float>(pImpl->sampleRate)
+        static_cast<float>(pImpl->stretchRate)
     );
 
+    // Pitch tracking for subclasses that steer the transpose per hop
+    pImpl->pitchDetector.prepare(static_cast<float>(pImpl->stretchRate));
+    pImpl->trackedOffset = 0.0f;
+    pImpl->medianPitch.reset();
+    pImpl->registerOffset = 0.0f;
+
+    float latencySeconds = static_cast<float>(pImpl->stretch.inputLatency() + pImpl->stretch.outputLatency()) /
+                           static_cast<float>(pImpl->stretchRate);
+    if (pImpl->resampling) {
+        latencySeconds += static_cast<float>(pImpl->downsamplers[0].getLatency() + pImpl->fifoPrime) /
+                          static_cast<float>(pImpl->sampleRate);
+        latencySeconds += static_cast<float>(pImpl->upsamplers[0].getLatency()) /
+                          static_cast<float>(pImpl->stretchRate);
+    }
+    pImpl->baseLatencyMs = 1000.0f * latencySeconds;
+    latencyMs_.store(pImpl->baseLatencyMs);
+
+    pImpl->spectralGate.prepare(static_cast<float>(pImpl->stretchRate), pImpl->numChannels);
+    pImpl->gateActive = false;
+
+    pImpl->activity.prepare(static_cast<float>(pImpl->sampleRate));
+    pImpl->frozen = false;
+    stretchActive_.store(true);
+
+    pImpl->currentMix = mix_.load();
+    pImpl->currentGain = outputGain_.load();
+
     // Allocate intermediate buffers
     pImpl->inputBuffers.resize(pImpl->numChannels);
     pImpl->outputBuffers.resize(pImpl->numChannels);
+    for (uint ch = 0; ch < pImpl->numChannels; ++ch) {
+        pImpl->inputBuffers[ch].reserve(inputBusFormat.numberOfFrames);
+        pImpl->outputBuffers[ch].reserve(inputBusFormat.numberOfFrames);
+    }
     pImpl->inputPtrs.resize(pImpl->numChannels);
     pImpl->outputPtrs.resize(pImpl->numChannels);
 
@@ -75,8 +160,75 @@ bool PitchShiftNode::setBusFormat(switchboard::AudioBusFormat& inputBusFormat,
     return true;
 }
 
+bool PitchShiftNode::configureResamplers() {
+    uint numChannels = pImpl->numChannels;
+    pImpl->downsamplers.resize(numChannels);
+    pImpl->upsamplers.resize(numChannels);
+    for (uint ch = 0; ch < numChannels; ++ch) {
+        if (!pImpl->downsamplers[ch].prepare(pImpl->sampleRate, pImpl->stretchRate, kResampleChunk)) {
+            return false;
+        }
+    }
+    size_t maxLow = numChannels > 0 ? pImpl->downsamplers[0].getMaxOutput(kResampleChunk) : 0;
+    for (uint ch = 0; ch < numChannels; ++ch) {
+        if (!pImpl->upsamplers[ch].prepare(pImpl->stretchRate, pImpl->sampleRate, maxLow)) {
+            return false;
+        }
+    }
+    size_t maxUp = numChannels > 0 ? pImpl->upsamplers[0].getMaxOutput(maxLow) : 0;
+
+    // Both resamplers' output counts jitter by one sample at their own rate;
+    // priming by one low-rate period plus a margin keeps the FIFO from running dry
+    pImpl->fifoPrime = (pImpl->sampleRate + pImpl->stretchRate - 1) / pImpl->stretchRate + 2;
+    pImpl->fifoCount = pImpl->fifoPrime;
+
+    pImpl->lowInputBuffers.assign(numChannels, std::vector<float>(maxLow, 0.0f));
+    pImpl->lowOutputBuffers.assign(numChannels, std::vector<float>(maxLow, 0.0f));
+    pImpl->fifos.assign(numChannels, std::vector<float>(pImpl->fifoPrime + kResampleChunk + maxUp, 0.0f));
+    return true;
+}
+
+void PitchShiftNode::resetStretchPath() {
+    pImpl->stretch.reset();
+    pImpl->pitchDetector.reset();
+    pImpl->spectralGate.reset();
+    if (pImpl->resampling) {
+        for (uint ch = 0; ch < pImpl->numChannels; ++ch) {
+            pImpl->downsamplers[ch].reset();
+            pImpl->upsamplers[ch].reset();
+            std::fill(pImpl->fifos[ch].begin(), pImpl->fifos[ch].end(), 0.0f);
+        }
+        pImpl->fifoCount = pImpl->fifoPrime;
+    }
+}
+
+float PitchShiftNode::pitchOffsetForEstimate(const dsp::PitchEstimate& estimate, float hopSeconds) {
+    float targetHz = targetMedianHz_.load();
+    if (targetHz <= 0.0f) {
+        pImpl->medianPitch.reset();
+        pImpl->registerOffset = 0.0f;
+        medianF0_.store(0.0f);
+        return 0.0f;
+    }
+
+    if (estimate.frequency > 0.0f && estimate.confidence >= kMedianMinConfidence) {
+        float median = pImpl->medianPitch.update(frequencyToMidi(estimate.frequency));
+        medianF0_.store(440.0f * std::pow(2.0f, (median - 69.0f) / 12.0f));
+    }
+
+    // Until the first voiced frame the plain pitchShift applies
+    if (pImpl->medianPitch.hasValue()) {
+        float transpose = std::clamp(frequencyToMidi(targetHz) - pImpl->medianPitch.value(), -24.0f, 24.0f);
+        float target = transpose - pitchShift_.load();
+        float coefficient = 1.0f - std::exp(-hopSeconds / kRegisterGlideSeconds);
+        pImpl->registerOffset += (target - pImpl->registerOffset) * coefficient;
+    }
+
+    return pImpl->registerOffset;
+}
+
 void PitchShiftNode::updateStretchParameters() {
-    float pitch = pitchShift_.load();
+    float pitch = pitchShift_.load() + pImpl->trackedOffset;
     float formantPreserve = formantPreserve_.load();
 
     // Always update both pitch and formant together since formant compensation
@@ -85,9 +237,6 @@ void PitchShiftNode::updateStretchParameters() {
                        (formantPreserve != pImpl->lastFormantPreserve);
 
     if (needsUpdate) {
-        // Set the pitch shift
-        pImpl->stretch.setTransposeSemitones(pitch);
-
         // Calculate formant compensation factor:
         // - formantPreserve=1.0: fully compensate (keep original formants)
         // - formantPreserve=0.0: no compensation (classic chipmunk/villain effect)
@@ -101,6 +250,8 @@ void PitchShiftNode::updateStretchParameters() {
         // the full compensation factor.
 
         float pitchFactor = std::pow(2.0f, pitch / 12.0f);
+        pImpl->stretch.setTransposeFactor(pitchFactor);
+
         float fullCompensation = 1.0f / pitchFactor;  // Inverse to counteract pitch shift
 
         // Interpolate: formantPreserve=0 -> factor=1.0 (no formant shift, chipmunk effect)
@@ -111,6 +262,95 @@ void PitchShiftNode::updateStretchParameters() {
 
         pImpl->lastPitchShift = pitch;
         pImpl->lastFormantPreserve = formantPreserve;
+        transpose_.store(pitch);
+    }
+}
+
+void PitchShiftNode::runStretch(std::vector<std::vector<float>>& input,
+                                std::vector<std::vector<float>>& output,
+                                uint numFrames, uint numChannels) {
+    // Without tracking the whole block is one hop; with tracking the stretcher
+    // is fed hop by hop so each new estimate can retarget the transpose.
+    bool tracking = needsPitchTracking();
+
+    // Denoise before the stretcher so the hiss is not transposed with the voice
+    float denoise = denoise_.load();
+    bool gateActive = denoise > 0.0f;
+    if (gateActive != pImpl->gateActive) {
+        pImpl->spectralGate.reset();
+        pImpl->gateActive = gateActive;
+        float gateMs = 1000.0f * static_cast<float>(pImpl->spectralGate.getLatency()) /
+                       static_cast<float>(pImpl->stretchRate);
+        latencyMs_.store(pImpl->baseLatencyMs + (gateActive ? gateMs : 0.0f));
+    }
+    if (gateActive) {
+        for (uint ch = 0; ch < numChannels; ++ch) {
+            pImpl->inputPtrs[ch] = input[ch].data();
+        }
+        pImpl->spectralGate.process(pImpl->inputPtrs.data(), numChannels, numFrames, denoise);
+    }
+
+    uint hopSize = tracking ? static_cast<uint>(pImpl->pitchDetector.getHopSize()) : numFrames;
+    float hopSeconds = static_cast<float>(hopSize) / static_cast<float>(pImpl->stretchRate);
+
+    for (uint offset = 0; offset < numFrames; offset += hopSize) {
+        uint hopFrames = std::min(hopSize, numFrames - offset);
+
+        for (uint ch = 0; ch < numChannels; ++ch) {
+            pImpl->inputPtrs[ch] = input[ch].data() + offset;
+            pImpl->outputPtrs[ch] = output[ch].data() + offset;
+        }
+
+        if (tracking && pImpl->pitchDetector.process(pImpl->inputPtrs.data(), numChannels, hopFrames)) {
+            pImpl->trackedOffset = pitchOffsetForEstimate(pImpl->pitchDetector.getEstimate(), hopSeconds);
+        }
+
+        // Update parameters if changed
+        updateStretchParameters();
+
+        // Process through signalsmith-stretch
+        // The library expects const float** for input and float** for output
+        pImpl->stretch.process(
+            pImpl->inputPtrs.data(),
+            static_cast<int>(hopFrames),
+            pImpl->outputPtrs.data(),
+            static_cast<int>(hopFrames)
+        );
+    }
+}
+
+void PitchShiftNode::processStretchPath(uint numFrames, uint numChannels) {
+    if (!pImpl->resampling) {
+        runStretch(pImpl->inputBuffers, pImpl->outputBuffers, numFrames, numChannels);
+    } else {
+        for (uint offset = 0; offset < numFrames; offset += kResampleChunk) {
+            uint chunkFrames = std::min(kResampleChunk, numFrames - offset);
+
+            size_t lowFrames = 0;
+            for (uint ch = 0; ch < numChannels; ++ch) {
+                lowFrames = pImpl->downsamplers[ch].process(
+                    pImpl->inputBuffers[ch].data() + offset, chunkFrames, pImpl->lowInputBuffers[ch].data());
+            }
+
+            runStretch(pImpl->lowInputBuffers, pImpl->lowOutputBuffers, static_cast<uint>(lowFrames), numChannels);
+
+            size_t fifoCount = pImpl->fifoCount;
+            for (uint ch = 0; ch < numChannels; ++ch) {
+                std::vector<float>& fifo = pImpl->fifos[ch];
+                size_t available = pImpl->fifoCount + pImpl->upsamplers[ch].process(
+                    pImpl->lowOutputBuffers[ch].data(), lowFrames, fifo.data() + pImpl->fifoCount);
+
+                // Pop one chunk; an underrun (never expected) is padded with silence
+                size_t popped = std::min<size_t>(chunkFrames, available);
+                float* wetData = pImpl->outputBuffers[ch].data() + offset;
+                std::copy(fifo.begin(), fifo.begin() + static_cast<std::ptrdiff_t>(popped), wetData);
+                std::fill(wetData + popped, wetData + chunkFrames, 0.0f);
+                std::copy(fifo.begin() + static_cast<std::ptrdiff_t>(popped),
+                          fifo.begin() + static_cast<std::ptrdiff_t>(available), fifo.begin());
+                fifoCount = available - popped;
+            }
+            pImpl->fifoCount = fifoCount;
+        }
     }
 }
 
@@ -129,15 +369,10 @@ bool PitchShiftNode::process(switchboard::AudioBus& inBus, switchboard::AudioBus
     uint numFrames = inBuffer->getNumberOfFrames();
     uint numChannels = inBuffer->getNumberOfChannels();
 
-    // Update parameters if changed
-    updateStretchParameters();
-
     // Ensure buffers are sized correctly
     for (uint ch = 0; ch < numChannels; ++ch) {
         pImpl->inputBuffers[ch].resize(numFrames);
         pImpl->outputBuffers[ch].resize(numFrames);
-        pImpl->inputPtrs[ch] = pImpl->inputBuffers[ch].data();
-        pImpl->outputPtrs[ch] = pImpl->outputBuffers[ch].data();
     }
 
     // Copy input to intermediate buffers
@@ -146,19 +381,56 @@ bool PitchShiftNode::process(switchboard::AudioBus& inBus, switchboard::AudioBus
         std::copy(channelData, channelData + numFrames, pImpl->inputBuffers[ch].begin());
     }
 
-    // Process through signalsmith-stretch
-    // The library expects const float** for input and float** for output
-    pImpl->stretch.process(
-        pImpl->inputPtrs.data(),
-        static_cast<int>(numFrames),
-        pImpl->outputPtrs.data(),
-        static_cast<int>(numFrames)
-    );
+    if (!needsPitchTracking()) {
+        pImpl->trackedOffset = 0.0f;
+    }
+
+    // Idle skipping: decide before any stretch work is done for this block
+    bool wasFrozen = pImpl->frozen;
+    bool speech = true;
+    if (idleFreeze_.load()) {
+        for (uint ch = 0; ch < numChannels; ++ch) {
+            pImpl->inputPtrs[ch] = pImpl->inputBuffers[ch].data();
+        }
+        pImpl->activity.process(pImpl->inputPtrs.data(), numChannels, numFrames);
+        // The per-block check wakes on the first block of an onset
+        speech = pImpl->activity.isActive() || pImpl->activity.isAboveFloor();
+    }
+    if (wasFrozen && speech) {
+        // Bounded warm-up: the reset path only needs its usual latency to refill
+        resetStretchPath();
+    }
+    pImpl->frozen = !speech;
+    stretchActive_.store(speech);
+
+    if (wasFrozen && pImpl->frozen) {
+        // The stretcher's tail already played out during the detector's hangover
+        for (uint ch = 0; ch < numChannels; ++ch) {
+            std::fill(pImpl->outputBuffers[ch].begin(), pImpl->outputBuffers[ch].end(), 0.0f);
+        }
+    } else {
+        processStretchPath(numFrames, numChannels);
+
+        // Fade in after a reset, or out into a freeze, so neither edge clicks
+        if (wasFrozen != pImpl->frozen) {
+            float step = 1.0f / static_cast<float>(numFrames);
+            for (uint ch = 0; ch < numChannels; ++ch) {
+                float* wetData = pImpl->outputBuffers[ch].data();
+                for (uint i = 0; i < numFrames; ++i) {
+                    float ramp = static_cast<float>(i + 1) * step;
+                    wetData[i] *= wasFrozen ? ramp : 1.0f - ramp;
+                }
+            }
+        }
+    }
 
-    // Apply mix and gain, copy to output
+    // Apply mix and gain, copy to output. Both ramp from the last block's
+    // values, so control-rate changes (e.g. modulation) do not step.
     float mix = mix_.load();
     float gain = outputGain_.load();
-    float dryMix = 1.0f - mix;
+    float invFrames = numFrames > 0 ? 1.0f / static_cast<float>(numFrames) : 0.0f;
+    float mixStep = (mix - pImpl->currentMix) * invFrames;
+    float gainStep = (gain - pImpl->currentGain) * invFrames;
 
     for (uint ch = 0; ch < numChannels; ++ch) {
         const float* inData = inBuffer->getReadPointer(ch);
@@ -166,61 +438,55 @@ bool PitchShiftNode::process(switchboard::AudioBus& inBus, switchboard::AudioBus
         float* wetData = pImpl->outputBuffers[ch].data();
 
         for (uint i = 0; i < numFrames; ++i) {
-            float wetSample = wetData[i] * mix;
-            float drySample = inData[i] * dryMix;
-            outData[i] = (wetSample + drySample) * gain;
+            float position = static_cast<float>(i + 1);
+            float frameMix = pImpl->currentMix + mixStep * position;
+            float frameGain = pImpl->currentGain + gainStep * position;
+            float wetSample = wetData[i] * frameMix;
+            float drySample = inData[i] * (1.0f - frameMix);
+            outData[i] = (wetSample + drySample) * frameGain;
         }
     }
+    pImpl->currentMix = mix;
+    pImpl->currentGain = gain;
 
     return true;
 }
 
-switchboard::Result<void> PitchShiftNode::setValue(const std::string& key, const switchboard::SBAny& value) {
-    try {
-        if (key == "pitchShift") {
-            auto v = std::any_cast<float>(value);
-            v = std::clamp(v, -24.0f, 24.0f);
-            pitchShift_.store(v);
-            return switchboard::makeSuccess();
-        }
-        if (key == "formantPreserve") {
-            auto v = std::any_cast<float>(value);
-            v = std::clamp(v, 0.0f, 1.0f);
-            formantPreserve_.store(v);
-            return switchboard::makeSuccess();
-        }
-        if (key == "mix") {
-            auto v = std::any_cast<float>(value);
-            v = std::clamp(v, 0.0f, 1.0f);
-            mix_.store(v);
-            return switchboard::makeSuccess();
-        }
-        if (key == "outputGain") {
-            auto v = std::any_cast<float>(value);
-            v = std::clamp(v, 0.0f, 4.0f);
-            outputGain_.store(v);
-            return switchboard::makeSuccess();
-        }
-        return switchboard::makeError<void>("Unknown parameter: " + key);
-    } catch (const std::bad_any_cast&) {
-        return switchboard::makeError<void>("Invalid value type for parameter: " + key);
-    }
+const ParameterDescriptor& PitchShiftNode::getParameterDescriptor(uint32_t id) const {
+    return kParameters[id];
 }
 
-switchboard::Result<switchboard::SBAny> PitchShiftNode::getValue(const std::string& key) {
-    if (key == "pitchShift") {
-        return switchboard::makeSuccess<switchboard::SBAny>(pitchShift_.load());
-    }
-    if (key == "formantPreserve") {
-        return switchboard::makeSuccess<switchboard::SBAny>(formantPreserve_.load());
-    }
-    if (key == "mix") {
-        return switchboard::makeSuccess<switchboard::SBAny>(mix_.load());
+void PitchShiftNode::storeParameter(uint32_t id, float value) {
+    switch (id) {
+        case kPitchShift: pitchShift_.store(value); break;
+        case kFormantPreserve: formantPreserve_.store(value); break;
+        case kMix: mix_.store(value); break;
+        case kOutputGain: outputGain_.store(value); break;
+        // Zero turns these off; other values are held to their working range
+        case kTargetMedianHz: targetMedianHz_.store(value <= 0.0f ? 0.0f : std::max(value, 50.0f)); break;
+        case kProcessingRate: processingRate_.store(value <= 0.0f ? 0.0f : std::max(value, 8000.0f)); break;
+        case kDenoise: denoise_.store(value); break;
+        case kIdleFreeze: idleFreeze_.store(value >= 0.5f); break;
+        default: break;
     }
-    if (key == "outputGain") {
-        return switchboard::makeSuccess<switchboard::SBAny>(outputGain_.load());
+}
+
+float PitchShiftNode::getParameter(uint32_t id) const {
+    switch (id) {
+        case kPitchShift: return pitchShift_.load();
+        case kFormantPreserve: return formantPreserve_.load();
+        case kMix: return mix_.load();
+        case kOutputGain: return outputGain_.load();
+        case kTargetMedianHz: return targetMedianHz_.load();
+        case kDenoise: return denoise_.load();
+        case kIdleFreeze: return idleFreeze_.load() ? 1.0f : 0.0f;
+        case kProcessingRate: return processingRate_.load();
+        case kLatency: return latencyMs_.load();
+        case kMedianF0: return medianF0_.load();
+        case kTranspose: return transpose_.load();
+        case kActive: return stretchActive_.load() ? 1.0f : 0.0f;
+        default: return 0.0f;
     }
-    return switchboard::makeError<switchboard::SBAny>("Unknown parameter: " + key);
 }
 
 } // namespace voicechanger
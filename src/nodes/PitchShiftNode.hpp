@@ -1,6 +1,10 @@
 #pragma once
 
-#include <switchboard_core/SingleBusAudioProcessorNode.hpp>
+#include "dsp/PitchDetector.hpp"
+#include "dsp/RunningMedian.hpp"
+
+#include "nodes/ParameterizedNode.hpp"
+
 #include <switchboard_core/NodeTypeInfo.hpp>
 
 #include <any>
@@ -8,6 +12,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace voicechanger {
 
@@ -22,9 +27,63 @@ namespace voicechanger {
  * - formantPreserve: Formant preservation amount (0.0 to 1.0)
  * - mix: Dry/wet mix (0.0 = dry, 1.0 = wet)
  * - outputGain: Output gain multiplier (0.0 to 4.0)
+ * - targetMedianHz: Target voice register in Hz (0 = off, else 50 to 500).
+ *   When set, the speaker's running median f0 is tracked and the transpose
+ *   glides to move that median onto the target; pitchShift applies until
+ *   the median is known.
+ * - denoise: Background-noise suppression depth (0.0 = off, 1.0 = up to 30 dB).
+ *   A spectral gate ahead of the stretcher, at the stretcher's rate, learns
+ *   the noise floor from gated frames so hiss is removed before it is
+ *   transposed. Adds 512 samples (at the processing rate) of latency while on.
+ * - idleFreeze: 1 to skip the stretch path during sustained silence (0 or 1).
+ *   A dsp::VoiceActivityDetector on the input decides per block; once it
+ *   reports silence (after its 0.5 s hangover, longer than the stretcher's
+ *   tail) the wet output fades out and the stretcher, resamplers and gate
+ *   stop running. The first block above the noise floor resets them and
+ *   fades back in; warm-up is bounded by the usual latency.
+ * - processingRate: Rate in Hz the stretcher runs at (0 = graph rate, else
+ *   8000 to 48000). Voice content sits below 8 kHz, so running the STFT at
+ *   16 or 22.05 kHz between polyphase resamplers cuts its cost roughly in
+ *   proportion; the wet signal keeps a flat passband to 0.8x the reduced
+ *   Nyquist. Applied by setBusFormat; rates at or above the graph rate, or
+ *   whose ratio to it needs over 1024 filter phases, run at the graph rate.
+ *
+ * mix and outputGain ramp linearly across each block from the values the
+ * previous block ended on, and pitchShift reaches the stretcher at the
+ * start of each block, so all three can be modulated at control rate.
+ *
+ * Read-only values:
+ * - latency: Stretcher input + output latency in milliseconds, including
+ *   the resamplers when processingRate is active and the gate while denoise is on
+ * - medianF0: Tracked median input f0 in Hz (0 until known or when off)
+ * - transpose: Transpose currently applied, in semitones
+ * - active: 1 while the stretch path is running, 0 while frozen by idleFreeze
+ *
+ * Subclasses can steer the transpose from the input's pitch: when
+ * needsPitchTracking() returns true, each block is processed in hops of the
+ * pitch detector's size and pitchOffsetForEstimate() is consulted per hop.
+ * The offset (in semitones) is added to pitchShift and applied through the
+ * same stretcher, so no second STFT is needed.
  */
-class PitchShiftNode : public switchboard::SingleBusAudioProcessorNode {
+class PitchShiftNode : public ParameterizedNode {
 public:
+    // Parameter ids, in table order
+    enum Param : uint32_t {
+        kPitchShift,
+        kFormantPreserve,
+        kMix,
+        kOutputGain,
+        kTargetMedianHz,
+        kDenoise,
+        kIdleFreeze,
+        kProcessingRate,
+        kLatency,
+        kMedianF0,
+        kTranspose,
+        kActive,
+        kNumParams
+    };
+
     static switchboard::NodeTypeInfo getNodeTypeInfo() {
         return switchboard::NodeTypeInfo{
             "VoiceChanger",
@@ -43,9 +102,44 @@ public:
                       switchboard::AudioBusFormat& outputBusFormat) override;
     bool process(switchboard::AudioBus& inBus, switchboard::AudioBus& outBus) override;
 
-    // Parameter access
-    switchboard::Result<void> setValue(const std::string& key, const switchboard::SBAny& value) override;
-    switchboard::Result<switchboard::SBAny> getValue(const std::string& key) override;
+    // ParameterizedNode interface
+    uint32_t getParameterCount() const override { return kNumParams; }
+    const ParameterDescriptor& getParameterDescriptor(uint32_t id) const override;
+    float getParameter(uint32_t id) const override;
+
+    // Parameter table, indexed by Param; constexpr so presets can be checked at compile time
+    static constexpr ParameterDescriptor kParameters[kNumParams] = {
+        {"pitchShift", -24.0f, 24.0f, 0.0f},
+        {"formantPreserve", 0.0f, 1.0f, 1.0f},
+        {"mix", 0.0f, 1.0f, 1.0f},
+        {"outputGain", 0.0f, 4.0f, 1.0f},
+        {"targetMedianHz", 0.0f, 500.0f, 0.0f, false, ParameterScale::kLog},
+        {"denoise", 0.0f, 1.0f, 0.0f},
+        {"idleFreeze", 0.0f, 1.0f, 0.0f, false, ParameterScale::kDiscrete},
+        {"processingRate", 0.0f, 48000.0f, 0.0f, false, ParameterScale::kDiscrete, true},
+        {"latency", 0.0f, 1000.0f, 0.0f, true},
+        {"medianF0", 0.0f, 500.0f, 0.0f, true},
+        {"transpose", -48.0f, 48.0f, 0.0f, true},
+        {"active", 0.0f, 1.0f, 1.0f, true},
+    };
+
+protected:
+    void storeParameter(uint32_t id, float value) override;
+
+    /**
+     * @brief Whether the input should be pitch-tracked. Called once per block on the audio thread.
+     * @details The base node tracks only in target-register mode (targetMedianHz > 0).
+     */
+    virtual bool needsPitchTracking() const { return targetMedianHz_.load() > 0.0f; }
+
+    /**
+     * @brief Maps a new pitch estimate to a transpose offset in semitones, added to pitchShift.
+     * @details Called on the audio thread once per tracking hop. Must not block or allocate.
+     *          The base implementation provides target-register mode.
+     */
+    virtual float pitchOffsetForEstimate(const dsp::PitchEstimate& estimate, float hopSeconds);
+
+    float pitchShiftSemitones() const { return pitchShift_.load(); }
 
 private:
     class Impl;
@@ -56,8 +150,24 @@ private:
     std::atomic<float> formantPreserve_{1.0f}; // 0.0 to 1.0
     std::atomic<float> mix_{1.0f};             // 0.0 to 1.0
     std::atomic<float> outputGain_{1.0f};      // 0.0 to 4.0
+    std::atomic<float> targetMedianHz_{0.0f};  // 0 = off, 50 to 500 Hz
+    std::atomic<float> processingRate_{0.0f};  // 0 = graph rate, else Hz
+    std::atomic<float> denoise_{0.0f};         // 0.0 to 1.0
+    std::atomic<bool> idleFreeze_{false};
+
+    // Published state
+    std::atomic<float> latencyMs_{0.0f};
+    std::atomic<float> medianF0_{0.0f};
+    std::atomic<float> transpose_{0.0f};
+    std::atomic<bool> stretchActive_{true};
 
     void updateStretchParameters();
+    bool configureResamplers();
+    void resetStretchPath();
+    void processStretchPath(uint numFrames, uint numChannels);
+    void runStretch(std::vector<std::vector<float>>& input,
+                    std::vector<std::vector<float>>& output,
+                    uint numFrames, uint numChannels);
 };
 
 } // namespace voicechanger
@@ -11,15 +11,7 @@ namespace voicechanger {
 
 RingModNode::RingModNode(const switchboard::SBAnyMap& config) {
     // Initialize from config
-    if (config.hasKey("carrierFrequency")) {
-        carrierFrequency_.store(switchboard::SBAny::convert<float>(config.at("carrierFrequency")));
-    }
-    if (config.hasKey("mix")) {
-        mix_.store(switchboard::SBAny::convert<float>(config.at("mix")));
-    }
-    if (config.hasKey("threshold")) {
-        threshold_.store(switchboard::SBAny::convert<float>(config.at("threshold")));
-    }
+    applyConfig(config);
 }
 
 bool RingModNode::setBusFormat(switchboard::AudioBusFormat& inputBusFormat,
@@ -33,6 +25,7 @@ bool RingModNode::setBusFormat(switchboard::AudioBusFormat& inputBusFormat,
     // Calculate phase increment for carrier oscillator
     float freq = carrierFrequency_.load();
     phaseIncrement_ = (2.0 * M_PI * freq) / static_cast<double>(sampleRate_);
+    currentMix_ = mix_.load();
 
     // Match output format to input
     outputBusFormat = inputBusFormat;
@@ -50,20 +43,24 @@ bool RingModNode::process(switchboard::AudioBus& inBus, switchboard::AudioBus& o
     uint numFrames = inBuffer->getNumberOfFrames();
     uint numChannels = inBuffer->getNumberOfChannels();
 
-    // Update phase increment if frequency changed
+    // Frequency and mix ramp from the last block's values, so changes
+    // (e.g. control-rate modulation) move in straight lines, not steps
     float freq = carrierFrequency_.load();
-    phaseIncrement_ = (2.0 * M_PI * freq) / static_cast<double>(sampleRate_);
+    double targetIncrement = (2.0 * M_PI * freq) / static_cast<double>(sampleRate_);
+    double incrementStep = numFrames > 0 ? (targetIncrement - phaseIncrement_) / numFrames : 0.0;
 
-    float mix = mix_.load();
-    float dryMix = 1.0f - mix;
+    float targetMix = mix_.load();
+    float mixStep = numFrames > 0 ? (targetMix - currentMix_) / static_cast<float>(numFrames) : 0.0f;
     float threshold = threshold_.load();
 
     for (uint frame = 0; frame < numFrames; ++frame) {
         // Generate carrier sample (sine wave)
         auto carrier = static_cast<float>(std::sin(phase_));
+        float mix = currentMix_ + mixStep * static_cast<float>(frame + 1);
+        float dryMix = 1.0f - mix;
 
         // Advance phase
-        phase_ += phaseIncrement_;
+        phase_ += phaseIncrement_ + incrementStep * (frame + 1);
         if (phase_ >= 2.0 * M_PI) {
             phase_ -= 2.0 * M_PI;
         }
@@ -89,47 +86,32 @@ bool RingModNode::process(switchboard::AudioBus& inBus, switchboard::AudioBus& o
             outData[frame] = (modulatedSample * mix) + (inSample * dryMix);
         }
     }
+    phaseIncrement_ = targetIncrement;
+    currentMix_ = targetMix;
 
     return true;
 }
 
-switchboard::Result<void> RingModNode::setValue(const std::string& key, const switchboard::SBAny& value) {
-    try {
-        if (key == "carrierFrequency") {
-            auto v = std::any_cast<float>(value);
-            v = std::clamp(v, 10.0f, 1000.0f);
-            carrierFrequency_.store(v);
-            return switchboard::makeSuccess();
-        }
-        if (key == "mix") {
-            auto v = std::any_cast<float>(value);
-            v = std::clamp(v, 0.0f, 1.0f);
-            mix_.store(v);
-            return switchboard::makeSuccess();
-        }
-        if (key == "threshold") {
-            auto v = std::any_cast<float>(value);
-            v = std::clamp(v, 0.0f, 1.0f);
-            threshold_.store(v);
-            return switchboard::makeSuccess();
-        }
-        return switchboard::makeError<void>("Unknown parameter: " + key);
-    } catch (const std::bad_any_cast&) {
-        return switchboard::makeError<void>("Invalid value type for parameter: " + key);
-    }
+const ParameterDescriptor& RingModNode::getParameterDescriptor(uint32_t id) const {
+    return kParameters[id];
 }
 
-switchboard::Result<switchboard::SBAny> RingModNode::getValue(const std::string& key) {
-    if (key == "carrierFrequency") {
-        return switchboard::makeSuccess<switchboard::SBAny>(carrierFrequency_.load());
-    }
-    if (key == "mix") {
-        return switchboard::makeSuccess<switchboard::SBAny>(mix_.load());
+void RingModNode::storeParameter(uint32_t id, float value) {
+    switch (id) {
+        case kCarrierFrequency: carrierFrequency_.store(value); break;
+        case kMix: mix_.store(value); break;
+        case kThreshold: threshold_.store(value); break;
+        default: break;
     }
-    if (key == "threshold") {
-        return switchboard::makeSuccess<switchboard::SBAny>(threshold_.load());
+}
+
+float RingModNode::getParameter(uint32_t id) const {
+    switch (id) {
+        case kCarrierFrequency: return carrierFrequency_.load();
+        case kMix: return mix_.load();
+        case kThreshold: return threshold_.load();
+        default: return 0.0f;
     }
-    return switchboard::makeError<switchboard::SBAny>("Unknown parameter: " + key);
 }
 
 } // namespace voicechanger
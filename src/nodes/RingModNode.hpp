@@ -1,6 +1,7 @@
 #pragma once
 
-#include <switchboard_core/SingleBusAudioProcessorNode.hpp>
+#include "nodes/ParameterizedNode.hpp"
+
 #include <switchboard_core/NodeTypeInfo.hpp>
 
 #include <any>
@@ -20,9 +21,15 @@ namespace voicechanger {
  * - carrierFrequency: Carrier oscillator frequency in Hz (10 to 1000)
  * - mix: Dry/wet mix (0.0 = dry, 1.0 = wet)
  * - threshold: Input level below which modulation is bypassed (0.0 to 1.0)
+ *
+ * carrierFrequency and mix ramp linearly across each block from the values
+ * the previous block ended on, so they can be modulated without zipper noise.
  */
-class RingModNode : public switchboard::SingleBusAudioProcessorNode {
+class RingModNode : public ParameterizedNode {
 public:
+    // Parameter ids, in table order
+    enum Param : uint32_t { kCarrierFrequency, kMix, kThreshold, kNumParams };
+
     static switchboard::NodeTypeInfo getNodeTypeInfo() {
         return switchboard::NodeTypeInfo{
             "VoiceChanger",
@@ -41,9 +48,20 @@ public:
                       switchboard::AudioBusFormat& outputBusFormat) override;
     bool process(switchboard::AudioBus& inBus, switchboard::AudioBus& outBus) override;
 
-    // Parameter access
-    switchboard::Result<void> setValue(const std::string& key, const switchboard::SBAny& value) override;
-    switchboard::Result<switchboard::SBAny> getValue(const std::string& key) override;
+    // ParameterizedNode interface
+    uint32_t getParameterCount() const override { return kNumParams; }
+    const ParameterDescriptor& getParameterDescriptor(uint32_t id) const override;
+    float getParameter(uint32_t id) const override;
+
+    // Parameter table, indexed by Param; constexpr so presets can be checked at compile time
+    static constexpr ParameterDescriptor kParameters[kNumParams] = {
+        {"carrierFrequency", 10.0f, 1000.0f, 100.0f, false, ParameterScale::kLog},
+        {"mix", 0.0f, 1.0f, 1.0f},
+        {"threshold", 0.0f, 1.0f, 0.02f},
+    };
+
+protected:
+    void storeParameter(uint32_t id, float value) override;
 
 private:
     // Thread-safe parameters
@@ -53,7 +71,8 @@ private:
 
     // Oscillator state
     double phase_ = 0.0;
-    double phaseIncrement_ = 0.0;
+    double phaseIncrement_ = 0.0;  // As of the end of the last block
+    float currentMix_ = 1.0f;      // As of the end of the last block
     uint sampleRate_ = 44100;
 };
 
@@ -0,0 +1,112 @@
+#include "nodes/VoiceActivityNode.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace voicechanger {
+
+namespace {
+const ParameterDescriptor kParameters[VoiceActivityNode::kNumParams] = {
+    {"threshold", -80.0f, -20.0f, -50.0f},
+    {"hangoverMs", 50.0f, 2000.0f, 500.0f, false, ParameterScale::kLog},
+    {"active", 0.0f, 1.0f, 0.0f, true},
+    {"level", -120.0f, 0.0f, -120.0f, true},
+    {"noiseFloor", -120.0f, 0.0f, -120.0f, true},
+    {"flatness", 0.0f, 1.0f, 1.0f, true},
+};
+} // namespace
+
+VoiceActivityNode::VoiceActivityNode(const switchboard::SBAnyMap& config) {
+    // Initialize from config
+    applyConfig(config);
+}
+
+bool VoiceActivityNode::setBusFormat(switchboard::AudioBusFormat& inputBusFormat,
+                                     switchboard::AudioBusFormat& outputBusFormat) {
+    if (!inputBusFormat.isSet()) {
+        return false;
+    }
+
+    detector_.prepare(static_cast<float>(inputBusFormat.sampleRate));
+    lastHangoverMs_ = hangoverMs_.load();
+    detector_.setHangover(lastHangoverMs_ / 1000.0f);
+    active_.store(false);
+    isConfigured_ = true;
+
+    // Match output format to input
+    outputBusFormat = inputBusFormat;
+    return true;
+}
+
+bool VoiceActivityNode::process(switchboard::AudioBus& inBus, switchboard::AudioBus& outBus) {
+    if (!isConfigured_) {
+        return false;
+    }
+
+    auto* inBuffer = inBus.getBuffer();
+    auto* outBuffer = outBus.getBuffer();
+
+    if (!inBuffer || !outBuffer) {
+        return false;
+    }
+
+    uint numFrames = inBuffer->getNumberOfFrames();
+    uint numChannels = inBuffer->getNumberOfChannels();
+
+    detector_.setThreshold(threshold_.load());
+    float hangoverMs = hangoverMs_.load();
+    if (hangoverMs != lastHangoverMs_) {
+        detector_.setHangover(hangoverMs / 1000.0f);
+        lastHangoverMs_ = hangoverMs;
+    }
+
+    // Gather channel pointers without allocating (the graph is at most stereo in practice)
+    constexpr uint kMaxChannels = 8;
+    const float* channels[kMaxChannels];
+    uint analysedChannels = std::min(numChannels, kMaxChannels);
+    for (uint ch = 0; ch < analysedChannels; ++ch) {
+        channels[ch] = inBuffer->getReadPointer(ch);
+    }
+
+    active_.store(detector_.process(channels, analysedChannels, numFrames));
+    levelDb_.store(detector_.getLevelDb());
+    noiseFloorDb_.store(detector_.getNoiseFloorDb());
+    flatness_.store(detector_.getFlatness());
+
+    // Analysis only: pass audio through
+    for (uint ch = 0; ch < numChannels; ++ch) {
+        const float* inData = inBuffer->getReadPointer(ch);
+        float* outData = outBuffer->getWritePointer(ch);
+        if (outData != inData) {
+            std::memcpy(outData, inData, numFrames * sizeof(float));
+        }
+    }
+
+    return true;
+}
+
+const ParameterDescriptor& VoiceActivityNode::getParameterDescriptor(uint32_t id) const {
+    return kParameters[id];
+}
+
+void VoiceActivityNode::storeParameter(uint32_t id, float value) {
+    switch (id) {
+        case kThreshold: threshold_.store(value); break;
+        case kHangoverMs: hangoverMs_.store(value); break;
+        default: break;
+    }
+}
+
+float VoiceActivityNode::getParameter(uint32_t id) const {
+    switch (id) {
+        case kThreshold: return threshold_.load();
+        case kHangoverMs: return hangoverMs_.load();
+        case kActive: return active_.load() ? 1.0f : 0.0f;
+        case kLevel: return levelDb_.load();
+        case kNoiseFloor: return noiseFloorDb_.load();
+        case kFlatness: return flatness_.load();
+        default: return 0.0f;
+    }
+}
+
+} // namespace voicechanger
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "dsp/VoiceActivityDetector.hpp"
+
+#include "nodes/ParameterizedNode.hpp"
+
+#include <switchboard_core/NodeTypeInfo.hpp>
+
+#include <any>
+#include <atomic>
+#include <string>
+
+namespace voicechanger {
+
+/**
+ * VoiceActivityNode - Speech/no-speech detection for idle streams.
+ *
+ * Passes audio through unchanged and publishes the decision of a
+ * dsp::VoiceActivityDetector (energy over a tracked noise floor plus
+ * spectral flatness, on a decimated mono mix) for the application or UI
+ * to read with getValue(), e.g. to mute or stop idle streams.
+ *
+ * Parameters:
+ * - threshold: Absolute level below which nothing counts as speech, dBFS (-80 to -20)
+ * - hangoverMs: How long activity is held after the last speech frame (50 to 2000)
+ *
+ * Read-only values:
+ * - active: 1.0 while speech is active (including hangover), else 0.0
+ * - level: Level of the latest analysis frame in dBFS
+ * - noiseFloor: Tracked background level in dBFS
+ * - flatness: Spectral flatness of the latest frame (0 = tonal, 1 = white)
+ */
+class VoiceActivityNode : public ParameterizedNode {
+public:
+    // Parameter ids, in table order
+    enum Param : uint32_t {
+        kThreshold,
+        kHangoverMs,
+        kActive,
+        kLevel,
+        kNoiseFloor,
+        kFlatness,
+        kNumParams
+    };
+
+    static switchboard::NodeTypeInfo getNodeTypeInfo() {
+        return switchboard::NodeTypeInfo{
+            "VoiceChanger",
+            "VoiceActivity",
+            "VoiceActivity",
+            "Voice activity detection",
+            {switchboard::NODE_CATEGORY_AUDIO_PROCESSING}
+        };
+    }
+
+    explicit VoiceActivityNode(const switchboard::SBAnyMap& config);
+    ~VoiceActivityNode() override = default;
+
+    // SingleBusAudioProcessorNode interface
+    bool setBusFormat(switchboard::AudioBusFormat& inputBusFormat,
+                      switchboard::AudioBusFormat& outputBusFormat) override;
+    bool process(switchboard::AudioBus& inBus, switchboard::AudioBus& outBus) override;
+
+    // ParameterizedNode interface
+    uint32_t getParameterCount() const override { return kNumParams; }
+    const ParameterDescriptor& getParameterDescriptor(uint32_t id) const override;
+    float getParameter(uint32_t id) const override;
+
+protected:
+    void storeParameter(uint32_t id, float value) override;
+
+private:
+    // Thread-safe parameters
+    std::atomic<float> threshold_{-50.0f};   // dBFS
+    std::atomic<float> hangoverMs_{500.0f};  // ms
+
+    // Published analysis results
+    std::atomic<bool> active_{false};
+    std::atomic<float> levelDb_{-120.0f};
+    std::atomic<float> noiseFloorDb_{-120.0f};
+    std::atomic<float> flatness_{1.0f};
+
+    // Audio-thread state
+    dsp::VoiceActivityDetector detector_;
+    float lastHangoverMs_ = 0.0f;
+    bool isConfigured_ = false;
+};
+
+} // namespace voicechanger
@@ -0,0 +1,229 @@
+#include "nodes/WhisperNode.hpp"
+
+#include "dsp/Lpc.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace voicechanger {
+
+namespace {
+// Bandwidth expansion of the LPC fit, so narrow formants do not ring
+constexpr double kLagWindowHz = 60.0;
+// White-noise correction; keeps the normal equations well conditioned
+constexpr double kNoiseFloorRatio = 1.0e-4;
+// The noise is uniform in [-1, 1), variance 1/3
+constexpr float kNoiseVarianceInverse = 3.0f;
+} // namespace
+
+WhisperNode::WhisperNode(const switchboard::SBAnyMap& config) {
+    // Initialize from config
+    applyConfig(config);
+
+    for (uint ch = 0; ch < kMaxChannels; ++ch) {
+        channels_[ch].noise.setSeed(ch + 1);
+    }
+}
+
+bool WhisperNode::setBusFormat(switchboard::AudioBusFormat& inputBusFormat,
+                               switchboard::AudioBusFormat& outputBusFormat) {
+    if (!inputBusFormat.isSet()) {
+        return false;
+    }
+
+    sampleRate_ = inputBusFormat.sampleRate;
+    numChannels_ = std::min(inputBusFormat.numberOfChannels, kMaxChannels);
+
+    windowPower_ = 0.0f;
+    for (uint n = 0; n < kWindowSize; ++n) {
+        window_[n] = 0.5f - 0.5f * static_cast<float>(std::cos(2.0 * M_PI * (n + 0.5) / kWindowSize));
+        windowPower_ += window_[n] * window_[n];
+    }
+    for (size_t lag = 0; lag <= kOrder; ++lag) {
+        double x = 2.0 * M_PI * kLagWindowHz * static_cast<double>(lag) / sampleRate_;
+        lagWindow_[lag] = std::exp(-0.5 * x * x);
+    }
+    lagWindow_[0] = 1.0 + kNoiseFloorRatio;
+
+    history_.fill(0.0f);
+    historyPos_ = 0;
+    hopFill_ = 0;
+    reflection_.fill(0.0f);
+    reflectionStep_.fill(0.0f);
+    reflectionTarget_.fill(0.0f);
+    gain_ = gainStep_ = gainTarget_ = 0.0f;
+    for (auto& channel : channels_) {
+        channel.lattice.fill(0.0f);
+    }
+
+    // Match output format to input
+    outputBusFormat = inputBusFormat;
+    return true;
+}
+
+void WhisperNode::analyze() {
+    // Windowed frame, oldest sample first
+    alignas(16) float frame[kWindowSize + kOrder];
+    for (uint n = 0; n < kWindowSize; ++n) {
+        frame[n] = history_[(historyPos_ + n) % kWindowSize] * window_[n];
+    }
+
+    // Eight partial sums per lag, so the adds do not wait on each other and
+    // the products vectorize; the frame is zero-padded past its end
+    constexpr size_t kLanes = 8;
+    std::fill(frame + kWindowSize, frame + kWindowSize + kOrder, 0.0f);
+    std::array<double, kOrder + 1> autocorrelation{};
+    for (size_t lag = 0; lag <= kOrder; ++lag) {
+        float partial[kLanes] = {};
+        for (uint n = 0; n < kWindowSize; n += kLanes) {
+            for (size_t j = 0; j < kLanes; ++j) {
+                partial[j] += frame[n + j] * frame[n + j + lag];
+            }
+        }
+        float sum = 0.0f;
+        for (float value : partial) {
+            sum += value;
+        }
+        autocorrelation[lag] = static_cast<double>(sum) / windowPower_ * lagWindow_[lag];
+    }
+
+    double error = dsp::levinsonDurbin(autocorrelation.data(), kOrder, reflectionTarget_.data());
+    gainTarget_ = static_cast<float>(std::sqrt(kNoiseVarianceInverse * error));
+}
+
+bool WhisperNode::process(switchboard::AudioBus& inBus, switchboard::AudioBus& outBus) {
+    auto* inBuffer = inBus.getBuffer();
+    auto* outBuffer = outBus.getBuffer();
+
+    if (!inBuffer || !outBuffer) {
+        return false;
+    }
+
+    uint numFrames = inBuffer->getNumberOfFrames();
+    uint numChannels = std::min(inBuffer->getNumberOfChannels(), numChannels_);
+
+    float mix = mix_.load();
+    float startMix = lastMix_;
+    lastMix_ = mix;
+    const bool active = mix > 0.0f || startMix > 0.0f;
+
+    // Switching on from fully dry: start at the current envelope rather than gliding up from silence
+    if (active && startMix == 0.0f) {
+        analyze();
+        reflection_ = reflectionTarget_;
+        reflectionStep_.fill(0.0f);
+        gain_ = gainTarget_;
+        gainStep_ = 0.0f;
+    }
+
+    const float mixStep = (mix - startMix) / static_cast<float>(std::max(numFrames, 1u));
+    const float channelScale = numChannels > 0 ? 1.0f / static_cast<float>(numChannels) : 0.0f;
+
+    uint done = 0;
+    while (done < numFrames) {
+        uint length = std::min(numFrames - done, kHopSize - hopFill_);
+
+        // Record the mono mix for analysis
+        for (uint i = 0; i < length; ++i) {
+            float sum = 0.0f;
+            for (uint ch = 0; ch < numChannels; ++ch) {
+                sum += inBuffer->getReadPointer(ch)[done + i];
+            }
+            history_[historyPos_] = sum * channelScale;
+            historyPos_ = (historyPos_ + 1) % kWindowSize;
+        }
+
+        if (!active) {
+            for (uint ch = 0; ch < numChannels; ++ch) {
+                const float* inData = inBuffer->getReadPointer(ch) + done;
+                std::copy(inData, inData + length, outBuffer->getWritePointer(ch) + done);
+            }
+        } else {
+            alignas(16) float excitation[kMaxChannels][kHopSize];
+            for (uint ch = 0; ch < numChannels; ++ch) {
+                channels_[ch].noise.fill(excitation[ch], length);
+            }
+
+            // Envelope as of this span's first sample
+            std::array<float, kOrder> k;
+            for (size_t i = 0; i < kOrder; ++i) {
+                k[i] = reflection_[i] + reflectionStep_[i] * static_cast<float>(hopFill_);
+            }
+            float gain = gain_ + gainStep_ * static_cast<float>(hopFill_);
+            float wetMix = startMix + mixStep * static_cast<float>(done);
+
+            // Channels inside the frame loop, so their lattice chains overlap
+            for (uint n = 0; n < length; ++n) {
+                for (uint ch = 0; ch < numChannels; ++ch) {
+                    auto& b = channels_[ch].lattice;
+
+                    // All-pole lattice synthesis, highest stage first
+                    float f = gain * excitation[ch][n];
+                    for (size_t i = kOrder; i > 0; --i) {
+                        f -= k[i - 1] * b[i - 1];
+                        b[i] = b[i - 1] + k[i - 1] * f;
+                    }
+                    b[0] = f;
+
+                    float x = inBuffer->getReadPointer(ch)[done + n];
+                    outBuffer->getWritePointer(ch)[done + n] = x + wetMix * (f - x);
+                }
+
+                for (size_t i = 0; i < kOrder; ++i) {
+                    k[i] += reflectionStep_[i];
+                }
+                gain += gainStep_;
+                wetMix += mixStep;
+            }
+        }
+
+        hopFill_ += length;
+        done += length;
+
+        // New envelope target; glide to it over the next hop
+        if (hopFill_ == kHopSize) {
+            hopFill_ = 0;
+            if (active) {
+                analyze();
+                for (size_t i = 0; i < kOrder; ++i) {
+                    reflection_[i] += reflectionStep_[i] * static_cast<float>(kHopSize);
+                    reflectionStep_[i] = (reflectionTarget_[i] - reflection_[i]) / static_cast<float>(kHopSize);
+                }
+                gain_ += gainStep_ * static_cast<float>(kHopSize);
+                gainStep_ = (gainTarget_ - gain_) / static_cast<float>(kHopSize);
+            }
+        }
+    }
+
+    // Channels beyond the supported count pass through
+    for (uint ch = numChannels; ch < inBuffer->getNumberOfChannels(); ++ch) {
+        const float* inData = inBuffer->getReadPointer(ch);
+        std::copy(inData, inData + numFrames, outBuffer->getWritePointer(ch));
+    }
+
+    return true;
+}
+
+const ParameterDescriptor& WhisperNode::getParameterDescriptor(uint32_t id) const {
+    return kParameters[id];
+}
+
+void WhisperNode::storeParameter(uint32_t id, float value) {
+    switch (id) {
+        case kMix: mix_.store(value); break;
+        default: break;
+    }
+}
+
+float WhisperNode::getParameter(uint32_t id) const {
+    switch (id) {
+        case kMix: return mix_.load();
+        default: return 0.0f;
+    }
+}
+
+} // namespace voicechanger
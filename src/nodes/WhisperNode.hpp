@@ -0,0 +1,107 @@
+#pragma once
+
+#include "dsp/Random.hpp"
+
+#include "nodes/ParameterizedNode.hpp"
+
+#include <switchboard_core/NodeTypeInfo.hpp>
+
+#include <any>
+#include <array>
+#include <atomic>
+#include <string>
+
+namespace voicechanger {
+
+/**
+ * WhisperNode - Breathy whisper by re-exciting the voice's envelope with noise.
+ *
+ * Every 256 samples a 16th-order LPC fit (Levinson-Durbin on the windowed
+ * autocorrelation of the last 512 input samples, mixed to mono) captures
+ * the spectral envelope and level. White noise from a multi-lane xorshift
+ * generator is then run through the matching all-pole lattice filter, so
+ * formants and loudness follow the speaker while the pitched excitation
+ * is gone. Reflection coefficients and gain are interpolated across each
+ * hop, which keeps the lattice stable and the envelope free of steps.
+ * There is no FFT and no added latency; the envelope trails the input by
+ * about half a window.
+ *
+ * Parameters:
+ * - mix: Dry/whisper mix (0.0 = dry, 1.0 = whisper only)
+ */
+class WhisperNode : public ParameterizedNode {
+public:
+    // Parameter ids, in table order
+    enum Param : uint32_t { kMix, kNumParams };
+
+    static switchboard::NodeTypeInfo getNodeTypeInfo() {
+        return switchboard::NodeTypeInfo{
+            "VoiceChanger",
+            "Whisper",
+            "Whisper",
+            "Noise-excited LPC whisper",
+            {switchboard::NODE_CATEGORY_AUDIO_PROCESSING, switchboard::NODE_CATEGORY_EFFECTS}
+        };
+    }
+
+    explicit WhisperNode(const switchboard::SBAnyMap& config);
+    ~WhisperNode() override = default;
+
+    // SingleBusAudioProcessorNode interface
+    bool setBusFormat(switchboard::AudioBusFormat& inputBusFormat,
+                      switchboard::AudioBusFormat& outputBusFormat) override;
+    bool process(switchboard::AudioBus& inBus, switchboard::AudioBus& outBus) override;
+
+    // ParameterizedNode interface
+    uint32_t getParameterCount() const override { return kNumParams; }
+    const ParameterDescriptor& getParameterDescriptor(uint32_t id) const override;
+    float getParameter(uint32_t id) const override;
+
+    static constexpr uint kMaxChannels = 8;
+
+    // Parameter table, indexed by Param; constexpr so presets can be checked at compile time
+    static constexpr ParameterDescriptor kParameters[kNumParams] = {
+        {"mix", 0.0f, 1.0f, 1.0f},
+    };
+
+protected:
+    void storeParameter(uint32_t id, float value) override;
+
+private:
+    static constexpr size_t kOrder = 16;
+    static constexpr uint kWindowSize = 512;
+    static constexpr uint kHopSize = 256;
+
+    struct Channel {
+        dsp::NoiseGenerator noise;
+        std::array<float, kOrder + 1> lattice{};  // Backward prediction errors
+    };
+
+    void analyze();
+
+    // Thread-safe parameters
+    std::atomic<float> mix_{1.0f};  // 0.0 to 1.0
+
+    // Audio-thread state
+    std::array<Channel, kMaxChannels> channels_;
+    std::array<float, kWindowSize> history_{};  // Mono input ring
+    std::array<float, kWindowSize> window_{};   // Hann
+    std::array<double, kOrder + 1> lagWindow_{};
+    float windowPower_ = 1.0f;
+    uint historyPos_ = 0;
+    uint hopFill_ = 0;  // Samples into the current hop
+
+    // Envelope at the start of the hop, its per-sample slope, and its target
+    std::array<float, kOrder> reflection_{};
+    std::array<float, kOrder> reflectionStep_{};
+    std::array<float, kOrder> reflectionTarget_{};
+    float gain_ = 0.0f;
+    float gainStep_ = 0.0f;
+    float gainTarget_ = 0.0f;
+
+    uint numChannels_ = 0;
+    uint sampleRate_ = 44100;
+    float lastMix_ = 0.0f;
+};
+
+} // namespace voicechanger
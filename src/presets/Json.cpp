@@ -0,0 +1,381 @@
+#include "presets/Json.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace voicechanger {
+
+namespace {
+// Nesting limit, so a hostile file cannot exhaust the stack
+constexpr int kMaxDepth = 64;
+} // namespace
+
+/**
+ * Recursive-descent parser over the whole document text.
+ */
+class JsonParser {
+public:
+    explicit JsonParser(const std::string& text) : text_(text) {}
+
+    bool parseDocument(JsonValue& value) {
+        skipWhitespace();
+        if (!parseValue(value, 0)) {
+            return false;
+        }
+        skipWhitespace();
+        if (pos_ != text_.size()) {
+            return fail("unexpected data after the document");
+        }
+        return true;
+    }
+
+    bool parseLeading(JsonValue& value, const std::vector<std::string>& keys) {
+        skipWhitespace();
+        if (pos_ >= text_.size() || text_[pos_] != '{') {
+            return false;
+        }
+        value.type_ = JsonValue::Type::Object;
+        ++pos_;
+        while (true) {
+            skipWhitespace();
+            std::string key;
+            if (pos_ >= text_.size() || text_[pos_] != '"' || !parseString(key) ||
+                std::find(keys.begin(), keys.end(), key) == keys.end() || value.find(key)) {
+                return true;
+            }
+            skipWhitespace();
+            if (pos_ >= text_.size() || text_[pos_] != ':') {
+                return true;
+            }
+            ++pos_;
+            skipWhitespace();
+            JsonValue member;
+            if (!parseValue(member, 1)) {
+                return true;
+            }
+            value.keys_.push_back(std::move(key));
+            value.items_.push_back(std::move(member));
+            skipWhitespace();
+            if (pos_ >= text_.size() || text_[pos_] != ',') {
+                return true;
+            }
+            ++pos_;
+        }
+    }
+
+    std::string getError() const {
+        size_t line = 1;
+        size_t column = 1;
+        for (size_t i = 0; i < errorPos_ && i < text_.size(); ++i) {
+            if (text_[i] == '\n') {
+                ++line;
+                column = 1;
+            } else {
+                ++column;
+            }
+        }
+        return "line " + std::to_string(line) + ", column " + std::to_string(column) + ": " + error_;
+    }
+
+private:
+    bool fail(const std::string& reason) {
+        error_ = reason;
+        errorPos_ = pos_;
+        return false;
+    }
+
+    void skipWhitespace() {
+        while (pos_ < text_.size() &&
+               (text_[pos_] == ' ' || text_[pos_] == '\t' || text_[pos_] == '\n' || text_[pos_] == '\r')) {
+            ++pos_;
+        }
+    }
+
+    bool consumeWord(const char* word) {
+        size_t length = std::char_traits<char>::length(word);
+        if (text_.compare(pos_, length, word) != 0) {
+            return fail("invalid literal");
+        }
+        pos_ += length;
+        return true;
+    }
+
+    bool parseValue(JsonValue& value, int depth) {
+        if (depth > kMaxDepth) {
+            return fail("nesting too deep");
+        }
+        if (pos_ >= text_.size()) {
+            return fail("unexpected end of input");
+        }
+        switch (text_[pos_]) {
+            case '{':
+                return parseObject(value, depth);
+            case '[':
+                return parseArray(value, depth);
+            case '"':
+                value.type_ = JsonValue::Type::String;
+                return parseString(value.string_);
+            case 't':
+                value.type_ = JsonValue::Type::Bool;
+                value.bool_ = true;
+                return consumeWord("true");
+            case 'f':
+                value.type_ = JsonValue::Type::Bool;
+                value.bool_ = false;
+                return consumeWord("false");
+            case 'n':
+                value.type_ = JsonValue::Type::Null;
+                return consumeWord("null");
+            default:
+                return parseNumber(value);
+        }
+    }
+
+    bool parseObject(JsonValue& value, int depth) {
+        value.type_ = JsonValue::Type::Object;
+        ++pos_;
+        skipWhitespace();
+        if (pos_ < text_.size() && text_[pos_] == '}') {
+            ++pos_;
+            return true;
+        }
+        while (true) {
+            skipWhitespace();
+            if (pos_ >= text_.size() || text_[pos_] != '"') {
+                return fail("expected a member name");
+            }
+            std::string key;
+            if (!parseString(key)) {
+                return false;
+            }
+            if (value.find(key)) {
+                return fail("duplicate member \"" + key + "\"");
+            }
+            skipWhitespace();
+            if (pos_ >= text_.size() || text_[pos_] != ':') {
+                return fail("expected ':'");
+            }
+            ++pos_;
+            skipWhitespace();
+            value.keys_.push_back(std::move(key));
+            value.items_.emplace_back();
+            if (!parseValue(value.items_.back(), depth + 1)) {
+                return false;
+            }
+            skipWhitespace();
+            if (pos_ < text_.size() && text_[pos_] == ',') {
+                ++pos_;
+                continue;
+            }
+            if (pos_ < text_.size() && text_[pos_] == '}') {
+                ++pos_;
+                return true;
+            }
+            return fail("expected ',' or '}'");
+        }
+    }
+
+    bool parseArray(JsonValue& value, int depth) {
+        value.type_ = JsonValue::Type::Array;
+        ++pos_;
+        skipWhitespace();
+        if (pos_ < text_.size() && text_[pos_] == ']') {
+            ++pos_;
+            return true;
+        }
+        while (true) {
+            skipWhitespace();
+            value.items_.emplace_back();
+            if (!parseValue(value.items_.back(), depth + 1)) {
+                return false;
+            }
+            skipWhitespace();
+            if (pos_ < text_.size() && text_[pos_] == ',') {
+                ++pos_;
+                continue;
+            }
+            if (pos_ < text_.size() && text_[pos_] == ']') {
+                ++pos_;
+                return true;
+            }
+            return fail("expected ',' or ']'");
+        }
+    }
+
+    bool parseHex4(unsigned& code) {
+        if (pos_ + 4 > text_.size()) {
+            return fail("truncated \\u escape");
+        }
+        code = 0;
+        for (int i = 0; i < 4; ++i) {
+            char c = text_[pos_++];
+            code <<= 4;
+            if (c >= '0' && c <= '9') {
+                code |= static_cast<unsigned>(c - '0');
+            } else if (c >= 'a' && c <= 'f') {
+                code |= static_cast<unsigned>(c - 'a' + 10);
+            } else if (c >= 'A' && c <= 'F') {
+                code |= static_cast<unsigned>(c - 'A' + 10);
+            } else {
+                return fail("invalid \\u escape");
+            }
+        }
+        return true;
+    }
+
+    static void appendUtf8(std::string& out, unsigned code) {
+        if (code < 0x80) {
+            out += static_cast<char>(code);
+        } else if (code < 0x800) {
+            out += static_cast<char>(0xC0 | (code >> 6));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        } else if (code < 0x10000) {
+            out += static_cast<char>(0xE0 | (code >> 12));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (code >> 18));
+            out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        }
+    }
+
+    bool parseString(std::string& out) {
+        ++pos_;  // Opening quote
+        while (pos_ < text_.size()) {
+            char c = text_[pos_++];
+            if (c == '"') {
+                return true;
+            }
+            if (static_cast<unsigned char>(c) < 0x20) {
+                --pos_;
+                return fail("control character in string");
+            }
+            if (c != '\\') {
+                out += c;
+                continue;
+            }
+            if (pos_ >= text_.size()) {
+                break;
+            }
+            switch (text_[pos_++]) {
+                case '"': out += '"'; break;
+                case '\\': out += '\\'; break;
+                case '/': out += '/'; break;
+                case 'b': out += '\b'; break;
+                case 'f': out += '\f'; break;
+                case 'n': out += '\n'; break;
+                case 'r': out += '\r'; break;
+                case 't': out += '\t'; break;
+                case 'u': {
+                    unsigned code;
+                    if (!parseHex4(code)) {
+                        return false;
+                    }
+                    // A high surrogate must be followed by its low half
+                    if (code >= 0xD800 && code < 0xDC00) {
+                        unsigned low;
+                        if (text_.compare(pos_, 2, "\\u") != 0) {
+                            return fail("unpaired surrogate");
+                        }
+                        pos_ += 2;
+                        if (!parseHex4(low)) {
+                            return false;
+                        }
+                        if (low < 0xDC00 || low >= 0xE000) {
+                            return fail("unpaired surrogate");
+                        }
+                        code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                    } else if (code >= 0xDC00 && code < 0xE000) {
+                        return fail("unpaired surrogate");
+                    }
+                    appendUtf8(out, code);
+                    break;
+                }
+                default:
+                    --pos_;
+                    return fail("invalid escape");
+            }
+        }
+        return fail("unterminated string");
+    }
+
+    bool parseNumber(JsonValue& value) {
+        // Validate the JSON number grammar, then let strtod convert it
+        size_t start = pos_;
+        auto isDigit = [&](size_t i) { return i < text_.size() && text_[i] >= '0' && text_[i] <= '9'; };
+        size_t i = pos_;
+        if (i < text_.size() && text_[i] == '-') {
+            ++i;
+        }
+        if (!isDigit(i)) {
+            return fail("unexpected character");
+        }
+        if (text_[i] == '0') {
+            ++i;
+        } else {
+            while (isDigit(i)) ++i;
+        }
+        if (i < text_.size() && text_[i] == '.') {
+            ++i;
+            if (!isDigit(i)) {
+                pos_ = i;
+                return fail("expected a digit");
+            }
+            while (isDigit(i)) ++i;
+        }
+        if (i < text_.size() && (text_[i] == 'e' || text_[i] == 'E')) {
+            ++i;
+            if (i < text_.size() && (text_[i] == '+' || text_[i] == '-')) ++i;
+            if (!isDigit(i)) {
+                pos_ = i;
+                return fail("expected a digit");
+            }
+            while (isDigit(i)) ++i;
+        }
+
+        std::string number = text_.substr(start, i - start);
+        value.type_ = JsonValue::Type::Number;
+        value.number_ = std::strtod(number.c_str(), nullptr);
+        if (!std::isfinite(value.number_)) {
+            return fail("number out of range");
+        }
+        pos_ = i;
+        return true;
+    }
+
+    const std::string& text_;
+    size_t pos_ = 0;
+    std::string error_;
+    size_t errorPos_ = 0;
+};
+
+bool JsonValue::parse(const std::string& text, JsonValue& value, std::string& error) {
+    value = JsonValue();
+    JsonParser parser(text);
+    if (!parser.parseDocument(value)) {
+        error = parser.getError();
+        return false;
+    }
+    return true;
+}
+
+bool JsonValue::parseLeadingMembers(const std::string& text, const std::vector<std::string>& keys,
+                                    JsonValue& object) {
+    object = JsonValue();
+    JsonParser parser(text);
+    return parser.parseLeading(object, keys);
+}
+
+const JsonValue* JsonValue::find(const std::string& key) const {
+    for (size_t i = 0; i < keys_.size(); ++i) {
+        if (keys_[i] == key) {
+            return &items_[i];
+        }
+    }
+    return nullptr;
+}
+
+} // namespace voicechanger
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace voicechanger {
+
+/**
+ * JsonValue - A parsed JSON document.
+ *
+ * Enough JSON for preset files: objects keep their members in file order,
+ * numbers are doubles, strings are UTF-8 with escapes resolved. parse()
+ * reports the line and column of the first error.
+ */
+class JsonValue {
+public:
+    enum class Type { Null, Bool, Number, String, Array, Object };
+
+    /**
+     * @brief Parses a complete document.
+     * @param error Receives "line L, column C: reason" when false is returned.
+     */
+    static bool parse(const std::string& text, JsonValue& value, std::string& error);
+
+    /**
+     * @brief Reads the leading members of a top-level object without
+     *        parsing the rest of the document.
+     *
+     * Members are read in file order while their names are in keys; reading
+     * stops at the first other member, at the end of the text or at a
+     * syntax error, so text may be just the first part of a file.
+     * @return False if text does not start with an object.
+     */
+    static bool parseLeadingMembers(const std::string& text, const std::vector<std::string>& keys,
+                                    JsonValue& object);
+
+    Type getType() const { return type_; }
+    bool isNull() const { return type_ == Type::Null; }
+    bool isBool() const { return type_ == Type::Bool; }
+    bool isNumber() const { return type_ == Type::Number; }
+    bool isString() const { return type_ == Type::String; }
+    bool isArray() const { return type_ == Type::Array; }
+    bool isObject() const { return type_ == Type::Object; }
+
+    bool asBool() const { return bool_; }
+    double asNumber() const { return number_; }
+    const std::string& asString() const { return string_; }
+
+    /// Array elements, or object member values (in the order of getKeys()).
+    const std::vector<JsonValue>& getItems() const { return items_; }
+    /// Object member names.
+    const std::vector<std::string>& getKeys() const { return keys_; }
+
+    /// Object member by name, or nullptr.
+    const JsonValue* find(const std::string& key) const;
+
+private:
+    friend class JsonParser;
+
+    Type type_ = Type::Null;
+    bool bool_ = false;
+    double number_ = 0.0;
+    std::string string_;
+    std::vector<std::string> keys_;
+    std::vector<JsonValue> items_;
+};
+
+} // namespace voicechanger
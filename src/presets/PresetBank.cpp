@@ -0,0 +1,357 @@
+#include "presets/PresetBank.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <unordered_map>
+
+namespace voicechanger {
+
+// Every record is a multiple of four bytes, so each array stays aligned
+
+struct PresetBank::Header {
+    char magic[4];
+    uint32_t version;
+    uint32_t tableFingerprint;
+    uint32_t presetCount;
+    uint32_t stageCount;
+    uint32_t paramCount;
+    uint32_t modulationCount;
+    uint32_t tagCount;
+    uint32_t stringBytes;
+};
+
+struct PresetBank::PresetRecord {
+    uint32_t name;  // String table offsets
+    uint32_t description;
+    uint32_t category;
+    uint32_t firstStage;
+    uint32_t stageCount;
+    uint32_t firstModulation;
+    uint32_t modulationCount;
+    uint32_t firstTag;
+    uint32_t tagCount;
+};
+
+struct PresetBank::StageRecord {
+    uint32_t id;
+    uint32_t type;
+    uint32_t firstParam;
+    uint32_t paramCount;
+};
+
+struct PresetBank::ParamRecord {
+    uint32_t key;
+    int32_t id;
+    float value;
+};
+
+struct PresetBank::ModulationRecord {
+    uint32_t source;
+    uint32_t stageId;
+    uint32_t key;
+    float depth;
+    float rateHz;
+    float attackMs;
+    float releaseMs;
+};
+
+namespace {
+constexpr char kMagic[4] = {'V', 'C', 'P', 'B'};
+
+// FNV-1a
+void hash(uint32_t& h, const char* text) {
+    for (; *text; ++text) {
+        h = (h ^ static_cast<uint8_t>(*text)) * 16777619u;
+    }
+    h = (h ^ 0xffu) * 16777619u;  // Separator, so "ab","c" and "a","bc" differ
+}
+
+/**
+ * Collects strings into one table, storing each distinct string once.
+ */
+class StringTable {
+public:
+    StringTable() { add(""); }
+
+    uint32_t add(const std::string& text) {
+        auto it = offsets_.find(text);
+        if (it != offsets_.end()) {
+            return it->second;
+        }
+        auto offset = static_cast<uint32_t>(bytes_.size());
+        bytes_.insert(bytes_.end(), text.begin(), text.end());
+        bytes_.push_back('\0');
+        offsets_.emplace(text, offset);
+        return offset;
+    }
+
+    // Pads the table to a multiple of four bytes
+    const std::vector<char>& finish() {
+        bytes_.resize((bytes_.size() + 3) & ~size_t(3), '\0');
+        return bytes_;
+    }
+
+private:
+    std::vector<char> bytes_;
+    std::unordered_map<std::string, uint32_t> offsets_;
+};
+
+template <typename T>
+void writeArray(std::ofstream& file, const std::vector<T>& items) {
+    file.write(reinterpret_cast<const char*>(items.data()), static_cast<std::streamsize>(items.size() * sizeof(T)));
+}
+} // namespace
+
+uint32_t PresetBank::getTableFingerprint() {
+    static const uint32_t fingerprint = [] {
+        uint32_t h = 2166136261u;
+        for (const auto& type : VoiceChain::getStageTypes()) {
+            hash(h, type.c_str());
+            auto probe = VoiceChain::createStage(type);
+            for (uint32_t id = 0; id < probe->getParameterCount(); ++id) {
+                hash(h, probe->getParameterDescriptor(id).key);
+            }
+        }
+        return h;
+    }();
+    return fingerprint;
+}
+
+bool PresetBank::write(const std::string& path, const std::vector<PresetDefinition>& presets, std::string& error) {
+    StringTable strings;
+    std::vector<PresetRecord> presetRecords;
+    std::vector<StageRecord> stageRecords;
+    std::vector<ParamRecord> paramRecords;
+    std::vector<ModulationRecord> modulationRecords;
+    std::vector<uint32_t> tagRecords;
+
+    for (const auto& preset : presets) {
+        const ChainSpec& chain = preset.chain;
+        presetRecords.push_back({strings.add(preset.name), strings.add(preset.description),
+                                 strings.add(preset.category), static_cast<uint32_t>(stageRecords.size()),
+                                 static_cast<uint32_t>(chain.stages.size()),
+                                 static_cast<uint32_t>(modulationRecords.size()),
+                                 static_cast<uint32_t>(chain.modulations.size()),
+                                 static_cast<uint32_t>(tagRecords.size()), static_cast<uint32_t>(preset.tags.size())});
+        for (const auto& tag : preset.tags) {
+            tagRecords.push_back(strings.add(tag));
+        }
+        for (const auto& stage : chain.stages) {
+            stageRecords.push_back({strings.add(stage.id), strings.add(stage.type),
+                                    static_cast<uint32_t>(paramRecords.size()),
+                                    static_cast<uint32_t>(stage.params.size())});
+            for (const auto& param : stage.params) {
+                paramRecords.push_back({strings.add(param.key), param.id, param.value});
+            }
+        }
+        for (const auto& modulation : chain.modulations) {
+            modulationRecords.push_back({static_cast<uint32_t>(modulation.source), strings.add(modulation.stageId),
+                                         strings.add(modulation.key), modulation.depth, modulation.rateHz,
+                                         modulation.attackMs, modulation.releaseMs});
+        }
+    }
+
+    const std::vector<char>& table = strings.finish();
+    Header header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.tableFingerprint = getTableFingerprint();
+    header.presetCount = static_cast<uint32_t>(presetRecords.size());
+    header.stageCount = static_cast<uint32_t>(stageRecords.size());
+    header.paramCount = static_cast<uint32_t>(paramRecords.size());
+    header.modulationCount = static_cast<uint32_t>(modulationRecords.size());
+    header.tagCount = static_cast<uint32_t>(tagRecords.size());
+    header.stringBytes = static_cast<uint32_t>(table.size());
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        error = path + ": cannot open file for writing";
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    writeArray(file, presetRecords);
+    writeArray(file, stageRecords);
+    writeArray(file, paramRecords);
+    writeArray(file, modulationRecords);
+    writeArray(file, tagRecords);
+    writeArray(file, table);
+    if (!file) {
+        error = path + ": write failed";
+        return false;
+    }
+    return true;
+}
+
+PresetBank::~PresetBank() {
+    close();
+}
+
+bool PresetBank::open(const std::string& path, std::string& error) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        error = path + ": " + std::strerror(errno);
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(Header)) {
+        ::close(fd);
+        error = path + ": not a preset bank";
+        return false;
+    }
+    size_t size = static_cast<size_t>(info.st_size);
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        error = path + ": " + std::strerror(errno);
+        return false;
+    }
+    data_ = static_cast<const uint8_t*>(mapping);
+    size_ = size;
+
+    Header header;
+    std::memcpy(&header, data_, sizeof(header));
+    uint64_t expected = sizeof(Header) + uint64_t(header.presetCount) * sizeof(PresetRecord) +
+                        uint64_t(header.stageCount) * sizeof(StageRecord) +
+                        uint64_t(header.paramCount) * sizeof(ParamRecord) +
+                        uint64_t(header.modulationCount) * sizeof(ModulationRecord) +
+                        uint64_t(header.tagCount) * sizeof(uint32_t) + header.stringBytes;
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+        error = path + ": not a preset bank";
+    } else if (header.version != kVersion) {
+        error = path + ": bank version " + std::to_string(header.version) + ", expected " +
+                std::to_string(kVersion);
+    } else if (header.tableFingerprint != getTableFingerprint()) {
+        error = path + ": written for different parameter tables; rebuild it from the JSON presets";
+    } else if (expected != size_ || header.stringBytes == 0 || data_[size_ - 1] != '\0') {
+        error = path + ": truncated or corrupt";
+    } else {
+        presetCount_ = header.presetCount;
+        stageCount_ = header.stageCount;
+        paramCount_ = header.paramCount;
+        modulationCount_ = header.modulationCount;
+        tagCount_ = header.tagCount;
+        stringBytes_ = header.stringBytes;
+        const uint8_t* cursor = data_ + sizeof(Header);
+        presets_ = reinterpret_cast<const PresetRecord*>(cursor);
+        cursor += presetCount_ * sizeof(PresetRecord);
+        stages_ = reinterpret_cast<const StageRecord*>(cursor);
+        cursor += stageCount_ * sizeof(StageRecord);
+        params_ = reinterpret_cast<const ParamRecord*>(cursor);
+        cursor += paramCount_ * sizeof(ParamRecord);
+        modulations_ = reinterpret_cast<const ModulationRecord*>(cursor);
+        cursor += modulationCount_ * sizeof(ModulationRecord);
+        tags_ = reinterpret_cast<const uint32_t*>(cursor);
+        cursor += tagCount_ * sizeof(uint32_t);
+        strings_ = reinterpret_cast<const char*>(cursor);
+        return true;
+    }
+    close();
+    return false;
+}
+
+void PresetBank::close() {
+    if (data_) {
+        munmap(const_cast<uint8_t*>(data_), size_);
+    }
+    data_ = nullptr;
+    size_ = 0;
+    presetCount_ = 0;
+    presets_ = nullptr;
+    stages_ = nullptr;
+    params_ = nullptr;
+    modulations_ = nullptr;
+    tags_ = nullptr;
+    strings_ = nullptr;
+    stageCount_ = paramCount_ = modulationCount_ = tagCount_ = stringBytes_ = 0;
+}
+
+const PresetBank::PresetRecord& PresetBank::preset(size_t index) const {
+    return presets_[index];
+}
+
+const char* PresetBank::string(uint32_t offset) const {
+    // The table ends in a NUL, so any offset inside it is a terminated string
+    return offset < stringBytes_ ? strings_ + offset : "";
+}
+
+const char* PresetBank::getName(size_t index) const {
+    return string(preset(index).name);
+}
+
+const char* PresetBank::getDescription(size_t index) const {
+    return string(preset(index).description);
+}
+
+const char* PresetBank::getCategory(size_t index) const {
+    return string(preset(index).category);
+}
+
+std::vector<std::string> PresetBank::getTags(size_t index) const {
+    const PresetRecord& record = preset(index);
+    std::vector<std::string> tags;
+    if (uint64_t(record.firstTag) + record.tagCount <= tagCount_) {
+        tags.reserve(record.tagCount);
+        for (uint32_t i = 0; i < record.tagCount; ++i) {
+            tags.emplace_back(string(tags_[record.firstTag + i]));
+        }
+    }
+    return tags;
+}
+
+bool PresetBank::getChain(size_t index, ChainSpec& chain, std::string& error) const {
+    if (index >= presetCount_) {
+        error = "preset " + std::to_string(index) + " is not in the bank";
+        return false;
+    }
+    const PresetRecord& record = preset(index);
+    if (uint64_t(record.firstStage) + record.stageCount > stageCount_ ||
+        uint64_t(record.firstModulation) + record.modulationCount > modulationCount_) {
+        error = std::string(getName(index)) + ": corrupt bank record";
+        return false;
+    }
+
+    chain = ChainSpec();
+    chain.name = string(record.name);
+    chain.stages.resize(record.stageCount);
+    for (uint32_t i = 0; i < record.stageCount; ++i) {
+        const StageRecord& stageRecord = stages_[record.firstStage + i];
+        if (uint64_t(stageRecord.firstParam) + stageRecord.paramCount > paramCount_) {
+            error = chain.name + ": corrupt bank record";
+            return false;
+        }
+        StageSpec& stage = chain.stages[i];
+        stage.id = string(stageRecord.id);
+        stage.type = string(stageRecord.type);
+        stage.params.reserve(stageRecord.paramCount);
+        for (uint32_t p = 0; p < stageRecord.paramCount; ++p) {
+            const ParamRecord& param = params_[stageRecord.firstParam + p];
+            stage.params.push_back({string(param.key), param.value, param.id});
+        }
+    }
+    chain.modulations.resize(record.modulationCount);
+    for (uint32_t i = 0; i < record.modulationCount; ++i) {
+        const ModulationRecord& modulationRecord = modulations_[record.firstModulation + i];
+        if (modulationRecord.source > static_cast<uint32_t>(dsp::ModulatorType::kRandomWalk)) {
+            error = chain.name + ": corrupt bank record";
+            return false;
+        }
+        ModulationSpec& modulation = chain.modulations[i];
+        modulation.source = static_cast<dsp::ModulatorType>(modulationRecord.source);
+        modulation.stageId = string(modulationRecord.stageId);
+        modulation.key = string(modulationRecord.key);
+        modulation.depth = modulationRecord.depth;
+        modulation.rateHz = modulationRecord.rateHz;
+        modulation.attackMs = modulationRecord.attackMs;
+        modulation.releaseMs = modulationRecord.releaseMs;
+    }
+    return true;
+}
+
+} // namespace voicechanger
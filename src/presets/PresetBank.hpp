@@ -0,0 +1,103 @@
+#pragma once
+
+#include "presets/PresetLoader.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace voicechanger {
+
+/**
+ * PresetBank - Presets compiled into one binary file and read through mmap.
+ *
+ * write() turns parsed presets into fixed-layout records: a header, then
+ * arrays of preset, stage, parameter, modulation and tag records, then a
+ * table of NUL-terminated strings shared between them. Parameters are stored
+ * with the table ids the loader resolved, and the header carries a
+ * fingerprint of every stage type's parameter table, so a bank written by
+ * a build with different tables is refused rather than misread.
+ *
+ * open() maps the file read-only and checks the header; nothing is copied
+ * or parsed, and the kernel only pages in the records that are read.
+ * Names come straight out of the mapping. getChain() builds a ChainSpec
+ * from one preset's records, with every parameter id already resolved, so
+ * selecting a preset costs a few hundred bytes of reads. Record indices
+ * are bounds-checked as they are followed, so a corrupt bank fails that
+ * preset rather than reading outside the file.
+ */
+class PresetBank {
+public:
+    static constexpr uint32_t kVersion = 2;
+
+    /**
+     * @brief Writes presets to a bank file.
+     * @return False with the reason in error if the file cannot be written.
+     */
+    static bool write(const std::string& path, const std::vector<PresetDefinition>& presets, std::string& error);
+
+    /**
+     * @brief Hash of every stage type's parameter keys in id order.
+     */
+    static uint32_t getTableFingerprint();
+
+    PresetBank() = default;
+    ~PresetBank();
+
+    PresetBank(const PresetBank&) = delete;
+    PresetBank& operator=(const PresetBank&) = delete;
+
+    /**
+     * @brief Maps a bank file, replacing any bank already open.
+     * @return False with the reason, prefixed with the path, in error.
+     */
+    bool open(const std::string& path, std::string& error);
+    void close();
+
+    bool isOpen() const { return data_ != nullptr; }
+    size_t size() const { return presetCount_; }
+    size_t getMappedBytes() const { return size_; }
+
+    // Strings inside the mapping, valid until close()
+    const char* getName(size_t index) const;
+    const char* getDescription(size_t index) const;
+    const char* getCategory(size_t index) const;
+
+    /**
+     * @brief The preset's tags; empty if its tag records are out of bounds.
+     */
+    std::vector<std::string> getTags(size_t index) const;
+
+    /**
+     * @brief Builds one preset's chain from its records.
+     * @return False with the reason in error if the records are out of bounds.
+     */
+    bool getChain(size_t index, ChainSpec& chain, std::string& error) const;
+
+private:
+    struct Header;
+    struct PresetRecord;
+    struct StageRecord;
+    struct ParamRecord;
+    struct ModulationRecord;
+
+    const PresetRecord& preset(size_t index) const;
+    const char* string(uint32_t offset) const;
+
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    size_t presetCount_ = 0;
+    const PresetRecord* presets_ = nullptr;
+    const StageRecord* stages_ = nullptr;
+    const ParamRecord* params_ = nullptr;
+    const ModulationRecord* modulations_ = nullptr;
+    const uint32_t* tags_ = nullptr;  // String table offsets
+    const char* strings_ = nullptr;
+    uint32_t stageCount_ = 0;
+    uint32_t paramCount_ = 0;
+    uint32_t modulationCount_ = 0;
+    uint32_t tagCount_ = 0;
+    uint32_t stringBytes_ = 0;
+};
+
+} // namespace voicechanger
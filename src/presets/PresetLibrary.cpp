@@ -0,0 +1,321 @@
+#include "presets/PresetLibrary.hpp"
+
+#include "presets/Json.hpp"
+#include "presets/PresetValidator.hpp"
+#include "presets/VoicePresets.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+
+namespace voicechanger {
+
+namespace {
+// Enough for the metadata members at the top of any reasonable preset
+constexpr size_t kHeaderBytes = 4096;
+
+std::string toLower(std::string text) {
+    std::transform(text.begin(), text.end(), text.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return text;
+}
+
+// "03_deep_villain" -> "Deep Villain"
+std::string nameFromStem(const std::string& stem) {
+    size_t start = 0;
+    while (start < stem.size() && std::isdigit(static_cast<unsigned char>(stem[start]))) {
+        ++start;
+    }
+    if (start == stem.size() || start == 0 || stem[start] != '_') {
+        start = 0;
+    } else {
+        ++start;
+    }
+    std::string name;
+    bool wordStart = true;
+    for (size_t i = start; i < stem.size(); ++i) {
+        char c = stem[i] == '_' ? ' ' : stem[i];
+        name += wordStart ? static_cast<char>(std::toupper(static_cast<unsigned char>(c))) : c;
+        wordStart = c == ' ';
+    }
+    return name;
+}
+
+// Subdirectory of root the file sits in, for presets without a category
+std::string categoryFromDirectory(const std::filesystem::path& path, const std::filesystem::path& root) {
+    if (root.empty()) {
+        return {};
+    }
+    std::filesystem::path parent = path.parent_path().lexically_relative(root);
+    return parent.empty() || parent == "." ? std::string() : parent.string();
+}
+
+void readHeader(const std::string& path, PresetEntry& entry) {
+    std::ifstream file(path, std::ios::binary);
+    std::string text(kHeaderBytes, '\0');
+    file.read(&text[0], static_cast<std::streamsize>(text.size()));
+    text.resize(static_cast<size_t>(file.gcount()));
+
+    JsonValue header;
+    if (!JsonValue::parseLeadingMembers(text, {"name", "description", "category", "tags"}, header)) {
+        return;
+    }
+    if (const JsonValue* name = header.find("name"); name && name->isString() && !name->asString().empty()) {
+        entry.name = name->asString();
+    }
+    if (const JsonValue* description = header.find("description"); description && description->isString()) {
+        entry.description = description->asString();
+    }
+    if (const JsonValue* category = header.find("category"); category && category->isString()) {
+        entry.category = category->asString();
+    }
+    if (const JsonValue* tags = header.find("tags"); tags && tags->isArray()) {
+        for (const auto& tag : tags->getItems()) {
+            if (tag.isString()) {
+                entry.tags.push_back(tag.asString());
+            }
+        }
+    }
+}
+} // namespace
+
+PresetLibrary::PresetLibrary(size_t cacheSize) : cacheSize_(std::max<size_t>(cacheSize, 1)) {}
+
+bool PresetLibrary::scan(const std::string& directory, std::string& error) {
+    namespace fs = std::filesystem;
+
+    std::error_code ec;
+    fs::recursive_directory_iterator it(directory, fs::directory_options::skip_permission_denied, ec);
+    if (ec) {
+        error = directory + ": " + ec.message();
+        return false;
+    }
+    std::vector<fs::path> paths;
+    for (fs::recursive_directory_iterator end; it != end; it.increment(ec)) {
+        if (ec) {
+            error = directory + ": " + ec.message();
+            return false;
+        }
+        if (it->is_regular_file(ec) && it->path().extension() == ".json") {
+            paths.push_back(it->path());
+        }
+    }
+    std::sort(paths.begin(), paths.end());
+    clear();
+
+    root_ = directory;
+    entries_.reserve(paths.size());
+    for (const auto& path : paths) {
+        PresetEntry entry;
+        entry.path = path.string();
+        readHeader(entry.path, entry);
+        if (entry.name.empty()) {
+            entry.name = nameFromStem(path.stem().string());
+        }
+        if (entry.category.empty()) {
+            entry.category = categoryFromDirectory(path, root_);
+        }
+        addCategory(entry.category);
+        nameIndex_.emplace(toLower(entry.name), entries_.size());
+        entries_.push_back(std::move(entry));
+    }
+    return true;
+}
+
+bool PresetLibrary::openBank(const std::string& path, std::string& error) {
+    auto bank = std::make_unique<PresetBank>();
+    if (!bank->open(path, error)) {
+        return false;
+    }
+    clear();
+    entries_.reserve(bank->size());
+    for (size_t i = 0; i < bank->size(); ++i) {
+        PresetEntry entry{path, bank->getName(i), bank->getDescription(i), bank->getCategory(i), bank->getTags(i)};
+        addCategory(entry.category);
+        nameIndex_.emplace(toLower(entry.name), entries_.size());
+        entries_.push_back(std::move(entry));
+    }
+    bank_ = std::move(bank);
+    return true;
+}
+
+void PresetLibrary::openBuiltIn() {
+    clear();
+    entries_.reserve(getPresets().size());
+    for (const auto& preset : getPresets()) {
+        PresetEntry entry{"built-in", preset.name, preset.description, preset.category,
+                          {preset.tags, preset.tags + preset.tagCount}};
+        addCategory(entry.category);
+        nameIndex_.emplace(toLower(entry.name), entries_.size());
+        entries_.push_back(std::move(entry));
+    }
+    builtIn_ = true;
+}
+
+int PresetLibrary::findByName(const std::string& name) const {
+    auto it = nameIndex_.find(toLower(name));
+    return it == nameIndex_.end() ? -1 : static_cast<int>(it->second);
+}
+
+std::vector<size_t> PresetLibrary::findByCategory(const std::string& category) const {
+    std::string lower = toLower(category);
+    std::vector<size_t> indices;
+    for (size_t i = 0; i < entries_.size(); ++i) {
+        if (toLower(entries_[i].category) == lower) {
+            indices.push_back(i);
+        }
+    }
+    return indices;
+}
+
+std::vector<size_t> PresetLibrary::findByTag(const std::string& tag) const {
+    std::string lower = toLower(tag);
+    std::vector<size_t> indices;
+    for (size_t i = 0; i < entries_.size(); ++i) {
+        for (const auto& entryTag : entries_[i].tags) {
+            if (toLower(entryTag) == lower) {
+                indices.push_back(i);
+                break;
+            }
+        }
+    }
+    return indices;
+}
+
+std::shared_ptr<const PresetDefinition> PresetLibrary::load(size_t index, std::string& error) {
+    if (index >= entries_.size()) {
+        error = "preset " + std::to_string(index) + " is not in the library";
+        return nullptr;
+    }
+    auto it = cached_.find(index);
+    if (it != cached_.end()) {
+        lru_.splice(lru_.begin(), lru_, it->second);
+        return it->second->second;
+    }
+
+    auto preset = std::make_shared<PresetDefinition>();
+    if (bank_) {
+        const PresetEntry& entry = entries_[index];
+        preset->name = entry.name;
+        preset->description = entry.description;
+        preset->category = entry.category;
+        preset->tags = entry.tags;
+        if (!bank_->getChain(index, preset->chain, error)) {
+            error = entry.path + ": " + error;
+            return nullptr;
+        }
+        if (!validateChain(preset->chain, preset->warnings, error)) {
+            error = entry.path + ": " + entry.name + ": " + error;
+            return nullptr;
+        }
+        preset->nodes = preset->chain.stages;
+    } else if (builtIn_) {
+        const PresetEntry& entry = entries_[index];
+        preset->name = entry.name;
+        preset->description = entry.description;
+        preset->category = entry.category;
+        preset->tags = entry.tags;
+        preset->chain = toChainSpec(getPresets()[index]);
+        if (!validateChain(preset->chain, preset->warnings, error)) {
+            error = entry.path + ": " + entry.name + ": " + error;
+            return nullptr;
+        }
+        preset->nodes = preset->chain.stages;
+    } else {
+        ++parseCount_;
+        if (!loadPresetFile(entries_[index].path, *preset, error)) {
+            return nullptr;
+        }
+    }
+    cache(index, preset);
+    return preset;
+}
+
+size_t PresetLibrary::update(const std::string& path, std::shared_ptr<const PresetDefinition> preset) {
+    int found = findByPath(path);
+    size_t index = found < 0 ? entries_.size() : static_cast<size_t>(found);
+    if (found < 0) {
+        entries_.push_back({path, {}, {}, {}, {}});
+    }
+
+    PresetEntry& entry = entries_[index];
+    const std::string oldName = toLower(entry.name);
+    entry.name = preset->name;
+    entry.description = preset->description;
+    // As when scanning, a preset without a category is listed under its subdirectory
+    entry.category = preset->category.empty() ? categoryFromDirectory(path, root_) : preset->category;
+    entry.tags = preset->tags;
+
+    // The category may have lost its last preset; keep order of first appearance
+    categories_.clear();
+    lowerCategories_.clear();
+    for (const auto& listed : entries_) {
+        addCategory(listed.category);
+    }
+    indexName(oldName);
+    indexName(toLower(entry.name));
+
+    auto it = cached_.find(index);
+    if (it != cached_.end()) {
+        lru_.erase(it->second);
+        cached_.erase(it);
+    }
+    cache(index, std::move(preset));
+    return index;
+}
+
+int PresetLibrary::findByPath(const std::string& path) const {
+    for (size_t i = 0; i < entries_.size(); ++i) {
+        if (entries_[i].path == path) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+void PresetLibrary::clear() {
+    bank_.reset();
+    root_.clear();
+    builtIn_ = false;
+    entries_.clear();
+    categories_.clear();
+    lowerCategories_.clear();
+    nameIndex_.clear();
+    lru_.clear();
+    cached_.clear();
+    parseCount_ = 0;
+}
+
+void PresetLibrary::addCategory(const std::string& category) {
+    if (category.empty()) {
+        return;
+    }
+    std::string lower = toLower(category);
+    if (std::find(lowerCategories_.begin(), lowerCategories_.end(), lower) == lowerCategories_.end()) {
+        lowerCategories_.push_back(lower);
+        categories_.push_back(category);
+    }
+}
+
+void PresetLibrary::indexName(const std::string& lowerName) {
+    // Another file may share the name; the first entry carrying it is found
+    for (size_t i = 0; i < entries_.size(); ++i) {
+        if (toLower(entries_[i].name) == lowerName) {
+            nameIndex_[lowerName] = i;
+            return;
+        }
+    }
+    nameIndex_.erase(lowerName);
+}
+
+void PresetLibrary::cache(size_t index, std::shared_ptr<const PresetDefinition> preset) {
+    if (lru_.size() >= cacheSize_) {
+        cached_.erase(lru_.back().first);
+        lru_.pop_back();
+    }
+    lru_.emplace_front(index, std::move(preset));
+    cached_[index] = lru_.begin();
+}
+
+} // namespace voicechanger
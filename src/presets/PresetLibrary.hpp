@@ -0,0 +1,121 @@
+#pragma once
+
+#include "presets/PresetBank.hpp"
+#include "presets/PresetLoader.hpp"
+
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace voicechanger {
+
+/**
+ * What a PresetLibrary knows about a preset before it is loaded.
+ */
+struct PresetEntry {
+    std::string path;
+    std::string name;
+    std::string description;
+    std::string category;
+    std::vector<std::string> tags;
+};
+
+/**
+ * PresetLibrary - A directory of preset files, indexed without parsing them.
+ *
+ * scan() walks the directory (and its subdirectories) for .json files and
+ * reads only the first few kilobytes of each: the name, description,
+ * category and tags members that precede "graph", so scanning costs the
+ * same per file however large the graphs are, and a broken file is only
+ * reported when it is selected. A file whose name comes later is listed
+ * under its file name ("03_robot.json" becomes "Robot"), and one without a
+ * category under its subdirectory.
+ *
+ * load() parses and validates a preset the first time it is asked for and
+ * keeps the most recently used ones in an LRU cache. A library opened on
+ * a PresetBank instead reads its index from the bank's records and builds
+ * presets from them, with nothing to parse, and one opened on the built-in
+ * presets copies them out of static tables. Control thread only.
+ */
+class PresetLibrary {
+public:
+    explicit PresetLibrary(size_t cacheSize = 32);
+
+    /**
+     * @brief Replaces the index with the presets under directory, sorted by path.
+     * @return False if the directory cannot be read.
+     */
+    bool scan(const std::string& directory, std::string& error);
+
+    /**
+     * @brief Replaces the index with the presets of a bank file (see PresetBank).
+     * @return False if the bank cannot be opened.
+     */
+    bool openBank(const std::string& path, std::string& error);
+
+    /**
+     * @brief Replaces the index with the presets compiled into the build
+     *        (see VoicePresets.hpp), listed under the path "built-in".
+     */
+    void openBuiltIn();
+
+    size_t size() const { return entries_.size(); }
+    bool empty() const { return entries_.empty(); }
+    const PresetEntry& getEntry(size_t index) const { return entries_[index]; }
+
+    /// Index of the first preset with this name (case-insensitive), or -1.
+    int findByName(const std::string& name) const;
+    /// Indices of the presets in a category (case-insensitive), in library order.
+    std::vector<size_t> findByCategory(const std::string& category) const;
+    /// Indices of the presets carrying a tag (case-insensitive), in library order.
+    std::vector<size_t> findByTag(const std::string& tag) const;
+    /// Every category, in order of first appearance.
+    const std::vector<std::string>& getCategories() const { return categories_; }
+
+    /**
+     * @brief Returns a parsed preset, reading its file on a cache miss.
+     * @param error Receives the reason, prefixed with the path, when nullptr is returned.
+     */
+    std::shared_ptr<const PresetDefinition> load(size_t index, std::string& error);
+
+    /**
+     * @brief Takes a freshly parsed version of a file: its entry is updated
+     *        and the preset replaces any cached copy. A file the library
+     *        does not list yet is added at the end. A preset without a
+     *        category is listed under its subdirectory, as in scan().
+     * @return The preset's index.
+     */
+    size_t update(const std::string& path, std::shared_ptr<const PresetDefinition> preset);
+
+    /// Index of the preset read from path, or -1.
+    int findByPath(const std::string& path) const;
+
+    size_t getCachedCount() const { return lru_.size(); }
+    /// Files parsed since the last scan(), for tests and benchmarks.
+    size_t getParseCount() const { return parseCount_; }
+
+private:
+    using CacheList = std::list<std::pair<size_t, std::shared_ptr<const PresetDefinition>>>;
+
+    void addCategory(const std::string& category);
+    void indexName(const std::string& lowerName);
+    void cache(size_t index, std::shared_ptr<const PresetDefinition> preset);
+
+    void clear();
+
+    size_t cacheSize_;
+    std::unique_ptr<PresetBank> bank_;  // Set when the library was opened on a bank
+    bool builtIn_ = false;              // Set when the library was opened on the built-in presets
+    std::string root_;                  // Directory scanned, empty for a bank or the built-in presets
+    std::vector<PresetEntry> entries_;
+    std::vector<std::string> categories_;
+    std::vector<std::string> lowerCategories_;
+    std::unordered_map<std::string, size_t> nameIndex_;  // Lower-case name -> first entry
+    CacheList lru_;                                        // Most recently used first
+    std::unordered_map<size_t, CacheList::iterator> cached_;
+    size_t parseCount_ = 0;
+};
+
+} // namespace voicechanger
@@ -0,0 +1,233 @@
+#include "presets/PresetLoader.hpp"
+
+#include "presets/Json.hpp"
+#include "presets/PresetValidator.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <limits>
+
+namespace voicechanger {
+
+namespace {
+bool readString(const JsonValue& object, const std::string& key, std::string& out, const std::string& where,
+                std::string& error) {
+    const JsonValue* value = object.find(key);
+    if (!value || !value->isString() || value->asString().empty()) {
+        error = where + ": \"" + key + "\" must be a non-empty string";
+        return false;
+    }
+    out = value->asString();
+    return true;
+}
+
+bool parseNode(const JsonValue& node, const std::string& where, StageSpec& stage, std::string& error) {
+    if (!node.isObject()) {
+        error = where + ": must be an object";
+        return false;
+    }
+    if (!readString(node, "id", stage.id, where, error) || !readString(node, "type", stage.type, where, error)) {
+        return false;
+    }
+
+    const JsonValue* config = node.find("config");
+    if (!config) {
+        return true;
+    }
+    if (!config->isObject()) {
+        error = where + " (" + stage.id + "): \"config\" must be an object";
+        return false;
+    }
+    for (size_t i = 0; i < config->getKeys().size(); ++i) {
+        const std::string& key = config->getKeys()[i];
+        const JsonValue& value = config->getItems()[i];
+        float number;
+        if (value.isNumber()) {
+            // Beyond float range becomes the largest float, not inf, so the validator
+            // clamps it into the parameter's range and warns instead of rejecting it
+            constexpr double kFloatMax = std::numeric_limits<float>::max();
+            number = static_cast<float>(std::clamp(value.asNumber(), -kFloatMax, kFloatMax));
+        } else if (value.isBool()) {
+            number = value.asBool() ? 1.0f : 0.0f;
+        } else {
+            error = where + " (" + stage.id + "): config \"" + key + "\" must be a number";
+            return false;
+        }
+        stage.params.push_back({key, number});
+    }
+    return true;
+}
+
+bool readNumber(const JsonValue& object, const std::string& key, float& out, const std::string& where,
+                std::string& error) {
+    const JsonValue* value = object.find(key);
+    if (!value) {
+        return true;
+    }
+    if (!value->isNumber()) {
+        error = where + ": \"" + key + "\" must be a number";
+        return false;
+    }
+    out = static_cast<float>(value->asNumber());
+    return true;
+}
+
+bool parseModulator(const JsonValue& item, const std::string& where, ModulationSpec& modulation,
+                    std::string& error) {
+    if (!item.isObject()) {
+        error = where + ": must be an object";
+        return false;
+    }
+
+    std::string source;
+    std::string target;
+    if (!readString(item, "source", source, where, error) || !readString(item, "target", target, where, error)) {
+        return false;
+    }
+    if (source == "sine") {
+        modulation.source = dsp::ModulatorType::kSine;
+    } else if (source == "triangle") {
+        modulation.source = dsp::ModulatorType::kTriangle;
+    } else if (source == "envelope") {
+        modulation.source = dsp::ModulatorType::kEnvelope;
+    } else if (source == "random") {
+        modulation.source = dsp::ModulatorType::kRandomWalk;
+    } else {
+        error = where + ": unknown source \"" + source + "\" (sine, triangle, envelope or random)";
+        return false;
+    }
+
+    size_t dot = target.find('.');
+    modulation.stageId = target.substr(0, dot);
+    modulation.key = dot == std::string::npos ? std::string() : target.substr(dot + 1);
+
+    if (!item.find("depth")) {
+        error = where + ": \"depth\" must be a number";
+        return false;
+    }
+    if (!readNumber(item, "depth", modulation.depth, where, error) ||
+        !readNumber(item, "rate", modulation.rateHz, where, error) ||
+        !readNumber(item, "attackMs", modulation.attackMs, where, error) ||
+        !readNumber(item, "releaseMs", modulation.releaseMs, where, error)) {
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+bool parsePreset(const std::string& json, PresetDefinition& preset, std::string& error) {
+    preset = PresetDefinition();
+
+    JsonValue document;
+    if (!JsonValue::parse(json, document, error)) {
+        return false;
+    }
+    if (!document.isObject()) {
+        error = "the preset must be a JSON object";
+        return false;
+    }
+    if (!readString(document, "name", preset.name, "preset", error)) {
+        return false;
+    }
+    if (const JsonValue* description = document.find("description")) {
+        if (!description->isString()) {
+            error = "preset: \"description\" must be a string";
+            return false;
+        }
+        preset.description = description->asString();
+    }
+    if (const JsonValue* category = document.find("category")) {
+        if (!category->isString()) {
+            error = "preset: \"category\" must be a string";
+            return false;
+        }
+        preset.category = category->asString();
+    }
+    if (const JsonValue* tags = document.find("tags")) {
+        if (!tags->isArray()) {
+            error = "preset: \"tags\" must be an array of strings";
+            return false;
+        }
+        for (const auto& tag : tags->getItems()) {
+            if (!tag.isString()) {
+                error = "preset: \"tags\" must be an array of strings";
+                return false;
+            }
+            preset.tags.push_back(tag.asString());
+        }
+    }
+
+    const JsonValue* graph = document.find("graph");
+    if (!graph || !graph->isObject()) {
+        error = "preset: \"graph\" must be an object";
+        return false;
+    }
+
+    const JsonValue* nodes = graph->find("nodes");
+    if (!nodes || !nodes->isArray()) {
+        error = "graph: \"nodes\" must be an array";
+        return false;
+    }
+    for (size_t i = 0; i < nodes->getItems().size(); ++i) {
+        StageSpec stage;
+        if (!parseNode(nodes->getItems()[i], "graph.nodes[" + std::to_string(i) + "]", stage, error)) {
+            return false;
+        }
+        preset.nodes.push_back(std::move(stage));
+    }
+
+    const JsonValue* connections = graph->find("connections");
+    if (!connections || !connections->isArray()) {
+        error = "graph: \"connections\" must be an array";
+        return false;
+    }
+    for (size_t i = 0; i < connections->getItems().size(); ++i) {
+        const JsonValue& item = connections->getItems()[i];
+        std::string where = "graph.connections[" + std::to_string(i) + "]";
+        if (!item.isObject()) {
+            error = where + ": must be an object";
+            return false;
+        }
+        PresetConnection connection;
+        if (!readString(item, "sourceNode", connection.source, where, error) ||
+            !readString(item, "destinationNode", connection.destination, where, error)) {
+            return false;
+        }
+        preset.connections.push_back(std::move(connection));
+    }
+
+    if (const JsonValue* modulators = document.find("modulators")) {
+        if (!modulators->isArray()) {
+            error = "preset: \"modulators\" must be an array";
+            return false;
+        }
+        for (size_t i = 0; i < modulators->getItems().size(); ++i) {
+            ModulationSpec modulation;
+            if (!parseModulator(modulators->getItems()[i], "modulators[" + std::to_string(i) + "]", modulation,
+                                error)) {
+                return false;
+            }
+            preset.chain.modulations.push_back(std::move(modulation));
+        }
+    }
+
+    return validatePreset(preset, error);
+}
+
+bool loadPresetFile(const std::string& path, PresetDefinition& preset, std::string& error) {
+    std::ifstream file(path);
+    if (!file) {
+        error = path + ": cannot open file";
+        return false;
+    }
+    std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (!parsePreset(content, preset, error)) {
+        error = path + ": " + error;
+        return false;
+    }
+    return true;
+}
+
+} // namespace voicechanger
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "chain/VoiceChain.hpp"
+
+#include <string>
+#include <vector>
+
+namespace voicechanger {
+
+/**
+ * One edge of a preset graph.
+ */
+struct PresetConnection {
+    std::string source;
+    std::string destination;
+};
+
+/**
+ * A preset file, parsed and validated.
+ *
+ * nodes and connections mirror the file; chain holds the nodes on the path
+ * from inputNode to outputNode in processing order, ready to hand to a
+ * VoiceChanger.Chain node.
+ */
+struct PresetDefinition {
+    std::string name;
+    std::string description;
+    std::string category;
+    std::vector<std::string> tags;
+    std::vector<StageSpec> nodes;
+    std::vector<PresetConnection> connections;
+    ChainSpec chain;
+    std::vector<std::string> warnings;  // Values clamped into range by validatePreset()
+};
+
+/**
+ * @brief Parses and validates a preset document.
+ *
+ * "category" (a string) and "tags" (an array of strings) are optional and
+ * only used to browse a PresetLibrary; when present they should come before
+ * "graph" so the library can index a file from its first few kilobytes.
+ *
+ * Every config value must be a number (or a bool, read as 0/1). Once the
+ * document has the right shape the preset goes through validatePreset()
+ * (see PresetValidator.hpp), which checks node types, parameter keys and
+ * ranges, connections and modulators, resolves keys to table ids and
+ * clamps out-of-range values, listing them in preset.warnings.
+ *
+ * An optional "modulators" array adds modulation routes to the chain:
+ * {"source": "sine" | "triangle" | "envelope" | "random",
+ *  "target": "<nodeId>.<parameter>", "depth": <parameter units>,
+ *  "rate": <Hz>, "attackMs": <ms>, "releaseMs": <ms>}. The target must be
+ * a continuous parameter of a PitchShift or RingMod node (see
+ * ModulationMatrix::canModulate); rate, attackMs and releaseMs are optional.
+ *
+ * @param error Receives the reason when false is returned.
+ */
+bool parsePreset(const std::string& json, PresetDefinition& preset, std::string& error);
+
+/**
+ * @brief Reads and parses a preset file.
+ * @param error Receives the reason, prefixed with the path, when false is returned.
+ */
+bool loadPresetFile(const std::string& path, PresetDefinition& preset, std::string& error);
+
+} // namespace voicechanger
@@ -0,0 +1,234 @@
+#include "presets/PresetValidator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <set>
+#include <sstream>
+
+namespace voicechanger {
+
+namespace {
+constexpr const char* kInputNode = "inputNode";
+constexpr const char* kOutputNode = "outputNode";
+
+std::string formatNumber(float value) {
+    std::ostringstream text;
+    text << value;
+    return text.str();
+}
+
+std::string knownTypes() {
+    std::string list;
+    for (const auto& type : VoiceChain::getStageTypes()) {
+        list += (list.empty() ? "" : ", ") + type;
+    }
+    return list;
+}
+
+std::string settableKeys(const ParameterizedNode& node) {
+    std::string list;
+    for (uint32_t id = 0; id < node.getParameterCount(); ++id) {
+        const auto& descriptor = node.getParameterDescriptor(id);
+        if (!descriptor.readOnly) {
+            list += (list.empty() ? "" : ", ") + std::string(descriptor.key);
+        }
+    }
+    return list;
+}
+
+bool validateStage(StageSpec& stage, const std::string& where, std::vector<std::string>& warnings,
+                   std::string& error) {
+    if (stage.id.empty() || stage.id.find('.') != std::string::npos) {
+        error = where + ": id \"" + stage.id + "\" must be non-empty and contain no '.'";
+        return false;
+    }
+    if (stage.id == kInputNode || stage.id == kOutputNode) {
+        error = where + ": node id \"" + stage.id + "\" is reserved";
+        return false;
+    }
+    const std::string at = where + " (" + stage.id + ")";
+
+    auto probe = VoiceChain::createStage(stage.type);
+    if (!probe) {
+        error = at + ": unknown type " + stage.type + " (known types: " + knownTypes() + ")";
+        return false;
+    }
+
+    std::set<std::string> seen;
+    for (auto& param : stage.params) {
+        int id = probe->findParameter(param.key);
+        if (id == ParameterizedNode::kUnknownParameter) {
+            error = at + ": unknown parameter \"" + param.key + "\" for " + stage.type + " (settable: " +
+                    settableKeys(*probe) + ")";
+            return false;
+        }
+        const auto& descriptor = probe->getParameterDescriptor(static_cast<uint32_t>(id));
+        if (descriptor.readOnly) {
+            error = at + ": \"" + param.key + "\" is read-only";
+            return false;
+        }
+        if (param.id != ParameterizedNode::kUnknownParameter && param.id != id) {
+            error = at + ": \"" + param.key + "\" has id " + std::to_string(param.id) + ", expected " +
+                    std::to_string(id);
+            return false;
+        }
+        if (!seen.insert(param.key).second) {
+            error = at + ": \"" + param.key + "\" is set twice";
+            return false;
+        }
+        if (!std::isfinite(param.value)) {
+            error = at + ": \"" + param.key + "\" must be a finite number";
+            return false;
+        }
+        float clamped = std::clamp(param.value, descriptor.minValue, descriptor.maxValue);
+        if (clamped != param.value) {
+            warnings.push_back(at + ": \"" + param.key + "\" " + formatNumber(param.value) + " is outside " +
+                               formatNumber(descriptor.minValue) + " to " + formatNumber(descriptor.maxValue) +
+                               ", using " + formatNumber(clamped));
+            param.value = clamped;
+        }
+        param.id = id;
+    }
+    return true;
+}
+
+bool validateModulation(const ModulationSpec& modulation, const std::string& where,
+                        const std::vector<StageSpec>& stages, std::string& error) {
+    if (modulation.source > dsp::ModulatorType::kRandomWalk) {
+        error = where + ": unknown source";
+        return false;
+    }
+
+    // "stageId.key", naming a continuous parameter of a node that ramps it
+    const std::string target = modulation.stageId + "." + modulation.key;
+    auto stage = std::find_if(stages.begin(), stages.end(),
+                              [&](const StageSpec& node) { return node.id == modulation.stageId; });
+    if (stage == stages.end()) {
+        error = where + ": target \"" + target + "\" names an unknown node";
+        return false;
+    }
+    auto probe = VoiceChain::createStage(stage->type);
+    int id = probe ? probe->findParameter(modulation.key) : ParameterizedNode::kUnknownParameter;
+    if (id == ParameterizedNode::kUnknownParameter ||
+        !ModulationMatrix::canModulate(*probe, static_cast<uint32_t>(id))) {
+        error = where + ": \"" + target + "\" cannot be modulated";
+        return false;
+    }
+
+    if (!std::isfinite(modulation.depth)) {
+        error = where + ": \"depth\" must be a finite number";
+        return false;
+    }
+    if (!(modulation.rateHz > 0.0f) || !(modulation.attackMs >= 0.0f) || !(modulation.releaseMs >= 0.0f) ||
+        !std::isfinite(modulation.rateHz + modulation.attackMs + modulation.releaseMs)) {
+        error = where + ": rate must be positive and attackMs, releaseMs not negative";
+        return false;
+    }
+    return true;
+}
+
+bool buildChain(PresetDefinition& preset, std::string& error) {
+    std::map<std::string, const StageSpec*> nodesById;
+    for (size_t i = 0; i < preset.nodes.size(); ++i) {
+        const StageSpec& node = preset.nodes[i];
+        if (!nodesById.emplace(node.id, &node).second) {
+            error = "graph.nodes[" + std::to_string(i) + "]: duplicate node id \"" + node.id + "\"";
+            return false;
+        }
+    }
+
+    std::map<std::string, std::string> next;
+    for (size_t i = 0; i < preset.connections.size(); ++i) {
+        const PresetConnection& connection = preset.connections[i];
+        const std::string where = "graph.connections[" + std::to_string(i) + "]";
+        bool knownSource = connection.source == kInputNode || nodesById.count(connection.source);
+        bool knownDestination = connection.destination == kOutputNode || nodesById.count(connection.destination);
+        if (!knownSource || !knownDestination) {
+            error = where + ": connection " + connection.source + " -> " + connection.destination +
+                    " names an unknown node";
+            return false;
+        }
+        if (!next.emplace(connection.source, connection.destination).second) {
+            error = where + ": node \"" + connection.source + "\" has more than one output; only chains are supported";
+            return false;
+        }
+    }
+
+    preset.chain.name = preset.name;
+    preset.chain.stages.clear();
+    std::set<std::string> visited;
+    std::string current = kInputNode;
+    while (current != kOutputNode) {
+        auto it = next.find(current);
+        if (it == next.end()) {
+            error = "the chain stops at \"" + current + "\" before reaching outputNode";
+            return false;
+        }
+        current = it->second;
+        if (current == kOutputNode) {
+            break;
+        }
+        if (!visited.insert(current).second) {
+            error = "the chain loops back to \"" + current + "\"";
+            return false;
+        }
+        preset.chain.stages.push_back(*nodesById[current]);
+    }
+
+    if (preset.chain.stages.size() != preset.nodes.size()) {
+        for (const auto& node : preset.nodes) {
+            if (!visited.count(node.id)) {
+                error = "node \"" + node.id + "\" is not on the path from inputNode to outputNode";
+                return false;
+            }
+        }
+    }
+    return true;
+}
+} // namespace
+
+bool validatePreset(PresetDefinition& preset, std::string& error) {
+    preset.warnings.clear();
+    for (size_t i = 0; i < preset.nodes.size(); ++i) {
+        if (!validateStage(preset.nodes[i], "graph.nodes[" + std::to_string(i) + "]", preset.warnings, error)) {
+            return false;
+        }
+    }
+    if (!buildChain(preset, error)) {
+        return false;
+    }
+    for (size_t i = 0; i < preset.chain.modulations.size(); ++i) {
+        if (!validateModulation(preset.chain.modulations[i], "modulators[" + std::to_string(i) + "]",
+                                preset.nodes, error)) {
+            return false;
+        }
+    }
+    preset.chain.validated = true;
+    return true;
+}
+
+bool validateChain(ChainSpec& chain, std::vector<std::string>& warnings, std::string& error) {
+    chain.validated = false;
+    std::set<std::string> ids;
+    for (size_t i = 0; i < chain.stages.size(); ++i) {
+        const std::string where = "stages[" + std::to_string(i) + "]";
+        if (!validateStage(chain.stages[i], where, warnings, error)) {
+            return false;
+        }
+        if (!ids.insert(chain.stages[i].id).second) {
+            error = where + ": duplicate node id \"" + chain.stages[i].id + "\"";
+            return false;
+        }
+    }
+    for (size_t i = 0; i < chain.modulations.size(); ++i) {
+        if (!validateModulation(chain.modulations[i], "modulators[" + std::to_string(i) + "]", chain.stages,
+                                error)) {
+            return false;
+        }
+    }
+    chain.validated = true;
+    return true;
+}
+
+} // namespace voicechanger
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "presets/PresetLoader.hpp"
+
+#include <string>
+#include <vector>
+
+namespace voicechanger {
+
+/**
+ * @brief Checks a parsed preset against the stages a VoiceChanger.Chain
+ *        node can build, and fills in preset.chain.
+ *
+ * Every node needs a unique id (not inputNode or outputNode, and without a
+ * '.', which separates node and parameter in modulator targets) and a type
+ * from VoiceChain::getStageTypes(). Every config key must name a settable
+ * parameter of that type, once, with a finite value; keys are resolved to
+ * table ids here. A value outside the parameter's range is clamped into it
+ * and reported in preset.warnings rather than rejected, so a chain built
+ * from the preset never sees an out-of-range value. The connections must
+ * form a single path from inputNode to outputNode through every node, and
+ * each modulator must target a parameter ModulationMatrix::canModulate()
+ * accepts, with a positive rate and non-negative times.
+ *
+ * Errors name the offending member ("graph.nodes[2] (ringMod): ...",
+ * "modulators[0]: ..."). On success the chain is marked validated.
+ *
+ * @param error Receives the first problem when false is returned.
+ */
+bool validatePreset(PresetDefinition& preset, std::string& error);
+
+/**
+ * @brief The same checks for a chain that is already in processing order,
+ *        such as one read from a PresetBank: stage ids, types, parameters
+ *        and modulators, with clamped values reported in warnings. Ids
+ *        already set on parameters must match the current tables.
+ */
+bool validateChain(ChainSpec& chain, std::vector<std::string>& warnings, std::string& error);
+
+} // namespace voicechanger
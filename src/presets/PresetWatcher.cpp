@@ -0,0 +1,145 @@
+#include "presets/PresetWatcher.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+namespace voicechanger {
+
+namespace {
+constexpr uint32_t kFileEvents = IN_CLOSE_WRITE | IN_MOVED_TO;
+constexpr uint32_t kWatchEvents = kFileEvents | IN_CREATE | IN_ONLYDIR;
+
+bool isPresetFile(const std::string& name) {
+    return name.size() > 5 && name.compare(name.size() - 5, 5, ".json") == 0;
+}
+} // namespace
+
+PresetWatcher::~PresetWatcher() {
+    stop();
+}
+
+bool PresetWatcher::start(const std::string& directory, std::string& error) {
+    stop();
+
+    inotifyFd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    stopFd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (inotifyFd_ < 0 || stopFd_ < 0) {
+        error = std::string("cannot start watching presets: ") + std::strerror(errno);
+        stop();
+        return false;
+    }
+    if (!addWatch(directory)) {
+        error = directory + ": " + std::strerror(errno);
+        stop();
+        return false;
+    }
+    std::error_code ec;
+    for (std::filesystem::recursive_directory_iterator it(directory, ec), end; !ec && it != end; it.increment(ec)) {
+        if (it->is_directory(ec)) {
+            addWatch(it->path().string());
+        }
+    }
+
+    thread_ = std::thread(&PresetWatcher::run, this);
+    return true;
+}
+
+void PresetWatcher::stop() {
+    if (thread_.joinable()) {
+        uint64_t one = 1;
+        ssize_t written = write(stopFd_, &one, sizeof(one));
+        (void)written;
+        thread_.join();
+    }
+    if (inotifyFd_ >= 0) {
+        close(inotifyFd_);
+        inotifyFd_ = -1;
+    }
+    if (stopFd_ >= 0) {
+        close(stopFd_);
+        stopFd_ = -1;
+    }
+    directories_.clear();
+}
+
+std::vector<PresetWatcher::Update> PresetWatcher::takeUpdates() {
+    std::lock_guard<std::mutex> lock(updatesMutex_);
+    std::vector<Update> updates;
+    updates.swap(updates_);
+    return updates;
+}
+
+bool PresetWatcher::addWatch(const std::string& directory) {
+    int wd = inotify_add_watch(inotifyFd_, directory.c_str(), kWatchEvents);
+    if (wd < 0) {
+        return false;
+    }
+    directories_[wd] = directory;
+    return true;
+}
+
+void PresetWatcher::run() {
+    std::set<std::string> changed;
+    while (true) {
+        // Block until something happens; once a file has changed, wait only until things settle
+        pollfd fds[2] = {{inotifyFd_, POLLIN, 0}, {stopFd_, POLLIN, 0}};
+        int ready = poll(fds, 2, changed.empty() ? -1 : kSettleMs);
+        if (ready < 0 && errno != EINTR) {
+            return;
+        }
+        if (fds[1].revents & POLLIN) {
+            return;
+        }
+        if (ready > 0 && (fds[0].revents & POLLIN)) {
+            readEvents(changed);
+            continue;
+        }
+        if (ready == 0) {
+            for (const auto& path : changed) {
+                auto preset = std::make_shared<PresetDefinition>();
+                Update update{path, nullptr, {}};
+                if (loadPresetFile(path, *preset, update.error)) {
+                    update.preset = std::move(preset);
+                }
+                std::lock_guard<std::mutex> lock(updatesMutex_);
+                updates_.push_back(std::move(update));
+            }
+            changed.clear();
+        }
+    }
+}
+
+void PresetWatcher::readEvents(std::set<std::string>& changed) {
+    alignas(inotify_event) char buffer[4096];
+    while (true) {
+        ssize_t length = read(inotifyFd_, buffer, sizeof(buffer));
+        if (length <= 0) {
+            return;
+        }
+        for (ssize_t offset = 0; offset < length;) {
+            const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+            auto directory = directories_.find(event->wd);
+            if (directory == directories_.end() || event->len == 0) {
+                continue;
+            }
+            std::string path = (std::filesystem::path(directory->second) / event->name).string();
+            if (event->mask & IN_ISDIR) {
+                // A new category directory
+                if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                    addWatch(path);
+                }
+            } else if ((event->mask & kFileEvents) && isPresetFile(event->name)) {
+                changed.insert(path);
+            }
+        }
+    }
+}
+
+} // namespace voicechanger
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "presets/PresetLoader.hpp"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace voicechanger {
+
+/**
+ * PresetWatcher - Reparses preset files as they are edited.
+ *
+ * start() watches a presets directory and its subdirectories with inotify
+ * and starts a background thread. When a .json file is written, created
+ * or moved in, the thread waits until the directory has been quiet for
+ * kSettleMs (editors often save in several writes), parses and validates
+ * the file and queues the result. takeUpdates() hands the queued results
+ * to the control thread, which decides what to do with them; nothing here
+ * touches a running chain, so a file that fails to parse only produces an
+ * error message.
+ */
+class PresetWatcher {
+public:
+    static constexpr int kSettleMs = 100;
+
+    /**
+     * A file that changed: the parsed preset, or the reason it did not parse.
+     */
+    struct Update {
+        std::string path;
+        std::shared_ptr<const PresetDefinition> preset;  // nullptr if the file failed to load
+        std::string error;
+    };
+
+    PresetWatcher() = default;
+    ~PresetWatcher();
+
+    PresetWatcher(const PresetWatcher&) = delete;
+    PresetWatcher& operator=(const PresetWatcher&) = delete;
+
+    /**
+     * @brief Starts watching directory.
+     * @return False with the reason in error if inotify cannot watch it.
+     */
+    bool start(const std::string& directory, std::string& error);
+
+    /**
+     * @brief Stops the background thread and releases the watches.
+     */
+    void stop();
+
+    bool isRunning() const { return thread_.joinable(); }
+
+    /**
+     * @brief Returns the files parsed since the last call, oldest first.
+     */
+    std::vector<Update> takeUpdates();
+
+private:
+    bool addWatch(const std::string& directory);
+    void run();
+    void readEvents(std::set<std::string>& changed);
+
+    int inotifyFd_ = -1;
+    int stopFd_ = -1;  // eventfd that wakes the thread to stop
+    std::map<int, std::string> directories_;  // Watch descriptor -> directory; background thread after start()
+    std::thread thread_;
+
+    std::mutex updatesMutex_;
+    std::vector<Update> updates_;
+};
+
+} // namespace voicechanger
@@ -0,0 +1,407 @@
+/**
+ * Built-in preset generator
+ *
+ * Turns the shipped JSON presets into the constexpr tables that
+ * presets/VoicePresets.hpp includes, so the built-in presets cannot drift
+ * from the files:
+ *
+ *   generate-presets <output.inc> <preset.json>...
+ *
+ * The generator only checks what it needs to lay the tables out (the JSON
+ * shape and the path from inputNode to outputNode). Parameter keys and
+ * ranges are checked by the compiler: every value is emitted with
+ * static_asserts against the node's own constexpr parameter table, so a
+ * preset outside a range, or modulating a parameter the modulation matrix
+ * would refuse, fails the build with the file and key in the message. Runs at build time, before any node code is compiled, so it
+ * only links the JSON parser.
+ */
+
+#include "presets/Json.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using voicechanger::JsonValue;
+
+namespace {
+
+struct Param {
+    std::string key;
+    float value;
+};
+
+struct Stage {
+    std::string id;
+    std::string type;
+    std::vector<Param> params;
+};
+
+struct Modulation {
+    std::string source;
+    std::string stageType;
+    std::string stageId;
+    std::string key;
+    float depth = 0.0f;
+    float rateHz = 1.0f;
+    float attackMs = 10.0f;
+    float releaseMs = 200.0f;
+};
+
+struct Preset {
+    std::string file;
+    std::string name;
+    std::string description;
+    std::string category;
+    std::vector<std::string> tags;
+    std::vector<Stage> stages;  // In processing order
+    std::vector<Modulation> modulations;
+};
+
+std::string baseName(const std::string& path) {
+    size_t slash = path.find_last_of('/');
+    return slash == std::string::npos ? path : path.substr(slash + 1);
+}
+
+// A C++ string literal. Control characters become three-digit octal
+// escapes, which unlike \x cannot run on into a following character
+std::string quote(const std::string& text) {
+    std::string out = "\"";
+    for (char c : text) {
+        auto byte = static_cast<unsigned char>(c);
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (c == '\n') {
+            out += "\\n";
+        } else if (c == '\t') {
+            out += "\\t";
+        } else if (byte < 0x20 || byte == 0x7f) {
+            char escape[5];
+            std::snprintf(escape, sizeof(escape), "\\%03o", byte);
+            out += escape;
+        } else {
+            out += c;
+        }
+    }
+    return out + "\"";
+}
+
+// A float literal that reads back as exactly the same float
+std::string literal(float value) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.9g", static_cast<double>(value));
+    std::string out = text;
+    if (out.find_first_of(".en") == std::string::npos) {
+        out += ".0";
+    }
+    return out + "f";
+}
+
+// For messages: "0.3" rather than "0.300000012"
+std::string shortNumber(float value) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%g", static_cast<double>(value));
+    return text;
+}
+
+// "VoiceChanger.PitchShift" -> "PitchShiftNode"
+bool nodeClass(const std::string& type, std::string& out) {
+    const std::string prefix = "VoiceChanger.";
+    if (type.compare(0, prefix.size(), prefix) != 0 || type.size() == prefix.size()) {
+        return false;
+    }
+    out = type.substr(prefix.size()) + "Node";
+    return true;
+}
+
+bool readString(const JsonValue& object, const char* key, std::string& out) {
+    const JsonValue* value = object.find(key);
+    if (!value || !value->isString()) {
+        return false;
+    }
+    out = value->asString();
+    return true;
+}
+
+bool readNumber(const JsonValue& object, const char* key, float& out) {
+    const JsonValue* value = object.find(key);
+    if (value && value->isNumber()) {
+        out = static_cast<float>(value->asNumber());
+    }
+    return !value || value->isNumber();
+}
+
+bool readPreset(const std::string& path, Preset& preset, std::string& error) {
+    std::ifstream file(path);
+    if (!file) {
+        error = "cannot open file";
+        return false;
+    }
+    std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    JsonValue document;
+    if (!JsonValue::parse(text, document, error)) {
+        return false;
+    }
+    if (!document.isObject() || !readString(document, "name", preset.name)) {
+        error = "\"name\" must be a string";
+        return false;
+    }
+    readString(document, "description", preset.description);
+    readString(document, "category", preset.category);
+    if (const JsonValue* tags = document.find("tags")) {
+        if (!tags->isArray()) {
+            error = "\"tags\" must be an array of strings";
+            return false;
+        }
+        for (const auto& tag : tags->getItems()) {
+            if (!tag.isString()) {
+                error = "\"tags\" must be an array of strings";
+                return false;
+            }
+            preset.tags.push_back(tag.asString());
+        }
+    }
+
+    const JsonValue* graph = document.find("graph");
+    const JsonValue* nodes = graph ? graph->find("nodes") : nullptr;
+    const JsonValue* connections = graph ? graph->find("connections") : nullptr;
+    if (!nodes || !nodes->isArray() || !connections || !connections->isArray()) {
+        error = "\"graph\" must have \"nodes\" and \"connections\" arrays";
+        return false;
+    }
+
+    std::map<std::string, Stage> stages;
+    for (const auto& node : nodes->getItems()) {
+        Stage stage;
+        if (!node.isObject() || !readString(node, "id", stage.id) || !readString(node, "type", stage.type)) {
+            error = "every node needs an \"id\" and a \"type\"";
+            return false;
+        }
+        std::string unused;
+        if (!nodeClass(stage.type, unused)) {
+            error = stage.id + ": unknown type " + stage.type;
+            return false;
+        }
+        if (const JsonValue* config = node.find("config")) {
+            for (size_t i = 0; config->isObject() && i < config->getKeys().size(); ++i) {
+                const JsonValue& value = config->getItems()[i];
+                if (!value.isNumber() && !value.isBool()) {
+                    error = stage.id + ": config \"" + config->getKeys()[i] + "\" must be a number";
+                    return false;
+                }
+                float number = value.isBool() ? (value.asBool() ? 1.0f : 0.0f) : static_cast<float>(value.asNumber());
+                stage.params.push_back({config->getKeys()[i], number});
+            }
+        }
+        if (!stages.emplace(stage.id, stage).second) {
+            error = "duplicate node id \"" + stage.id + "\"";
+            return false;
+        }
+    }
+
+    // Follow the single path from inputNode to outputNode
+    std::map<std::string, std::string> next;
+    for (const auto& connection : connections->getItems()) {
+        std::string source;
+        std::string destination;
+        if (!connection.isObject() || !readString(connection, "sourceNode", source) ||
+            !readString(connection, "destinationNode", destination) || !next.emplace(source, destination).second) {
+            error = "connections must form a single chain";
+            return false;
+        }
+    }
+    std::set<std::string> visited;
+    for (std::string current = next["inputNode"]; current != "outputNode"; current = next[current]) {
+        auto stage = stages.find(current);
+        if (stage == stages.end() || !visited.insert(current).second) {
+            error = "the chain from inputNode does not reach outputNode";
+            return false;
+        }
+        preset.stages.push_back(stage->second);
+    }
+    if (preset.stages.size() != stages.size()) {
+        error = "every node must be on the path from inputNode to outputNode";
+        return false;
+    }
+
+    if (const JsonValue* modulators = document.find("modulators")) {
+        for (size_t i = 0; modulators->isArray() && i < modulators->getItems().size(); ++i) {
+            const JsonValue& item = modulators->getItems()[i];
+            Modulation modulation;
+            std::string target;
+            if (!item.isObject() || !readString(item, "source", modulation.source) ||
+                !readString(item, "target", target) || !item.find("depth") ||
+                !readNumber(item, "depth", modulation.depth) || !readNumber(item, "rate", modulation.rateHz) ||
+                !readNumber(item, "attackMs", modulation.attackMs) ||
+                !readNumber(item, "releaseMs", modulation.releaseMs)) {
+                error = "modulators[" + std::to_string(i) + "]: needs \"source\", \"target\" and \"depth\"";
+                return false;
+            }
+            size_t dot = target.find('.');
+            modulation.stageId = target.substr(0, dot);
+            modulation.key = dot == std::string::npos ? std::string() : target.substr(dot + 1);
+            auto stage = stages.find(modulation.stageId);
+            if (stage == stages.end()) {
+                error = "modulators[" + std::to_string(i) + "]: target \"" + target + "\" names an unknown node";
+                return false;
+            }
+            modulation.stageType = stage->second.type;
+            preset.modulations.push_back(modulation);
+        }
+    }
+    return true;
+}
+
+bool modulatorType(const std::string& source, std::string& out) {
+    static const std::map<std::string, std::string> types = {
+        {"sine", "kSine"}, {"triangle", "kTriangle"}, {"envelope", "kEnvelope"}, {"random", "kRandomWalk"}};
+    auto it = types.find(source);
+    if (it == types.end()) {
+        return false;
+    }
+    out = "dsp::ModulatorType::" + it->second;
+    return true;
+}
+
+bool writeTables(std::ostream& out, const std::vector<Preset>& presets, std::string& error) {
+    out << "// Generated by generate-presets from src/presets/json; do not edit.\n"
+        << "// Included by presets/VoicePresets.hpp inside namespace voicechanger::builtin.\n";
+
+    for (size_t p = 0; p < presets.size(); ++p) {
+        const Preset& preset = presets[p];
+        const std::string prefix = "kPreset" + std::to_string(p);
+        out << "\n// " << preset.file << "\n";
+
+        if (!preset.tags.empty()) {
+            out << "inline constexpr const char* " << prefix << "Tags[] = {";
+            for (size_t t = 0; t < preset.tags.size(); ++t) {
+                out << (t ? ", " : "") << quote(preset.tags[t]);
+            }
+            out << "};\n";
+        }
+
+        for (size_t s = 0; s < preset.stages.size(); ++s) {
+            const Stage& stage = preset.stages[s];
+            if (stage.params.empty()) {
+                continue;
+            }
+            std::string node;
+            nodeClass(stage.type, node);
+            out << "inline constexpr BuiltInParam " << prefix << "Stage" << s << "[] = {\n";
+            for (const auto& param : stage.params) {
+                out << "    {" << quote(param.key) << ", parameterId<" << node << ">(" << quote(param.key)
+                    << "), " << literal(param.value) << "},\n";
+            }
+            out << "};\n";
+            for (const auto& param : stage.params) {
+                std::string where = preset.file + ": " + stage.id + "." + param.key;
+                out << "static_assert(isSettable<" << node << ">(" << quote(param.key) << "), "
+                    << quote(where + " is not a settable " + node + " parameter") << ");\n"
+                    << "static_assert(inRange<" << node << ">(" << quote(param.key) << ", " << literal(param.value)
+                    << "), " << quote(where + " = " + shortNumber(param.value) + " is outside the " + node + " range")
+                    << ");\n";
+            }
+        }
+
+        out << "inline constexpr BuiltInStage " << prefix << "Stages[] = {\n";
+        for (size_t s = 0; s < preset.stages.size(); ++s) {
+            const Stage& stage = preset.stages[s];
+            out << "    {" << quote(stage.id) << ", " << quote(stage.type) << ", ";
+            if (stage.params.empty()) {
+                out << "nullptr, 0},\n";
+            } else {
+                out << prefix << "Stage" << s << ", " << stage.params.size() << "},\n";
+            }
+        }
+        out << "};\n";
+
+        if (!preset.modulations.empty()) {
+            out << "inline constexpr BuiltInModulation " << prefix << "Modulations[] = {\n";
+            for (const auto& modulation : preset.modulations) {
+                std::string source;
+                if (!modulatorType(modulation.source, source)) {
+                    error = preset.file + ": unknown modulation source \"" + modulation.source + "\"";
+                    return false;
+                }
+                out << "    {" << source << ", " << quote(modulation.stageId) << ", " << quote(modulation.key) << ", "
+                    << literal(modulation.depth) << ", " << literal(modulation.rateHz) << ", "
+                    << literal(modulation.attackMs) << ", " << literal(modulation.releaseMs) << "},\n";
+            }
+            out << "};\n";
+            for (const auto& modulation : preset.modulations) {
+                std::string node;
+                nodeClass(modulation.stageType, node);
+                std::string where = preset.file + ": modulation target " + modulation.stageId + "." + modulation.key;
+                out << "static_assert(isSettable<" << node << ">(" << quote(modulation.key) << "), "
+                    << quote(where + " is not a settable " + node + " parameter") << ");\n"
+                    << "static_assert(canModulate<" << node << ">(" << quote(modulation.key) << "), "
+                    << quote(where + " is not a " + node + " parameter that can be modulated") << ");\n";
+            }
+        }
+    }
+
+    out << "\ninline constexpr size_t kPresetCount = " << presets.size() << ";\n"
+        << "inline constexpr std::array<BuiltInPreset, kPresetCount> kPresets = {{\n";
+    for (size_t p = 0; p < presets.size(); ++p) {
+        const Preset& preset = presets[p];
+        const std::string prefix = "kPreset" + std::to_string(p);
+        out << "    {" << quote(preset.name) << ", " << quote(preset.description) << ", " << quote(preset.category)
+            << ", ";
+        if (preset.tags.empty()) {
+            out << "nullptr, 0, ";
+        } else {
+            out << prefix << "Tags, " << preset.tags.size() << ", ";
+        }
+        out << prefix << "Stages, " << preset.stages.size() << ", ";
+        if (preset.modulations.empty()) {
+            out << "nullptr, 0},\n";
+        } else {
+            out << prefix << "Modulations, " << preset.modulations.size() << "},\n";
+        }
+    }
+    out << "}};\n";
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <output.inc> <preset.json>..." << std::endl;
+        return 2;
+    }
+
+    std::vector<Preset> presets;
+    for (int i = 2; i < argc; ++i) {
+        Preset preset;
+        preset.file = baseName(argv[i]);
+        std::string error;
+        if (!readPreset(argv[i], preset, error)) {
+            std::cerr << argv[i] << ": " << error << std::endl;
+            return 1;
+        }
+        presets.push_back(std::move(preset));
+    }
+
+    std::ostringstream text;
+    std::string error;
+    if (!writeTables(text, presets, error)) {
+        std::cerr << "Error: " << error << std::endl;
+        return 1;
+    }
+
+    std::ofstream output(argv[1], std::ios::trunc);
+    output << text.str();
+    if (!output) {
+        std::cerr << "Error: cannot write " << argv[1] << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,58 @@
+/**
+ * Preset bank converter
+ *
+ * Compiles a directory of JSON presets into a binary bank that the demo
+ * (or an embedded build) can map instead of parsing JSON:
+ *
+ *   make-preset-bank <presets-dir> <output.bank>
+ *
+ * Every preset is parsed and validated first; a preset that fails is
+ * reported and left out, and values clamped into range are reported and
+ * stored clamped. The bank only loads in builds with the same
+ * parameter tables, so rebuild it after changing a node's parameters.
+ */
+
+#include "presets/PresetBank.hpp"
+#include "presets/PresetLibrary.hpp"
+
+#include <iostream>
+#include <vector>
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        std::cerr << "Usage: " << argv[0] << " <presets-dir> <output.bank>" << std::endl;
+        return 2;
+    }
+
+    voicechanger::PresetLibrary library;
+    std::string error;
+    if (!library.scan(argv[1], error)) {
+        std::cerr << "Error: " << error << std::endl;
+        return 1;
+    }
+
+    std::vector<voicechanger::PresetDefinition> presets;
+    presets.reserve(library.size());
+    for (size_t i = 0; i < library.size(); ++i) {
+        auto preset = library.load(i, error);
+        if (!preset) {
+            std::cerr << "Warning: Skipping preset " << error << std::endl;
+            continue;
+        }
+        for (const auto& warning : preset->warnings) {
+            std::cerr << "Warning: " << library.getEntry(i).path << ": " << warning << std::endl;
+        }
+        presets.push_back(*preset);
+    }
+    if (presets.empty()) {
+        std::cerr << "Error: No valid presets in " << argv[1] << std::endl;
+        return 1;
+    }
+
+    if (!voicechanger::PresetBank::write(argv[2], presets, error)) {
+        std::cerr << "Error: " << error << std::endl;
+        return 1;
+    }
+    std::cout << "Wrote " << presets.size() << " presets to " << argv[2] << std::endl;
+    return 0;
+}
@@ -7,6 +7,7 @@ Usage:
     inv build       - Build the project
     inv test        - Run all tests
     inv run         - Run the demo application
+    inv bank        - Compile the JSON presets into build/presets.bank
     inv clean       - Clean build artifacts
     inv rebuild     - Clean and rebuild
 """
@@ -166,9 +167,31 @@ def test(c, filter=None):
 
 
 @task(pre=[build])
-def run(c):
-    """Run the voice changer demo application."""
-    c.run(f"{BUILD_DIR}/voice-changer-demo")
+def run(c, bank=False, sample_rate=0, buffer_size=0, auto_latency=False):
+    """Run the voice changer demo application.
+
+    Args:
+        bank: Load build/presets.bank (see `inv bank`) instead of the JSON presets
+        sample_rate: Engine sample rate in Hz (default 44100)
+        buffer_size: Engine buffer size in frames (default 512)
+        auto_latency: Start at the smallest buffer size the first preset keeps up with
+    """
+    args = []
+    if sample_rate:
+        args.append(f"--sample-rate {sample_rate}")
+    if buffer_size:
+        args.append(f"--buffer-size {buffer_size}")
+    if auto_latency:
+        args.append("--auto-latency")
+    if bank:
+        args.append(f"{BUILD_DIR}/presets.bank")
+    c.run(" ".join([f"{BUILD_DIR}/voice-changer-demo"] + args))
+
+
+@task(pre=[build])
+def bank(c):
+    """Compile the JSON presets into a binary bank (run it with `inv run --bank`)."""
+    c.run(f"{BUILD_DIR}/make-preset-bank src/presets/json {BUILD_DIR}/presets.bank")
 
 
 @task
@@ -183,6 +206,12 @@ def test_baseline(c):
     c.run(f'{BUILD_DIR}/VoiceChangerTests "[baseline]"')
 
 
+@task
+def bench(c):
+    """Run CPU benchmarks (hidden from the default test run)."""
+    c.run(f'{BUILD_DIR}/VoiceChangerTests "[benchmark]"')
+
+
 @task
 def format(c):
     """Format source code with clang-format."""
@@ -0,0 +1,507 @@
+/**
+ * CPU benchmarks for the VoiceChanger nodes.
+ *
+ * Hidden from the default run; use `inv bench` or
+ * `VoiceChangerTests "[benchmark]"`. Each case reports nanoseconds per
+ * 512-frame stereo block and checks relative costs with generous margins.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "TestHelpers.hpp"
+#include "engine/EngineGraph.hpp"
+#include "nodes/ChainNode.hpp"
+#include "nodes/DelayNode.hpp"
+#include "nodes/DriveNode.hpp"
+#include "nodes/ModDelayNode.hpp"
+#include "nodes/PitchDetectNode.hpp"
+#include "nodes/PitchShiftNode.hpp"
+#include "nodes/RingModNode.hpp"
+#include "nodes/WhisperNode.hpp"
+#include "presets/PresetBank.hpp"
+#include "presets/PresetLibrary.hpp"
+
+#include <ChorusNode.hpp>
+#include <DelayNode.hpp>
+#include <FlangerNode.hpp>
+#include <VibratoNode.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <unistd.h>
+
+// Shipped preset directory (passed via CMake compile definition)
+#ifndef PRESETS_DIR
+#define PRESETS_DIR "src/presets/json"
+#endif
+
+using namespace voicechanger;
+using namespace voicechanger::test;
+
+// Global Switchboard initialization
+static SwitchboardInitializer switchboardInit;
+
+// Test constants
+constexpr uint SAMPLE_RATE = 44100;
+constexpr uint NUM_CHANNELS = 2;
+constexpr uint BUFFER_SIZE = 512;
+constexpr int BENCH_BLOCKS = 2000;
+
+/**
+ * Process BENCH_BLOCKS blocks of a 220 Hz tone and return the mean
+ * nanoseconds spent per block. An amplitude of 0 measures an idle stream.
+ */
+static double measureNanosPerBlock(switchboard::SingleBusAudioProcessorNode& node, float amplitude = 0.5f) {
+    switchboard::AudioBusFormat inputFormat(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    switchboard::AudioBusFormat outputFormat(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    REQUIRE(node.setBusFormat(inputFormat, outputFormat));
+
+    TestAudioBus inBus(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    TestAudioBus outBus(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+
+    // Warm up caches, any lazily sized state and idle detection (~1.2 s)
+    for (int i = 0; i < 100; ++i) {
+        inBus.fillWithSine(220.0f, amplitude, SAMPLE_RATE, i * BUFFER_SIZE);
+        node.process(inBus.bus, outBus.bus);
+    }
+
+    std::chrono::nanoseconds total{0};
+    for (int i = 0; i < BENCH_BLOCKS; ++i) {
+        inBus.fillWithSine(220.0f, amplitude, SAMPLE_RATE, i * BUFFER_SIZE);
+        auto start = std::chrono::steady_clock::now();
+        node.process(inBus.bus, outBus.bus);
+        total += std::chrono::steady_clock::now() - start;
+    }
+
+    return static_cast<double>(total.count()) / BENCH_BLOCKS;
+}
+
+/**
+ * Resident set size of this process in kilobytes.
+ */
+static long residentKb() {
+    long pages = 0;
+    long resident = 0;
+    std::ifstream statm("/proc/self/statm");
+    statm >> pages >> resident;
+    return resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+/**
+ * Print a result line in a stable, grep-friendly format.
+ */
+static void report(const std::string& name, double nanosPerBlock) {
+    double blockNanos = 1.0e9 * BUFFER_SIZE / SAMPLE_RATE;
+    std::cout << "[bench] " << name << ": " << nanosPerBlock / 1000.0 << " us/block ("
+              << 100.0 * nanosPerBlock / blockNanos << "% of one core)" << std::endl;
+}
+
+TEST_CASE("Benchmark - PitchDetect costs a small fraction of PitchShift", "[.][benchmark]") {
+    SBAnyMap config;
+    PitchShiftNode pitchShift(config);
+    PitchDetectNode pitchDetect(config);
+
+    double shiftNanos = measureNanosPerBlock(pitchShift);
+    double detectNanos = measureNanosPerBlock(pitchDetect);
+
+    report("PitchShift", shiftNanos);
+    report("PitchDetect", detectNanos);
+
+    REQUIRE(detectNanos < shiftNanos * 0.2);
+}
+
+TEST_CASE("Benchmark - targetMedianHz adds little over plain PitchShift", "[.][benchmark]") {
+    SBAnyMap plainConfig;
+    SBAnyMap targetConfig = {{"targetMedianHz", 160.0f}};
+    PitchShiftNode plain(plainConfig);
+    PitchShiftNode target(targetConfig);
+
+    double plainNanos = measureNanosPerBlock(plain);
+    double targetNanos = measureNanosPerBlock(target);
+
+    report("PitchShift", plainNanos);
+    report("PitchShift (targetMedianHz)", targetNanos);
+
+    REQUIRE(targetNanos < plainNanos * 1.25);
+}
+
+TEST_CASE("Benchmark - processingRate cuts PitchShift cost", "[.][benchmark]") {
+    SBAnyMap fullConfig;
+    SBAnyMap halfConfig = {{"processingRate", 22050.0f}};
+    SBAnyMap voiceConfig = {{"processingRate", 16000.0f}};
+    PitchShiftNode full(fullConfig);
+    PitchShiftNode half(halfConfig);
+    PitchShiftNode voice(voiceConfig);
+
+    double fullNanos = measureNanosPerBlock(full);
+    double halfNanos = measureNanosPerBlock(half);
+    double voiceNanos = measureNanosPerBlock(voice);
+
+    report("PitchShift", fullNanos);
+    report("PitchShift (22.05 kHz)", halfNanos);
+    report("PitchShift (16 kHz)", voiceNanos);
+
+    REQUIRE(halfNanos < fullNanos * 0.8);
+    REQUIRE(voiceNanos < fullNanos * 0.6);
+}
+
+TEST_CASE("Benchmark - denoise adds little over plain PitchShift", "[.][benchmark]") {
+    SBAnyMap plainConfig;
+    SBAnyMap denoiseConfig = {{"denoise", 1.0f}};
+    PitchShiftNode plain(plainConfig);
+    PitchShiftNode denoise(denoiseConfig);
+
+    double plainNanos = measureNanosPerBlock(plain);
+    double denoiseNanos = measureNanosPerBlock(denoise);
+
+    report("PitchShift", plainNanos);
+    report("PitchShift (denoise)", denoiseNanos);
+
+    REQUIRE(denoiseNanos < plainNanos * 1.25);
+}
+
+TEST_CASE("Benchmark - idleFreeze cuts idle-stream PitchShift cost", "[.][benchmark]") {
+    SBAnyMap plainConfig;
+    SBAnyMap freezeConfig = {{"idleFreeze", 1.0f}};
+    PitchShiftNode plain(plainConfig);
+    PitchShiftNode freeze(freezeConfig);
+
+    double plainIdleNanos = measureNanosPerBlock(plain, 0.0f);
+    double freezeIdleNanos = measureNanosPerBlock(freeze, 0.0f);
+    double freezeActiveNanos = measureNanosPerBlock(freeze);
+    double plainActiveNanos = measureNanosPerBlock(plain);
+
+    report("PitchShift idle", plainIdleNanos);
+    report("PitchShift idle (idleFreeze)", freezeIdleNanos);
+    report("PitchShift active", plainActiveNanos);
+    report("PitchShift active (idleFreeze)", freezeActiveNanos);
+
+    REQUIRE(freezeIdleNanos < plainIdleNanos * 0.2);
+    // The detector itself is cheap while speech is active
+    REQUIRE(freezeActiveNanos < plainActiveNanos * 1.1);
+}
+
+TEST_CASE("Benchmark - Drive cost per oversampling factor", "[.][benchmark]") {
+    double nanos[3] = {};
+    const float factors[3] = {1.0f, 2.0f, 4.0f};
+    for (int i = 0; i < 3; ++i) {
+        SBAnyMap config = {{"oversampling", factors[i]}};
+        DriveNode drive(config);
+        nanos[i] = measureNanosPerBlock(drive);
+        report("Drive " + std::to_string(static_cast<int>(factors[i])) + "x", nanos[i]);
+    }
+
+    SBAnyMap config;
+    PitchShiftNode pitchShift(config);
+    double shiftNanos = measureNanosPerBlock(pitchShift);
+    report("PitchShift", shiftNanos);
+
+    REQUIRE(nanos[2] < shiftNanos);
+}
+
+TEST_CASE("Benchmark - ModDelay costs less than separate vibrato/chorus/flanger", "[.][benchmark]") {
+    SBAnyMap allTaps = {{"useVibrato", 1.0f}, {"useChorus", 1.0f}, {"useFlanger", 1.0f}};
+    SBAnyMap noTaps;
+    ModDelayNode modDelay(allTaps);
+    ModDelayNode modDelayOff(noTaps);
+
+    switchboard::extensions::audioeffects::VibratoNode vibrato(2);
+    switchboard::extensions::audioeffects::ChorusNode chorus(2);
+    switchboard::extensions::audioeffects::FlangerNode flanger(2);
+    vibrato.setIsEnabled(true);
+    chorus.setIsEnabled(true);
+    flanger.setIsEnabled(true);
+
+    double modDelayNanos = measureNanosPerBlock(modDelay);
+    double modDelayOffNanos = measureNanosPerBlock(modDelayOff);
+    double separateNanos = measureNanosPerBlock(vibrato) + measureNanosPerBlock(chorus) + measureNanosPerBlock(flanger);
+
+    report("ModDelay (vibrato+chorus+flanger)", modDelayNanos);
+    report("ModDelay (all off)", modDelayOffNanos);
+    report("Vibrato + Chorus + Flanger nodes", separateNanos);
+
+    REQUIRE(modDelayNanos < separateNanos);
+    REQUIRE(modDelayOffNanos < modDelayNanos * 0.25);
+}
+
+TEST_CASE("Benchmark - Delay costs less than the built-in delay", "[.][benchmark]") {
+    SBAnyMap oneTap = {{"delayMs", 250.0f}, {"feedbackLevel", 0.4f}};
+    SBAnyMap fourTaps = {{"delayMs", 250.0f}, {"feedbackLevel", 0.4f}, {"tap2Ms", 90.0f}, {"tap3Ms", 170.0f},
+                         {"tap4Ms", 330.0f}, {"tap4Feedback", 0.2f}, {"damping", 0.3f}};
+    DelayNode delay(oneTap);
+    DelayNode delayFourTaps(fourTaps);
+
+    switchboard::extensions::audioeffects::DelayNode builtIn(2);
+    builtIn.setIsEnabled(true);
+    builtIn.setDelayMs(250);
+    builtIn.setFeedbackLevel(0.4f);
+
+    double delayNanos = measureNanosPerBlock(delay);
+    double fourTapNanos = measureNanosPerBlock(delayFourTaps);
+    double builtInNanos = measureNanosPerBlock(builtIn);
+
+    report("Delay (one tap)", delayNanos);
+    report("Delay (four taps, damped)", fourTapNanos);
+    report("AudioEffects.Delay", builtInNanos);
+
+    REQUIRE(delayNanos < builtInNanos);
+}
+
+TEST_CASE("Benchmark - Whisper stays under 1% of a core", "[.][benchmark]") {
+    SBAnyMap config = {{"mix", 1.0f}};
+    WhisperNode whisper(config);
+
+    double whisperNanos = measureNanosPerBlock(whisper);
+    report("Whisper", whisperNanos);
+
+    double blockNanos = 1.0e9 * BUFFER_SIZE / SAMPLE_RATE;
+    REQUIRE(whisperNanos < 0.01 * blockNanos);
+}
+
+TEST_CASE("Benchmark - A pruned chain costs only its active stages", "[.][benchmark]") {
+    // Ring modulation and a delay active, everything else dry
+    ChainSpec spec{"RingDelay",
+                   {{"pitchShift", "VoiceChanger.PitchShift", {{"mix", 0.0f}}},
+                    {"whisper", "VoiceChanger.Whisper", {{"mix", 0.0f}}},
+                    {"ringMod", "VoiceChanger.RingMod", {{"carrierFrequency", 100.0f}, {"mix", 0.8f}}},
+                    {"drive", "VoiceChanger.Drive", {{"mix", 0.0f}}},
+                    {"glitch", "VoiceChanger.Glitch", {{"mix", 0.0f}}},
+                    {"modDelay", "VoiceChanger.ModDelay", {{"useVibrato", 0.0f}}},
+                    {"delay", "VoiceChanger.Delay", {{"delayMs", 250.0f}, {"wetMix", 0.4f}}}}};
+
+    SBAnyMap config;
+    ChainNode chain(config);
+    REQUIRE(!chain.setValue("preset", std::make_any<ChainSpec>(spec)).isError());
+    double chainNanos = measureNanosPerBlock(chain);
+
+    // The same stages as separate nodes, as the fixed preset graph runs them
+    double activeNanos = 0.0;
+    double serialNanos = 0.0;
+    for (const auto& stage : spec.stages) {
+        auto node = VoiceChain::createStage(stage.type);
+        for (const auto& param : stage.params) {
+            REQUIRE(!node->setValue(param.key, param.value).isError());
+        }
+        double nanos = measureNanosPerBlock(*node);
+        serialNanos += nanos;
+        if (!VoiceChain::isPassThrough(stage)) {
+            activeNanos += nanos;
+        }
+    }
+
+    report("Chain (ringMod + delay of 7 stages)", chainNanos);
+    report("Active stages alone", activeNanos);
+    report("All 7 stages in series", serialNanos);
+
+    REQUIRE(chainNanos < serialNanos);
+    REQUIRE(chainNanos < 1.5 * activeNanos + 2000.0);
+}
+
+TEST_CASE("Benchmark - Parameter handles are cheaper than string keys", "[.][benchmark]") {
+    constexpr int kUpdates = 1000000;
+    SBAnyMap config;
+    RingModNode node(config);
+
+    // What a preset switch or automation pass does per parameter
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kUpdates; ++i) {
+        node.setValue("threshold", std::make_any<float>(static_cast<float>(i & 1023) / 1024.0f));
+    }
+    double keyNanos = static_cast<double>((std::chrono::steady_clock::now() - start).count()) / kUpdates;
+
+    ParameterHandle threshold = node.getParameterHandle("threshold");
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kUpdates; ++i) {
+        threshold.set(static_cast<float>(i & 1023) / 1024.0f);
+    }
+    double handleNanos = static_cast<double>((std::chrono::steady_clock::now() - start).count()) / kUpdates;
+
+    std::cout << "[bench] setValue by key: " << keyNanos << " ns/update" << std::endl;
+    std::cout << "[bench] ParameterHandle::set: " << handleNanos << " ns/update" << std::endl;
+
+    REQUIRE(handleNanos < keyNanos);
+}
+
+TEST_CASE("Benchmark - A crossfade costs at most one extra chain", "[.][benchmark]") {
+    auto makeSpec = [](const std::string& name, float carrier) {
+        return ChainSpec{name,
+                         {{"ringMod", "VoiceChanger.RingMod", {{"carrierFrequency", carrier}, {"mix", 0.8f}}},
+                          {"drive", "VoiceChanger.Drive", {{"drive", 12.0f}, {"mix", 0.5f}}},
+                          {"delay", "VoiceChanger.Delay", {{"delayMs", 250.0f}, {"wetMix", 0.4f}}}}};
+    };
+
+    SBAnyMap config = {{"crossfadeMs", 50.0f}};
+    ChainNode chain(config);
+    switchboard::AudioBusFormat inputFormat(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    switchboard::AudioBusFormat outputFormat(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    REQUIRE(chain.setBusFormat(inputFormat, outputFormat));
+
+    TestAudioBus inBus(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    TestAudioBus outBus(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    float worstPeak = 0.0f;
+    for (int i = 0; i < BENCH_BLOCKS; ++i) {
+        // A transition every 20 blocks, alternating between two presets
+        if (i % 20 == 0) {
+            auto spec = (i / 20) % 2 == 0 ? makeSpec("Low", 60.0f) : makeSpec("High", 400.0f);
+            REQUIRE(!chain.setValue("preset", std::make_any<ChainSpec>(spec)).isError());
+        }
+        inBus.fillWithSine(220.0f, 0.5f, SAMPLE_RATE, i * BUFFER_SIZE);
+        chain.process(inBus.bus, outBus.bus);
+        if (i % 20 == 19 && i > 100) {
+            worstPeak = std::max(worstPeak, std::any_cast<float>(chain.getValue("transitionPeakLoad").value()));
+        }
+    }
+
+    float load = std::any_cast<float>(chain.getValue("load").value());
+    std::cout << "[bench] Chain load between transitions: " << 100.0f * load << "% of one core" << std::endl;
+    std::cout << "[bench] Worst block during a crossfade: " << 100.0f * worstPeak << "% of one core" << std::endl;
+
+    // Two chains plus the mix, with room for scheduling noise
+    REQUIRE(worstPeak < 4.0f * load + 0.02f);
+}
+
+TEST_CASE("Benchmark - Preset library startup with 5,000 presets", "[.][benchmark]") {
+    namespace fs = std::filesystem;
+    constexpr size_t kLibrarySize = 5000;
+
+    // 5,000 copies of the shipped presets across 50 category directories
+    std::vector<std::string> shipped;
+    for (const auto& file : fs::directory_iterator(PRESETS_DIR)) {
+        std::ifstream in(file.path());
+        shipped.emplace_back(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    REQUIRE(!shipped.empty());
+    fs::path root = fs::temp_directory_path() / "voicechanger-library-bench";
+    fs::remove_all(root);
+    for (size_t i = 0; i < kLibrarySize; ++i) {
+        fs::path directory = root / ("category" + std::to_string(i % 50));
+        fs::create_directories(directory);
+        std::ofstream(directory / ("preset" + std::to_string(i) + ".json")) << shipped[i % shipped.size()];
+    }
+
+    // Startup: index every file, then parse the first preset
+    auto start = std::chrono::steady_clock::now();
+    PresetLibrary library;
+    std::string error;
+    REQUIRE(library.scan(root.string(), error));
+    REQUIRE(library.load(0, error));
+    double startupMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    REQUIRE(library.size() == kLibrarySize);
+
+    // What startup cost when every preset was parsed up front
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < kLibrarySize; ++i) {
+        PresetDefinition preset;
+        REQUIRE(loadPresetFile(library.getEntry(i).path, preset, error));
+    }
+    double parseAllMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "[bench] Library startup, 5000 presets: " << startupMs << " ms" << std::endl;
+    std::cout << "[bench] Parsing all 5000 presets: " << parseAllMs << " ms" << std::endl;
+    fs::remove_all(root);
+
+    REQUIRE(startupMs < parseAllMs);
+}
+
+TEST_CASE("Benchmark - Preset bank load time and memory with 10,000 presets", "[.][benchmark]") {
+    namespace fs = std::filesystem;
+    constexpr size_t kBankSize = 10000;
+
+    PresetLibrary json;
+    std::string error;
+    REQUIRE(json.scan(PRESETS_DIR, error));
+    std::vector<PresetDefinition> presets;
+    for (size_t i = 0; i < kBankSize; ++i) {
+        auto preset = json.load(i % json.size(), error);
+        REQUIRE(preset);
+        presets.push_back(*preset);
+        presets.back().name += " " + std::to_string(i);
+        presets.back().chain.name = presets.back().name;
+    }
+    fs::path path = fs::temp_directory_path() / "voicechanger-bench.bank";
+    REQUIRE(PresetBank::write(path.string(), presets, error));
+    presets.clear();
+    presets.shrink_to_fit();
+
+    long before = residentKb();
+    auto start = std::chrono::steady_clock::now();
+    PresetBank bank;
+    REQUIRE(bank.open(path.string(), error));
+    double openUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    long afterOpen = residentKb();
+
+    // Selecting a preset: one record to a ChainSpec
+    start = std::chrono::steady_clock::now();
+    ChainSpec chain;
+    for (size_t i = 0; i < kBankSize; ++i) {
+        REQUIRE(bank.getChain(i, chain, error));
+    }
+    double selectUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() /
+                      kBankSize;
+    long afterAll = residentKb();
+
+    std::cout << "[bench] Bank of 10000 presets: " << bank.getMappedBytes() / 1024 << " KB on disk" << std::endl;
+    std::cout << "[bench] Bank open: " << openUs << " us, +" << afterOpen - before << " KB resident" << std::endl;
+    std::cout << "[bench] Bank select: " << selectUs << " us/preset, +" << afterAll - before
+              << " KB resident after reading every preset" << std::endl;
+    fs::remove(path);
+
+    // Opening maps the file; only what is read becomes resident
+    REQUIRE(afterOpen - before < static_cast<long>(bank.getMappedBytes() / 1024) / 4 + 64);
+}
+
+TEST_CASE("Benchmark - Engine description is built once per graph", "[.][benchmark]") {
+    constexpr int kIterations = 10000;
+
+    // Startup: build, validate and serialize the demo's graph
+    auto start = std::chrono::steady_clock::now();
+    size_t bytes = 0;
+    for (int i = 0; i < kIterations; ++i) {
+        auto graph = EngineGraph::forChainNode(50.0f);
+        std::string error;
+        REQUIRE(graph.validate(error));
+        bytes = graph.toJson().size();
+    }
+    double buildUs =
+        std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / kIterations;
+
+    // Recreating the engine with an unchanged graph
+    auto graph = EngineGraph::forChainNode(50.0f);
+    graph.toJson();
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kIterations; ++i) {
+        bytes = graph.toJson().size();
+    }
+    double cachedUs =
+        std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / kIterations;
+
+    // Every shipped preset laid out stage by stage
+    PresetLibrary library;
+    std::string error;
+    REQUIRE(library.scan(PRESETS_DIR, error));
+    std::vector<ChainSpec> chains;
+    for (size_t i = 0; i < library.size(); ++i) {
+        auto preset = library.load(i, error);
+        REQUIRE(preset);
+        chains.push_back(preset->chain);
+    }
+    start = std::chrono::steady_clock::now();
+    for (const auto& chain : chains) {
+        auto presetGraph = EngineGraph::forChain(chain);
+        REQUIRE(presetGraph.validate(error));
+        presetGraph.toJson();
+    }
+    double presetUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() /
+                      chains.size();
+
+    std::cout << "[bench] Engine description (" << bytes << " bytes): " << buildUs << " us to build, "
+              << cachedUs << " us cached" << std::endl;
+    std::cout << "[bench] Preset engine descriptions: " << presetUs << " us/preset" << std::endl;
+
+    REQUIRE(graph.getSerializeCount() == 1);
+    REQUIRE(cachedUs < buildUs);
+}
@@ -0,0 +1,179 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include "TestHelpers.hpp"
+#include "nodes/DelayNode.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace voicechanger;
+using namespace voicechanger::test;
+using Catch::Approx;
+
+// Global Switchboard initialization
+static SwitchboardInitializer switchboardInit;
+
+// Test constants
+constexpr uint SAMPLE_RATE = 44100;
+constexpr uint BUFFER_SIZE = 512;
+
+static size_t msToFrames(float ms) {
+    return static_cast<size_t>(std::lround(ms * 0.001f * SAMPLE_RATE));
+}
+
+TEST_CASE("DelayNode - Zero wet mix passes audio through unchanged", "[DelayNode][baseline]") {
+    SBAnyMap config = {{"wetMix", 0.0f}, {"feedbackLevel", 0.9f}};
+    DelayNode node(config);
+    prepareNode(node);
+
+    auto input = makeSine(440.0f, 0.5f, 8 * BUFFER_SIZE);
+    auto output = processMono(node, input);
+    REQUIRE(output == input);
+}
+
+TEST_CASE("DelayNode - setValue/getValue for parameters", "[DelayNode][baseline]") {
+    SBAnyMap config = {{"delayMs", 120.0f}, {"tap3Ms", 45.0f}};
+    DelayNode node(config);
+
+    REQUIRE(std::any_cast<float>(node.getValue("delayMs").value()) == Approx(120.0f));
+    REQUIRE(std::any_cast<float>(node.getValue("tap3Ms").value()) == Approx(45.0f));
+    REQUIRE(std::any_cast<float>(node.getValue("tap2Ms").value()) == 0.0f);
+
+    REQUIRE(!node.setValue("delayMs", std::make_any<float>(0.0f)).isError());
+    REQUIRE(std::any_cast<float>(node.getValue("delayMs").value()) == Approx(1.0f));
+    REQUIRE(!node.setValue("tap4Ms", std::make_any<float>(5000.0f)).isError());
+    REQUIRE(std::any_cast<float>(node.getValue("tap4Ms").value()) == Approx(2000.0f));
+    REQUIRE(!node.setValue("tap4Ms", std::make_any<float>(-1.0f)).isError());
+    REQUIRE(std::any_cast<float>(node.getValue("tap4Ms").value()) == 0.0f);
+    REQUIRE(!node.setValue("tap2Feedback", std::make_any<float>(2.0f)).isError());
+    REQUIRE(std::any_cast<float>(node.getValue("tap2Feedback").value()) == Approx(0.95f));
+    REQUIRE(!node.setValue("damping", std::make_any<float>(1.0f)).isError());
+    REQUIRE(std::any_cast<float>(node.getValue("damping").value()) == Approx(0.99f));
+
+    REQUIRE(node.setValue("wetMix", std::make_any<int>(1)).isError());
+    REQUIRE(node.setValue("tap5Ms", std::make_any<float>(10.0f)).isError());
+    REQUIRE(node.setValue("unknown", std::make_any<float>(0.0f)).isError());
+}
+
+TEST_CASE("DelayNode - Echoes repeat at the delay and decay by the feedback", "[DelayNode]") {
+    SBAnyMap config = {{"delayMs", 10.0f}, {"feedbackLevel", 0.5f}, {"wetMix", 1.0f}, {"dryMix", 1.0f}};
+    DelayNode node(config);
+    prepareNode(node);
+
+    std::vector<float> input(8 * BUFFER_SIZE, 0.0f);
+    input[0] = 1.0f;
+    auto output = processMono(node, input);
+
+    size_t delay = msToFrames(10.0f);
+    REQUIRE(output[0] == Approx(1.0f));
+    REQUIRE(output[delay] == Approx(1.0f).margin(1.0e-6));
+    REQUIRE(output[2 * delay] == Approx(0.5f).margin(1.0e-6));
+    REQUIRE(output[3 * delay] == Approx(0.25f).margin(1.0e-6));
+    for (size_t i = 1; i < delay; ++i) {
+        REQUIRE(std::abs(output[i]) < 1.0e-6f);
+    }
+}
+
+TEST_CASE("DelayNode - Extra taps add their own echoes", "[DelayNode]") {
+    SBAnyMap config = {{"delayMs", 30.0f}, {"feedbackLevel", 0.0f},
+                       {"tap2Ms", 7.0f}, {"tap3Ms", 19.0f}, {"tap4Ms", 26.0f},
+                       {"wetMix", 0.5f}, {"dryMix", 0.0f}};
+    DelayNode node(config);
+    prepareNode(node);
+
+    std::vector<float> input(8 * BUFFER_SIZE, 0.0f);
+    input[0] = 1.0f;
+    auto output = processMono(node, input);
+
+    for (float ms : {7.0f, 19.0f, 26.0f, 30.0f}) {
+        REQUIRE(output[msToFrames(ms)] == Approx(0.5f).margin(1.0e-6));
+    }
+    float total = 0.0f;
+    for (float sample : output) {
+        total += std::abs(sample);
+    }
+    REQUIRE(total == Approx(2.0f).margin(1.0e-4));
+}
+
+TEST_CASE("DelayNode - Damping darkens each repeat", "[DelayNode]") {
+    // A high tone loses more level per repeat than a low one
+    auto repeatLevel = [](float frequency) {
+        SBAnyMap config = {{"delayMs", 20.0f}, {"feedbackLevel", 0.9f}, {"damping", 0.6f},
+                           {"wetMix", 1.0f}, {"dryMix", 0.0f}};
+        DelayNode node(config);
+        prepareNode(node);
+
+        // A 20 ms burst, then silence while the repeats ring out
+        auto burst = makeSine(frequency, 0.5f, msToFrames(20.0f));
+        std::vector<float> input(32 * BUFFER_SIZE, 0.0f);
+        std::copy(burst.begin(), burst.end(), input.begin());
+        auto output = processMono(node, input);
+
+        auto peak = [&](size_t repeat) {
+            size_t begin = repeat * msToFrames(20.0f);
+            auto end = static_cast<std::ptrdiff_t>(begin + msToFrames(20.0f));
+            float level = 0.0f;
+            for (auto it = output.begin() + static_cast<std::ptrdiff_t>(begin); it != output.begin() + end; ++it) {
+                level = std::max(level, std::abs(*it));
+            }
+            return level;
+        };
+        return peak(6) / peak(1);
+    };
+
+    float low = repeatLevel(200.0f);
+    float high = repeatLevel(8000.0f);
+    INFO("Low decay " << low << ", high decay " << high);
+    REQUIRE(low > 0.4f);
+    REQUIRE(high < 0.1f * low);
+}
+
+TEST_CASE("DelayNode - Long feedback tails stay out of the denormal range", "[DelayNode]") {
+    SBAnyMap config = {{"delayMs", 3.0f}, {"feedbackLevel", 0.95f}, {"tap2Ms", 5.0f}, {"tap2Feedback", 0.5f},
+                       {"damping", 0.5f}, {"wetMix", 1.0f}};
+    DelayNode node(config);
+    prepareNode(node);
+
+    std::vector<float> input(20 * SAMPLE_RATE / BUFFER_SIZE * BUFFER_SIZE, 0.0f);
+    input[0] = 1.0f;
+    auto output = processMono(node, input);
+
+    for (float sample : output) {
+        REQUIRE(std::isfinite(sample));
+        REQUIRE(std::fpclassify(sample) != FP_SUBNORMAL);
+    }
+    REQUIRE(std::abs(output.back()) < 1.0e-6f);
+}
+
+TEST_CASE("DelayNode - Changing the delay time does not click", "[DelayNode]") {
+    SBAnyMap config = {{"delayMs", 40.0f}, {"feedbackLevel", 0.4f}, {"wetMix", 0.5f}};
+    DelayNode node(config);
+    prepareNode(node);
+
+    auto input = makeSine(220.0f, 0.4f, 24 * BUFFER_SIZE);
+    std::vector<float> output;
+    auto run = [&](size_t block) {
+        std::vector<float> chunk(input.begin() + static_cast<std::ptrdiff_t>(block * BUFFER_SIZE),
+                                 input.begin() + static_cast<std::ptrdiff_t>((block + 6) * BUFFER_SIZE));
+        auto processed = processMono(node, chunk);
+        output.insert(output.end(), processed.begin(), processed.end());
+    };
+
+    run(0);
+    node.setValue("delayMs", std::make_any<float>(53.0f));
+    run(6);
+    node.setValue("tap2Ms", std::make_any<float>(11.0f));
+    run(12);
+    node.setValue("tap2Ms", std::make_any<float>(0.0f));
+    run(18);
+
+    // Full-scale 220 Hz moves at most 0.031 per sample; a 0.4 tone with echoes stays well under that
+    float maxStep = 0.0f;
+    for (size_t i = 1; i < output.size(); ++i) {
+        maxStep = std::max(maxStep, std::abs(output[i] - output[i - 1]));
+    }
+    INFO("Max step: " << maxStep);
+    REQUIRE(maxStep < 0.04f);
+}
@@ -0,0 +1,202 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include "TestHelpers.hpp"
+#include "dsp/Fft.hpp"
+#include "dsp/HalfBand.hpp"
+#include "dsp/Waveshaper.hpp"
+#include "nodes/DriveNode.hpp"
+
+#include <cmath>
+#include <vector>
+
+using namespace voicechanger;
+using namespace voicechanger::test;
+using Catch::Approx;
+
+// Global Switchboard initialization
+static SwitchboardInitializer switchboardInit;
+
+// Test constants
+constexpr uint SAMPLE_RATE = 44100;
+constexpr uint NUM_CHANNELS = 2;
+constexpr uint BUFFER_SIZE = 512;
+
+TEST_CASE("DriveNode - Silence in produces silence out", "[DriveNode][baseline]") {
+    SBAnyMap config = {{"drive", 36.0f}, {"curve", 2.0f}};
+    DriveNode node(config);
+
+    prepareNode(node);
+    auto output = processMono(node, std::vector<float>(8 * BUFFER_SIZE, 0.0f));
+    for (float sample : output) {
+        REQUIRE(std::abs(sample) < 1.0e-6f);
+    }
+}
+
+TEST_CASE("DriveNode - Zero mix passes audio through unchanged", "[DriveNode][baseline]") {
+    SBAnyMap config = {{"mix", 0.0f}, {"drive", 36.0f}};
+    DriveNode node(config);
+
+    auto input = makeSine(440.0f, 0.5f, 8 * BUFFER_SIZE);
+    prepareNode(node);
+    auto output = processMono(node, input);
+    for (size_t i = 0; i < output.size(); ++i) {
+        REQUIRE(output[i] == input[i]);
+    }
+}
+
+TEST_CASE("DriveNode - Leaving bypass does not replay old audio", "[DriveNode][baseline]") {
+    SBAnyMap config = {{"drive", 24.0f}, {"oversampling", 4.0f}};
+    DriveNode node(config);
+    prepareNode(node);
+
+    // Loud input fills the filters, then the effect is bypassed for a while
+    processMono(node, makeSine(220.0f, 0.8f, 4 * BUFFER_SIZE));
+    REQUIRE(!node.setValue("mix", 0.0f).isError());
+    processMono(node, std::vector<float>(BUFFER_SIZE, 0.0f));
+
+    // Switched back on with silence coming in: silence comes out
+    REQUIRE(!node.setValue("mix", 1.0f).isError());
+    for (float sample : processMono(node, std::vector<float>(BUFFER_SIZE, 0.0f))) {
+        REQUIRE(std::abs(sample) < 1.0e-6f);
+    }
+}
+
+TEST_CASE("DriveNode - setValue/getValue for parameters", "[DriveNode][baseline]") {
+    SBAnyMap config;
+    DriveNode node(config);
+
+    REQUIRE(!node.setValue("drive", std::make_any<float>(48.0f)).isError());
+    REQUIRE(std::any_cast<float>(node.getValue("drive").value()) == Approx(36.0f));  // clamped
+
+    REQUIRE(!node.setValue("curve", std::make_any<float>(3.0f)).isError());
+    REQUIRE(std::any_cast<float>(node.getValue("curve").value()) == Approx(3.0f));
+
+    // Oversampling snaps to 1, 2 or 4
+    REQUIRE(!node.setValue("oversampling", std::make_any<float>(3.0f)).isError());
+    REQUIRE(std::any_cast<float>(node.getValue("oversampling").value()) == Approx(4.0f));
+    REQUIRE(!node.setValue("oversampling", std::make_any<float>(1.0f)).isError());
+    REQUIRE(std::any_cast<float>(node.getValue("oversampling").value()) == Approx(1.0f));
+
+    REQUIRE(!node.setValue("tone", std::make_any<float>(100.0f)).isError());
+    REQUIRE(std::any_cast<float>(node.getValue("tone").value()) == Approx(1000.0f));
+
+    REQUIRE(node.setValue("latency", std::make_any<float>(0.0f)).isError());
+}
+
+TEST_CASE("DriveNode - Latency grows with the oversampling factor", "[DriveNode][baseline]") {
+    float latencies[3] = {};
+    const float factors[3] = {1.0f, 2.0f, 4.0f};
+    for (int i = 0; i < 3; ++i) {
+        SBAnyMap config = {{"oversampling", factors[i]}};
+        DriveNode node(config);
+        switchboard::AudioBusFormat inputFormat(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+        switchboard::AudioBusFormat outputFormat(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+        REQUIRE(node.setBusFormat(inputFormat, outputFormat));
+        latencies[i] = std::any_cast<float>(node.getValue("latency").value());
+    }
+
+    REQUIRE(latencies[0] == Approx(0.0f));
+    REQUIRE(latencies[1] > 0.0f);
+    REQUIRE(latencies[2] > latencies[1]);
+    REQUIRE(latencies[2] < 1.0f);  // Well under a millisecond
+}
+
+TEST_CASE("Waveshaper - Curves are bounded and pass through zero", "[DriveNode][baseline]") {
+    using namespace dsp::waveshaper;
+    for (float x = -10.0f; x <= 10.0f; x += 0.01f) {
+        REQUIRE(std::abs(softClip(x)) <= 1.0f);
+        REQUIRE(std::abs(hardClip(x)) <= 1.0f);
+        REQUIRE(asymmetric(x) >= -1.3f);
+        REQUIRE(asymmetric(x) <= 0.72f);
+        REQUIRE(std::abs(fold(x)) <= 1.0f + 1.0e-6f);
+    }
+    REQUIRE(softClip(0.0f) == 0.0f);
+    REQUIRE(asymmetric(0.0f) == Approx(0.0f).margin(1.0e-7));
+    REQUIRE(fold(0.0f) == Approx(0.0f).margin(1.0e-7));
+
+    // Soft clip tracks tanh closely without calling it
+    for (float x = -3.0f; x <= 3.0f; x += 0.01f) {
+        REQUIRE(softClip(x) == Approx(std::tanh(x)).margin(0.025));
+    }
+
+    // Fold reflects beyond +-1
+    REQUIRE(fold(0.5f) == Approx(0.5f));
+    REQUIRE(fold(1.5f) == Approx(0.5f));
+    REQUIRE(fold(-1.5f) == Approx(-0.5f));
+}
+
+TEST_CASE("HalfBand - Up then down reproduces a tone after the filter delay", "[DriveNode]") {
+    auto taps = dsp::designHalfBand(47, 8.0);
+    dsp::HalfBandUpsampler up;
+    dsp::HalfBandDownsampler down;
+    up.prepare(taps, 256);
+    down.prepare(taps, 256);
+
+    auto input = makeSine(1000.0f, 0.5f, 4096);
+    std::vector<float> upsampled(2 * 256);
+    std::vector<float> output(input.size());
+    for (size_t offset = 0; offset < input.size(); offset += 256) {
+        up.process(input.data() + offset, upsampled.data(), 256);
+        down.process(upsampled.data(), output.data() + offset, 256);
+    }
+
+    // Round trip delay in input samples
+    size_t delay = (up.getLatency() + down.getLatency()) / 2;
+    REQUIRE(delay == 23);
+    for (size_t i = 1000; i < input.size(); ++i) {
+        REQUIRE(output[i] == Approx(input[i - delay]).margin(1.0e-3));
+    }
+}
+
+/**
+ * Fraction of output energy that is not at a harmonic of the test tone.
+ * The tone sits exactly on an FFT bin, so aliases land on other exact bins.
+ */
+static float aliasEnergyRatio(int oversampling) {
+    constexpr size_t FFT_SIZE = 8192;
+    constexpr size_t TONE_BIN = 1000;  // ~5383 Hz
+    const float toneHz = static_cast<float>(TONE_BIN) * SAMPLE_RATE / FFT_SIZE;
+
+    SBAnyMap config = {
+        {"drive", 24.0f},
+        {"curve", 1.0f},  // Hard clip: strongest high harmonics
+        {"oversampling", static_cast<float>(oversampling)},
+        {"tone", 16000.0f}
+    };
+    DriveNode node(config);
+    prepareNode(node);
+    auto output = processMono(node, makeSine(toneHz, 0.5f, 4 * FFT_SIZE));
+
+    // Steady-state, exactly periodic window
+    dsp::Fft fft;
+    fft.setSize(FFT_SIZE);
+    std::vector<dsp::Fft::Complex> spectrum(FFT_SIZE);
+    for (size_t i = 0; i < FFT_SIZE; ++i) {
+        spectrum[i] = output[output.size() - FFT_SIZE + i];
+    }
+    fft.forward(spectrum.data());
+
+    double harmonic = 0.0;
+    double alias = 0.0;
+    for (size_t bin = 1; bin < FFT_SIZE / 2; ++bin) {
+        double power = std::norm(spectrum[bin]);
+        size_t nearest = (bin + TONE_BIN / 2) / TONE_BIN * TONE_BIN;
+        bool isHarmonic = nearest > 0 && (bin > nearest ? bin - nearest : nearest - bin) <= 2;
+        (isHarmonic ? harmonic : alias) += power;
+    }
+    return static_cast<float>(alias / (harmonic + alias));
+}
+
+TEST_CASE("DriveNode - Oversampling suppresses aliasing", "[DriveNode]") {
+    float alias1x = aliasEnergyRatio(1);
+    float alias2x = aliasEnergyRatio(2);
+    float alias4x = aliasEnergyRatio(4);
+
+    INFO("Alias energy: 1x " << 10.0f * std::log10(alias1x) << " dB, 2x "
+         << 10.0f * std::log10(alias2x) << " dB, 4x " << 10.0f * std::log10(alias4x) << " dB");
+    REQUIRE(alias2x < alias1x);
+    REQUIRE(alias4x < alias2x);
+    // At least 20 dB less aliasing at 4x
+    REQUIRE(alias4x < alias1x * 0.01f);
+}
@@ -0,0 +1,120 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "engine/EngineGraph.hpp"
+#include "presets/Json.hpp"
+#include "presets/PresetLoader.hpp"
+
+#include <cmath>
+#include <string>
+
+// Shipped preset directory (passed via CMake compile definition)
+#ifndef PRESETS_DIR
+#define PRESETS_DIR "src/presets/json"
+#endif
+
+using namespace voicechanger;
+
+TEST_CASE("EngineGraph - Describes the chain node engine", "[EngineGraph][baseline]") {
+    auto graph = EngineGraph::forChainNode(50.0f);
+    std::string error;
+    REQUIRE(graph.validate(error));
+
+    JsonValue document;
+    REQUIRE(JsonValue::parse(graph.toJson(), document, error));
+    REQUIRE(document.find("type")->asString() == "RealTimeGraphRenderer");
+    const JsonValue* config = document.find("config");
+    REQUIRE(config->find("microphoneEnabled")->asBool());
+
+    const JsonValue* engine = config->find("graph");
+    REQUIRE(engine->find("config")->find("sampleRate")->asNumber() == EngineGraph::kDefaultSampleRate);
+    REQUIRE(engine->find("config")->find("bufferSize")->asNumber() == EngineGraph::kDefaultBufferSize);
+
+    const auto& nodes = engine->find("nodes")->getItems();
+    REQUIRE(nodes.size() == 1);
+    REQUIRE(nodes[0].find("id")->asString() == "chain");
+    REQUIRE(nodes[0].find("type")->asString() == "VoiceChanger.Chain");
+    REQUIRE(nodes[0].find("config")->find("crossfadeMs")->asNumber() == 50.0);
+
+    const auto& connections = engine->find("connections")->getItems();
+    REQUIRE(connections.size() == 2);
+    REQUIRE(connections[0].find("sourceNode")->asString() == "inputNode");
+    REQUIRE(connections[1].find("destinationNode")->asString() == "outputNode");
+}
+
+TEST_CASE("EngineGraph - Serializes once until something changes", "[EngineGraph][baseline]") {
+    auto graph = EngineGraph::forChainNode(50.0f);
+    const std::string& first = graph.toJson();
+    REQUIRE(&graph.toJson() == &first);
+    REQUIRE(graph.getSerializeCount() == 1);
+
+    graph.setSampleRate(48000);
+    graph.setBufferSize(128);
+    graph.setMicrophoneEnabled(false);
+    std::string changed = graph.toJson();
+    REQUIRE(graph.getSerializeCount() == 2);
+    REQUIRE(changed.find("\"sampleRate\":48000") != std::string::npos);
+    REQUIRE(changed.find("\"bufferSize\":128") != std::string::npos);
+    REQUIRE(changed.find("\"microphoneEnabled\":false") != std::string::npos);
+    graph.toJson();
+    REQUIRE(graph.getSerializeCount() == 2);
+}
+
+TEST_CASE("EngineGraph - Lays a preset chain out as engine nodes", "[EngineGraph][baseline]") {
+    PresetDefinition preset;
+    std::string error;
+    REQUIRE(loadPresetFile(std::string(PRESETS_DIR) + "/10_cyborg.json", preset, error));
+
+    auto graph = EngineGraph::forChain(preset.chain);
+    REQUIRE(graph.validate(error));
+    REQUIRE(graph.getNodes().size() == preset.chain.stages.size());
+    REQUIRE(graph.getConnections().size() == preset.chain.stages.size() + 1);
+
+    // Every stage keeps its type and parameter values in the description
+    JsonValue document;
+    REQUIRE(JsonValue::parse(graph.toJson(), document, error));
+    const auto& nodes = document.find("config")->find("graph")->find("nodes")->getItems();
+    REQUIRE(nodes.size() == preset.chain.stages.size());
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        const StageSpec& stage = preset.chain.stages[i];
+        REQUIRE(nodes[i].find("id")->asString() == stage.id);
+        REQUIRE(nodes[i].find("type")->asString() == stage.type);
+        for (const auto& param : stage.params) {
+            REQUIRE(static_cast<float>(nodes[i].find("config")->find(param.key)->asNumber()) == param.value);
+        }
+    }
+}
+
+TEST_CASE("EngineGraph - Rejects graphs the engine cannot build", "[EngineGraph][baseline]") {
+    std::string error;
+
+    auto graph = EngineGraph::forChainNode(50.0f);
+    graph.setBufferSize(4);
+    REQUIRE_FALSE(graph.validate(error));
+    REQUIRE(error.find("buffer size") != std::string::npos);
+
+    graph = EngineGraph::forChainNode(50.0f);
+    graph.setSampleRate(1000);
+    REQUIRE_FALSE(graph.validate(error));
+    REQUIRE(error.find("sample rate") != std::string::npos);
+
+    graph = EngineGraph::forChainNode(50.0f);
+    graph.addNode({"chain", "VoiceChanger.Delay", {}});
+    REQUIRE_FALSE(graph.validate(error));
+    REQUIRE(error.find("duplicate") != std::string::npos);
+
+    graph = EngineGraph::forChainNode(50.0f);
+    graph.connect("chain", "reverb");
+    REQUIRE_FALSE(graph.validate(error));
+    REQUIRE(error.find("reverb") != std::string::npos);
+
+    graph = EngineGraph::forChainNode(NAN);
+    REQUIRE_FALSE(graph.validate(error));
+    REQUIRE(error.find("crossfadeMs") != std::string::npos);
+
+    // Names are escaped, not spliced
+    graph = EngineGraph();
+    graph.addNode({"a\"b", "VoiceChanger.Delay", {}});
+    JsonValue document;
+    REQUIRE(JsonValue::parse(graph.toJson(), document, error));
+    REQUIRE(document.find("config")->find("graph")->find("nodes")->getItems()[0].find("id")->asString() == "a\"b");
+}
@@ -0,0 +1,186 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include "TestHelpers.hpp"
+#include "nodes/GlitchNode.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace voicechanger;
+using namespace voicechanger::test;
+using Catch::Approx;
+
+// Global Switchboard initialization
+static SwitchboardInitializer switchboardInit;
+
+// Test constants
+constexpr uint SAMPLE_RATE = 44100;
+constexpr uint BUFFER_SIZE = 512;
+
+/**
+ * Slow sawtooth: rises for one second, so any replayed or reversed audio
+ * shows up as the output running backwards.
+ */
+static std::vector<float> makeRamp(size_t numFrames) {
+    std::vector<float> ramp(numFrames);
+    for (size_t i = 0; i < numFrames; ++i) {
+        ramp[i] = 0.5f * static_cast<float>(i % SAMPLE_RATE) / SAMPLE_RATE;
+    }
+    return ramp;
+}
+
+/**
+ * Number of samples where the output steps downwards.
+ */
+static int countFalling(const std::vector<float>& samples) {
+    int falling = 0;
+    for (size_t i = 1; i < samples.size(); ++i) {
+        if (samples[i] < samples[i - 1] - 1.0e-6f) {
+            ++falling;
+        }
+    }
+    return falling;
+}
+
+TEST_CASE("GlitchNode - Silence in produces silence out", "[GlitchNode][baseline]") {
+    SBAnyMap config = {{"density", 20.0f}, {"crush", 1.0f}};
+    GlitchNode node(config);
+
+    prepareNode(node, BUFFER_SIZE);
+    auto output = processMono(node, std::vector<float>(SAMPLE_RATE, 0.0f), BUFFER_SIZE);
+    for (float sample : output) {
+        REQUIRE(sample == 0.0f);
+    }
+}
+
+TEST_CASE("GlitchNode - Zero mix passes audio through unchanged", "[GlitchNode][baseline]") {
+    SBAnyMap config = {{"mix", 0.0f}, {"density", 20.0f}};
+    GlitchNode node(config);
+
+    auto input = makeRamp(SAMPLE_RATE);
+    prepareNode(node, BUFFER_SIZE);
+    auto output = processMono(node, input, BUFFER_SIZE);
+    for (size_t i = 0; i < output.size(); ++i) {
+        REQUIRE(output[i] == input[i]);
+    }
+}
+
+TEST_CASE("GlitchNode - setValue/getValue for parameters", "[GlitchNode][baseline]") {
+    SBAnyMap config;
+    GlitchNode node(config);
+
+    REQUIRE(std::any_cast<float>(node.getValue("mix").value()) == Approx(1.0f));  // default
+
+    REQUIRE(!node.setValue("density", std::make_any<float>(50.0f)).isError());
+    REQUIRE(std::any_cast<float>(node.getValue("density").value()) == Approx(20.0f));  // clamped
+
+    REQUIRE(!node.setValue("grainMs", std::make_any<float>(1000.0f)).isError());
+    REQUIRE(std::any_cast<float>(node.getValue("grainMs").value()) == Approx(GlitchNode::kMaxGrainMs));
+
+    REQUIRE(!node.setValue("repeats", std::make_any<float>(0.0f)).isError());
+    REQUIRE(std::any_cast<float>(node.getValue("repeats").value()) == Approx(1.0f));
+
+    REQUIRE(!node.setValue("bitDepth", std::make_any<float>(24.0f)).isError());
+    REQUIRE(std::any_cast<float>(node.getValue("bitDepth").value()) == Approx(16.0f));
+
+    REQUIRE(!node.setValue("downsample", std::make_any<float>(8.0f)).isError());
+    REQUIRE(std::any_cast<float>(node.getValue("downsample").value()) == Approx(8.0f));
+
+    REQUIRE(!node.setValue("seed", std::make_any<float>(1234.0f)).isError());
+    REQUIRE(std::any_cast<float>(node.getValue("seed").value()) == Approx(1234.0f));
+
+    REQUIRE(node.setValue("unknown", std::make_any<float>(1.0f)).isError());
+}
+
+TEST_CASE("GlitchNode - Same seed renders identically at any block size", "[GlitchNode]") {
+    SBAnyMap config = {{"density", 10.0f}, {"reverse", 0.5f}, {"crush", 0.5f}, {"seed", 7.0f}};
+    auto input = makeRamp(2 * SAMPLE_RATE);
+
+    GlitchNode first(config);
+    GlitchNode second(config);
+    prepareNode(first, BUFFER_SIZE);
+    auto outputA = processMono(first, input, BUFFER_SIZE);
+    prepareNode(second, 128);
+    auto outputB = processMono(second, input, 128);
+
+    size_t compared = std::min(outputA.size(), outputB.size());
+    for (size_t i = 0; i < compared; ++i) {
+        REQUIRE(outputA[i] == outputB[i]);
+    }
+
+    // A different seed gives a different render
+    SBAnyMap otherConfig = {{"density", 10.0f}, {"reverse", 0.5f}, {"crush", 0.5f}, {"seed", 8.0f}};
+    GlitchNode third(otherConfig);
+    prepareNode(third, BUFFER_SIZE);
+    auto outputC = processMono(third, input, BUFFER_SIZE);
+    REQUIRE(!std::equal(outputA.begin(), outputA.begin() + compared, outputC.begin()));
+}
+
+TEST_CASE("GlitchNode - Stutter replays and reverse plays backwards", "[GlitchNode]") {
+    auto input = makeRamp(2 * SAMPLE_RATE);
+    int inputFalling = countFalling(input);
+
+    SBAnyMap stutterConfig = {{"density", 8.0f}, {"repeats", 4.0f}, {"reverse", 0.0f}, {"crush", 0.0f}};
+    GlitchNode stutter(stutterConfig);
+    prepareNode(stutter, BUFFER_SIZE);
+    int stutterFalling = countFalling(processMono(stutter, input, BUFFER_SIZE));
+
+    SBAnyMap reverseConfig = {{"density", 8.0f}, {"repeats", 4.0f}, {"reverse", 1.0f}, {"crush", 0.0f}};
+    GlitchNode reversed(reverseConfig);
+    prepareNode(reversed, BUFFER_SIZE);
+    int reverseFalling = countFalling(processMono(reversed, input, BUFFER_SIZE));
+
+    INFO("Falling samples: input " << inputFalling << ", stutter " << stutterFalling
+         << ", reverse " << reverseFalling);
+    // Each stutter jumps back to the grain start
+    REQUIRE(stutterFalling > inputFalling);
+    // Reversed grains fall for their whole length
+    REQUIRE(reverseFalling > 10 * stutterFalling);
+}
+
+TEST_CASE("GlitchNode - Crushed grains are quantised", "[GlitchNode]") {
+    // Long grains, always crushed to 2 bits without sample-and-hold
+    SBAnyMap config = {
+        {"density", 1.0f}, {"grainMs", 200.0f}, {"repeats", 8.0f},
+        {"reverse", 0.0f}, {"crush", 1.0f}, {"bitDepth", 2.0f}, {"downsample", 1.0f}
+    };
+    GlitchNode node(config);
+
+    auto input = makeRamp(2 * SAMPLE_RATE);
+    prepareNode(node, BUFFER_SIZE);
+    auto output = processMono(node, input, BUFFER_SIZE);
+
+    // Fully-wet grain samples sit on the 0.5 grid; count them
+    int onGrid = 0;
+    for (size_t i = 0; i < output.size(); ++i) {
+        float scaled = output[i] * 2.0f;
+        if (output[i] != input[i] && std::abs(scaled - std::round(scaled)) < 1.0e-6f) {
+            ++onGrid;
+        }
+    }
+    INFO("Quantised samples: " << onGrid);
+    REQUIRE(onGrid > static_cast<int>(SAMPLE_RATE / 10));
+}
+
+TEST_CASE("GlitchNode - Dense overlapping grains stay bounded", "[GlitchNode]") {
+    // Far more events than pool slots: extra events are dropped, level is normalised
+    SBAnyMap config = {{"density", 20.0f}, {"grainMs", 200.0f}, {"repeats", 8.0f}, {"crush", 0.0f}};
+    GlitchNode node(config);
+
+    std::vector<float> input(5 * SAMPLE_RATE);
+    for (size_t i = 0; i < input.size(); ++i) {
+        input[i] = 0.5f * std::sin(2.0f * static_cast<float>(M_PI) * 220.0f * i / SAMPLE_RATE);
+    }
+    prepareNode(node, BUFFER_SIZE);
+    auto output = processMono(node, input, BUFFER_SIZE);
+
+    float peak = 0.0f;
+    for (float sample : output) {
+        REQUIRE(std::isfinite(sample));
+        peak = std::max(peak, std::abs(sample));
+    }
+    INFO("Peak: " << peak);
+    REQUIRE(peak <= 0.5f + 1.0e-4f);
+}
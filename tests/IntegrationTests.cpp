@@ -9,23 +9,22 @@
 #include <catch2/catch_approx.hpp>
 
 #include "TestHelpers.hpp"
+#include "nodes/DelayNode.hpp"
+#include "nodes/DriveNode.hpp"
+#include "nodes/GlitchNode.hpp"
+#include "nodes/ModDelayNode.hpp"
 #include "nodes/PitchShiftNode.hpp"
 #include "nodes/RingModNode.hpp"
+#include "nodes/WhisperNode.hpp"
 #include "presets/VoicePresets.hpp"
 #include "extension/VoiceChangerNodeFactory.hpp"
 
-#include <AudioEffectsExtension.hpp>
-
-#include <ChorusNode.hpp>
-#include <FlangerNode.hpp>
-#include <VibratoNode.hpp>
-#include <DelayNode.hpp>
-
 #include <fstream>
 #include <vector>
 #include <cmath>
 #include <cstring>
 #include <algorithm>
+#include <utility>
 
 using namespace voicechanger;
 using namespace voicechanger::test;
@@ -39,185 +38,6 @@ constexpr uint OUTPUT_SAMPLE_RATE = 44100;
 constexpr uint NUM_CHANNELS = 2;  // Stereo processing
 constexpr uint BUFFER_SIZE = 512;
 
-// Test assets directory (passed via CMake compile definition)
-#ifndef TEST_ASSETS_DIR
-#define TEST_ASSETS_DIR "test-assets"
-#endif
-
-/**
- * Simple WAV file header structure.
- */
-#pragma pack(push, 1)
-struct WavHeader {
-    char riff[4];           // "RIFF"
-    uint32_t fileSize;      // File size - 8
-    char wave[4];           // "WAVE"
-    char fmt[4];            // "fmt "
-    uint32_t fmtSize;       // Format chunk size (16 for PCM)
-    uint16_t audioFormat;   // 1 = PCM
-    uint16_t numChannels;   // Number of channels
-    uint32_t sampleRate;    // Sample rate
-    uint32_t byteRate;      // Bytes per second
-    uint16_t blockAlign;    // Bytes per sample frame
-    uint16_t bitsPerSample; // Bits per sample
-    char data[4];           // "data"
-    uint32_t dataSize;      // Data chunk size
-};
-#pragma pack(pop)
-
-/**
- * Load a WAV file and return samples as floats (-1.0 to 1.0).
- * Supports 16-bit PCM mono/stereo.
- */
-bool loadWavFile(const std::string& path,
-                 std::vector<float>& samples,
-                 uint32_t& sampleRate,
-                 uint16_t& numChannels) {
-    std::ifstream file(path, std::ios::binary);
-    if (!file) {
-        return false;
-    }
-
-    // Read RIFF header (12 bytes)
-    char riff[4], wave[4];
-    uint32_t fileSize;
-    file.read(riff, 4);
-    file.read(reinterpret_cast<char*>(&fileSize), 4);
-    file.read(wave, 4);
-
-    if (std::strncmp(riff, "RIFF", 4) != 0 ||
-        std::strncmp(wave, "WAVE", 4) != 0) {
-        return false;
-    }
-
-    // Read chunks until we find fmt and data
-    uint16_t audioFormat = 0;
-    uint16_t bitsPerSample = 0;
-    sampleRate = 0;
-    numChannels = 0;
-    uint32_t dataSize = 0;
-    bool foundFmt = false;
-    bool foundData = false;
-
-    while (!foundData && file) {
-        char chunkId[4];
-        uint32_t chunkSize;
-        file.read(chunkId, 4);
-        file.read(reinterpret_cast<char*>(&chunkSize), 4);
-
-        if (!file) break;
-
-        if (std::strncmp(chunkId, "fmt ", 4) == 0) {
-            file.read(reinterpret_cast<char*>(&audioFormat), 2);
-            file.read(reinterpret_cast<char*>(&numChannels), 2);
-            file.read(reinterpret_cast<char*>(&sampleRate), 4);
-            uint32_t byteRate;
-            uint16_t blockAlign;
-            file.read(reinterpret_cast<char*>(&byteRate), 4);
-            file.read(reinterpret_cast<char*>(&blockAlign), 2);
-            file.read(reinterpret_cast<char*>(&bitsPerSample), 2);
-            // Skip any extra fmt bytes
-            if (chunkSize > 16) {
-                file.seekg(chunkSize - 16, std::ios::cur);
-            }
-            foundFmt = true;
-        } else if (std::strncmp(chunkId, "data", 4) == 0) {
-            dataSize = chunkSize;
-            foundData = true;
-        } else {
-            // Skip unknown chunk
-            file.seekg(chunkSize, std::ios::cur);
-        }
-    }
-
-    if (!foundFmt || !foundData) {
-        return false;
-    }
-
-    if (bitsPerSample != 16) {
-        return false;  // Only support 16-bit for now
-    }
-
-    uint32_t numSamples = dataSize / (bitsPerSample / 8);
-    std::vector<int16_t> rawSamples(numSamples);
-    file.read(reinterpret_cast<char*>(rawSamples.data()), dataSize);
-
-    samples.resize(numSamples);
-    for (size_t i = 0; i < numSamples; ++i) {
-        samples[i] = static_cast<float>(rawSamples[i]) / 32768.0f;
-    }
-
-    return true;
-}
-
-/**
- * Save samples to a WAV file.
- */
-bool saveWavFile(const std::string& path,
-                 const std::vector<float>& samples,
-                 uint32_t sampleRate,
-                 uint16_t numChannels) {
-    std::ofstream file(path, std::ios::binary);
-    if (!file) {
-        return false;
-    }
-
-    uint32_t dataSize = samples.size() * sizeof(int16_t);
-    uint32_t fileSize = 36 + dataSize;
-
-    WavHeader header;
-    std::memcpy(header.riff, "RIFF", 4);
-    header.fileSize = fileSize;
-    std::memcpy(header.wave, "WAVE", 4);
-    std::memcpy(header.fmt, "fmt ", 4);
-    header.fmtSize = 16;
-    header.audioFormat = 1;  // PCM
-    header.numChannels = numChannels;
-    header.sampleRate = sampleRate;
-    header.byteRate = sampleRate * numChannels * 2;
-    header.blockAlign = numChannels * 2;
-    header.bitsPerSample = 16;
-    std::memcpy(header.data, "data", 4);
-    header.dataSize = dataSize;
-
-    file.write(reinterpret_cast<char*>(&header), sizeof(header));
-
-    std::vector<int16_t> rawSamples(samples.size());
-    for (size_t i = 0; i < samples.size(); ++i) {
-        float sample = std::clamp(samples[i], -1.0f, 1.0f);
-        rawSamples[i] = static_cast<int16_t>(sample * 32767.0f);
-    }
-    file.write(reinterpret_cast<char*>(rawSamples.data()), dataSize);
-
-    return true;
-}
-
-/**
- * Simple linear resampling from srcRate to dstRate.
- */
-std::vector<float> resample(const std::vector<float>& input,
-                            uint32_t srcRate,
-                            uint32_t dstRate) {
-    if (srcRate == dstRate) {
-        return input;
-    }
-
-    double ratio = static_cast<double>(dstRate) / srcRate;
-    size_t outputSize = static_cast<size_t>(input.size() * ratio);
-    std::vector<float> output(outputSize);
-
-    for (size_t i = 0; i < outputSize; ++i) {
-        double srcIndex = i / ratio;
-        size_t idx0 = static_cast<size_t>(srcIndex);
-        size_t idx1 = std::min(idx0 + 1, input.size() - 1);
-        double frac = srcIndex - idx0;
-
-        output[i] = static_cast<float>(input[idx0] * (1.0 - frac) + input[idx1] * frac);
-    }
-
-    return output;
-}
-
 /**
  * Convert mono to stereo by duplicating channels.
  */
@@ -255,59 +75,38 @@ float calculateRMS(const std::vector<float>& samples) {
 
 /**
  * Apply a preset to the audio processing chain.
+ *
+ * Every node is reset to its defaults first, as compiling the preset's
+ * chain would, then given the preset's stage parameters by table id.
  */
-void applyPresetToNodes(const VoicePreset& preset,
+void applyPresetToNodes(const BuiltInPreset& preset,
                         PitchShiftNode* pitchShiftNode,
+                        WhisperNode* whisperNode,
                         RingModNode* ringModNode,
-                        switchboard::extensions::audioeffects::ChorusNode* chorusNode,
-                        switchboard::extensions::audioeffects::FlangerNode* flangerNode,
-                        switchboard::extensions::audioeffects::VibratoNode* vibratoNode,
-                        switchboard::extensions::audioeffects::DelayNode* delayNode) {
-
-    // Apply pitch shift parameters
-    pitchShiftNode->setValue("pitchShift", std::make_any<float>(preset.pitchShift));
-    pitchShiftNode->setValue("formantPreserve", std::make_any<float>(preset.formantPreserve));
-    pitchShiftNode->setValue("outputGain", std::make_any<float>(preset.outputGain));
-
-    // Apply ring modulation parameters
-    if (preset.useRingMod) {
-        ringModNode->setValue("carrierFrequency", std::make_any<float>(preset.carrierFrequency));
-        ringModNode->setValue("mix", std::make_any<float>(preset.ringModMix));
-    } else {
-        ringModNode->setValue("mix", std::make_any<float>(0.0f));
-    }
-
-    // Apply chorus parameters
-    chorusNode->setIsEnabled(preset.useChorus);
-    if (preset.useChorus) {
-        chorusNode->setSweepWidth(preset.chorusSweepWidth);
-        chorusNode->setFrequency(preset.chorusFrequency);
-    }
-
-    // Apply flanger parameters
-    flangerNode->setIsEnabled(preset.useFlanger);
-    if (preset.useFlanger) {
-        flangerNode->setSweepWidth(preset.flangerSweepWidth);
-        flangerNode->setFrequency(preset.flangerFrequency);
-    }
-
-    // Apply vibrato parameters
-    vibratoNode->setIsEnabled(preset.useVibrato);
-    if (preset.useVibrato) {
-        vibratoNode->setSweepWidth(preset.vibratoSweepWidth);
-        vibratoNode->setFrequency(preset.vibratoFrequency);
-    }
-
-    // Apply delay parameters
-    delayNode->setIsEnabled(preset.useDelay);
-    if (preset.useDelay) {
-        delayNode->setDelayMs(preset.delayMs);
-        delayNode->setFeedbackLevel(preset.delayFeedback);
-        delayNode->setWetMix(preset.delayWetMix);
-        delayNode->setDryMix(1.0f - preset.delayWetMix * 0.5f);
-    } else {
-        delayNode->setWetMix(0.0f);
-        delayNode->setDryMix(1.0f);
+                        DriveNode* driveNode,
+                        GlitchNode* glitchNode,
+                        ModDelayNode* modDelayNode,
+                        DelayNode* delayNode) {
+    const std::pair<const char*, ParameterizedNode*> nodes[] = {
+        {"VoiceChanger.PitchShift", pitchShiftNode}, {"VoiceChanger.Whisper", whisperNode},
+        {"VoiceChanger.RingMod", ringModNode},       {"VoiceChanger.Drive", driveNode},
+        {"VoiceChanger.Glitch", glitchNode},         {"VoiceChanger.ModDelay", modDelayNode},
+        {"VoiceChanger.Delay", delayNode},
+    };
+
+    for (const auto& [type, node] : nodes) {
+        for (uint32_t id = 0; id < node->getParameterCount(); ++id) {
+            node->setParameter(id, node->getParameterDescriptor(id).defaultValue);
+        }
+        for (size_t s = 0; s < preset.stageCount; ++s) {
+            const BuiltInStage& stage = preset.stages[s];
+            if (std::strcmp(stage.type, type) != 0) {
+                continue;
+            }
+            for (size_t p = 0; p < stage.paramCount; ++p) {
+                node->setParameter(static_cast<uint32_t>(stage.params[p].id), stage.params[p].value);
+            }
+        }
     }
 }
 
@@ -318,11 +117,12 @@ void applyPresetToNodes(const VoicePreset& preset,
 std::vector<float> processAudioThroughChain(
     const std::vector<float>& inputStereo,
     PitchShiftNode* pitchShiftNode,
+    WhisperNode* whisperNode,
     RingModNode* ringModNode,
-    switchboard::extensions::audioeffects::ChorusNode* chorusNode,
-    switchboard::extensions::audioeffects::FlangerNode* flangerNode,
-    switchboard::extensions::audioeffects::VibratoNode* vibratoNode,
-    switchboard::extensions::audioeffects::DelayNode* delayNode) {
+    DriveNode* driveNode,
+    GlitchNode* glitchNode,
+    ModDelayNode* modDelayNode,
+    DelayNode* delayNode) {
 
     size_t numFrames = inputStereo.size() / 2;
     std::vector<float> outputStereo(inputStereo.size());
@@ -342,6 +142,7 @@ std::vector<float> processAudioThroughChain(
         TestAudioBus outBus4(OUTPUT_SAMPLE_RATE, NUM_CHANNELS, framesToProcess);
         TestAudioBus outBus5(OUTPUT_SAMPLE_RATE, NUM_CHANNELS, framesToProcess);
         TestAudioBus outBus6(OUTPUT_SAMPLE_RATE, NUM_CHANNELS, framesToProcess);
+        TestAudioBus outBus7(OUTPUT_SAMPLE_RATE, NUM_CHANNELS, framesToProcess);
 
         // Copy input samples (deinterleave)
         for (size_t frame = 0; frame < framesToProcess; ++frame) {
@@ -350,19 +151,20 @@ std::vector<float> processAudioThroughChain(
             inBus1.setSample(1, frame, inputStereo[srcIdx + 1]);
         }
 
-        // Process through chain: pitchShift -> ringMod -> vibrato -> chorus -> flanger -> delay
+        // Process through chain: pitchShift -> whisper -> ringMod -> drive -> glitch -> modDelay -> delay
         pitchShiftNode->process(inBus1.bus, outBus1.bus);
-        ringModNode->process(outBus1.bus, outBus2.bus);
-        vibratoNode->process(outBus2.bus, outBus3.bus);
-        chorusNode->process(outBus3.bus, outBus4.bus);
-        flangerNode->process(outBus4.bus, outBus5.bus);
-        delayNode->process(outBus5.bus, outBus6.bus);
+        whisperNode->process(outBus1.bus, outBus2.bus);
+        ringModNode->process(outBus2.bus, outBus3.bus);
+        driveNode->process(outBus3.bus, outBus4.bus);
+        glitchNode->process(outBus4.bus, outBus5.bus);
+        modDelayNode->process(outBus5.bus, outBus6.bus);
+        delayNode->process(outBus6.bus, outBus7.bus);
 
         // Copy output samples (interleave)
         for (size_t frame = 0; frame < framesToProcess; ++frame) {
             size_t dstIdx = (framesProcessed + frame) * 2;
-            outputStereo[dstIdx] = outBus6.getSample(0, frame);
-            outputStereo[dstIdx + 1] = outBus6.getSample(1, frame);
+            outputStereo[dstIdx] = outBus7.getSample(0, frame);
+            outputStereo[dstIdx + 1] = outBus7.getSample(1, frame);
         }
 
         framesProcessed += framesToProcess;
@@ -398,20 +200,22 @@ TEST_CASE("Integration - Process Harvard sentences through all presets", "[integ
     // Create effect nodes
     SBAnyMap emptyConfig;
     PitchShiftNode pitchShiftNode(emptyConfig);
+    WhisperNode whisperNode(emptyConfig);
     RingModNode ringModNode(emptyConfig);
-    switchboard::extensions::audioeffects::ChorusNode chorusNode(2);
-    switchboard::extensions::audioeffects::FlangerNode flangerNode(2);
-    switchboard::extensions::audioeffects::VibratoNode vibratoNode(2);
-    switchboard::extensions::audioeffects::DelayNode delayNode(2);
+    DriveNode driveNode(emptyConfig);
+    GlitchNode glitchNode(emptyConfig);
+    ModDelayNode modDelayNode(emptyConfig);
+    DelayNode delayNode(emptyConfig);
 
     // Set bus format for all nodes
     switchboard::AudioBusFormat inputFormat(OUTPUT_SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
     switchboard::AudioBusFormat outputFormat(OUTPUT_SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
     REQUIRE(pitchShiftNode.setBusFormat(inputFormat, outputFormat));
+    REQUIRE(whisperNode.setBusFormat(inputFormat, outputFormat));
     REQUIRE(ringModNode.setBusFormat(inputFormat, outputFormat));
-    REQUIRE(chorusNode.setBusFormat(inputFormat, outputFormat));
-    REQUIRE(flangerNode.setBusFormat(inputFormat, outputFormat));
-    REQUIRE(vibratoNode.setBusFormat(inputFormat, outputFormat));
+    REQUIRE(driveNode.setBusFormat(inputFormat, outputFormat));
+    REQUIRE(glitchNode.setBusFormat(inputFormat, outputFormat));
+    REQUIRE(modDelayNode.setBusFormat(inputFormat, outputFormat));
     REQUIRE(delayNode.setBusFormat(inputFormat, outputFormat));
 
     // Process through each preset
@@ -424,14 +228,14 @@ TEST_CASE("Integration - Process Harvard sentences through all presets", "[integ
 
         // Apply preset settings
         applyPresetToNodes(preset,
-                          &pitchShiftNode, &ringModNode, &chorusNode,
-                          &flangerNode, &vibratoNode, &delayNode);
+                          &pitchShiftNode, &whisperNode, &ringModNode, &driveNode, &glitchNode, &modDelayNode,
+                          &delayNode);
 
         // Process audio
         std::vector<float> outputStereo = processAudioThroughChain(
             inputStereo,
-            &pitchShiftNode, &ringModNode, &chorusNode,
-            &flangerNode, &vibratoNode, &delayNode);
+            &pitchShiftNode, &whisperNode, &ringModNode, &driveNode, &glitchNode, &modDelayNode,
+            &delayNode);
 
         // Convert back to mono for analysis
         std::vector<float> outputMono = stereoToMono(outputStereo);
@@ -481,20 +285,22 @@ TEST_CASE("Integration - Each preset produces distinct output", "[integration][d
     // Create effect nodes
     SBAnyMap emptyConfig;
     PitchShiftNode pitchShiftNode(emptyConfig);
+    WhisperNode whisperNode(emptyConfig);
     RingModNode ringModNode(emptyConfig);
-    switchboard::extensions::audioeffects::ChorusNode chorusNode(2);
-    switchboard::extensions::audioeffects::FlangerNode flangerNode(2);
-    switchboard::extensions::audioeffects::VibratoNode vibratoNode(2);
-    switchboard::extensions::audioeffects::DelayNode delayNode(2);
+    DriveNode driveNode(emptyConfig);
+    GlitchNode glitchNode(emptyConfig);
+    ModDelayNode modDelayNode(emptyConfig);
+    DelayNode delayNode(emptyConfig);
 
     // Set bus format
     switchboard::AudioBusFormat inputFormat(OUTPUT_SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
     switchboard::AudioBusFormat outputFormat(OUTPUT_SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
     pitchShiftNode.setBusFormat(inputFormat, outputFormat);
+    whisperNode.setBusFormat(inputFormat, outputFormat);
     ringModNode.setBusFormat(inputFormat, outputFormat);
-    chorusNode.setBusFormat(inputFormat, outputFormat);
-    flangerNode.setBusFormat(inputFormat, outputFormat);
-    vibratoNode.setBusFormat(inputFormat, outputFormat);
+    driveNode.setBusFormat(inputFormat, outputFormat);
+    glitchNode.setBusFormat(inputFormat, outputFormat);
+    modDelayNode.setBusFormat(inputFormat, outputFormat);
     delayNode.setBusFormat(inputFormat, outputFormat);
 
     // Store outputs for comparison
@@ -504,13 +310,13 @@ TEST_CASE("Integration - Each preset produces distinct output", "[integration][d
         const auto& preset = getPreset(presetIdx);
 
         applyPresetToNodes(preset,
-                          &pitchShiftNode, &ringModNode, &chorusNode,
-                          &flangerNode, &vibratoNode, &delayNode);
+                          &pitchShiftNode, &whisperNode, &ringModNode, &driveNode, &glitchNode, &modDelayNode,
+                          &delayNode);
 
         std::vector<float> outputStereo = processAudioThroughChain(
             inputStereo,
-            &pitchShiftNode, &ringModNode, &chorusNode,
-            &flangerNode, &vibratoNode, &delayNode);
+            &pitchShiftNode, &whisperNode, &ringModNode, &driveNode, &glitchNode, &modDelayNode,
+            &delayNode);
 
         presetOutputs.push_back(stereoToMono(outputStereo));
     }
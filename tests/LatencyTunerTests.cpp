@@ -0,0 +1,88 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "TestHelpers.hpp"
+#include "engine/LatencyTuner.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace voicechanger;
+using namespace voicechanger::test;
+
+// Global Switchboard initialization
+static SwitchboardInitializer switchboardInit;
+
+constexpr uint SAMPLE_RATE = 44100;
+
+static ChainSpec ringModChain() {
+    ChainSpec spec;
+    spec.name = "Ring";
+    spec.stages = {{"ringMod", "VoiceChanger.RingMod", {{"carrierFrequency", 100.0f}, {"mix", 0.8f}}}};
+    return spec;
+}
+
+TEST_CASE("LatencyTuner - Times the slowest call against the buffer deadline", "[LatencyTuner][baseline]") {
+    LatencyTuner tuner(SAMPLE_RATE);
+    tuner.setTrialSeconds(0.2f);
+
+    LatencyTrial trial;
+    std::string error;
+    REQUIRE(tuner.measure(ringModChain(), 256, trial, error));
+    REQUIRE(trial.bufferSize == 256);
+    REQUIRE(trial.deadlineUs == 1.0e6 * 256 / SAMPLE_RATE);
+    REQUIRE(trial.worstUs > 0.0);
+    REQUIRE(trial.fits == (trial.worstUs <= 0.5 * trial.deadlineUs));
+}
+
+TEST_CASE("LatencyTuner - Halves the buffer until a size does not fit", "[LatencyTuner][baseline]") {
+    LatencyTuner tuner(SAMPLE_RATE);
+    tuner.setTrialSeconds(0.2f);
+    tuner.setBufferSizeRange(64, 512);
+
+    uint bufferSize = 0;
+    std::vector<LatencyTrial> trials;
+    std::string error;
+    REQUIRE(tuner.tune(ringModChain(), bufferSize, trials, error));
+    REQUIRE(!trials.empty());
+    REQUIRE(trials.size() <= 4);
+    REQUIRE(trials.front().bufferSize == 512);
+    uint lastFit = trials.front().bufferSize;
+    for (size_t i = 0; i < trials.size(); ++i) {
+        if (trials[i].fits) {
+            lastFit = trials[i].bufferSize;
+        }
+        if (i > 0) {
+            REQUIRE(trials[i].bufferSize == trials[i - 1].bufferSize / 2);
+        }
+        // Every size before the last was kept up with
+        REQUIRE((trials[i].fits || i + 1 == trials.size()));
+    }
+    REQUIRE(bufferSize == lastFit);
+}
+
+TEST_CASE("LatencyTuner - Keeps the largest size when nothing fits", "[LatencyTuner][baseline]") {
+    LatencyTuner tuner(SAMPLE_RATE);
+    tuner.setTrialSeconds(0.1f);
+    tuner.setSafetyMargin(1.0f);  // No time left for processing at all
+
+    uint bufferSize = 0;
+    std::vector<LatencyTrial> trials;
+    std::string error;
+    REQUIRE(tuner.tune(ringModChain(), bufferSize, trials, error));
+    REQUIRE(trials.size() == 1);
+    REQUIRE_FALSE(trials.front().fits);
+    REQUIRE(bufferSize == LatencyTuner::kDefaultLargestBufferSize);
+}
+
+TEST_CASE("LatencyTuner - Reports a chain that does not compile", "[LatencyTuner][baseline]") {
+    ChainSpec spec;
+    spec.name = "Broken";
+    spec.stages = {{"reverb", "VoiceChanger.Reverb", {}}};
+
+    LatencyTuner tuner(SAMPLE_RATE);
+    uint bufferSize = 0;
+    std::vector<LatencyTrial> trials;
+    std::string error;
+    REQUIRE_FALSE(tuner.tune(spec, bufferSize, trials, error));
+    REQUIRE(error.find("VoiceChanger.Reverb") != std::string::npos);
+}
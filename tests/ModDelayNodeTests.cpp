@@ -0,0 +1,171 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include "TestHelpers.hpp"
+#include "nodes/ModDelayNode.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace voicechanger;
+using namespace voicechanger::test;
+using Catch::Approx;
+
+// Global Switchboard initialization
+static SwitchboardInitializer switchboardInit;
+
+// Test constants
+constexpr uint SAMPLE_RATE = 44100;
+constexpr uint BUFFER_SIZE = 512;
+
+static float sumRange(const std::vector<float>& samples, float fromSeconds, float toSeconds) {
+    auto begin = static_cast<size_t>(fromSeconds * SAMPLE_RATE);
+    auto end = std::min(samples.size(), static_cast<size_t>(toSeconds * SAMPLE_RATE) + 1);
+    float sum = 0.0f;
+    for (size_t i = begin; i < end; ++i) {
+        sum += samples[i];
+    }
+    return sum;
+}
+
+TEST_CASE("ModDelayNode - All taps off passes audio through unchanged", "[ModDelayNode][baseline]") {
+    SBAnyMap config;
+    ModDelayNode node(config);
+    prepareNode(node);
+
+    auto input = makeSine(440.0f, 0.5f, 4 * BUFFER_SIZE);
+    auto output = processMono(node, input);
+    REQUIRE(output == input);
+}
+
+TEST_CASE("ModDelayNode - setValue/getValue for parameters", "[ModDelayNode][baseline]") {
+    SBAnyMap config = {{"useChorus", 1.0f}, {"chorusSweepWidth", 0.03f}};
+    ModDelayNode node(config);
+
+    REQUIRE(std::any_cast<float>(node.getValue("useChorus").value()) == 1.0f);
+    REQUIRE(std::any_cast<float>(node.getValue("useVibrato").value()) == 0.0f);
+    REQUIRE(std::any_cast<float>(node.getValue("chorusSweepWidth").value()) == Approx(0.03f));
+
+    REQUIRE(!node.setValue("vibratoSweepWidth", std::make_any<float>(1.0f)).isError());
+    REQUIRE(std::any_cast<float>(node.getValue("vibratoSweepWidth").value()) == Approx(0.01f));
+    REQUIRE(!node.setValue("flangerFrequency", std::make_any<float>(0.0f)).isError());
+    REQUIRE(std::any_cast<float>(node.getValue("flangerFrequency").value()) == Approx(0.05f));
+    REQUIRE(!node.setValue("useFlanger", std::make_any<float>(1.0f)).isError());
+    REQUIRE(std::any_cast<float>(node.getValue("useFlanger").value()) == 1.0f);
+
+    REQUIRE(node.setValue("chorusFrequency", std::make_any<int>(1)).isError());
+    REQUIRE(node.setValue("unknown", std::make_any<float>(0.0f)).isError());
+}
+
+TEST_CASE("ModDelayNode - Chorus and flanger taps sit at their delays", "[ModDelayNode]") {
+    // Slow, narrow sweeps so an impulse lands inside a known window
+    SBAnyMap config = {{"useChorus", 1.0f}, {"chorusSweepWidth", 0.001f}, {"chorusFrequency", 0.1f},
+                       {"useFlanger", 1.0f}, {"flangerSweepWidth", 0.001f}, {"flangerFrequency", 0.05f}};
+    ModDelayNode node(config);
+    prepareNode(node);
+
+    std::vector<float> input(8 * BUFFER_SIZE, 0.0f);
+    input[0] = 1.0f;
+    auto output = processMono(node, input);
+
+    REQUIRE(output[0] == Approx(1.0f));
+    // Flanger: 1 to 2 ms, chorus: 20 to 21 ms, each spread over two interpolated samples
+    REQUIRE(sumRange(output, 0.0009f, 0.0021f) == Approx(0.7f).margin(1.0e-3));
+    REQUIRE(sumRange(output, 0.0199f, 0.0211f) == Approx(0.5f).margin(1.0e-3));
+    REQUIRE(sumRange(output, 0.0022f, 0.0198f) == Approx(0.0f).margin(1.0e-6));
+}
+
+TEST_CASE("ModDelayNode - Tap levels between 0 and 1 scale the taps", "[ModDelayNode]") {
+    SBAnyMap config = {{"useVibrato", 0.25f}, {"vibratoSweepWidth", 0.002f}, {"vibratoFrequency", 0.1f},
+                       {"useChorus", 0.5f}, {"chorusSweepWidth", 0.001f}, {"chorusFrequency", 0.1f}};
+    ModDelayNode node(config);
+    prepareNode(node);
+    REQUIRE(std::any_cast<float>(node.getValue("useChorus").value()) == Approx(0.5f));
+
+    std::vector<float> input(8 * BUFFER_SIZE, 0.0f);
+    input[0] = 1.0f;
+    auto output = processMono(node, input);
+
+    // A quarter of the vibrato tap over three quarters of the dry signal, and half the chorus
+    REQUIRE(output[0] == Approx(0.75f));
+    REQUIRE(sumRange(output, 0.0009f, 0.0011f) == Approx(0.25f).margin(1.0e-3));
+    REQUIRE(sumRange(output, 0.0199f, 0.0221f) == Approx(0.25f).margin(1.0e-3));
+}
+
+TEST_CASE("ModDelayNode - Vibrato delays the chorus tap with it", "[ModDelayNode]") {
+    SBAnyMap config = {{"useVibrato", 1.0f}, {"vibratoSweepWidth", 0.002f}, {"vibratoFrequency", 0.1f},
+                       {"useChorus", 1.0f}, {"chorusSweepWidth", 0.001f}, {"chorusFrequency", 0.1f}};
+    ModDelayNode node(config);
+    prepareNode(node);
+
+    std::vector<float> input(8 * BUFFER_SIZE, 0.0f);
+    input[0] = 1.0f;
+    auto output = processMono(node, input);
+
+    // No dry path; the vibrato tap starts at mid-sweep (1 ms) and chorus rides on it
+    REQUIRE(output[0] == Approx(0.0f).margin(1.0e-6));
+    REQUIRE(sumRange(output, 0.0009f, 0.0011f) == Approx(1.0f).margin(1.0e-3));
+    REQUIRE(sumRange(output, 0.0209f, 0.0221f) == Approx(0.5f).margin(1.0e-3));
+}
+
+TEST_CASE("ModDelayNode - Vibrato sweeps the pitch of a steady tone", "[ModDelayNode]") {
+    // A 5 ms sweep at 5 Hz moves the pitch by about +/-7.9%
+    SBAnyMap config = {{"useVibrato", 1.0f}, {"vibratoSweepWidth", 0.005f}, {"vibratoFrequency", 5.0f}};
+    ModDelayNode node(config);
+    prepareNode(node);
+
+    auto output = processMono(node, makeSine(440.0f, 0.5f, SAMPLE_RATE));
+
+    // Periods between rising zero crossings, after the line has filled
+    std::vector<float> periods;
+    float lastCrossing = -1.0f;
+    for (size_t i = SAMPLE_RATE / 10; i < output.size(); ++i) {
+        if (output[i - 1] < 0.0f && output[i] >= 0.0f) {
+            float crossing = static_cast<float>(i - 1) + output[i - 1] / (output[i - 1] - output[i]);
+            if (lastCrossing >= 0.0f) {
+                periods.push_back(crossing - lastCrossing);
+            }
+            lastCrossing = crossing;
+        }
+    }
+    REQUIRE(!periods.empty());
+    float nominal = static_cast<float>(SAMPLE_RATE) / 440.0f;
+    float shortest = *std::min_element(periods.begin(), periods.end());
+    float longest = *std::max_element(periods.begin(), periods.end());
+    INFO("Periods " << shortest << " to " << longest << " samples, nominal " << nominal);
+    REQUIRE(nominal / shortest == Approx(1.0f + 0.079f).margin(0.01f));
+    REQUIRE(nominal / longest == Approx(1.0f - 0.079f).margin(0.01f));
+}
+
+TEST_CASE("ModDelayNode - Switching taps on and off does not click", "[ModDelayNode]") {
+    SBAnyMap config = {{"flangerSweepWidth", 0.008f}, {"vibratoSweepWidth", 0.005f}};
+    ModDelayNode node(config);
+    prepareNode(node);
+
+    auto input = makeSine(220.0f, 0.5f, 16 * BUFFER_SIZE);
+    std::vector<float> output;
+    auto run = [&](size_t block) {
+        std::vector<float> chunk(input.begin() + static_cast<std::ptrdiff_t>(block * BUFFER_SIZE),
+                                 input.begin() + static_cast<std::ptrdiff_t>((block + 4) * BUFFER_SIZE));
+        auto processed = processMono(node, chunk);
+        output.insert(output.end(), processed.begin(), processed.end());
+    };
+
+    run(0);
+    node.setValue("useFlanger", std::make_any<float>(1.0f));
+    node.setValue("useVibrato", std::make_any<float>(1.0f));
+    run(4);
+    node.setValue("useVibrato", std::make_any<float>(0.0f));
+    run(8);
+    node.setValue("useFlanger", std::make_any<float>(0.0f));
+    run(12);
+
+    // The steepest edge stays near the tone's own slope (0.0157 at full scale), not a jump
+    float maxStep = 0.0f;
+    for (size_t i = 1; i < output.size(); ++i) {
+        maxStep = std::max(maxStep, std::abs(output[i] - output[i - 1]));
+    }
+    INFO("Max step: " << maxStep);
+    REQUIRE(maxStep < 0.04f);
+}
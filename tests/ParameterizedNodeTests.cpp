@@ -0,0 +1,189 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include "TestHelpers.hpp"
+#include "chain/VoiceChain.hpp"
+#include "nodes/PitchCorrectNode.hpp"
+#include "nodes/PitchDetectNode.hpp"
+#include "nodes/PitchShiftNode.hpp"
+#include "nodes/RingModNode.hpp"
+#include "nodes/VoiceActivityNode.hpp"
+
+#include <cmath>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace voicechanger;
+using namespace voicechanger::test;
+using Catch::Approx;
+
+// Global Switchboard initialization
+static SwitchboardInitializer switchboardInit;
+
+/**
+ * One node of every parameterized type, at its defaults.
+ */
+static std::vector<std::unique_ptr<ParameterizedNode>> makeAllNodes() {
+    std::vector<std::unique_ptr<ParameterizedNode>> nodes;
+    for (const char* type : {"VoiceChanger.PitchShift", "VoiceChanger.Whisper", "VoiceChanger.RingMod",
+                             "VoiceChanger.Drive", "VoiceChanger.Glitch", "VoiceChanger.ModDelay",
+                             "VoiceChanger.Delay"}) {
+        nodes.push_back(VoiceChain::createStage(type));
+    }
+    SBAnyMap config;
+    nodes.push_back(std::make_unique<PitchCorrectNode>(config));
+    nodes.push_back(std::make_unique<PitchDetectNode>(config));
+    nodes.push_back(std::make_unique<VoiceActivityNode>(config));
+    return nodes;
+}
+
+TEST_CASE("ParameterizedNode - Tables match the nodes' defaults", "[ParameterizedNode][baseline]") {
+    for (const auto& node : makeAllNodes()) {
+        REQUIRE(node);
+        std::set<std::string> keys;
+        for (uint32_t id = 0; id < node->getParameterCount(); ++id) {
+            const auto& descriptor = node->getParameterDescriptor(id);
+            INFO(descriptor.key);
+            REQUIRE(keys.insert(descriptor.key).second);
+            REQUIRE(node->findParameter(descriptor.key) == static_cast<int>(id));
+            REQUIRE(descriptor.minValue <= descriptor.defaultValue);
+            REQUIRE(descriptor.defaultValue <= descriptor.maxValue);
+
+            // The table's default is what the node starts with
+            REQUIRE(node->getParameter(id) == Approx(descriptor.defaultValue));
+            auto result = node->getValue(descriptor.key);
+            REQUIRE(!result.isError());
+            REQUIRE(std::any_cast<float>(result.value()) == Approx(descriptor.defaultValue));
+        }
+        REQUIRE(node->findParameter("noSuchParameter") == ParameterizedNode::kUnknownParameter);
+    }
+}
+
+TEST_CASE("ParameterizedNode - Handles clamp like setValue", "[ParameterizedNode][baseline]") {
+    SBAnyMap config;
+    RingModNode node(config);
+
+    ParameterHandle carrier = node.getParameterHandle("carrierFrequency");
+    REQUIRE(carrier);
+    REQUIRE(carrier.getId() == RingModNode::kCarrierFrequency);
+
+    carrier.set(250.0f);
+    REQUIRE(carrier.get() == Approx(250.0f));
+    REQUIRE(std::any_cast<float>(node.getValue("carrierFrequency").value()) == Approx(250.0f));
+
+    carrier.set(5000.0f);
+    REQUIRE(carrier.get() == Approx(1000.0f));
+    REQUIRE(!node.setValue("carrierFrequency", std::make_any<float>(1.0f)).isError());
+    REQUIRE(carrier.get() == Approx(10.0f));
+
+    // Out-of-range ids are ignored
+    node.setParameter(RingModNode::kNumParams, 0.5f);
+    REQUIRE(node.getParameter(RingModNode::kMix) == Approx(1.0f));
+
+    REQUIRE_FALSE(node.getParameterHandle("roomSize"));
+    REQUIRE(node.setValue("roomSize", std::make_any<float>(1.0f)).isError());
+    REQUIRE(node.setValue("mix", std::make_any<int>(1)).isError());
+}
+
+TEST_CASE("ParameterizedNode - Read-only parameters ignore writes", "[ParameterizedNode][baseline]") {
+    SBAnyMap config;
+    PitchShiftNode node(config);
+
+    REQUIRE(node.getParameterDescriptor(PitchShiftNode::kLatency).readOnly);
+    REQUIRE(node.getParameterDescriptor(PitchShiftNode::kProcessingRate).structural);
+    REQUIRE_FALSE(node.getParameterDescriptor(PitchShiftNode::kPitchShift).structural);
+    node.setParameter(PitchShiftNode::kLatency, 50.0f);
+    REQUIRE(node.getParameter(PitchShiftNode::kLatency) == Approx(0.0f));
+
+    auto result = node.setValue("latency", std::make_any<float>(50.0f));
+    REQUIRE(result.isError());
+    REQUIRE(result.error().message.find("Read-only") != std::string::npos);
+
+    // Zero keeps meaning "off" where the range starts above it
+    node.setParameter(PitchShiftNode::kTargetMedianHz, 20.0f);
+    REQUIRE(node.getParameter(PitchShiftNode::kTargetMedianHz) == Approx(50.0f));
+    node.setParameter(PitchShiftNode::kTargetMedianHz, 0.0f);
+    REQUIRE(node.getParameter(PitchShiftNode::kTargetMedianHz) == Approx(0.0f));
+}
+
+TEST_CASE("ParameterizedNode - NaN and infinity are rejected on every path", "[ParameterizedNode][baseline]") {
+    SBAnyMap config = {{"carrierFrequency", NAN}, {"mix", 0.5f}};
+    RingModNode node(config);
+    REQUIRE(node.getParameter(RingModNode::kCarrierFrequency) == Approx(100.0f));
+    REQUIRE(node.getParameter(RingModNode::kMix) == Approx(0.5f));
+
+    REQUIRE_FALSE(node.setParameter(RingModNode::kMix, NAN));
+    REQUIRE_FALSE(node.getParameterHandle("mix").set(INFINITY));
+    REQUIRE_FALSE(node.setParameter(RingModNode::kCarrierFrequency, -INFINITY));
+    REQUIRE(node.getParameter(RingModNode::kMix) == Approx(0.5f));
+    REQUIRE(node.getParameter(RingModNode::kCarrierFrequency) == Approx(100.0f));
+
+    auto result = node.setValue("mix", std::make_any<float>(NAN));
+    REQUIRE(result.isError());
+    REQUIRE(result.error().message.find("Non-finite") != std::string::npos);
+    REQUIRE(node.getParameter(RingModNode::kMix) == Approx(0.5f));
+
+    // Out-of-range finite values still clamp
+    REQUIRE(node.setParameter(RingModNode::kMix, 2.0f));
+    REQUIRE(node.getParameter(RingModNode::kMix) == Approx(1.0f));
+
+    // Chains refuse them at compile time and ignore them when live
+    ChainSpec spec;
+    spec.name = "RingMod";
+    spec.stages = {{"ringMod", "VoiceChanger.RingMod", {{"mix", NAN}}}};
+    std::string error;
+    REQUIRE_FALSE(VoiceChain::compile(spec, switchboard::AudioBusFormat(44100, 2, 512), error));
+    REQUIRE(error.find("finite") != std::string::npos);
+
+    spec.stages[0].params[0].value = 0.5f;
+    auto chain = VoiceChain::compile(spec, switchboard::AudioBusFormat(44100, 2, 512), error);
+    REQUIRE(chain);
+    ParameterHandle mix = chain->findParameter("ringMod", "mix");
+    chain->applyParameter(mix, NAN);
+    REQUIRE(mix.get() == Approx(0.5f));
+}
+
+TEST_CASE("ParameterizedNode - PitchCorrect extends PitchShift's table", "[ParameterizedNode][baseline]") {
+    SBAnyMap config = {{"pitchShift", 3.0f}, {"key", 4.0f}, {"scale", 1.0f}};
+    PitchCorrectNode node(config);
+
+    REQUIRE(node.getParameterCount() == PitchCorrectNode::kNumParams);
+    REQUIRE(node.findParameter("pitchShift") == PitchShiftNode::kPitchShift);
+    REQUIRE(node.findParameter("key") == PitchCorrectNode::kKey);
+    REQUIRE(node.getParameter(PitchShiftNode::kPitchShift) == Approx(3.0f));
+    REQUIRE(node.getParameter(PitchCorrectNode::kKey) == Approx(4.0f));
+
+    // Integer parameters round, then clamp to the table's range
+    node.getParameterHandle("scale").set(2.6f);
+    REQUIRE(node.getParameter(PitchCorrectNode::kScale) == Approx(3.0f));
+    node.getParameterHandle("scale").set(99.0f);
+    REQUIRE(node.getParameter(PitchCorrectNode::kScale) == Approx(4.0f));
+}
+
+TEST_CASE("ParameterizedNode - Chains resolve handles to compiled stages", "[ParameterizedNode][baseline]") {
+    // ids resolved up front, as the preset loader does
+    StageSpec ringMod{"ringMod", "VoiceChanger.RingMod",
+                      {{"carrierFrequency", 80.0f, RingModNode::kCarrierFrequency}, {"mix", 0.5f}}};
+    StageSpec whisper{"whisper", "VoiceChanger.Whisper", {{"mix", 0.0f}}};
+    ChainSpec spec{"RingMod", {whisper, ringMod}};
+
+    std::string error;
+    auto chain = VoiceChain::compile(spec, switchboard::AudioBusFormat(44100, 2, 512), error);
+    REQUIRE(chain);
+
+    ParameterHandle mix = chain->findParameter("ringMod", "mix");
+    ParameterHandle carrier = chain->findParameter("ringMod", "carrierFrequency");
+    REQUIRE(mix);
+    REQUIRE(carrier);
+    REQUIRE(mix.get() == Approx(0.5f));
+    REQUIRE(carrier.get() == Approx(80.0f));
+
+    mix.set(0.25f);
+    REQUIRE(std::any_cast<float>(chain->findStage("ringMod")->getValue("mix").value()) == Approx(0.25f));
+
+    // Pruned stages and unknown keys give empty handles
+    REQUIRE_FALSE(chain->findParameter("whisper", "mix"));
+    REQUIRE_FALSE(chain->findParameter("ringMod", "roomSize"));
+}
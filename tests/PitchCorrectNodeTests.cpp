@@ -0,0 +1,163 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include "TestHelpers.hpp"
+#include "nodes/PitchCorrectNode.hpp"
+
+#include <vector>
+
+using namespace voicechanger;
+using namespace voicechanger::test;
+using Catch::Approx;
+
+// Global Switchboard initialization
+static SwitchboardInitializer switchboardInit;
+
+// Test constants
+constexpr uint SAMPLE_RATE = 44100;
+constexpr uint NUM_CHANNELS = 2;
+constexpr uint BUFFER_SIZE = 512;
+
+/**
+ * Helper to process a sine through the node and collect channel 0 after warmup.
+ */
+static std::vector<float> processSine(PitchCorrectNode& node, float frequency,
+                                      int totalBuffers, int warmupBuffers) {
+    std::vector<float> outputSamples;
+
+    for (int i = 0; i < totalBuffers; ++i) {
+        TestAudioBus inBus(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+        TestAudioBus outBus(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+
+        inBus.fillWithSine(frequency, 0.5f, SAMPLE_RATE, i * BUFFER_SIZE);
+        node.process(inBus.bus, outBus.bus);
+
+        if (i > warmupBuffers) {
+            for (uint frame = 0; frame < BUFFER_SIZE; ++frame) {
+                outputSamples.push_back(outBus.getSample(0, frame));
+            }
+        }
+    }
+
+    return outputSamples;
+}
+
+/**
+ * Zero-crossing frequency estimate.
+ */
+static float estimateFrequency(const std::vector<float>& samples) {
+    int zeroCrossings = 0;
+    for (size_t i = 1; i < samples.size(); ++i) {
+        if ((samples[i-1] < 0 && samples[i] >= 0) ||
+            (samples[i-1] >= 0 && samples[i] < 0)) {
+            ++zeroCrossings;
+        }
+    }
+    float duration = static_cast<float>(samples.size()) / SAMPLE_RATE;
+    return (zeroCrossings / 2.0f) / duration;
+}
+
+TEST_CASE("PitchCorrectNode - correctionToScale picks the nearest scale note", "[PitchCorrectNode][baseline]") {
+    // Chromatic: always the nearest semitone
+    REQUIRE(PitchCorrectNode::correctionToScale(60.3f, 0, 0) == Approx(-0.3f));
+    REQUIRE(PitchCorrectNode::correctionToScale(60.7f, 0, 0) == Approx(0.3f));
+
+    // C major: C# (61) is not in the scale, so 61.2 goes to D (62), 60.8 to C (60)
+    REQUIRE(PitchCorrectNode::correctionToScale(61.2f, 0, 1) == Approx(0.8f));
+    REQUIRE(PitchCorrectNode::correctionToScale(60.8f, 0, 1) == Approx(-0.8f));
+
+    // D major (key = 2): C# (61) is in the scale
+    REQUIRE(PitchCorrectNode::correctionToScale(61.2f, 2, 1) == Approx(-0.2f));
+
+    // A minor pentatonic (key = 9): A C D E G, so B (71) goes to A (69) or C (72)
+    REQUIRE(PitchCorrectNode::correctionToScale(71.4f, 9, 4) == Approx(0.6f));
+}
+
+TEST_CASE("PitchCorrectNode - setValue/getValue for correction parameters", "[PitchCorrectNode][baseline]") {
+    SBAnyMap config;
+    PitchCorrectNode node(config);
+
+    REQUIRE(std::any_cast<float>(node.getValue("retuneSpeed").value()) == Approx(50.0f));  // default
+    REQUIRE(!node.setValue("retuneSpeed", std::make_any<float>(0.0f)).isError());
+    REQUIRE(std::any_cast<float>(node.getValue("retuneSpeed").value()) == Approx(0.0f));
+
+    REQUIRE(!node.setValue("key", std::make_any<float>(14.0f)).isError());
+    REQUIRE(std::any_cast<float>(node.getValue("key").value()) == Approx(11.0f));  // clamped
+
+    REQUIRE(!node.setValue("scale", std::make_any<float>(2.0f)).isError());
+    REQUIRE(std::any_cast<float>(node.getValue("scale").value()) == Approx(2.0f));
+
+    // Inherited PitchShiftNode parameters still work
+    REQUIRE(!node.setValue("pitchShift", std::make_any<float>(-3.0f)).isError());
+    REQUIRE(std::any_cast<float>(node.getValue("pitchShift").value()) == Approx(-3.0f));
+
+    // Analysis outputs are read-only
+    REQUIRE(node.setValue("correction", std::make_any<float>(1.0f)).isError());
+    REQUIRE(node.setValue("f0", std::make_any<float>(1.0f)).isError());
+}
+
+TEST_CASE("PitchCorrectNode - Reports stretcher latency", "[PitchCorrectNode]") {
+    SBAnyMap config;
+    PitchCorrectNode node(config);
+
+    switchboard::AudioBusFormat inputFormat(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    switchboard::AudioBusFormat outputFormat(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    REQUIRE(node.setBusFormat(inputFormat, outputFormat));
+
+    float latencyMs = std::any_cast<float>(node.getValue("latency").value());
+    INFO("Latency: " << latencyMs << " ms");
+    REQUIRE(latencyMs > 0.0f);
+    REQUIRE(latencyMs < 200.0f);
+}
+
+TEST_CASE("PitchCorrectNode - Detuned tone is pulled onto the scale", "[PitchCorrectNode]") {
+    // 230 Hz is MIDI 57.77: between A3 (220 Hz) and A#3. In C major A#
+    // is not available, so the nearest scale note is A3.
+    SBAnyMap config = {
+        {"key", 0.0f},
+        {"scale", 1.0f},
+        {"retuneSpeed", 0.0f}
+    };
+    PitchCorrectNode node(config);
+
+    switchboard::AudioBusFormat inputFormat(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    switchboard::AudioBusFormat outputFormat(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    REQUIRE(node.setBusFormat(inputFormat, outputFormat));
+
+    auto outputSamples = processSine(node, 230.0f, 60, 20);
+
+    float detected = std::any_cast<float>(node.getValue("f0").value());
+    float correction = std::any_cast<float>(node.getValue("correction").value());
+    INFO("Detected f0: " << detected << " Hz, correction: " << correction << " semitones");
+    REQUIRE(detected == Approx(230.0f).epsilon(0.01));
+    REQUIRE(correction == Approx(-0.77f).margin(0.05));
+
+    float outputFrequency = estimateFrequency(outputSamples);
+    INFO("Output frequency: " << outputFrequency << " Hz (expected ~220 Hz)");
+    REQUIRE(outputFrequency == Approx(220.0f).epsilon(0.03));
+}
+
+TEST_CASE("PitchCorrectNode - Retune speed glides instead of jumping", "[PitchCorrectNode]") {
+    SBAnyMap config = {
+        {"scale", 1.0f},
+        {"retuneSpeed", 400.0f}
+    };
+    PitchCorrectNode node(config);
+
+    switchboard::AudioBusFormat inputFormat(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    switchboard::AudioBusFormat outputFormat(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    REQUIRE(node.setBusFormat(inputFormat, outputFormat));
+
+    // ~100 ms in: the detector has locked but a 400 ms glide is far from done
+    processSine(node, 230.0f, 9, 0);
+    float earlyCorrection = std::any_cast<float>(node.getValue("correction").value());
+
+    // ~1.5 s in: settled on the target
+    processSine(node, 230.0f, 120, 120);
+    float lateCorrection = std::any_cast<float>(node.getValue("correction").value());
+
+    INFO("Early correction: " << earlyCorrection << ", late correction: " << lateCorrection);
+    REQUIRE(earlyCorrection < 0.0f);
+    REQUIRE(earlyCorrection > -0.5f);
+    REQUIRE(lateCorrection == Approx(-0.77f).margin(0.05));
+}
@@ -0,0 +1,227 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include "TestHelpers.hpp"
+#include "nodes/PitchDetectNode.hpp"
+
+#include <algorithm>
+#include <vector>
+
+using namespace voicechanger;
+using namespace voicechanger::test;
+using Catch::Approx;
+
+// Global Switchboard initialization
+static SwitchboardInitializer switchboardInit;
+
+// Test constants
+constexpr uint SAMPLE_RATE = 44100;
+constexpr uint NUM_CHANNELS = 2;
+constexpr uint BUFFER_SIZE = 512;
+
+/**
+ * Helper to run a mono signal through the detector block by block.
+ * Returns the (f0, confidence) pair read back after every block.
+ */
+static std::vector<std::pair<float, float>> trackPitch(PitchDetectNode& node,
+                                                       const std::vector<float>& mono) {
+    std::vector<std::pair<float, float>> track;
+
+    for (size_t offset = 0; offset + BUFFER_SIZE <= mono.size(); offset += BUFFER_SIZE) {
+        TestAudioBus inBus(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+        TestAudioBus outBus(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+
+        for (uint frame = 0; frame < BUFFER_SIZE; ++frame) {
+            inBus.setSample(0, frame, mono[offset + frame]);
+            inBus.setSample(1, frame, mono[offset + frame]);
+        }
+
+        node.process(inBus.bus, outBus.bus);
+
+        float f0 = std::any_cast<float>(node.getValue("f0").value());
+        float confidence = std::any_cast<float>(node.getValue("confidence").value());
+        track.emplace_back(f0, confidence);
+    }
+
+    return track;
+}
+
+/**
+ * Median of the voiced (f0 > 0) estimates in a track.
+ */
+static float voicedMedian(const std::vector<std::pair<float, float>>& track) {
+    std::vector<float> voiced;
+    for (const auto& [f0, confidence] : track) {
+        if (f0 > 0.0f) {
+            voiced.push_back(f0);
+        }
+    }
+    if (voiced.empty()) {
+        return 0.0f;
+    }
+    std::nth_element(voiced.begin(), voiced.begin() + voiced.size() / 2, voiced.end());
+    return voiced[voiced.size() / 2];
+}
+
+/**
+ * Load a Harvard sentence, resampled to the graph rate.
+ */
+static std::vector<float> loadHarvard(const std::string& filename) {
+    std::vector<float> samples;
+    uint32_t sampleRate = 0;
+    uint16_t channels = 0;
+    REQUIRE(loadWavFile(std::string(TEST_ASSETS_DIR) + "/" + filename, samples, sampleRate, channels));
+    return resample(samples, sampleRate, SAMPLE_RATE);
+}
+
+TEST_CASE("PitchDetectNode - Passes audio through unchanged", "[PitchDetectNode][baseline]") {
+    SBAnyMap config;
+    PitchDetectNode node(config);
+
+    switchboard::AudioBusFormat inputFormat(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    switchboard::AudioBusFormat outputFormat(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    REQUIRE(node.setBusFormat(inputFormat, outputFormat));
+
+    TestAudioBus inBus(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    TestAudioBus outBus(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    inBus.fillWithSine(220.0f, 0.5f, SAMPLE_RATE);
+
+    REQUIRE(node.process(inBus.bus, outBus.bus));
+
+    for (uint ch = 0; ch < NUM_CHANNELS; ++ch) {
+        for (uint frame = 0; frame < BUFFER_SIZE; ++frame) {
+            REQUIRE(outBus.getSample(ch, frame) == inBus.getSample(ch, frame));
+        }
+    }
+}
+
+TEST_CASE("PitchDetectNode - Silence reports no pitch", "[PitchDetectNode][baseline]") {
+    SBAnyMap config;
+    PitchDetectNode node(config);
+
+    switchboard::AudioBusFormat inputFormat(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    switchboard::AudioBusFormat outputFormat(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    REQUIRE(node.setBusFormat(inputFormat, outputFormat));
+
+    auto track = trackPitch(node, std::vector<float>(SAMPLE_RATE / 2, 0.0f));
+    REQUIRE(track.back().first == 0.0f);
+    REQUIRE(track.back().second == 0.0f);
+}
+
+TEST_CASE("PitchDetectNode - setValue/getValue for parameters", "[PitchDetectNode][baseline]") {
+    SBAnyMap config;
+    PitchDetectNode node(config);
+
+    REQUIRE(std::any_cast<float>(node.getValue("threshold").value()) == Approx(0.15f));  // default
+    REQUIRE(!node.setValue("threshold", std::make_any<float>(0.2f)).isError());
+    REQUIRE(std::any_cast<float>(node.getValue("threshold").value()) == Approx(0.2f));
+
+    REQUIRE(!node.setValue("minFrequency", std::make_any<float>(80.0f)).isError());
+    REQUIRE(std::any_cast<float>(node.getValue("minFrequency").value()) == Approx(80.0f));
+
+    REQUIRE(!node.setValue("maxFrequency", std::make_any<float>(5000.0f)).isError());
+    REQUIRE(std::any_cast<float>(node.getValue("maxFrequency").value()) == Approx(2000.0f));  // clamped
+}
+
+TEST_CASE("PitchDetectNode - f0 and confidence are read-only", "[PitchDetectNode][baseline]") {
+    SBAnyMap config;
+    PitchDetectNode node(config);
+
+    REQUIRE(node.setValue("f0", std::make_any<float>(100.0f)).isError());
+    REQUIRE(node.setValue("confidence", std::make_any<float>(1.0f)).isError());
+    REQUIRE(!node.getValue("f0").isError());
+    REQUIRE(!node.getValue("confidence").isError());
+}
+
+TEST_CASE("PitchDetectNode - Sine frequencies are detected within 1%", "[PitchDetectNode]") {
+    for (float frequency : {82.0f, 110.0f, 196.0f, 261.6f, 440.0f, 784.0f}) {
+        SBAnyMap config;
+        PitchDetectNode node(config);
+
+        switchboard::AudioBusFormat inputFormat(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+        switchboard::AudioBusFormat outputFormat(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+        REQUIRE(node.setBusFormat(inputFormat, outputFormat));
+
+        std::vector<float> signal(SAMPLE_RATE / 2);
+        for (size_t i = 0; i < signal.size(); ++i) {
+            signal[i] = 0.5f * std::sin(2.0f * static_cast<float>(M_PI) * frequency * i / SAMPLE_RATE);
+        }
+
+        auto track = trackPitch(node, signal);
+        auto [f0, confidence] = track.back();
+
+        INFO("Input " << frequency << " Hz, detected " << f0 << " Hz, confidence " << confidence);
+        REQUIRE(f0 == Approx(frequency).epsilon(0.01));
+        REQUIRE(confidence > 0.9f);
+    }
+}
+
+TEST_CASE("PitchDetectNode - Harmonic-rich tone reports the fundamental", "[PitchDetectNode]") {
+    // Missing-strong-fundamental case: harmonics 2-4 louder than the fundamental
+    constexpr float FUNDAMENTAL = 120.0f;
+
+    SBAnyMap config;
+    PitchDetectNode node(config);
+
+    switchboard::AudioBusFormat inputFormat(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    switchboard::AudioBusFormat outputFormat(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    REQUIRE(node.setBusFormat(inputFormat, outputFormat));
+
+    std::vector<float> signal(SAMPLE_RATE / 2);
+    for (size_t i = 0; i < signal.size(); ++i) {
+        float t = static_cast<float>(i) / SAMPLE_RATE;
+        float w = 2.0f * static_cast<float>(M_PI) * FUNDAMENTAL * t;
+        signal[i] = 0.1f * std::sin(w) + 0.3f * std::sin(2.0f * w) +
+                    0.25f * std::sin(3.0f * w) + 0.2f * std::sin(4.0f * w);
+    }
+
+    auto track = trackPitch(node, signal);
+    INFO("Detected " << track.back().first << " Hz");
+    REQUIRE(track.back().first == Approx(FUNDAMENTAL).epsilon(0.02));
+}
+
+TEST_CASE("PitchDetectNode - Harvard sentences give plausible voice pitch", "[PitchDetectNode][harvard]") {
+    SBAnyMap config;
+    PitchDetectNode maleNode(config);
+    PitchDetectNode femaleNode(config);
+
+    switchboard::AudioBusFormat inputFormat(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    switchboard::AudioBusFormat outputFormat(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    REQUIRE(maleNode.setBusFormat(inputFormat, outputFormat));
+    REQUIRE(femaleNode.setBusFormat(inputFormat, outputFormat));
+
+    auto maleTrack = trackPitch(maleNode, loadHarvard("harvard_male_01.wav"));
+    auto femaleTrack = trackPitch(femaleNode, loadHarvard("harvard_female_01.wav"));
+
+    float maleMedian = voicedMedian(maleTrack);
+    float femaleMedian = voicedMedian(femaleTrack);
+    INFO("Male median f0: " << maleMedian << " Hz, female median f0: " << femaleMedian << " Hz");
+
+    // Typical adult speaking ranges
+    REQUIRE(maleMedian > 80.0f);
+    REQUIRE(maleMedian < 180.0f);
+    REQUIRE(femaleMedian > 150.0f);
+    REQUIRE(femaleMedian < 300.0f);
+    REQUIRE(femaleMedian > maleMedian * 1.3f);
+
+    // Continuous speech should be voiced a good part of the time, and the
+    // voiced track should be mostly free of octave jumps between blocks
+    for (const auto* track : {&maleTrack, &femaleTrack}) {
+        int voiced = 0;
+        int jumps = 0;
+        float previous = 0.0f;
+        for (const auto& [f0, confidence] : *track) {
+            if (f0 > 0.0f) {
+                ++voiced;
+                REQUIRE(confidence > 0.8f);
+                if (previous > 0.0f && (f0 > previous * 1.8f || f0 < previous / 1.8f)) {
+                    ++jumps;
+                }
+            }
+            previous = f0;
+        }
+        INFO("Voiced blocks: " << voiced << "/" << track->size() << ", octave jumps: " << jumps);
+        REQUIRE(voiced > static_cast<int>(track->size()) / 5);
+        REQUIRE(jumps < voiced / 20);
+    }
+}
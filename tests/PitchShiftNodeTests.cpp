@@ -2,8 +2,16 @@
 #include <catch2/catch_approx.hpp>
 
 #include "TestHelpers.hpp"
+#include "dsp/Fft.hpp"
+#include "dsp/Random.hpp"
+#include "dsp/Resampler.hpp"
+#include "nodes/PitchDetectNode.hpp"
 #include "nodes/PitchShiftNode.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 using namespace voicechanger;
 using namespace voicechanger::test;
 using Catch::Approx;
@@ -158,6 +166,135 @@ TEST_CASE("PitchShiftNode - setValue/getValue for outputGain", "[PitchShiftNode]
     REQUIRE(std::any_cast<float>(result.value()) == Approx(2.0f));
 }
 
+TEST_CASE("PitchShiftNode - latency is reported and read-only", "[PitchShiftNode][baseline]") {
+    SBAnyMap config;
+    PitchShiftNode node(config);
+
+    switchboard::AudioBusFormat inputFormat(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    switchboard::AudioBusFormat outputFormat(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    REQUIRE(node.setBusFormat(inputFormat, outputFormat));
+
+    auto result = node.getValue("latency");
+    REQUIRE(!result.isError());
+    REQUIRE(std::any_cast<float>(result.value()) > 0.0f);
+
+    REQUIRE(node.setValue("latency", std::make_any<float>(0.0f)).isError());
+}
+
+TEST_CASE("PitchShiftNode - setValue/getValue for targetMedianHz", "[PitchShiftNode][baseline]") {
+    SBAnyMap config;
+    PitchShiftNode node(config);
+
+    // Off by default
+    REQUIRE(std::any_cast<float>(node.getValue("targetMedianHz").value()) == Approx(0.0f));
+
+    REQUIRE(!node.setValue("targetMedianHz", std::make_any<float>(160.0f)).isError());
+    REQUIRE(std::any_cast<float>(node.getValue("targetMedianHz").value()) == Approx(160.0f));
+
+    // Clamped to the voice range; zero or below switches the mode off
+    REQUIRE(!node.setValue("targetMedianHz", std::make_any<float>(20.0f)).isError());
+    REQUIRE(std::any_cast<float>(node.getValue("targetMedianHz").value()) == Approx(50.0f));
+    REQUIRE(!node.setValue("targetMedianHz", std::make_any<float>(2000.0f)).isError());
+    REQUIRE(std::any_cast<float>(node.getValue("targetMedianHz").value()) == Approx(500.0f));
+    REQUIRE(!node.setValue("targetMedianHz", std::make_any<float>(-1.0f)).isError());
+    REQUIRE(std::any_cast<float>(node.getValue("targetMedianHz").value()) == Approx(0.0f));
+
+    // Tracking outputs are read-only
+    REQUIRE(node.setValue("medianF0", std::make_any<float>(100.0f)).isError());
+    REQUIRE(node.setValue("transpose", std::make_any<float>(1.0f)).isError());
+}
+
+TEST_CASE("PitchShiftNode - setValue/getValue for processingRate", "[PitchShiftNode][baseline]") {
+    SBAnyMap config;
+    PitchShiftNode node(config);
+
+    // Graph rate by default
+    REQUIRE(std::any_cast<float>(node.getValue("processingRate").value()) == Approx(0.0f));
+
+    REQUIRE(!node.setValue("processingRate", std::make_any<float>(16000.0f)).isError());
+    REQUIRE(std::any_cast<float>(node.getValue("processingRate").value()) == Approx(16000.0f));
+
+    REQUIRE(!node.setValue("processingRate", std::make_any<float>(1000.0f)).isError());
+    REQUIRE(std::any_cast<float>(node.getValue("processingRate").value()) == Approx(8000.0f));
+    REQUIRE(!node.setValue("processingRate", std::make_any<float>(96000.0f)).isError());
+    REQUIRE(std::any_cast<float>(node.getValue("processingRate").value()) == Approx(48000.0f));
+    REQUIRE(!node.setValue("processingRate", std::make_any<float>(-1.0f)).isError());
+    REQUIRE(std::any_cast<float>(node.getValue("processingRate").value()) == Approx(0.0f));
+}
+
+TEST_CASE("PitchShiftNode - setValue/getValue for denoise", "[PitchShiftNode][baseline]") {
+    SBAnyMap config;
+    PitchShiftNode node(config);
+
+    // Off by default
+    REQUIRE(std::any_cast<float>(node.getValue("denoise").value()) == Approx(0.0f));
+
+    REQUIRE(!node.setValue("denoise", std::make_any<float>(0.5f)).isError());
+    REQUIRE(std::any_cast<float>(node.getValue("denoise").value()) == Approx(0.5f));
+
+    REQUIRE(!node.setValue("denoise", std::make_any<float>(2.0f)).isError());
+    REQUIRE(std::any_cast<float>(node.getValue("denoise").value()) == Approx(1.0f));
+    REQUIRE(!node.setValue("denoise", std::make_any<float>(-1.0f)).isError());
+    REQUIRE(std::any_cast<float>(node.getValue("denoise").value()) == Approx(0.0f));
+}
+
+TEST_CASE("PitchShiftNode - processingRate adds the resampler latency", "[PitchShiftNode][baseline]") {
+    switchboard::AudioBusFormat inputFormat(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    switchboard::AudioBusFormat outputFormat(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+
+    SBAnyMap fullConfig;
+    PitchShiftNode full(fullConfig);
+    REQUIRE(full.setBusFormat(inputFormat, outputFormat));
+
+    SBAnyMap reducedConfig = {{"processingRate", 16000.0f}};
+    PitchShiftNode reduced(reducedConfig);
+    REQUIRE(reduced.setBusFormat(inputFormat, outputFormat));
+
+    float fullLatency = std::any_cast<float>(full.getValue("latency").value());
+    float reducedLatency = std::any_cast<float>(reduced.getValue("latency").value());
+    INFO("Latency: graph rate " << fullLatency << " ms, 16 kHz " << reducedLatency << " ms");
+    REQUIRE(reducedLatency > 0.0f);
+    // The stretcher's window is sized in time, so the resamplers add only a few ms
+    REQUIRE(reducedLatency < fullLatency + 10.0f);
+}
+
+TEST_CASE("PolyphaseResampler - Down and back up reproduces a tone after the filter delay", "[PitchShiftNode]") {
+    constexpr float TONE_HZ = 1000.0f;
+
+    for (uint lowRate : {16000u, 22050u}) {
+        dsp::PolyphaseResampler down;
+        dsp::PolyphaseResampler up;
+        REQUIRE(down.prepare(SAMPLE_RATE, lowRate, 256));
+        REQUIRE(up.prepare(lowRate, SAMPLE_RATE, down.getMaxOutput(256)));
+
+        std::vector<float> low(down.getMaxOutput(256));
+        std::vector<float> high(up.getMaxOutput(low.size()));
+        std::vector<float> output;
+        for (size_t offset = 0; offset < 4 * SAMPLE_RATE / 10; offset += 256) {
+            float input[256];
+            for (size_t i = 0; i < 256; ++i) {
+                input[i] = 0.5f * static_cast<float>(std::sin(2.0 * M_PI * TONE_HZ * static_cast<double>(offset + i) / SAMPLE_RATE));
+            }
+            size_t numLow = down.process(input, 256, low.data());
+            size_t numHigh = up.process(low.data(), numLow, high.data());
+            output.insert(output.end(), high.begin(), high.begin() + static_cast<std::ptrdiff_t>(numHigh));
+        }
+
+        // Output count tracks input count to within a sample or two
+        REQUIRE(output.size() + 4 >= 4 * SAMPLE_RATE / 10 / 256 * 256);
+
+        // Compare against the ideal tone delayed by both filters (fractional samples)
+        double delay = down.getLatency() + up.getLatency() * SAMPLE_RATE / lowRate;
+        float maxError = 0.0f;
+        for (size_t i = SAMPLE_RATE / 20; i < output.size(); ++i) {
+            float expected = 0.5f * static_cast<float>(std::sin(2.0 * M_PI * TONE_HZ * (static_cast<double>(i) - delay) / SAMPLE_RATE));
+            maxError = std::max(maxError, std::abs(output[i] - expected));
+        }
+        INFO(lowRate << " Hz round trip: delay " << delay << " samples, max error " << maxError);
+        REQUIRE(maxError < 5.0e-3f);
+    }
+}
+
 TEST_CASE("PitchShiftNode - Config-based initialization", "[PitchShiftNode]") {
     SBAnyMap config = {
         {"pitchShift", -8.0f},
@@ -416,3 +553,267 @@ TEST_CASE("PitchShiftNode - Negative semitones shift frequency DOWN (villain)",
     REQUIRE(estimatedFreq > EXPECTED_OUTPUT_FREQ * 0.8f);
     REQUIRE(estimatedFreq < EXPECTED_OUTPUT_FREQ * 1.2f);
 }
+
+/**
+ * Median voiced f0 of a mono signal, measured with PitchDetectNode.
+ */
+static float measureMedianF0(const std::vector<float>& mono) {
+    SBAnyMap config;
+    PitchDetectNode detector(config);
+    switchboard::AudioBusFormat format(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    REQUIRE(detector.setBusFormat(format, format));
+
+    std::vector<float> voiced;
+    for (size_t offset = 0; offset + BUFFER_SIZE <= mono.size(); offset += BUFFER_SIZE) {
+        TestAudioBus inBus(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+        TestAudioBus outBus(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+        for (uint frame = 0; frame < BUFFER_SIZE; ++frame) {
+            inBus.setSample(0, frame, mono[offset + frame]);
+            inBus.setSample(1, frame, mono[offset + frame]);
+        }
+        detector.process(inBus.bus, outBus.bus);
+
+        float f0 = std::any_cast<float>(detector.getValue("f0").value());
+        if (f0 > 0.0f) {
+            voiced.push_back(f0);
+        }
+    }
+
+    if (voiced.empty()) {
+        return 0.0f;
+    }
+    std::nth_element(voiced.begin(), voiced.begin() + voiced.size() / 2, voiced.end());
+    return voiced[voiced.size() / 2];
+}
+
+TEST_CASE("PitchShiftNode - targetMedianHz moves a steady tone onto the target", "[PitchShiftNode][target]") {
+    // The fixed pitchShift applies only until the median is known
+    SBAnyMap config = {
+        {"pitchShift", -8.0f},
+        {"targetMedianHz", 220.0f}
+    };
+    PitchShiftNode node(config);
+
+    switchboard::AudioBusFormat inputFormat(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    switchboard::AudioBusFormat outputFormat(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    REQUIRE(node.setBusFormat(inputFormat, outputFormat));
+
+    // 2 s of 110 Hz
+    std::vector<float> tone(2 * SAMPLE_RATE);
+    for (size_t i = 0; i < tone.size(); ++i) {
+        tone[i] = 0.5f * std::sin(2.0f * static_cast<float>(M_PI) * 110.0f * i / SAMPLE_RATE);
+    }
+    auto output = processMono(node, tone);
+
+    float medianF0 = std::any_cast<float>(node.getValue("medianF0").value());
+    float transpose = std::any_cast<float>(node.getValue("transpose").value());
+    INFO("Median f0: " << medianF0 << " Hz, transpose: " << transpose << " semitones");
+    REQUIRE(medianF0 == Approx(110.0f).epsilon(0.01));
+    REQUIRE(transpose == Approx(12.0f).margin(0.1));
+
+    // Last second of output sits at the target
+    std::vector<float> settled(output.end() - SAMPLE_RATE, output.end());
+    float outputF0 = measureMedianF0(settled);
+    INFO("Output f0: " << outputF0 << " Hz (expected ~220 Hz)");
+    REQUIRE(outputF0 == Approx(220.0f).epsilon(0.03));
+}
+
+TEST_CASE("PitchShiftNode - targetMedianHz brings different speakers to one register", "[PitchShiftNode][target][harvard]") {
+    constexpr float TARGET_HZ = 160.0f;
+
+    for (const char* filename : {"harvard_male_01.wav", "harvard_female_01.wav"}) {
+        std::vector<float> samples;
+        uint32_t sampleRate = 0;
+        uint16_t channels = 0;
+        REQUIRE(loadWavFile(std::string(TEST_ASSETS_DIR) + "/" + filename, samples, sampleRate, channels));
+        auto speech = resample(samples, sampleRate, SAMPLE_RATE);
+
+        SBAnyMap config = {{"targetMedianHz", TARGET_HZ}};
+        PitchShiftNode node(config);
+        switchboard::AudioBusFormat inputFormat(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+        switchboard::AudioBusFormat outputFormat(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+        REQUIRE(node.setBusFormat(inputFormat, outputFormat));
+
+        auto output = processMono(node, speech);
+
+        float inputF0 = measureMedianF0(speech);
+        float trackedF0 = std::any_cast<float>(node.getValue("medianF0").value());
+        // Skip the first second while the median locks on
+        std::vector<float> settled(output.begin() + std::min<size_t>(SAMPLE_RATE, output.size() / 2), output.end());
+        float outputF0 = measureMedianF0(settled);
+
+        INFO(filename << ": input median " << inputF0 << " Hz, tracked " << trackedF0
+             << " Hz, output median " << outputF0 << " Hz");
+        // Running estimate agrees with the batch median within two semitones
+        REQUIRE(std::abs(12.0f * std::log2(trackedF0 / inputF0)) < 2.0f);
+        // Output register lands within two semitones of the target
+        REQUIRE(std::abs(12.0f * std::log2(outputF0 / TARGET_HZ)) < 2.0f);
+    }
+}
+
+/**
+ * Long-term average power in third-octave bands from 100 Hz to maxHz (dB).
+ */
+static std::vector<float> bandSpectrumDb(const std::vector<float>& mono, float maxHz) {
+    constexpr size_t FFT_SIZE = 2048;
+    dsp::Fft fft;
+    fft.setSize(FFT_SIZE);
+    std::vector<dsp::Fft::Complex> frame(FFT_SIZE);
+    std::vector<double> power(FFT_SIZE / 2, 0.0);
+    for (size_t offset = 0; offset + FFT_SIZE <= mono.size(); offset += FFT_SIZE / 2) {
+        for (size_t i = 0; i < FFT_SIZE; ++i) {
+            float window = 0.5f - 0.5f * static_cast<float>(std::cos(2.0 * M_PI * static_cast<double>(i) / FFT_SIZE));
+            frame[i] = mono[offset + i] * window;
+        }
+        fft.forward(frame.data());
+        for (size_t bin = 0; bin < FFT_SIZE / 2; ++bin) {
+            power[bin] += std::norm(frame[bin]);
+        }
+    }
+
+    std::vector<float> bands;
+    const float binHz = static_cast<float>(SAMPLE_RATE) / FFT_SIZE;
+    for (float low = 100.0f; low * std::pow(2.0f, 1.0f / 3.0f) <= maxHz; low *= std::pow(2.0f, 1.0f / 3.0f)) {
+        float high = low * std::pow(2.0f, 1.0f / 3.0f);
+        double sum = 1.0e-12;
+        for (size_t bin = static_cast<size_t>(low / binHz); bin < static_cast<size_t>(high / binHz); ++bin) {
+            sum += power[bin];
+        }
+        bands.push_back(10.0f * static_cast<float>(std::log10(sum)));
+    }
+    return bands;
+}
+
+TEST_CASE("PitchShiftNode - processingRate keeps the voice band spectrum", "[PitchShiftNode][harvard]") {
+    // Shifted content up to this frequency is inside the 16 kHz passband
+    constexpr float MAX_HZ = 5000.0f;
+
+    for (const char* filename : {"harvard_male_01.wav", "harvard_female_01.wav"}) {
+        std::vector<float> samples;
+        uint32_t sampleRate = 0;
+        uint16_t channels = 0;
+        REQUIRE(loadWavFile(std::string(TEST_ASSETS_DIR) + "/" + filename, samples, sampleRate, channels));
+        auto speech = resample(samples, sampleRate, SAMPLE_RATE);
+
+        std::vector<float> reference;
+        for (float processingRate : {0.0f, 22050.0f, 16000.0f}) {
+            SBAnyMap config = {{"pitchShift", 3.0f}, {"processingRate", processingRate}};
+            PitchShiftNode node(config);
+            switchboard::AudioBusFormat inputFormat(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+            switchboard::AudioBusFormat outputFormat(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+            REQUIRE(node.setBusFormat(inputFormat, outputFormat));
+
+            auto bands = bandSpectrumDb(processMono(node, speech), MAX_HZ);
+            if (processingRate == 0.0f) {
+                reference = bands;
+                continue;
+            }
+
+            float worst = 0.0f;
+            for (size_t band = 0; band < bands.size(); ++band) {
+                worst = std::max(worst, std::abs(bands[band] - reference[band]));
+            }
+            INFO(filename << " at " << processingRate << " Hz: worst band deviation " << worst << " dB");
+            REQUIRE(worst < 3.0f);
+        }
+    }
+}
+
+static float windowRmsDb(const std::vector<float>& samples, float startSeconds, float endSeconds) {
+    size_t start = static_cast<size_t>(startSeconds * SAMPLE_RATE);
+    size_t end = std::min(samples.size(), static_cast<size_t>(endSeconds * SAMPLE_RATE));
+    double sum = 0.0;
+    for (size_t i = start; i < end; ++i) {
+        sum += static_cast<double>(samples[i]) * samples[i];
+    }
+    return 10.0f * static_cast<float>(std::log10(sum / static_cast<double>(end - start) + 1.0e-20));
+}
+
+TEST_CASE("PitchShiftNode - denoise suppresses steady noise between notes", "[PitchShiftNode][denoise]") {
+    // 3 s of -45 dBFS hiss with 220 Hz notes at 1.0-1.5 s and 2.0-2.5 s
+    dsp::XorShift32 random(7);
+    std::vector<float> input(3 * SAMPLE_RATE);
+    for (size_t i = 0; i < input.size(); ++i) {
+        float seconds = static_cast<float>(i) / SAMPLE_RATE;
+        bool note = (seconds >= 1.0f && seconds < 1.5f) || (seconds >= 2.0f && seconds < 2.5f);
+        float tone = note ? 0.3f * std::sin(2.0f * static_cast<float>(M_PI) * 220.0f * seconds) : 0.0f;
+        input[i] = tone + 0.01f * random.nextBipolar();
+    }
+
+    float latencyOff = 0.0f;
+    float latencyOn = 0.0f;
+    std::vector<float> outputs[2];
+    for (int denoise = 0; denoise < 2; ++denoise) {
+        SBAnyMap config = {{"denoise", static_cast<float>(denoise)}};
+        PitchShiftNode node(config);
+        switchboard::AudioBusFormat inputFormat(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+        switchboard::AudioBusFormat outputFormat(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+        REQUIRE(node.setBusFormat(inputFormat, outputFormat));
+        outputs[denoise] = processMono(node, input);
+        (denoise ? latencyOn : latencyOff) = std::any_cast<float>(node.getValue("latency").value());
+    }
+
+    // Windows well inside each segment, clear of the node's latency
+    float noiseOff = windowRmsDb(outputs[0], 2.65f, 2.95f);
+    float noiseOn = windowRmsDb(outputs[1], 2.65f, 2.95f);
+    float toneOff = windowRmsDb(outputs[0], 2.15f, 2.45f);
+    float toneOn = windowRmsDb(outputs[1], 2.15f, 2.45f);
+    INFO("Noise: " << noiseOff << " dB -> " << noiseOn << " dB; tone: " << toneOff << " dB -> " << toneOn << " dB");
+    REQUIRE(noiseOn < noiseOff - 15.0f);
+    REQUIRE(std::abs(toneOn - toneOff) < 1.5f);
+
+    // The gate's latency is reported while it runs
+    REQUIRE(latencyOn > latencyOff);
+}
+
+TEST_CASE("PitchShiftNode - idleFreeze freezes during silence and resumes without a click", "[PitchShiftNode][idle]") {
+    // 0.5 s of a 220 Hz tone, 1.5 s of silence, 0.5 s of tone
+    std::vector<float> input(5 * SAMPLE_RATE / 2, 0.0f);
+    for (size_t i = 0; i < input.size(); ++i) {
+        float seconds = static_cast<float>(i) / SAMPLE_RATE;
+        if (seconds < 0.5f || seconds >= 2.0f) {
+            input[i] = 0.5f * std::sin(2.0f * static_cast<float>(M_PI) * 220.0f * seconds);
+        }
+    }
+
+    std::vector<float> outputs[2];
+    std::vector<bool> active;
+    for (int freeze = 0; freeze < 2; ++freeze) {
+        SBAnyMap config = {{"idleFreeze", static_cast<float>(freeze)}};
+        PitchShiftNode node(config);
+        switchboard::AudioBusFormat inputFormat(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+        switchboard::AudioBusFormat outputFormat(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+        REQUIRE(node.setBusFormat(inputFormat, outputFormat));
+
+        for (size_t offset = 0; offset + BUFFER_SIZE <= input.size(); offset += BUFFER_SIZE) {
+            std::vector<float> block(input.begin() + static_cast<std::ptrdiff_t>(offset),
+                                     input.begin() + static_cast<std::ptrdiff_t>(offset + BUFFER_SIZE));
+            auto processed = processMono(node, block);
+            outputs[freeze].insert(outputs[freeze].end(), processed.begin(), processed.end());
+            if (freeze) {
+                active.push_back(std::any_cast<float>(node.getValue("active").value()) > 0.5f);
+            }
+        }
+    }
+
+    // Frozen for the end of the silence, running again from the first tone block
+    size_t blockAtSilenceEnd = static_cast<size_t>(1.9f * SAMPLE_RATE) / BUFFER_SIZE;
+    size_t firstToneBlock = (2 * SAMPLE_RATE + BUFFER_SIZE - 1) / BUFFER_SIZE;
+    REQUIRE(!active[blockAtSilenceEnd]);
+    REQUIRE(active[firstToneBlock]);
+    for (size_t i = blockAtSilenceEnd * BUFFER_SIZE; i < (blockAtSilenceEnd + 1) * BUFFER_SIZE; ++i) {
+        REQUIRE(outputs[1][i] == 0.0f);
+    }
+
+    // No edge steeper than the tone itself, and the resumed tone at full level
+    auto maxStep = [](const std::vector<float>& samples) {
+        float step = 0.0f;
+        for (size_t i = 1; i < samples.size(); ++i) {
+            step = std::max(step, std::abs(samples[i] - samples[i - 1]));
+        }
+        return step;
+    };
+    INFO("Max step: plain " << maxStep(outputs[0]) << ", idleFreeze " << maxStep(outputs[1]));
+    REQUIRE(maxStep(outputs[1]) <= maxStep(outputs[0]) * 1.5f + 1.0e-3f);
+    REQUIRE(windowRmsDb(outputs[1], 2.2f, 2.45f) == Approx(windowRmsDb(outputs[0], 2.2f, 2.45f)).margin(1.0));
+}
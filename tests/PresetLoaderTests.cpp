@@ -0,0 +1,644 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include "TestHelpers.hpp"
+#include "presets/Json.hpp"
+#include "presets/PresetBank.hpp"
+#include "presets/PresetLibrary.hpp"
+#include "presets/PresetLoader.hpp"
+#include "presets/PresetValidator.hpp"
+#include "presets/PresetWatcher.hpp"
+#include "presets/VoicePresets.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Shipped preset directory (passed via CMake compile definition)
+#ifndef PRESETS_DIR
+#define PRESETS_DIR "src/presets/json"
+#endif
+
+using namespace voicechanger;
+using namespace voicechanger::test;
+using Catch::Approx;
+
+// Global Switchboard initialization
+static SwitchboardInitializer switchboardInit;
+
+static const std::vector<std::string> kPresetFiles = {
+    "01_deep_villain.json", "02_chipmunk.json", "03_robot.json", "04_alien.json", "05_monster.json",
+    "06_radio.json",        "07_demon.json",    "08_ghost.json", "09_giant.json", "10_cyborg.json"};
+
+/**
+ * A preset document around the given node and connection lists.
+ */
+static std::string makePresetJson(const std::string& nodes, const std::string& connections) {
+    return R"({"name": "Test", "description": "A test preset", "graph": {"nodes": [)" + nodes +
+           R"(], "connections": [)" + connections + "]}}";
+}
+
+// Ring modulation then a delay, with the nodes listed out of order
+static const std::string kNodes =
+    R"({"id": "delay", "type": "VoiceChanger.Delay", "config": {"delayMs": 120.0, "wetMix": 0.3}},
+       {"id": "ringMod", "type": "VoiceChanger.RingMod", "config": {"carrierFrequency": 65, "mix": 0.5}})";
+static const std::string kConnections =
+    R"({"sourceNode": "inputNode", "destinationNode": "ringMod"},
+       {"sourceNode": "ringMod", "destinationNode": "delay"},
+       {"sourceNode": "delay", "destinationNode": "outputNode"})";
+
+static std::string parseError(const std::string& json) {
+    PresetDefinition preset;
+    std::string error;
+    REQUIRE_FALSE(parsePreset(json, preset, error));
+    INFO(error);
+    REQUIRE(!error.empty());
+    return error;
+}
+
+TEST_CASE("Json - Parses values, escapes and nesting", "[PresetLoader][baseline]") {
+    JsonValue value;
+    std::string error;
+    REQUIRE(JsonValue::parse(R"( {"a": [1, -2.5e1, true, false, null], "b": {"c": "x\"y\\u00e9\n"}} )", value, error));
+    REQUIRE(value.isObject());
+    REQUIRE(value.getKeys() == std::vector<std::string>{"a", "b"});
+
+    const auto& a = value.find("a")->getItems();
+    REQUIRE(a.size() == 5);
+    REQUIRE(a[0].asNumber() == 1.0);
+    REQUIRE(a[1].asNumber() == -25.0);
+    REQUIRE(a[2].asBool());
+    REQUIRE_FALSE(a[3].asBool());
+    REQUIRE(a[4].isNull());
+    REQUIRE(value.find("b")->find("c")->asString() == "x\"y\\u00e9\n");
+    REQUIRE(value.find("missing") == nullptr);
+
+    REQUIRE(JsonValue::parse(R"("caf\u00e9 \ud83c\udfa4")", value, error));
+    REQUIRE(value.asString() == "caf\xc3\xa9 \xf0\x9f\x8e\xa4");
+}
+
+TEST_CASE("Json - Reports where a document is malformed", "[PresetLoader][baseline]") {
+    JsonValue value;
+    std::string error;
+
+    REQUIRE_FALSE(JsonValue::parse("{\n  \"a\": 1,\n  \"b\" 2\n}", value, error));
+    REQUIRE(error.find("line 3") == 0);
+
+    for (const char* bad : {"", "{", "[1,]", "{\"a\":1,}", "01", "1.", "\"open", "tru", "{\"a\":1}x",
+                            "{\"a\":1,\"a\":2}", "\"\\ud800\""}) {
+        INFO(bad);
+        REQUIRE_FALSE(JsonValue::parse(bad, value, error));
+    }
+
+    // Nesting is bounded
+    REQUIRE_FALSE(JsonValue::parse(std::string(1000, '[') + std::string(1000, ']'), value, error));
+}
+
+TEST_CASE("Json - Reads leading members without the rest of the document", "[PresetLoader][baseline]") {
+    const std::vector<std::string> keys = {"name", "tags"};
+    JsonValue header;
+    // Truncated mid-graph, as when only the start of a file is read
+    REQUIRE(JsonValue::parseLeadingMembers(R"({"name": "A", "tags": ["x", "y"], "graph": {"nodes": [{"id)", keys,
+                                           header));
+    REQUIRE(header.getKeys() == std::vector<std::string>{"name", "tags"});
+    REQUIRE(header.find("tags")->getItems().size() == 2);
+
+    // Stops at the first member not asked for, and at a value cut short
+    REQUIRE(JsonValue::parseLeadingMembers(R"({"graph": {}, "name": "A"})", keys, header));
+    REQUIRE(header.getKeys().empty());
+    REQUIRE(JsonValue::parseLeadingMembers(R"({"name": "A", "tags": ["x", "y)", keys, header));
+    REQUIRE(header.getKeys() == std::vector<std::string>{"name"});
+
+    REQUIRE_FALSE(JsonValue::parseLeadingMembers("[1, 2]", keys, header));
+}
+
+TEST_CASE("PresetLoader - Builds the chain in connection order", "[PresetLoader][baseline]") {
+    PresetDefinition preset;
+    std::string error;
+    REQUIRE(parsePreset(makePresetJson(kNodes, kConnections), preset, error));
+
+    REQUIRE(preset.name == "Test");
+    REQUIRE(preset.description == "A test preset");
+    REQUIRE(preset.nodes.size() == 2);
+    REQUIRE(preset.connections.size() == 3);
+
+    REQUIRE(preset.chain.name == "Test");
+    REQUIRE(preset.chain.stages.size() == 2);
+    REQUIRE(preset.chain.stages[0].id == "ringMod");
+    REQUIRE(preset.chain.stages[0].type == "VoiceChanger.RingMod");
+    REQUIRE(preset.chain.stages[0].getParam("carrierFrequency", 0.0f) == Approx(65.0f));
+    REQUIRE(preset.chain.stages[1].id == "delay");
+    REQUIRE(preset.chain.stages[1].getParam("wetMix", 0.0f) == Approx(0.3f));
+}
+
+TEST_CASE("PresetLoader - Rejects invalid presets", "[PresetLoader][baseline]") {
+    // Not JSON
+    REQUIRE(parseError("{\"name\": ").find("line 1") != std::string::npos);
+
+    // Missing name
+    REQUIRE(parseError(R"({"graph": {"nodes": [], "connections": []}})").find("name") != std::string::npos);
+
+    // Unknown node type
+    REQUIRE(parseError(makePresetJson(R"({"id": "verb", "type": "VoiceChanger.Reverb"})",
+                                      R"({"sourceNode": "inputNode", "destinationNode": "verb"},
+                                         {"sourceNode": "verb", "destinationNode": "outputNode"})"))
+                .find("VoiceChanger.Reverb") != std::string::npos);
+
+    // Unknown parameter
+    REQUIRE(parseError(makePresetJson(R"({"id": "ringMod", "type": "VoiceChanger.RingMod", "config": {"roomSize": 1}})",
+                                      R"({"sourceNode": "inputNode", "destinationNode": "ringMod"},
+                                         {"sourceNode": "ringMod", "destinationNode": "outputNode"})"))
+                .find("roomSize") != std::string::npos);
+
+    // Parameter of the wrong type
+    REQUIRE(parseError(makePresetJson(R"({"id": "ringMod", "type": "VoiceChanger.RingMod", "config": {"mix": "half"}})",
+                                      R"({"sourceNode": "inputNode", "destinationNode": "ringMod"},
+                                         {"sourceNode": "ringMod", "destinationNode": "outputNode"})"))
+                .find("mix") != std::string::npos);
+
+    // Duplicate id
+    REQUIRE(parseError(makePresetJson(kNodes + R"(, {"id": "delay", "type": "VoiceChanger.Delay"})", kConnections))
+                .find("duplicate") != std::string::npos);
+
+    // Chain that never reaches the output
+    REQUIRE(parseError(makePresetJson(kNodes, R"({"sourceNode": "inputNode", "destinationNode": "ringMod"},
+                                                 {"sourceNode": "ringMod", "destinationNode": "delay"})"))
+                .find("outputNode") != std::string::npos);
+
+    // Node left off the path
+    REQUIRE(parseError(makePresetJson(kNodes, R"({"sourceNode": "inputNode", "destinationNode": "ringMod"},
+                                                 {"sourceNode": "ringMod", "destinationNode": "outputNode"})"))
+                .find("delay") != std::string::npos);
+
+    // Loop
+    REQUIRE(parseError(makePresetJson(kNodes, R"({"sourceNode": "inputNode", "destinationNode": "ringMod"},
+                                                 {"sourceNode": "ringMod", "destinationNode": "delay"},
+                                                 {"sourceNode": "delay", "destinationNode": "ringMod"})"))
+                .find("loops") != std::string::npos);
+}
+
+TEST_CASE("PresetValidator - Clamps out-of-range values and reports them", "[PresetLoader][baseline]") {
+    PresetDefinition preset;
+    std::string error;
+    REQUIRE(parsePreset(makePresetJson(
+                            R"({"id": "ringMod", "type": "VoiceChanger.RingMod", "config": {"mix": 1.5, "carrierFrequency": 65}})",
+                            R"({"sourceNode": "inputNode", "destinationNode": "ringMod"},
+                               {"sourceNode": "ringMod", "destinationNode": "outputNode"})"),
+                        preset, error));
+    INFO(error);
+    REQUIRE(preset.chain.validated);
+    REQUIRE(preset.chain.stages[0].getParam("mix", 0.0f) == 1.0f);
+    REQUIRE(preset.chain.stages[0].params[0].id == RingModNode::kMix);
+    REQUIRE(preset.warnings.size() == 1);
+    REQUIRE(preset.warnings[0].find("graph.nodes[0] (ringMod)") != std::string::npos);
+    REQUIRE(preset.warnings[0].find("\"mix\" 1.5 is outside 0 to 1") != std::string::npos);
+
+    // Too large for a float is still just out of range
+    REQUIRE(parsePreset(makePresetJson(
+                            R"({"id": "ringMod", "type": "VoiceChanger.RingMod", "config": {"carrierFrequency": 1e300}})",
+                            R"({"sourceNode": "inputNode", "destinationNode": "ringMod"},
+                               {"sourceNode": "ringMod", "destinationNode": "outputNode"})"),
+                        preset, error));
+    REQUIRE(preset.chain.stages[0].getParam("carrierFrequency", 0.0f) ==
+            RingModNode::kParameters[RingModNode::kCarrierFrequency].maxValue);
+    REQUIRE(preset.warnings.size() == 1);
+
+    // The shipped presets are all in range
+    for (const auto& file : kPresetFiles) {
+        REQUIRE(loadPresetFile(std::string(PRESETS_DIR) + "/" + file, preset, error));
+        REQUIRE(preset.warnings.empty());
+    }
+}
+
+TEST_CASE("PresetValidator - Rejects ids, types and values a chain cannot take", "[PresetLoader][baseline]") {
+    auto single = [](const std::string& node, const std::string& id) {
+        return makePresetJson(node, R"({"sourceNode": "inputNode", "destinationNode": ")" + id +
+                                        R"("}, {"sourceNode": ")" + id + R"(", "destinationNode": "outputNode"})");
+    };
+
+    // The diagnostics say what would have been accepted
+    std::string error = parseError(single(R"({"id": "verb", "type": "VoiceChanger.Reverb"})", "verb"));
+    REQUIRE(error.find("graph.nodes[0] (verb)") != std::string::npos);
+    REQUIRE(error.find("VoiceChanger.RingMod") != std::string::npos);
+    error = parseError(single(R"({"id": "ringMod", "type": "VoiceChanger.RingMod", "config": {"mixx": 1}})", "ringMod"));
+    REQUIRE(error.find("carrierFrequency, mix, threshold") != std::string::npos);
+
+    REQUIRE(parseError(single(R"({"id": "ring.mod", "type": "VoiceChanger.RingMod"})", "ring.mod")).find("'.'") !=
+            std::string::npos);
+    REQUIRE(parseError(single(R"({"id": "pitch", "type": "VoiceChanger.PitchShift", "config": {"latency": 1}})",
+                              "pitch"))
+                .find("read-only") != std::string::npos);
+
+    // Chains from other sources go through the same checks
+    ChainSpec chain;
+    chain.stages.push_back({"ringMod", "VoiceChanger.RingMod", {{"mix", 0.5f}}});
+    std::vector<std::string> warnings;
+    REQUIRE(validateChain(chain, warnings, error));
+    REQUIRE(chain.validated);
+    REQUIRE(chain.stages[0].params[0].id == RingModNode::kMix);
+
+    chain.stages[0].params[0].value = std::nanf("");
+    REQUIRE_FALSE(validateChain(chain, warnings, error));
+    REQUIRE(error.find("finite") != std::string::npos);
+    REQUIRE_FALSE(chain.validated);
+
+    chain.stages[0].params[0] = {"mix", 0.5f, RingModNode::kCarrierFrequency};  // Id from other tables
+    REQUIRE_FALSE(validateChain(chain, warnings, error));
+    REQUIRE(error.find("stages[0] (ringMod)") != std::string::npos);
+
+    chain.stages[0].params[0].id = ParameterizedNode::kUnknownParameter;
+    chain.stages.push_back(chain.stages[0]);
+    REQUIRE_FALSE(validateChain(chain, warnings, error));
+    REQUIRE(error.find("duplicate") != std::string::npos);
+}
+
+/**
+ * The test preset with a "modulators" array.
+ */
+static std::string makeModulatedJson(const std::string& modulators) {
+    std::string json = makePresetJson(kNodes, kConnections);
+    json.pop_back();
+    return json + R"(, "modulators": [)" + modulators + "]}";
+}
+
+TEST_CASE("PresetLoader - Parses modulators into the chain", "[PresetLoader][baseline]") {
+    PresetDefinition preset;
+    std::string error;
+    REQUIRE(parsePreset(makeModulatedJson(
+                            R"({"source": "sine", "target": "ringMod.carrierFrequency", "depth": 20, "rate": 0.5},
+                               {"source": "envelope", "target": "ringMod.mix", "depth": 0.3, "releaseMs": 80})"),
+                        preset, error));
+    INFO(error);
+    REQUIRE(preset.chain.modulations.size() == 2);
+
+    const auto& lfo = preset.chain.modulations[0];
+    REQUIRE(lfo.source == dsp::ModulatorType::kSine);
+    REQUIRE(lfo.stageId == "ringMod");
+    REQUIRE(lfo.key == "carrierFrequency");
+    REQUIRE(lfo.depth == Approx(20.0f));
+    REQUIRE(lfo.rateHz == Approx(0.5f));
+
+    const auto& envelope = preset.chain.modulations[1];
+    REQUIRE(envelope.source == dsp::ModulatorType::kEnvelope);
+    REQUIRE(envelope.releaseMs == Approx(80.0f));
+    REQUIRE(envelope.attackMs == Approx(ModulationSpec().attackMs));
+
+    // Bad sources and targets are rejected
+    REQUIRE(parseError(makeModulatedJson(R"({"source": "saw", "target": "ringMod.mix", "depth": 1})"))
+                .find("saw") != std::string::npos);
+    REQUIRE(parseError(makeModulatedJson(R"({"source": "sine", "target": "reverb.mix", "depth": 1})"))
+                .find("reverb.mix") != std::string::npos);
+    REQUIRE(parseError(makeModulatedJson(R"({"source": "sine", "target": "delay.wetMix", "depth": 1})"))
+                .find("cannot be modulated") != std::string::npos);
+    REQUIRE(parseError(makeModulatedJson(R"({"source": "sine", "target": "ringMod.mix"})"))
+                .find("depth") != std::string::npos);
+    REQUIRE(parseError(makeModulatedJson(R"({"source": "random", "target": "ringMod.mix", "depth": 1, "rate": 0})"))
+                .find("rate") != std::string::npos);
+}
+
+TEST_CASE("PresetLoader - Shipped presets load and match the built-in tables", "[PresetLoader][baseline]") {
+    const auto& expected = getPresets();
+    REQUIRE(kPresetFiles.size() == expected.size());
+
+    for (size_t i = 0; i < kPresetFiles.size(); ++i) {
+        PresetDefinition preset;
+        std::string error;
+        bool loaded = loadPresetFile(std::string(PRESETS_DIR) + "/" + kPresetFiles[i], preset, error);
+        INFO(kPresetFiles[i] << ": " << error);
+        REQUIRE(loaded);
+
+        REQUIRE(preset.name == expected[i].name);
+        REQUIRE(preset.description == expected[i].description);
+        REQUIRE(preset.category == expected[i].category);
+        REQUIRE(!preset.tags.empty());
+        REQUIRE(preset.tags == std::vector<std::string>(expected[i].tags, expected[i].tags + expected[i].tagCount));
+        REQUIRE(preset.chain.stages.size() == preset.nodes.size());
+
+        // The generated chain is the loader's, down to the resolved ids
+        ChainSpec builtIn = toChainSpec(expected[i]);
+        REQUIRE(builtIn.name == preset.chain.name);
+        REQUIRE(builtIn.stages.size() == preset.chain.stages.size());
+        for (size_t s = 0; s < builtIn.stages.size(); ++s) {
+            const StageSpec& stage = preset.chain.stages[s];
+            REQUIRE(builtIn.stages[s].id == stage.id);
+            REQUIRE(builtIn.stages[s].type == stage.type);
+            REQUIRE(builtIn.stages[s].params.size() == stage.params.size());
+            for (size_t p = 0; p < stage.params.size(); ++p) {
+                REQUIRE(builtIn.stages[s].params[p].key == stage.params[p].key);
+                REQUIRE(builtIn.stages[s].params[p].id == stage.params[p].id);
+                REQUIRE(builtIn.stages[s].params[p].value == stage.params[p].value);
+            }
+        }
+        REQUIRE(builtIn.modulations.size() == preset.chain.modulations.size());
+        for (size_t m = 0; m < builtIn.modulations.size(); ++m) {
+            const ModulationSpec& modulation = preset.chain.modulations[m];
+            REQUIRE(builtIn.modulations[m].source == modulation.source);
+            REQUIRE(builtIn.modulations[m].stageId == modulation.stageId);
+            REQUIRE(builtIn.modulations[m].key == modulation.key);
+            REQUIRE(builtIn.modulations[m].depth == modulation.depth);
+            REQUIRE(builtIn.modulations[m].rateHz == modulation.rateHz);
+            REQUIRE(builtIn.modulations[m].attackMs == modulation.attackMs);
+            REQUIRE(builtIn.modulations[m].releaseMs == modulation.releaseMs);
+        }
+    }
+}
+
+TEST_CASE("VoicePresets - Built-in presets are checked at compile time", "[PresetLoader][baseline]") {
+    STATIC_REQUIRE(getPresetCount() == 10);
+    STATIC_REQUIRE(builtin::equals(getPreset(2).name, "Robot"));
+    STATIC_REQUIRE(getPreset(-1).name == getPreset(0).name);
+    STATIC_REQUIRE(getPreset(0).findStage("pitchShift")->getParam("pitchShift", 0.0f) == -8.0f);
+    STATIC_REQUIRE(getPreset(0).findStage("nowhere") == nullptr);
+
+    STATIC_REQUIRE(builtin::parameterId<RingModNode>("mix") == static_cast<int>(RingModNode::kMix));
+    STATIC_REQUIRE(builtin::inRange<PitchShiftNode>("pitchShift", 24.0f));
+    STATIC_REQUIRE_FALSE(builtin::inRange<PitchShiftNode>("pitchShift", 24.5f));
+    STATIC_REQUIRE_FALSE(builtin::inRange<PitchShiftNode>("pitchShiftt", 0.0f));
+    STATIC_REQUIRE_FALSE(builtin::isSettable<PitchShiftNode>("latency"));  // Read-only
+    STATIC_REQUIRE(builtin::canModulate<RingModNode>("carrierFrequency"));
+    STATIC_REQUIRE_FALSE(builtin::canModulate<PitchShiftNode>("processingRate"));  // A switch
+    STATIC_REQUIRE_FALSE(builtin::canModulate<DriveNode>("drive"));              // Not ramped per sample
+
+    // The compile-time rule is the chain's
+    SBAnyMap config;
+    RingModNode ringMod(config);
+    for (uint32_t id = 0; id < RingModNode::kNumParams; ++id) {
+        const char* key = ringMod.getParameterDescriptor(id).key;
+        REQUIRE(builtin::canModulate<RingModNode>(key) == ModulationMatrix::canModulate(ringMod, id));
+    }
+    DriveNode drive(config);
+    for (uint32_t id = 0; id < DriveNode::kNumParams; ++id) {
+        const char* key = drive.getParameterDescriptor(id).key;
+        REQUIRE(builtin::canModulate<DriveNode>(key) == ModulationMatrix::canModulate(drive, id));
+    }
+    PitchShiftNode pitchShift(config);
+    for (uint32_t id = 0; id < PitchShiftNode::kNumParams; ++id) {
+        const char* key = pitchShift.getParameterDescriptor(id).key;
+        REQUIRE(builtin::canModulate<PitchShiftNode>(key) == ModulationMatrix::canModulate(pitchShift, id));
+    }
+
+    // The library serves the same presets without any files
+    PresetLibrary library;
+    library.openBuiltIn();
+    REQUIRE(library.size() == getPresets().size());
+    REQUIRE(library.findByCategory("sci-fi") == std::vector<size_t>{2, 3, 9});
+    REQUIRE(library.findByTag("robotic") == std::vector<size_t>{2, 9});
+    std::string error;
+    auto cyborg = library.load(9, error);
+    INFO(error);
+    REQUIRE(cyborg);
+    REQUIRE(cyborg->tags == library.getEntry(9).tags);
+    REQUIRE(cyborg->chain.modulations.size() == 2);
+    REQUIRE(library.getParseCount() == 0);
+}
+
+TEST_CASE("PresetLibrary - Indexes the shipped presets and parses them on demand", "[PresetLoader][baseline]") {
+    PresetLibrary library(2);
+    std::string error;
+    REQUIRE(library.scan(PRESETS_DIR, error));
+    REQUIRE(library.size() == kPresetFiles.size());
+    REQUIRE(library.getParseCount() == 0);
+
+    // The index comes from the file headers alone
+    const auto& expected = getPresets();
+    for (size_t i = 0; i < library.size(); ++i) {
+        REQUIRE(library.getEntry(i).name == expected[i].name);
+        REQUIRE(library.getEntry(i).description == expected[i].description);
+    }
+    REQUIRE(library.findByName("robot") == 2);
+    REQUIRE(library.findByName("Nobody") == -1);
+    REQUIRE(library.findByCategory("sci-fi") == std::vector<size_t>{2, 3, 9});
+    REQUIRE(library.findByTag("robotic") == std::vector<size_t>{2, 9});
+    REQUIRE(library.getCategories().front() == "Character");
+
+    // Parsed once, then served from the cache until evicted
+    auto robot = library.load(2, error);
+    INFO(error);
+    REQUIRE(robot);
+    REQUIRE(robot->name == "Robot");
+    REQUIRE(library.load(2, error) == robot);
+    REQUIRE(library.getParseCount() == 1);
+
+    REQUIRE(library.load(0, error));
+    REQUIRE(library.load(2, error) == robot);  // Now the most recently used
+    REQUIRE(library.load(1, error));           // Evicts preset 0
+    REQUIRE(library.getCachedCount() == 2);
+    REQUIRE(library.load(2, error) == robot);
+    REQUIRE(library.getParseCount() == 3);
+    REQUIRE(library.load(0, error));
+    REQUIRE(library.getParseCount() == 4);
+}
+
+TEST_CASE("PresetLibrary - Falls back to file names and directories", "[PresetLoader][baseline]") {
+    namespace fs = std::filesystem;
+    fs::path root = fs::temp_directory_path() / "voicechanger-library-test";
+    fs::remove_all(root);
+    fs::create_directories(root / "Robots");
+    std::ofstream(root / "Robots" / "07_tin_can.json")
+        << R"({"graph": {"nodes": [], "connections": []}, "name": "Named too late"})";
+    std::ofstream(root / "broken.json") << R"({"name": "Broken", "graph": )";
+    std::ofstream(root / "notes.txt") << "not a preset";
+
+    PresetLibrary library;
+    std::string error;
+    REQUIRE(library.scan(root.string(), error));
+    REQUIRE(library.size() == 2);
+
+    // A broken file is indexed, and only reported when it is loaded
+    REQUIRE(library.getEntry(1).name == "Broken");
+    REQUIRE_FALSE(library.load(1, error));
+    REQUIRE(error.find("broken.json") != std::string::npos);
+
+    REQUIRE(library.getEntry(0).name == "Tin Can");
+    REQUIRE(library.getEntry(0).category == "Robots");
+    REQUIRE(library.getCategories() == std::vector<std::string>{"Robots"});
+
+    REQUIRE_FALSE(library.scan((root / "missing").string(), error));
+    fs::remove_all(root);
+}
+
+TEST_CASE("PresetLibrary - Updates move presets between categories and names", "[PresetLoader][baseline]") {
+    namespace fs = std::filesystem;
+    fs::path root = fs::temp_directory_path() / "voicechanger-library-update-test";
+    fs::remove_all(root);
+    fs::create_directories(root);
+    const std::string graph = R"("graph": {"nodes": [], "connections": []})";
+    std::ofstream(root / "a.json") << R"({"name": "Twin", "category": "Old", )" << graph << "}";
+    std::ofstream(root / "b.json") << R"({"name": "Twin", "category": "Shared", )" << graph << "}";
+
+    PresetLibrary library;
+    std::string error;
+    REQUIRE(library.scan(root.string(), error));
+    REQUIRE(library.getCategories() == std::vector<std::string>{"Old", "Shared"});
+
+    // The only preset in "Old" moves, and the category goes with it
+    auto moved = std::make_shared<PresetDefinition>();
+    moved->name = "Twin";
+    moved->category = "New";
+    REQUIRE(library.update(library.getEntry(0).path, moved) == 0);
+    REQUIRE(library.getCategories() == std::vector<std::string>{"New", "Shared"});
+    REQUIRE(library.findByCategory("Old").empty());
+    REQUIRE(library.findByCategory("new") == std::vector<size_t>{0});
+
+    // Renaming the first of two presets with one name leaves the other findable
+    REQUIRE(library.findByName("twin") == 0);
+    auto renamed = std::make_shared<PresetDefinition>(*moved);
+    renamed->name = "Solo";
+    REQUIRE(library.update(library.getEntry(0).path, renamed) == 0);
+    REQUIRE(library.findByName("Solo") == 0);
+    REQUIRE(library.findByName("Twin") == 1);
+
+    // Without a category, a reloaded or new file falls back to its subdirectory as in a scan
+    auto uncategorized = std::make_shared<PresetDefinition>(*renamed);
+    uncategorized->category.clear();
+    REQUIRE(library.update(library.getEntry(0).path, uncategorized) == 0);
+    REQUIRE(library.getEntry(0).category.empty());
+    REQUIRE(library.getCategories() == std::vector<std::string>{"Shared"});
+    fs::create_directories(root / "Robots");
+    REQUIRE(library.update((root / "Robots" / "c.json").string(), uncategorized) == 2);
+    REQUIRE(library.getEntry(2).category == "Robots");
+    REQUIRE(library.getCategories() == std::vector<std::string>{"Shared", "Robots"});
+
+    fs::remove_all(root);
+}
+
+TEST_CASE("PresetWatcher - Reparses edited presets in the background", "[PresetLoader][baseline]") {
+    namespace fs = std::filesystem;
+    fs::path root = fs::temp_directory_path() / "voicechanger-watcher-test";
+    fs::remove_all(root);
+    fs::create_directories(root);
+    fs::path presetPath = root / "ring.json";
+    std::ofstream(presetPath) << makePresetJson(kNodes, kConnections);
+
+    PresetLibrary library;
+    std::string error;
+    REQUIRE(library.scan(root.string(), error));
+    auto original = library.load(0, error);
+    REQUIRE(original);
+
+    PresetWatcher watcher;
+    REQUIRE(watcher.start(root.string(), error));
+
+    // Waits up to two seconds for the watcher to report count files
+    auto waitForUpdates = [&](size_t count) {
+        std::vector<PresetWatcher::Update> updates;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+        while (updates.size() < count && std::chrono::steady_clock::now() < deadline) {
+            for (auto& update : watcher.takeUpdates()) {
+                updates.push_back(std::move(update));
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return updates;
+    };
+
+    // Two quick saves settle into one update with the final contents
+    std::string edited = makePresetJson(kNodes, kConnections);
+    edited.replace(edited.find("65"), 2, "90");
+    std::ofstream(presetPath) << makePresetJson(kNodes, kConnections);
+    std::ofstream(presetPath) << edited;
+    std::ofstream(root / "notes.txt") << "not a preset";
+    auto updates = waitForUpdates(1);
+    REQUIRE(updates.size() == 1);
+    REQUIRE(updates[0].path == library.getEntry(0).path);
+    REQUIRE(updates[0].preset);
+    REQUIRE(updates[0].preset->chain.stages[0].getParam("carrierFrequency", 0.0f) == Approx(90.0f));
+
+    // The library serves the new version without reading the file again
+    REQUIRE(library.update(updates[0].path, updates[0].preset) == 0);
+    REQUIRE(library.load(0, error) == updates[0].preset);
+    REQUIRE(library.getParseCount() == 1);
+
+    // A broken save is reported, and nothing else changes
+    std::ofstream(presetPath) << R"({"name": "Test", "graph": )";
+    updates = waitForUpdates(1);
+    REQUIRE(updates.size() == 1);
+    REQUIRE_FALSE(updates[0].preset);
+    REQUIRE(updates[0].error.find("ring.json") != std::string::npos);
+
+    // New files are picked up too
+    std::ofstream(root / "new.json") << edited;
+    updates = waitForUpdates(1);
+    REQUIRE(updates.size() == 1);
+    REQUIRE(updates[0].preset);
+    REQUIRE(library.update(updates[0].path, updates[0].preset) == 1);
+    REQUIRE(library.size() == 2);
+
+    watcher.stop();
+    REQUIRE_FALSE(watcher.isRunning());
+    fs::remove_all(root);
+}
+
+TEST_CASE("PresetBank - Shipped presets round-trip through a bank", "[PresetLoader][baseline]") {
+    namespace fs = std::filesystem;
+    PresetLibrary json;
+    std::string error;
+    REQUIRE(json.scan(PRESETS_DIR, error));
+    std::vector<PresetDefinition> presets;
+    for (size_t i = 0; i < json.size(); ++i) {
+        auto preset = json.load(i, error);
+        INFO(error);
+        REQUIRE(preset);
+        presets.push_back(*preset);
+    }
+
+    fs::path path = fs::temp_directory_path() / "voicechanger-test.bank";
+    REQUIRE(PresetBank::write(path.string(), presets, error));
+
+    PresetBank bank;
+    REQUIRE(bank.open(path.string(), error));
+    REQUIRE(bank.size() == presets.size());
+    for (size_t i = 0; i < presets.size(); ++i) {
+        REQUIRE(std::string(bank.getName(i)) == presets[i].name);
+        REQUIRE(std::string(bank.getCategory(i)) == presets[i].category);
+        REQUIRE(bank.getTags(i) == presets[i].tags);
+
+        ChainSpec chain;
+        REQUIRE(bank.getChain(i, chain, error));
+        const ChainSpec& expected = presets[i].chain;
+        REQUIRE(chain.name == expected.name);
+        REQUIRE(chain.stages.size() == expected.stages.size());
+        for (size_t s = 0; s < chain.stages.size(); ++s) {
+            REQUIRE(chain.stages[s].id == expected.stages[s].id);
+            REQUIRE(chain.stages[s].type == expected.stages[s].type);
+            REQUIRE(chain.stages[s].params.size() == expected.stages[s].params.size());
+            for (size_t p = 0; p < chain.stages[s].params.size(); ++p) {
+                // Ids come out resolved, so compiling does no key lookups
+                REQUIRE(chain.stages[s].params[p].id != ParameterizedNode::kUnknownParameter);
+                REQUIRE(chain.stages[s].params[p].id == expected.stages[s].params[p].id);
+                REQUIRE(chain.stages[s].params[p].value == expected.stages[s].params[p].value);
+            }
+        }
+        REQUIRE(chain.modulations.size() == expected.modulations.size());
+        for (size_t m = 0; m < chain.modulations.size(); ++m) {
+            REQUIRE(chain.modulations[m].source == expected.modulations[m].source);
+            REQUIRE(chain.modulations[m].key == expected.modulations[m].key);
+            REQUIRE(chain.modulations[m].depth == expected.modulations[m].depth);
+        }
+    }
+
+    // The library serves a bank like a directory
+    PresetLibrary library;
+    REQUIRE(library.openBank(path.string(), error));
+    REQUIRE(library.findByName("Cyborg") == 9);
+    REQUIRE(library.findByTag("robotic") == std::vector<size_t>{2, 9});
+    auto cyborg = library.load(9, error);
+    REQUIRE(cyborg);
+    REQUIRE(cyborg->tags == presets[9].tags);
+    REQUIRE(cyborg->chain.modulations.size() == presets[9].chain.modulations.size());
+    REQUIRE(library.getParseCount() == 0);
+
+    // Truncated and foreign files are refused
+    bank.close();
+    fs::resize_file(path, fs::file_size(path) - 4);
+    REQUIRE_FALSE(bank.open(path.string(), error));
+    REQUIRE(error.find("corrupt") != std::string::npos);
+    std::ofstream(path, std::ios::trunc) << makePresetJson(kNodes, kConnections);
+    REQUIRE_FALSE(bank.open(path.string(), error));
+    REQUIRE(error.find("not a preset bank") != std::string::npos);
+    fs::remove(path);
+}
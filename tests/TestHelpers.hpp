@@ -1,13 +1,27 @@
 #pragma once
 
+#include <catch2/catch_test_macros.hpp>
+
 #include <switchboard/Switchboard.hpp>
 #include <switchboard_core/AudioBuffer.hpp>
 #include <switchboard_core/AudioBus.hpp>
 #include <switchboard_core/AudioBusFormat.hpp>
+#include <switchboard_core/SingleBusAudioProcessorNode.hpp>
 
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <string>
 #include <vector>
 
+// Test assets directory (passed via CMake compile definition)
+#ifndef TEST_ASSETS_DIR
+#define TEST_ASSETS_DIR "test-assets"
+#endif
+
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
@@ -157,4 +171,227 @@ inline float dbToLinear(float db) {
     return std::pow(10.0f, db / 20.0f);
 }
 
+/**
+ * Simple WAV file header structure.
+ */
+#pragma pack(push, 1)
+struct WavHeader {
+    char riff[4];           // "RIFF"
+    uint32_t fileSize;      // File size - 8
+    char wave[4];           // "WAVE"
+    char fmt[4];            // "fmt "
+    uint32_t fmtSize;       // Format chunk size (16 for PCM)
+    uint16_t audioFormat;   // 1 = PCM
+    uint16_t numChannels;   // Number of channels
+    uint32_t sampleRate;    // Sample rate
+    uint32_t byteRate;      // Bytes per second
+    uint16_t blockAlign;    // Bytes per sample frame
+    uint16_t bitsPerSample; // Bits per sample
+    char data[4];           // "data"
+    uint32_t dataSize;      // Data chunk size
+};
+#pragma pack(pop)
+
+/**
+ * Load a WAV file and return samples as floats (-1.0 to 1.0).
+ * Supports 16-bit PCM mono/stereo.
+ */
+inline bool loadWavFile(const std::string& path,
+                        std::vector<float>& samples,
+                        uint32_t& sampleRate,
+                        uint16_t& numChannels) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+
+    // Read RIFF header (12 bytes)
+    char riff[4], wave[4];
+    uint32_t fileSize;
+    file.read(riff, 4);
+    file.read(reinterpret_cast<char*>(&fileSize), 4);
+    file.read(wave, 4);
+
+    if (std::strncmp(riff, "RIFF", 4) != 0 ||
+        std::strncmp(wave, "WAVE", 4) != 0) {
+        return false;
+    }
+
+    // Read chunks until we find fmt and data
+    uint16_t audioFormat = 0;
+    uint16_t bitsPerSample = 0;
+    sampleRate = 0;
+    numChannels = 0;
+    uint32_t dataSize = 0;
+    bool foundFmt = false;
+    bool foundData = false;
+
+    while (!foundData && file) {
+        char chunkId[4];
+        uint32_t chunkSize;
+        file.read(chunkId, 4);
+        file.read(reinterpret_cast<char*>(&chunkSize), 4);
+
+        if (!file) break;
+
+        if (std::strncmp(chunkId, "fmt ", 4) == 0) {
+            file.read(reinterpret_cast<char*>(&audioFormat), 2);
+            file.read(reinterpret_cast<char*>(&numChannels), 2);
+            file.read(reinterpret_cast<char*>(&sampleRate), 4);
+            uint32_t byteRate;
+            uint16_t blockAlign;
+            file.read(reinterpret_cast<char*>(&byteRate), 4);
+            file.read(reinterpret_cast<char*>(&blockAlign), 2);
+            file.read(reinterpret_cast<char*>(&bitsPerSample), 2);
+            // Skip any extra fmt bytes
+            if (chunkSize > 16) {
+                file.seekg(chunkSize - 16, std::ios::cur);
+            }
+            foundFmt = true;
+        } else if (std::strncmp(chunkId, "data", 4) == 0) {
+            dataSize = chunkSize;
+            foundData = true;
+        } else {
+            // Skip unknown chunk
+            file.seekg(chunkSize, std::ios::cur);
+        }
+    }
+
+    if (!foundFmt || !foundData) {
+        return false;
+    }
+
+    if (bitsPerSample != 16) {
+        return false;  // Only support 16-bit for now
+    }
+
+    uint32_t numSamples = dataSize / (bitsPerSample / 8);
+    std::vector<int16_t> rawSamples(numSamples);
+    file.read(reinterpret_cast<char*>(rawSamples.data()), dataSize);
+
+    samples.resize(numSamples);
+    for (size_t i = 0; i < numSamples; ++i) {
+        samples[i] = static_cast<float>(rawSamples[i]) / 32768.0f;
+    }
+
+    return true;
+}
+
+/**
+ * Save samples to a WAV file.
+ */
+inline bool saveWavFile(const std::string& path,
+                        const std::vector<float>& samples,
+                        uint32_t sampleRate,
+                        uint16_t numChannels) {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+
+    uint32_t dataSize = samples.size() * sizeof(int16_t);
+    uint32_t fileSize = 36 + dataSize;
+
+    WavHeader header;
+    std::memcpy(header.riff, "RIFF", 4);
+    header.fileSize = fileSize;
+    std::memcpy(header.wave, "WAVE", 4);
+    std::memcpy(header.fmt, "fmt ", 4);
+    header.fmtSize = 16;
+    header.audioFormat = 1;  // PCM
+    header.numChannels = numChannels;
+    header.sampleRate = sampleRate;
+    header.byteRate = sampleRate * numChannels * 2;
+    header.blockAlign = numChannels * 2;
+    header.bitsPerSample = 16;
+    std::memcpy(header.data, "data", 4);
+    header.dataSize = dataSize;
+
+    file.write(reinterpret_cast<char*>(&header), sizeof(header));
+
+    std::vector<int16_t> rawSamples(samples.size());
+    for (size_t i = 0; i < samples.size(); ++i) {
+        float sample = std::clamp(samples[i], -1.0f, 1.0f);
+        rawSamples[i] = static_cast<int16_t>(sample * 32767.0f);
+    }
+    file.write(reinterpret_cast<char*>(rawSamples.data()), dataSize);
+
+    return true;
+}
+
+/**
+ * Simple linear resampling from srcRate to dstRate.
+ */
+inline std::vector<float> resample(const std::vector<float>& input,
+                                   uint32_t srcRate,
+                                   uint32_t dstRate) {
+    if (srcRate == dstRate) {
+        return input;
+    }
+
+    double ratio = static_cast<double>(dstRate) / srcRate;
+    size_t outputSize = static_cast<size_t>(input.size() * ratio);
+    std::vector<float> output(outputSize);
+
+    for (size_t i = 0; i < outputSize; ++i) {
+        double srcIndex = i / ratio;
+        size_t idx0 = static_cast<size_t>(srcIndex);
+        size_t idx1 = std::min(idx0 + 1, input.size() - 1);
+        double frac = srcIndex - idx0;
+
+        output[i] = static_cast<float>(input[idx0] * (1.0 - frac) + input[idx1] * frac);
+    }
+
+    return output;
+}
+
+/**
+ * Set a node's input and output format to numChannels x blockSize frames.
+ */
+inline void prepareNode(SingleBusAudioProcessorNode& node, uint blockSize = 512, uint sampleRate = 44100,
+                        uint numChannels = 2) {
+    AudioBusFormat inputFormat(sampleRate, numChannels, blockSize);
+    AudioBusFormat outputFormat(sampleRate, numChannels, blockSize);
+    REQUIRE(node.setBusFormat(inputFormat, outputFormat));
+}
+
+/**
+ * Run a mono signal through a prepared node in blocks of blockSize, copied
+ * to every channel, and return channel 0. A trailing partial block is dropped.
+ */
+inline std::vector<float> processMono(SingleBusAudioProcessorNode& node, const std::vector<float>& mono,
+                                      uint blockSize = 512, uint sampleRate = 44100, uint numChannels = 2) {
+    std::vector<float> output;
+    output.reserve(mono.size());
+    for (size_t offset = 0; offset + blockSize <= mono.size(); offset += blockSize) {
+        TestAudioBus inBus(sampleRate, numChannels, blockSize);
+        TestAudioBus outBus(sampleRate, numChannels, blockSize);
+
+        for (uint frame = 0; frame < blockSize; ++frame) {
+            for (uint ch = 0; ch < numChannels; ++ch) {
+                inBus.setSample(ch, frame, mono[offset + frame]);
+            }
+        }
+
+        REQUIRE(node.process(inBus.bus, outBus.bus));
+
+        for (uint frame = 0; frame < blockSize; ++frame) {
+            output.push_back(outBus.getSample(0, frame));
+        }
+    }
+    return output;
+}
+
+/**
+ * A sine of numFrames samples, starting at phase zero.
+ */
+inline std::vector<float> makeSine(float frequency, float amplitude, size_t numFrames, uint sampleRate = 44100) {
+    std::vector<float> signal(numFrames);
+    for (size_t i = 0; i < numFrames; ++i) {
+        signal[i] = amplitude *
+                    static_cast<float>(std::sin(2.0 * M_PI * frequency * static_cast<double>(i) / sampleRate));
+    }
+    return signal;
+}
+
 } // namespace voicechanger::test
@@ -0,0 +1,177 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include "TestHelpers.hpp"
+#include "dsp/Random.hpp"
+#include "nodes/VoiceActivityNode.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace voicechanger;
+using namespace voicechanger::test;
+using Catch::Approx;
+
+// Global Switchboard initialization
+static SwitchboardInitializer switchboardInit;
+
+// Test constants
+constexpr uint SAMPLE_RATE = 44100;
+constexpr uint NUM_CHANNELS = 2;
+constexpr uint BUFFER_SIZE = 512;
+constexpr float BLOCK_SECONDS = static_cast<float>(BUFFER_SIZE) / SAMPLE_RATE;
+
+/**
+ * Run a mono signal through the node block by block.
+ * Returns the "active" value read back after every block.
+ */
+static std::vector<bool> trackActivity(VoiceActivityNode& node, const std::vector<float>& mono) {
+    switchboard::AudioBusFormat inputFormat(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    switchboard::AudioBusFormat outputFormat(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    REQUIRE(node.setBusFormat(inputFormat, outputFormat));
+
+    std::vector<bool> track;
+    for (size_t offset = 0; offset + BUFFER_SIZE <= mono.size(); offset += BUFFER_SIZE) {
+        TestAudioBus inBus(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+        TestAudioBus outBus(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+
+        for (uint frame = 0; frame < BUFFER_SIZE; ++frame) {
+            inBus.setSample(0, frame, mono[offset + frame]);
+            inBus.setSample(1, frame, mono[offset + frame]);
+        }
+
+        REQUIRE(node.process(inBus.bus, outBus.bus));
+        track.push_back(std::any_cast<float>(node.getValue("active").value()) > 0.5f);
+    }
+    return track;
+}
+
+/**
+ * Harmonic-rich voice-like tone: the first ten harmonics of f0 with 1/n amplitudes.
+ */
+static std::vector<float> makeBuzz(float f0, float amplitude, size_t numFrames) {
+    std::vector<float> signal(numFrames, 0.0f);
+    for (size_t i = 0; i < numFrames; ++i) {
+        double t = static_cast<double>(i) / SAMPLE_RATE;
+        for (int n = 1; n <= 10; ++n) {
+            signal[i] += amplitude / static_cast<float>(n) * static_cast<float>(std::sin(2.0 * M_PI * f0 * n * t));
+        }
+    }
+    return signal;
+}
+
+static size_t countActive(const std::vector<bool>& track, size_t begin, size_t end) {
+    return static_cast<size_t>(std::count(track.begin() + static_cast<std::ptrdiff_t>(begin),
+                                          track.begin() + static_cast<std::ptrdiff_t>(std::min(end, track.size())), true));
+}
+
+TEST_CASE("VoiceActivityNode - Passes audio through unchanged", "[VoiceActivityNode][baseline]") {
+    SBAnyMap config;
+    VoiceActivityNode node(config);
+
+    switchboard::AudioBusFormat inputFormat(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    switchboard::AudioBusFormat outputFormat(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    REQUIRE(node.setBusFormat(inputFormat, outputFormat));
+
+    TestAudioBus inBus(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    TestAudioBus outBus(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    inBus.fillWithSine(440.0f, 0.5f, SAMPLE_RATE);
+    REQUIRE(node.process(inBus.bus, outBus.bus));
+
+    for (uint ch = 0; ch < NUM_CHANNELS; ++ch) {
+        for (uint frame = 0; frame < BUFFER_SIZE; ++frame) {
+            REQUIRE(outBus.getSample(ch, frame) == inBus.getSample(ch, frame));
+        }
+    }
+}
+
+TEST_CASE("VoiceActivityNode - setValue/getValue for parameters", "[VoiceActivityNode][baseline]") {
+    SBAnyMap config;
+    VoiceActivityNode node(config);
+
+    REQUIRE(std::any_cast<float>(node.getValue("threshold").value()) == Approx(-50.0f));
+    REQUIRE(std::any_cast<float>(node.getValue("hangoverMs").value()) == Approx(500.0f));
+
+    REQUIRE(!node.setValue("threshold", std::make_any<float>(-100.0f)).isError());
+    REQUIRE(std::any_cast<float>(node.getValue("threshold").value()) == Approx(-80.0f));
+    REQUIRE(!node.setValue("hangoverMs", std::make_any<float>(10.0f)).isError());
+    REQUIRE(std::any_cast<float>(node.getValue("hangoverMs").value()) == Approx(50.0f));
+
+    // Analysis outputs are read-only
+    REQUIRE(node.setValue("active", std::make_any<float>(1.0f)).isError());
+    REQUIRE(node.setValue("level", std::make_any<float>(0.0f)).isError());
+    REQUIRE(node.setValue("noiseFloor", std::make_any<float>(0.0f)).isError());
+    REQUIRE(node.setValue("flatness", std::make_any<float>(0.0f)).isError());
+    REQUIRE(node.setValue("unknown", std::make_any<float>(0.0f)).isError());
+}
+
+TEST_CASE("VoiceActivityNode - Silence is inactive", "[VoiceActivityNode][baseline]") {
+    SBAnyMap config;
+    VoiceActivityNode node(config);
+
+    auto track = trackActivity(node, std::vector<float>(SAMPLE_RATE, 0.0f));
+    REQUIRE(countActive(track, 0, track.size()) == 0);
+}
+
+TEST_CASE("VoiceActivityNode - Onset is detected quickly and released after the hangover", "[VoiceActivityNode]") {
+    SBAnyMap config = {{"hangoverMs", 500.0f}};
+    VoiceActivityNode node(config);
+
+    // 0.5 s silence, 1 s buzz, 1.5 s silence
+    std::vector<float> input(SAMPLE_RATE / 2, 0.0f);
+    auto buzz = makeBuzz(150.0f, 0.2f, SAMPLE_RATE);
+    input.insert(input.end(), buzz.begin(), buzz.end());
+    input.resize(input.size() + 3 * SAMPLE_RATE / 2, 0.0f);
+
+    auto track = trackActivity(node, input);
+    auto blockAt = [](float seconds) { return static_cast<size_t>(seconds / BLOCK_SECONDS); };
+
+    REQUIRE(countActive(track, 0, blockAt(0.5f)) == 0);
+    // Active within ~40 ms of the onset and throughout the buzz
+    size_t onset = blockAt(0.5f) + 1;
+    REQUIRE(std::find(track.begin() + static_cast<std::ptrdiff_t>(onset), track.end(), true) - track.begin()
+            <= static_cast<std::ptrdiff_t>(blockAt(0.54f)));
+    REQUIRE(countActive(track, blockAt(0.6f), blockAt(1.5f)) == blockAt(1.5f) - blockAt(0.6f));
+    // Held through the hangover, released after it
+    REQUIRE(countActive(track, blockAt(1.5f), blockAt(1.9f)) == blockAt(1.9f) - blockAt(1.5f));
+    REQUIRE(countActive(track, blockAt(2.2f), track.size()) == 0);
+}
+
+TEST_CASE("VoiceActivityNode - Steady hiss is inactive, voice over it is active", "[VoiceActivityNode]") {
+    SBAnyMap config;
+    VoiceActivityNode node(config);
+
+    // 2 s of -30 dBFS white noise (well above the absolute threshold), then a buzz over it
+    dsp::XorShift32 random(3);
+    std::vector<float> input(3 * SAMPLE_RATE);
+    auto buzz = makeBuzz(150.0f, 0.1f, SAMPLE_RATE);
+    for (size_t i = 0; i < input.size(); ++i) {
+        input[i] = 0.055f * random.nextBipolar() + (i >= 2 * SAMPLE_RATE ? buzz[i - 2 * SAMPLE_RATE] : 0.0f);
+    }
+
+    auto track = trackActivity(node, input);
+    auto blockAt = [](float seconds) { return static_cast<size_t>(seconds / BLOCK_SECONDS); };
+
+    INFO("Flatness " << std::any_cast<float>(node.getValue("flatness").value())
+         << ", floor " << std::any_cast<float>(node.getValue("noiseFloor").value()) << " dBFS");
+    // Hiss may hold activity at the start while the floor settles, then releases
+    REQUIRE(countActive(track, blockAt(1.0f), blockAt(2.0f)) == 0);
+    REQUIRE(countActive(track, blockAt(2.1f), track.size()) == track.size() - blockAt(2.1f));
+}
+
+TEST_CASE("VoiceActivityNode - Speech is mostly active", "[VoiceActivityNode][harvard]") {
+    std::vector<float> samples;
+    uint32_t sampleRate = 0;
+    uint16_t channels = 0;
+    REQUIRE(loadWavFile(std::string(TEST_ASSETS_DIR) + "/harvard_female_01.wav", samples, sampleRate, channels));
+    auto speech = resample(samples, sampleRate, SAMPLE_RATE);
+
+    SBAnyMap config;
+    VoiceActivityNode node(config);
+    auto track = trackActivity(node, speech);
+
+    float activeFraction = static_cast<float>(countActive(track, 0, track.size())) / static_cast<float>(track.size());
+    INFO("Active fraction: " << activeFraction);
+    REQUIRE(activeFraction > 0.6f);
+}
@@ -0,0 +1,679 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include "TestHelpers.hpp"
+#include "chain/ModulationMatrix.hpp"
+#include "chain/PresetMorph.hpp"
+#include "chain/VoiceChain.hpp"
+#include "nodes/ChainNode.hpp"
+#include "nodes/DriveNode.hpp"
+#include "nodes/RingModNode.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace voicechanger;
+using namespace voicechanger::test;
+using Catch::Approx;
+
+// Global Switchboard initialization
+static SwitchboardInitializer switchboardInit;
+
+// Test constants
+constexpr uint SAMPLE_RATE = 44100;
+constexpr uint NUM_CHANNELS = 2;
+constexpr uint BUFFER_SIZE = 512;
+
+/**
+ * The stock preset layout with every stage set to pass audio through.
+ */
+static ChainSpec makeIdleSpec(const std::string& name) {
+    return ChainSpec{name,
+                     {{"pitchShift", "VoiceChanger.PitchShift", {{"pitchShift", 0.0f}, {"mix", 0.0f}}},
+                      {"whisper", "VoiceChanger.Whisper", {{"mix", 0.0f}}},
+                      {"ringMod", "VoiceChanger.RingMod", {{"carrierFrequency", 100.0f}, {"mix", 0.0f}}},
+                      {"drive", "VoiceChanger.Drive", {{"mix", 0.0f}}},
+                      {"glitch", "VoiceChanger.Glitch", {{"mix", 0.0f}}},
+                      {"modDelay", "VoiceChanger.ModDelay", {{"useVibrato", 0.0f}}},
+                      {"delay", "VoiceChanger.Delay", {{"wetMix", 0.0f}, {"dryMix", 1.0f}}}}};
+}
+
+/**
+ * The idle layout with ring modulation and drive switched on.
+ */
+static ChainSpec makeRingDriveSpec(const std::string& name) {
+    auto spec = makeIdleSpec(name);
+    spec.stages[2].params = {{"carrierFrequency", 120.0f}, {"mix", 0.8f}, {"threshold", 0.0f}};
+    spec.stages[3].params = {{"drive", 8.0f}, {"mix", 0.6f}};
+    return spec;
+}
+
+static switchboard::AudioBusFormat makeFormat() {
+    return switchboard::AudioBusFormat(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+}
+
+TEST_CASE("VoiceChain - Pass-through stages are pruned", "[VoiceChain][baseline]") {
+    std::string error;
+
+    auto idle = VoiceChain::compile(makeIdleSpec("Idle"), makeFormat(), error);
+    REQUIRE(idle);
+    REQUIRE(idle->getStageCount() == 0);
+
+    auto ringDrive = VoiceChain::compile(makeRingDriveSpec("RingDrive"), makeFormat(), error);
+    REQUIRE(ringDrive);
+    REQUIRE(ringDrive->getName() == "RingDrive");
+    REQUIRE(ringDrive->getStageIds() == std::vector<std::string>{"ringMod", "drive"});
+    REQUIRE(ringDrive->findStage("drive") != nullptr);
+    REQUIRE(ringDrive->findStage("delay") == nullptr);
+
+    // A stage with no parameters runs at its defaults, which are not all dry
+    REQUIRE_FALSE(VoiceChain::isPassThrough({"delay", "VoiceChanger.Delay", {}}));
+    REQUIRE(VoiceChain::isPassThrough({"modDelay", "VoiceChanger.ModDelay", {}}));
+    REQUIRE_FALSE(VoiceChain::isPassThrough({"drive", "VoiceChanger.Drive", {{"mix", 0.0f}, {"outputGain", 2.0f}}}));
+}
+
+TEST_CASE("VoiceChain - An empty chain copies its input", "[VoiceChain][baseline]") {
+    std::string error;
+    auto chain = VoiceChain::compile(makeIdleSpec("Idle"), makeFormat(), error);
+    REQUIRE(chain);
+
+    TestAudioBus inBus(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    TestAudioBus outBus(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    inBus.fillWithSine(440.0f, 0.5f, SAMPLE_RATE);
+    REQUIRE(chain->process(inBus.bus, outBus.bus));
+    REQUIRE(outBus.channelData == inBus.channelData);
+}
+
+TEST_CASE("VoiceChain - Output matches its stages run one after another", "[VoiceChain]") {
+    auto spec = makeRingDriveSpec("RingDrive");
+    std::string error;
+    auto chain = VoiceChain::compile(spec, makeFormat(), error);
+    REQUIRE(chain);
+
+    SBAnyMap ringModConfig = {{"carrierFrequency", 120.0f}, {"mix", 0.8f}, {"threshold", 0.0f}};
+    SBAnyMap driveConfig = {{"drive", 8.0f}, {"mix", 0.6f}};
+    RingModNode ringMod(ringModConfig);
+    DriveNode drive(driveConfig);
+    auto inputFormat = makeFormat();
+    auto outputFormat = makeFormat();
+    REQUIRE(ringMod.setBusFormat(inputFormat, outputFormat));
+    REQUIRE(drive.setBusFormat(inputFormat, outputFormat));
+
+    for (uint block = 0; block < 8; ++block) {
+        TestAudioBus inBus(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+        TestAudioBus middleBus(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+        TestAudioBus expectedBus(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+        TestAudioBus outBus(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+        inBus.fillWithSine(220.0f, 0.5f, SAMPLE_RATE, block * BUFFER_SIZE);
+
+        REQUIRE(ringMod.process(inBus.bus, middleBus.bus));
+        REQUIRE(drive.process(middleBus.bus, expectedBus.bus));
+        REQUIRE(chain->process(inBus.bus, outBus.bus));
+
+        REQUIRE(outBus.channelData == expectedBus.channelData);
+    }
+}
+
+TEST_CASE("VoiceChain - Unknown stage types and parameters fail to compile", "[VoiceChain][baseline]") {
+    auto spec = makeIdleSpec("Broken");
+    spec.stages.push_back({"reverb", "VoiceChanger.Reverb", {}});
+
+    std::string error;
+    REQUIRE_FALSE(VoiceChain::compile(spec, makeFormat(), error));
+    REQUIRE(error.find("VoiceChanger.Reverb") != std::string::npos);
+
+    spec = makeRingDriveSpec("Broken");
+    spec.stages[2].params.push_back({"roomSize", 0.5f});
+    REQUIRE_FALSE(VoiceChain::compile(spec, makeFormat(), error));
+    REQUIRE(error.find("roomSize") != std::string::npos);
+}
+
+TEST_CASE("ChainNode - A new preset takes effect at the next block", "[VoiceChain]") {
+    SBAnyMap config;
+    ChainNode node(config);
+
+    // Set before the format is known; compiled by setBusFormat
+    REQUIRE(!node.setValue("preset", std::make_any<ChainSpec>(makeIdleSpec("Idle"))).isError());
+    auto inputFormat = makeFormat();
+    auto outputFormat = makeFormat();
+    REQUIRE(node.setBusFormat(inputFormat, outputFormat));
+    REQUIRE(std::any_cast<int>(node.getValue("stageCount").value()) == 0);
+
+    TestAudioBus inBus(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    TestAudioBus outBus(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    inBus.fillWithSine(220.0f, 0.5f, SAMPLE_RATE);
+    REQUIRE(node.process(inBus.bus, outBus.bus));
+    REQUIRE(outBus.channelData == inBus.channelData);
+
+    REQUIRE(!node.setValue("preset", std::make_any<ChainSpec>(makeRingDriveSpec("RingDrive"))).isError());
+    REQUIRE(std::any_cast<int>(node.getValue("stageCount").value()) == 2);
+    REQUIRE(std::any_cast<std::string>(node.getValue("activePreset").value()) == "RingDrive");
+
+    REQUIRE(node.process(inBus.bus, outBus.bus));
+    REQUIRE(outBus.channelData != inBus.channelData);
+
+    // Switching every block cycles old chains through the retire ring
+    for (int i = 0; i < 20; ++i) {
+        auto spec = (i % 2 == 0) ? makeRingDriveSpec("RingDrive") : makeIdleSpec("Idle");
+        REQUIRE(!node.setValue("preset", std::make_any<ChainSpec>(spec)).isError());
+        REQUIRE(node.process(inBus.bus, outBus.bus));
+    }
+    REQUIRE(!node.setValue("preset", std::make_any<ChainSpec>(makeIdleSpec("Idle"))).isError());
+    REQUIRE(node.process(inBus.bus, outBus.bus));
+    REQUIRE(outBus.channelData == inBus.channelData);
+}
+
+TEST_CASE("ChainNode - A rejected preset keeps the current chain", "[VoiceChain][baseline]") {
+    SBAnyMap config;
+    ChainNode node(config);
+    auto inputFormat = makeFormat();
+    auto outputFormat = makeFormat();
+    REQUIRE(node.setBusFormat(inputFormat, outputFormat));
+    REQUIRE(!node.setValue("preset", std::make_any<ChainSpec>(makeRingDriveSpec("RingDrive"))).isError());
+
+    auto broken = makeIdleSpec("Broken");
+    broken.stages.push_back({"reverb", "VoiceChanger.Reverb", {}});
+    REQUIRE(node.setValue("preset", std::make_any<ChainSpec>(broken)).isError());
+    REQUIRE(std::any_cast<std::string>(node.getValue("activePreset").value()) == "RingDrive");
+    REQUIRE(std::any_cast<int>(node.getValue("stageCount").value()) == 2);
+
+    REQUIRE(node.setValue("preset", std::make_any<float>(1.0f)).isError());
+    REQUIRE(node.setValue("stageCount", std::make_any<int>(3)).isError());
+    REQUIRE(node.setValue("unknown", std::make_any<float>(0.0f)).isError());
+    REQUIRE(node.getValue("unknown").isError());
+}
+
+TEST_CASE("ChainNode - A prepared preset is used by the next switch to it", "[VoiceChain][baseline]") {
+    SBAnyMap config;
+    ChainNode node(config);
+    auto inputFormat = makeFormat();
+    auto outputFormat = makeFormat();
+    REQUIRE(node.setBusFormat(inputFormat, outputFormat));
+
+    REQUIRE(!node.setValue("prepare", std::make_any<ChainSpec>(makeRingDriveSpec("RingDrive"))).isError());
+    REQUIRE(std::any_cast<std::string>(node.getValue("preparedPreset").value()) == "RingDrive");
+
+    REQUIRE(!node.setValue("preset", std::make_any<ChainSpec>(makeRingDriveSpec("RingDrive"))).isError());
+    REQUIRE(std::any_cast<std::string>(node.getValue("preparedPreset").value()).empty());
+    REQUIRE(std::any_cast<int>(node.getValue("stageCount").value()) == 2);
+
+    TestAudioBus inBus(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    TestAudioBus outBus(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    inBus.fillWithSine(220.0f, 0.5f, SAMPLE_RATE);
+    REQUIRE(node.process(inBus.bus, outBus.bus));
+    REQUIRE(outBus.channelData != inBus.channelData);
+}
+
+static float chainValue(ChainNode& node, const std::string& key) {
+    auto result = node.getValue(key);
+    REQUIRE(!result.isError());
+    return std::any_cast<float>(result.value());
+}
+
+TEST_CASE("ChainNode - A prepared preset is only used for the same spec", "[VoiceChain][baseline]") {
+    SBAnyMap config;
+    ChainNode node(config);
+    auto inputFormat = makeFormat();
+    auto outputFormat = makeFormat();
+    REQUIRE(node.setBusFormat(inputFormat, outputFormat));
+
+    // Two presets named alike, as duplicate files or a reloaded one are
+    auto prepared = makeRingDriveSpec("Twin");
+    auto other = makeRingDriveSpec("Twin");
+    other.stages[2].params[0].value = 300.0f;
+    REQUIRE(!node.setValue("prepare", std::make_any<ChainSpec>(prepared)).isError());
+
+    REQUIRE(!node.setValue("preset", std::make_any<ChainSpec>(other)).isError());
+    REQUIRE(chainValue(node, "ringMod.carrierFrequency") == Approx(300.0f));
+    REQUIRE(std::any_cast<std::string>(node.getValue("preparedPreset").value()) == "Twin");
+
+    REQUIRE(!node.setValue("preset", std::make_any<ChainSpec>(prepared)).isError());
+    REQUIRE(chainValue(node, "ringMod.carrierFrequency") == Approx(120.0f));
+    REQUIRE(std::any_cast<std::string>(node.getValue("preparedPreset").value()).empty());
+
+    // Ids and the validated flag do not make a spec different
+    auto resolved = makeRingDriveSpec("Twin");
+    resolved.stages[2].params[0].id = 0;
+    resolved.validated = true;
+    REQUIRE(resolved.buildsSameChain(prepared));
+    REQUIRE_FALSE(other.buildsSameChain(prepared));
+    resolved.modulations.push_back({dsp::ModulatorType::kSine, "ringMod", "carrierFrequency", 20.0f});
+    REQUIRE_FALSE(resolved.buildsSameChain(prepared));
+}
+
+TEST_CASE("ChainNode - A parameter batch takes effect in one block", "[VoiceChain][baseline]") {
+    SBAnyMap config;
+    ChainNode node(config);
+    auto inputFormat = makeFormat();
+    auto outputFormat = makeFormat();
+    REQUIRE(node.setBusFormat(inputFormat, outputFormat));
+    REQUIRE(!node.setValue("preset", std::make_any<ChainSpec>(makeRingDriveSpec("RingDrive"))).isError());
+
+    TestAudioBus inBus(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    TestAudioBus outBus(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    inBus.fillWithSine(220.0f, 0.5f, SAMPLE_RATE);
+    REQUIRE(node.process(inBus.bus, outBus.bus));
+
+    // Two batches before the next block are merged; nothing changes until then
+    std::vector<ParameterChange> changes = {{"ringMod", "carrierFrequency", 300.0f}, {"drive", "mix", 0.2f}};
+    REQUIRE(!node.setValue("parameters", std::make_any<std::vector<ParameterChange>>(changes)).isError());
+    changes = {{"drive", "drive", 20.0f}};
+    REQUIRE(!node.setValue("parameters", std::make_any<std::vector<ParameterChange>>(changes)).isError());
+    REQUIRE(chainValue(node, "ringMod.carrierFrequency") == Approx(120.0f));
+    REQUIRE(chainValue(node, "drive.mix") == Approx(0.6f));
+    REQUIRE(chainValue(node, "drive.drive") == Approx(8.0f));
+
+    REQUIRE(node.process(inBus.bus, outBus.bus));
+    REQUIRE(chainValue(node, "ringMod.carrierFrequency") == Approx(300.0f));
+    REQUIRE(chainValue(node, "drive.mix") == Approx(0.2f));
+    REQUIRE(chainValue(node, "drive.drive") == Approx(20.0f));
+    REQUIRE(std::any_cast<int>(node.getValue("stageCount").value()) == 2);
+
+    // A pruned stage is brought in by recompiling, with the earlier changes kept
+    changes = {{"delay", "wetMix", 0.4f}};
+    REQUIRE(!node.setValue("parameters", std::make_any<std::vector<ParameterChange>>(changes)).isError());
+    REQUIRE(std::any_cast<int>(node.getValue("stageCount").value()) == 3);
+    REQUIRE(chainValue(node, "ringMod.carrierFrequency") == Approx(300.0f));
+    REQUIRE(chainValue(node, "delay.wetMix") == Approx(0.4f));
+    REQUIRE(node.process(inBus.bus, outBus.bus));
+
+    // A whole batch is rejected if any change is
+    changes = {{"drive", "mix", 0.9f}, {"reverb", "mix", 0.5f}};
+    REQUIRE(node.setValue("parameters", std::make_any<std::vector<ParameterChange>>(changes)).isError());
+    changes = {{"drive", "mix", 0.9f}, {"drive", "latency", 1.0f}};
+    REQUIRE(node.setValue("parameters", std::make_any<std::vector<ParameterChange>>(changes)).isError());
+    changes = {{"drive", "mix", 0.9f}, {"ringMod", "roomSize", 1.0f}};
+    REQUIRE(node.setValue("parameters", std::make_any<std::vector<ParameterChange>>(changes)).isError());
+    changes = {{"drive", "mix", 0.9f}, {"ringMod", "mix", NAN}};
+    REQUIRE(node.setValue("parameters", std::make_any<std::vector<ParameterChange>>(changes)).isError());
+    changes = {{"drive", "drive", INFINITY}};
+    REQUIRE(node.setValue("parameters", std::make_any<std::vector<ParameterChange>>(changes)).isError());
+    REQUIRE(node.process(inBus.bus, outBus.bus));
+    REQUIRE(chainValue(node, "drive.mix") == Approx(0.2f));
+}
+
+TEST_CASE("ChainNode - A structural parameter recompiles the chain", "[VoiceChain][baseline]") {
+    SBAnyMap config;
+    ChainNode node(config);
+    auto inputFormat = makeFormat();
+    auto outputFormat = makeFormat();
+    REQUIRE(node.setBusFormat(inputFormat, outputFormat));
+    auto spec = makeIdleSpec("Shifted");
+    spec.stages[0].params = {{"pitchShift", 3.0f}, {"mix", 1.0f}};
+    REQUIRE(!node.setValue("preset", std::make_any<ChainSpec>(spec)).isError());
+
+    TestAudioBus inBus(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    TestAudioBus outBus(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    inBus.fillWithSine(220.0f, 0.5f, SAMPLE_RATE);
+    REQUIRE(node.process(inBus.bus, outBus.bus));
+
+    // processingRate is only read when the stage is configured, so the batch
+    // builds a new chain with it instead of storing it in the running one
+    std::vector<ParameterChange> changes = {{"pitchShift", "processingRate", 16000.0f}, {"pitchShift", "mix", 0.5f}};
+    REQUIRE(!node.setValue("parameters", std::make_any<std::vector<ParameterChange>>(changes)).isError());
+    REQUIRE(chainValue(node, "pitchShift.processingRate") == Approx(16000.0f));
+    REQUIRE(chainValue(node, "pitchShift.mix") == Approx(0.5f));
+    REQUIRE(node.process(inBus.bus, outBus.bus));
+    REQUIRE(chainValue(node, "pitchShift.processingRate") == Approx(16000.0f));
+
+    // Other parameters still change in place
+    changes = {{"pitchShift", "mix", 0.25f}};
+    REQUIRE(!node.setValue("parameters", std::make_any<std::vector<ParameterChange>>(changes)).isError());
+    REQUIRE(chainValue(node, "pitchShift.mix") == Approx(0.5f));
+    REQUIRE(node.process(inBus.bus, outBus.bus));
+    REQUIRE(chainValue(node, "pitchShift.mix") == Approx(0.25f));
+}
+
+TEST_CASE("ChainNode - A batch for a replaced chain is dropped", "[VoiceChain][baseline]") {
+    SBAnyMap config;
+    ChainNode node(config);
+    auto inputFormat = makeFormat();
+    auto outputFormat = makeFormat();
+    REQUIRE(node.setBusFormat(inputFormat, outputFormat));
+    REQUIRE(!node.setValue("preset", std::make_any<ChainSpec>(makeRingDriveSpec("RingDrive"))).isError());
+
+    TestAudioBus inBus(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    TestAudioBus outBus(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    inBus.fillWithSine(220.0f, 0.5f, SAMPLE_RATE);
+    REQUIRE(node.process(inBus.bus, outBus.bus));
+
+    std::vector<ParameterChange> changes = {{"ringMod", "carrierFrequency", 300.0f}};
+    REQUIRE(!node.setValue("parameters", std::make_any<std::vector<ParameterChange>>(changes)).isError());
+    REQUIRE(!node.setValue("preset", std::make_any<ChainSpec>(makeRingDriveSpec("RingDrive2"))).isError());
+
+    // Both arrive in the same block; the new preset's values win
+    REQUIRE(node.process(inBus.bus, outBus.bus));
+    REQUIRE(chainValue(node, "ringMod.carrierFrequency") == Approx(120.0f));
+
+    // Parameters of a stage that is not running cannot be read
+    REQUIRE(node.getValue("delay.wetMix").isError());
+}
+
+TEST_CASE("ChainNode - A batch for a standby published during a fade reaches it", "[VoiceChain][baseline]") {
+    SBAnyMap config = {{"crossfadeMs", 50.0f}};
+    ChainNode node(config);
+    auto inputFormat = makeFormat();
+    auto outputFormat = makeFormat();
+    REQUIRE(node.setBusFormat(inputFormat, outputFormat));
+    REQUIRE(!node.setValue("preset", std::make_any<ChainSpec>(makeRingDriveSpec("First"))).isError());
+
+    TestAudioBus inBus(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    TestAudioBus outBus(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    inBus.fillWithSine(220.0f, 0.5f, SAMPLE_RATE);
+    REQUIRE(node.process(inBus.bus, outBus.bus));
+
+    // The standby is compiled before the chain that starts the fade, and published while it runs
+    REQUIRE(!node.setValue("prepare", std::make_any<ChainSpec>(makeRingDriveSpec("Standby"))).isError());
+    REQUIRE(!node.setValue("preset", std::make_any<ChainSpec>(makeRingDriveSpec("Second"))).isError());
+    REQUIRE(node.process(inBus.bus, outBus.bus));
+    REQUIRE(!node.setValue("preset", std::make_any<ChainSpec>(makeRingDriveSpec("Standby"))).isError());
+
+    std::vector<ParameterChange> changes = {{"ringMod", "carrierFrequency", 300.0f}};
+    REQUIRE(!node.setValue("parameters", std::make_any<std::vector<ParameterChange>>(changes)).isError());
+    for (int i = 0; i < 16; ++i) {
+        REQUIRE(node.process(inBus.bus, outBus.bus));
+    }
+    REQUIRE(std::any_cast<std::string>(node.getValue("activePreset").value()) == "Standby");
+    REQUIRE(chainValue(node, "ringMod.carrierFrequency") == Approx(300.0f));
+}
+
+/**
+ * The idle layout with the drive stage reduced to a gain of 0.25.
+ */
+static ChainSpec makeQuietSpec(const std::string& name) {
+    auto spec = makeIdleSpec(name);
+    spec.stages[3].params = {{"mix", 0.0f}, {"outputGain", 0.25f}};
+    return spec;
+}
+
+/**
+ * Run an idle chain on a constant input, switch to the quiet one and
+ * process numBlocks more blocks. Returns the output after the switch.
+ */
+static std::vector<float> switchToQuiet(ChainNode& node, int numBlocks) {
+    auto inputFormat = makeFormat();
+    auto outputFormat = makeFormat();
+    REQUIRE(node.setBusFormat(inputFormat, outputFormat));
+    REQUIRE(!node.setValue("preset", std::make_any<ChainSpec>(makeIdleSpec("Idle"))).isError());
+
+    TestAudioBus inBus(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    TestAudioBus outBus(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    for (auto& channel : inBus.channelData) {
+        std::fill(channel.begin(), channel.end(), 0.5f);
+    }
+    for (int i = 0; i < 4; ++i) {
+        REQUIRE(node.process(inBus.bus, outBus.bus));
+    }
+
+    REQUIRE(!node.setValue("preset", std::make_any<ChainSpec>(makeQuietSpec("Quiet"))).isError());
+    std::vector<float> output;
+    for (int i = 0; i < numBlocks; ++i) {
+        REQUIRE(node.process(inBus.bus, outBus.bus));
+        output.insert(output.end(), outBus.channelData[0].begin(), outBus.channelData[0].end());
+    }
+    return output;
+}
+
+TEST_CASE("ChainNode - Crossfaded transitions are click-free", "[VoiceChain][baseline]") {
+    SBAnyMap config;
+    ChainNode hard(config);
+    auto hardOutput = switchToQuiet(hard, 1);
+    REQUIRE(hardOutput.front() == Approx(0.125f));
+    float hardStep = std::any_cast<float>(hard.getValue("transitionMaxStep").value());
+    REQUIRE(hardStep == Approx(0.375f));
+
+    SBAnyMap fadeConfig = {{"crossfadeMs", 50.0f}};
+    ChainNode faded(fadeConfig);
+    REQUIRE(std::any_cast<float>(faded.getValue("crossfadeMs").value()) == Approx(50.0f));
+    auto fadedOutput = switchToQuiet(faded, 6);
+
+    // Equal-power gains: all old at the start, cos/sin at the midpoint, all new at the end
+    const size_t fadeLength = static_cast<size_t>(0.05f * SAMPLE_RATE + 0.5f);
+    REQUIRE(fadedOutput.front() == Approx(0.5f).margin(0.001f));
+    REQUIRE(fadedOutput[fadeLength / 2] == Approx(0.5f * std::sqrt(0.5f) + 0.125f * std::sqrt(0.5f)).margin(0.001f));
+    REQUIRE(fadedOutput[fadeLength] == Approx(0.125f));
+    REQUIRE(fadedOutput.back() == Approx(0.125f));
+
+    float fadedStep = std::any_cast<float>(faded.getValue("transitionMaxStep").value());
+    REQUIRE(fadedStep < 0.01f * hardStep);
+    REQUIRE(std::any_cast<float>(faded.getValue("transitionPeakLoad").value()) > 0.0f);
+    REQUIRE(std::any_cast<float>(faded.getValue("load").value()) > 0.0f);
+}
+
+TEST_CASE("ChainNode - A preset set during a crossfade waits for it", "[VoiceChain][baseline]") {
+    SBAnyMap config = {{"crossfadeMs", 50.0f}};
+    ChainNode node(config);
+    auto output = switchToQuiet(node, 1);
+
+    // Back to idle mid-fade; the fade to quiet still completes first
+    REQUIRE(!node.setValue("preset", std::make_any<ChainSpec>(makeIdleSpec("Idle"))).isError());
+    TestAudioBus inBus(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    TestAudioBus outBus(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    for (auto& channel : inBus.channelData) {
+        std::fill(channel.begin(), channel.end(), 0.5f);
+    }
+    for (int i = 0; i < 16; ++i) {
+        REQUIRE(node.process(inBus.bus, outBus.bus));
+        output.insert(output.end(), outBus.channelData[0].begin(), outBus.channelData[0].end());
+    }
+
+    auto lowest = std::min_element(output.begin(), output.end());
+    REQUIRE(*lowest == Approx(0.125f));
+    REQUIRE(output.back() == Approx(0.5f));
+    REQUIRE(std::any_cast<float>(node.getValue("transitionMaxStep").value()) < 0.01f);
+}
+
+TEST_CASE("ChainNode - A format change installs the rebuilt chain without a fade", "[VoiceChain][baseline]") {
+    SBAnyMap config = {{"crossfadeMs", 50.0f}};
+    ChainNode node(config);
+    switchToQuiet(node, 6);
+
+    // Back to idle, then a new format before the next block: the idle chain
+    // is rebuilt for it and heard from the first frame, not faded into
+    REQUIRE(!node.setValue("preset", std::make_any<ChainSpec>(makeIdleSpec("Idle"))).isError());
+    constexpr uint kNewBufferSize = BUFFER_SIZE / 2;
+    switchboard::AudioBusFormat inputFormat(SAMPLE_RATE / 2, 1, kNewBufferSize);
+    switchboard::AudioBusFormat outputFormat(SAMPLE_RATE / 2, 1, kNewBufferSize);
+    REQUIRE(node.setBusFormat(inputFormat, outputFormat));
+
+    TestAudioBus inBus(SAMPLE_RATE / 2, 1, kNewBufferSize);
+    TestAudioBus outBus(SAMPLE_RATE / 2, 1, kNewBufferSize);
+    std::fill(inBus.channelData[0].begin(), inBus.channelData[0].end(), 0.5f);
+    REQUIRE(node.process(inBus.bus, outBus.bus));
+    REQUIRE(outBus.channelData[0].front() == Approx(0.5f));
+    REQUIRE(outBus.channelData[0].back() == Approx(0.5f));
+}
+
+static const ParameterChange* findChange(const std::vector<ParameterChange>& changes, const std::string& stageId,
+                                         const std::string& key) {
+    auto it = std::find_if(changes.begin(), changes.end(),
+                           [&](const ParameterChange& c) { return c.stageId == stageId && c.key == key; });
+    return it == changes.end() ? nullptr : &*it;
+}
+
+TEST_CASE("PresetMorph - Parameters move along their own scales", "[VoiceChain][baseline]") {
+    auto from = makeRingDriveSpec("RingDrive");
+    auto to = makeRingDriveSpec("Other");
+    to.stages[0].params = {{"pitchShift", 12.0f}, {"mix", 1.0f}};
+    to.stages[2].params = {{"carrierFrequency", 480.0f}, {"mix", 0.8f}, {"threshold", 0.0f}};
+    to.stages[3].params = {{"drive", 8.0f}, {"mix", 0.6f}, {"curve", 2.0f}};
+    to.stages[5].params = {{"useChorus", 1.0f}};
+
+    std::string error;
+    auto morph = PresetMorph::create(from, to, error);
+    REQUIRE(morph);
+    // pitchShift, its mix, carrierFrequency, curve and useChorus
+    REQUIRE(morph->getTrackCount() == 5);
+
+    const auto& quarter = morph->update(0.25f);
+    REQUIRE(quarter.size() == 4);
+    REQUIRE(findChange(quarter, "pitchShift", "pitchShift")->value == Approx(3.0f));
+    REQUIRE(findChange(quarter, "pitchShift", "mix")->value == Approx(0.25f));
+    REQUIRE(findChange(quarter, "ringMod", "carrierFrequency")->value == Approx(120.0f * std::pow(4.0f, 0.25f)));
+    REQUIRE(findChange(quarter, "modDelay", "useChorus")->value == Approx(0.25f));
+    REQUIRE(findChange(quarter, "drive", "curve") == nullptr);
+
+    // The same position again changes nothing; a switch steps at the midpoint
+    REQUIRE(morph->update(0.25f).empty());
+    const auto& half = morph->update(0.5f);
+    REQUIRE(findChange(half, "drive", "curve")->value == Approx(2.0f));
+    REQUIRE(findChange(half, "ringMod", "carrierFrequency")->value == Approx(240.0f));
+
+    // The ends are exactly the presets
+    auto end = morph->specAt(1.0f);
+    REQUIRE(end.name == "Other");
+    REQUIRE(end.stages[2].getParam("carrierFrequency", 0.0f) == 480.0f);
+    REQUIRE(morph->specAt(0.0f).stages[2].getParam("carrierFrequency", 0.0f) == 120.0f);
+
+    // Presets with different stages cannot be morphed
+    auto shorter = from;
+    shorter.stages.pop_back();
+    REQUIRE_FALSE(PresetMorph::create(from, shorter, error));
+    auto swapped = from;
+    std::swap(swapped.stages[2], swapped.stages[3]);
+    REQUIRE_FALSE(PresetMorph::create(from, swapped, error));
+    REQUIRE(error.find("ringMod") != std::string::npos);
+}
+
+TEST_CASE("ChainNode - Morphing pushes only the parameters that moved", "[VoiceChain][baseline]") {
+    SBAnyMap config;
+    ChainNode node(config);
+    auto inputFormat = makeFormat();
+    auto outputFormat = makeFormat();
+    REQUIRE(node.setBusFormat(inputFormat, outputFormat));
+    REQUIRE(node.setValue("morph", std::make_any<float>(0.5f)).isError());
+    REQUIRE(!node.setValue("preset", std::make_any<ChainSpec>(makeRingDriveSpec("RingDrive"))).isError());
+
+    auto target = makeRingDriveSpec("Target");
+    target.stages[2].params = {{"carrierFrequency", 480.0f}, {"mix", 0.4f}, {"threshold", 0.0f}};
+    target.stages[5].params = {{"useFlanger", 1.0f}};
+    REQUIRE(!node.setValue("morphTarget", std::make_any<ChainSpec>(target)).isError());
+
+    auto broken = makeRingDriveSpec("Broken");
+    broken.stages.pop_back();
+    REQUIRE(node.setValue("morphTarget", std::make_any<ChainSpec>(broken)).isError());
+
+    TestAudioBus inBus(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    TestAudioBus outBus(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    inBus.fillWithSine(220.0f, 0.5f, SAMPLE_RATE);
+    REQUIRE(node.process(inBus.bus, outBus.bus));
+
+    // Halfway the flanger is half on, which brings the pruned ModDelay stage in
+    REQUIRE(!node.setValue("morph", std::make_any<float>(0.5f)).isError());
+    REQUIRE(node.process(inBus.bus, outBus.bus));
+    REQUIRE(std::any_cast<int>(node.getValue("stageCount").value()) == 3);
+    REQUIRE(chainValue(node, "ringMod.carrierFrequency") == Approx(240.0f));
+    REQUIRE(chainValue(node, "ringMod.mix") == Approx(0.6f));
+    REQUIRE(chainValue(node, "modDelay.useFlanger") == Approx(0.5f));
+    REQUIRE(std::any_cast<float>(node.getValue("morph").value()) == Approx(0.5f));
+
+    REQUIRE(!node.setValue("morph", std::make_any<float>(1.0f)).isError());
+    REQUIRE(node.process(inBus.bus, outBus.bus));
+    REQUIRE(chainValue(node, "ringMod.carrierFrequency") == Approx(480.0f));
+    REQUIRE(chainValue(node, "modDelay.useFlanger") == Approx(1.0f));
+    REQUIRE(std::any_cast<std::string>(node.getValue("activePreset").value()) == "Target");
+
+    // Selecting a preset ends the morph
+    REQUIRE(!node.setValue("preset", std::make_any<ChainSpec>(makeIdleSpec("Idle"))).isError());
+    REQUIRE(node.setValue("morph", std::make_any<float>(0.0f)).isError());
+}
+
+TEST_CASE("Modulator - Sources stay in range and are deterministic", "[VoiceChain][baseline]") {
+    const float controlRate = static_cast<float>(SAMPLE_RATE) / ModulationMatrix::kControlFrames;
+
+    // A 1 Hz sine peaks a quarter of a second in
+    dsp::Modulator sine;
+    sine.prepare(dsp::ModulatorType::kSine, 1.0f, 0.0f, 0.0f, controlRate, 1);
+    float peak = 0.0f;
+    for (int i = 0; i < static_cast<int>(controlRate); ++i) {
+        peak = std::max(peak, sine.step(0.0f));
+    }
+    REQUIRE(peak == Approx(1.0f).margin(1.0e-3));
+
+    dsp::Modulator triangle;
+    triangle.prepare(dsp::ModulatorType::kTriangle, 4.0f, 0.0f, 0.0f, controlRate, 1);
+    for (int i = 0; i < 1000; ++i) {
+        float value = triangle.step(0.0f);
+        REQUIRE(value >= -1.0f);
+        REQUIRE(value <= 1.0f);
+    }
+
+    // The envelope rises with the level and falls back after it
+    dsp::Modulator envelope;
+    envelope.prepare(dsp::ModulatorType::kEnvelope, 1.0f, 5.0f, 100.0f, controlRate, 1);
+    for (int i = 0; i < 100; ++i) {
+        envelope.step(0.8f);
+    }
+    REQUIRE(envelope.getValue() == Approx(0.8f).margin(1.0e-3));
+    for (int i = 0; i < 1000; ++i) {
+        envelope.step(0.0f);
+    }
+    REQUIRE(envelope.getValue() < 0.01f);
+
+    // Same seed, same walk; it wanders but stays in range
+    dsp::Modulator walkA;
+    dsp::Modulator walkB;
+    walkA.prepare(dsp::ModulatorType::kRandomWalk, 2.0f, 0.0f, 0.0f, controlRate, 7);
+    walkB.prepare(dsp::ModulatorType::kRandomWalk, 2.0f, 0.0f, 0.0f, controlRate, 7);
+    float lowest = 0.0f;
+    float highest = 0.0f;
+    for (int i = 0; i < 10000; ++i) {
+        float value = walkA.step(0.0f);
+        REQUIRE(value == walkB.step(0.0f));
+        lowest = std::min(lowest, value);
+        highest = std::max(highest, value);
+    }
+    REQUIRE(lowest >= -1.0f);
+    REQUIRE(highest <= 1.0f);
+    REQUIRE(highest - lowest > 0.5f);
+}
+
+TEST_CASE("VoiceChain - Modulation moves parameters at control rate", "[VoiceChain][baseline]") {
+    auto spec = makeRingDriveSpec("Modulated");
+    ModulationSpec lfo;
+    lfo.source = dsp::ModulatorType::kSine;
+    lfo.stageId = "ringMod";
+    lfo.key = "carrierFrequency";
+    lfo.depth = 50.0f;
+    lfo.rateHz = 2.0f;
+    spec.modulations.push_back(lfo);
+
+    std::string error;
+    auto chain = VoiceChain::compile(spec, makeFormat(), error);
+    REQUIRE(chain);
+    REQUIRE(chain->getModulationCount() == 1);
+    ParameterHandle carrier = chain->findParameter("ringMod", "carrierFrequency");
+
+    TestAudioBus inBus(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    TestAudioBus outBus(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    inBus.fillWithSine(220.0f, 0.5f, SAMPLE_RATE);
+    REQUIRE(chain->process(inBus.bus, outBus.bus));
+
+    // The last control step of the block was the 16th
+    const float controlRate = static_cast<float>(SAMPLE_RATE) / ModulationMatrix::kControlFrames;
+    const float phase = 2.0f * static_cast<float>(M_PI) * 15.0f * 2.0f / controlRate;
+    REQUIRE(carrier.get() == Approx(120.0f + 50.0f * std::sin(phase)).margin(1.0e-3));
+
+    // A new preset value moves the centre of the modulation
+    chain->applyParameter(carrier, 300.0f);
+    REQUIRE(chain->process(inBus.bus, outBus.bus));
+    REQUIRE(carrier.get() > 250.0f);
+
+    // A modulated stage is kept even at its pass-through values
+    auto idle = makeIdleSpec("Idle");
+    lfo.key = "mix";
+    lfo.depth = 0.5f;
+    idle.modulations.push_back(lfo);
+    auto idleChain = VoiceChain::compile(idle, makeFormat(), error);
+    REQUIRE(idleChain);
+    REQUIRE(idleChain->getStageIds() == std::vector<std::string>{"ringMod"});
+
+    // Only continuous parameters of PitchShift and RingMod can be targets
+    auto broken = makeRingDriveSpec("Broken");
+    lfo.stageId = "drive";
+    lfo.key = "drive";
+    broken.modulations.push_back(lfo);
+    REQUIRE_FALSE(VoiceChain::compile(broken, makeFormat(), error));
+    REQUIRE(error.find("drive.drive") != std::string::npos);
+}
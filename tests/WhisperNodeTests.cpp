@@ -0,0 +1,194 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include "TestHelpers.hpp"
+#include "dsp/Biquad.hpp"
+#include "dsp/Lpc.hpp"
+#include "dsp/Random.hpp"
+#include "nodes/WhisperNode.hpp"
+
+#include <cmath>
+#include <vector>
+
+using namespace voicechanger;
+using namespace voicechanger::test;
+using Catch::Approx;
+
+// Global Switchboard initialization
+static SwitchboardInitializer switchboardInit;
+
+// Test constants
+constexpr uint SAMPLE_RATE = 44100;
+constexpr uint NUM_CHANNELS = 2;
+constexpr uint BUFFER_SIZE = 512;
+
+/**
+ * A crude voiced vowel: a 120 Hz pulse train through one formant resonance.
+ */
+static std::vector<float> makeVowel(float formantHz, size_t numFrames) {
+    dsp::Biquad formant;
+    formant.setBandpass(static_cast<float>(SAMPLE_RATE), formantHz, 6.0f);
+    std::vector<float> signal(numFrames);
+    auto period = static_cast<size_t>(SAMPLE_RATE / 120);
+    for (size_t i = 0; i < numFrames; ++i) {
+        signal[i] = 4.0f * formant.process(i % period == 0 ? 1.0f : 0.0f);
+    }
+    return signal;
+}
+
+static float rms(const std::vector<float>& samples, size_t begin, size_t end) {
+    double sum = 0.0;
+    for (size_t i = begin; i < end; ++i) {
+        sum += static_cast<double>(samples[i]) * samples[i];
+    }
+    return static_cast<float>(std::sqrt(sum / static_cast<double>(end - begin)));
+}
+
+/**
+ * Normalized autocorrelation at one lag over [begin, end).
+ */
+static float correlationAt(const std::vector<float>& samples, size_t lag, size_t begin, size_t end) {
+    double cross = 0.0, energy = 0.0;
+    for (size_t i = begin; i + lag < end; ++i) {
+        cross += static_cast<double>(samples[i]) * samples[i + lag];
+        energy += static_cast<double>(samples[i]) * samples[i];
+    }
+    return static_cast<float>(cross / energy);
+}
+
+TEST_CASE("WhisperNode - Silence in produces silence out", "[WhisperNode][baseline]") {
+    SBAnyMap config;
+    WhisperNode node(config);
+
+    std::vector<float> input(8 * BUFFER_SIZE, 0.0f);
+    prepareNode(node);
+    auto output = processMono(node, input);
+    for (float sample : output) {
+        REQUIRE(sample == 0.0f);
+    }
+}
+
+TEST_CASE("WhisperNode - Zero mix passes audio through unchanged", "[WhisperNode][baseline]") {
+    SBAnyMap config = {{"mix", 0.0f}};
+    WhisperNode node(config);
+
+    auto input = makeVowel(700.0f, 8 * BUFFER_SIZE);
+    prepareNode(node);
+    auto output = processMono(node, input);
+    REQUIRE(output == input);
+}
+
+TEST_CASE("WhisperNode - setValue/getValue for parameters", "[WhisperNode][baseline]") {
+    SBAnyMap config = {{"mix", 0.4f}};
+    WhisperNode node(config);
+
+    REQUIRE(std::any_cast<float>(node.getValue("mix").value()) == Approx(0.4f));
+    REQUIRE(!node.setValue("mix", std::make_any<float>(2.0f)).isError());
+    REQUIRE(std::any_cast<float>(node.getValue("mix").value()) == Approx(1.0f));
+
+    REQUIRE(node.setValue("mix", std::make_any<int>(1)).isError());
+    REQUIRE(node.setValue("unknown", std::make_any<float>(0.0f)).isError());
+    REQUIRE(node.getValue("unknown").isError());
+}
+
+TEST_CASE("Lpc - Levinson recovers a known all-pole resonator", "[WhisperNode][baseline]") {
+    // x[n] = 1.6 x[n-1] - 0.81 x[n-2] + noise, so A(z) = 1 - 1.6 z^-1 + 0.81 z^-2
+    dsp::NoiseGenerator noise(7);
+    std::vector<float> excitation(1 << 16);
+    noise.fill(excitation.data(), excitation.size());
+    std::vector<double> x(excitation.size(), 0.0);
+    for (size_t n = 2; n < x.size(); ++n) {
+        x[n] = 1.6 * x[n - 1] - 0.81 * x[n - 2] + excitation[n];
+    }
+
+    double r[3] = {};
+    for (size_t lag = 0; lag < 3; ++lag) {
+        for (size_t n = 0; n + lag < x.size(); ++n) {
+            r[lag] += x[n] * x[n + lag];
+        }
+        r[lag] /= static_cast<double>(x.size());
+    }
+
+    float k[2];
+    double error = dsp::levinsonDurbin(r, 2, k);
+    // Step-up: a1 = k1 (1 + k2), a2 = k2
+    REQUIRE(k[1] == Approx(0.81f).margin(0.01f));
+    REQUIRE(k[0] * (1.0f + k[1]) == Approx(-1.6f).margin(0.01f));
+    REQUIRE(error == Approx(1.0 / 3.0).margin(0.01));
+}
+
+TEST_CASE("WhisperNode - Removes pitch but keeps level and formant", "[WhisperNode]") {
+    SBAnyMap config = {{"mix", 1.0f}};
+    WhisperNode node(config);
+
+    auto input = makeVowel(700.0f, 64 * BUFFER_SIZE);
+    prepareNode(node);
+    auto output = processMono(node, input);
+
+    size_t begin = 4 * BUFFER_SIZE;
+    size_t end = output.size();
+    size_t period = SAMPLE_RATE / 120;
+
+    // The pulse train repeats every period; the whisper does not
+    float inputPeriodicity = correlationAt(input, period, begin, end);
+    float outputPeriodicity = correlationAt(output, period, begin, end);
+    INFO("Periodicity in " << inputPeriodicity << ", out " << outputPeriodicity);
+    REQUIRE(inputPeriodicity > 0.8f);
+    REQUIRE(std::abs(outputPeriodicity) < 0.2f);
+
+    // Level within 3 dB
+    float levelRatio = rms(output, begin, end) / rms(input, begin, end);
+    INFO("Level ratio " << levelRatio);
+    REQUIRE(levelRatio > 0.7f);
+    REQUIRE(levelRatio < 1.4f);
+
+    // The formant stands out of the whisper about as far as it does from the vowel
+    auto bandLevel = [&](const std::vector<float>& signal, float centreHz) {
+        dsp::Biquad band;
+        band.setBandpass(static_cast<float>(SAMPLE_RATE), centreHz, 4.0f);
+        std::vector<float> filtered(signal.size());
+        for (size_t i = 0; i < signal.size(); ++i) {
+            filtered[i] = band.process(signal[i]);
+        }
+        return rms(filtered, begin, end);
+    };
+    float inputContrast = bandLevel(input, 700.0f) / bandLevel(input, 5000.0f);
+    float outputContrast = bandLevel(output, 700.0f) / bandLevel(output, 5000.0f);
+    INFO("700 Hz over 5 kHz: in " << inputContrast << ", out " << outputContrast);
+    REQUIRE(outputContrast > 0.5f * inputContrast);
+}
+
+TEST_CASE("WhisperNode - Switching on mid-stream does not click", "[WhisperNode]") {
+    SBAnyMap config = {{"mix", 0.0f}};
+    WhisperNode node(config);
+    switchboard::AudioBusFormat inputFormat(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    switchboard::AudioBusFormat outputFormat(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+    REQUIRE(node.setBusFormat(inputFormat, outputFormat));
+
+    auto input = makeVowel(700.0f, 16 * BUFFER_SIZE);
+    float inputPeak = 0.0f;
+    for (float sample : input) {
+        inputPeak = std::max(inputPeak, std::abs(sample));
+    }
+
+    float outputPeak = 0.0f;
+    for (size_t block = 0; block < 16; ++block) {
+        if (block == 8) {
+            node.setValue("mix", std::make_any<float>(1.0f));
+        }
+        TestAudioBus inBus(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+        TestAudioBus outBus(SAMPLE_RATE, NUM_CHANNELS, BUFFER_SIZE);
+        for (uint frame = 0; frame < BUFFER_SIZE; ++frame) {
+            inBus.setSample(0, frame, input[block * BUFFER_SIZE + frame]);
+            inBus.setSample(1, frame, input[block * BUFFER_SIZE + frame]);
+        }
+        REQUIRE(node.process(inBus.bus, outBus.bus));
+        for (uint frame = 0; frame < BUFFER_SIZE; ++frame) {
+            REQUIRE(std::isfinite(outBus.getSample(0, frame)));
+            outputPeak = std::max(outputPeak, std::abs(outBus.getSample(0, frame)));
+        }
+    }
+
+    INFO("Input peak " << inputPeak << ", output peak " << outputPeak);
+    REQUIRE(outputPeak < 2.0f * inputPeak);
+}